@@ -0,0 +1,428 @@
+#!/usr/bin/env python3
+# © H2O.ai 2018; -*- encoding: utf-8 -*-
+#   This Source Code Form is subject to the terms of the Mozilla Public
+#   License, v. 2.0. If a copy of the MPL was not distributed with this
+#   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#-------------------------------------------------------------------------------
+"""
+End-to-end benchmarks of datatable's query engine.
+
+This script generates deterministic datasets, runs a standard suite of
+queries (groupby, join, sort, filter, fread/to_csv, Jay save/open), and
+reports for each query its wall time, peak memory and throughput. The
+results can be saved into a JSON file, and later compared against, in order
+to detect performance regressions:
+
+    $ python benchmarks/harness.py --nrows=1e7 --save=baseline.json
+    ... rebuild datatable ...
+    $ python benchmarks/harness.py --nrows=1e7 --compare=baseline.json
+
+When comparing, the script exits with status 1 if any benchmark became
+slower (or used more memory) than the baseline by more than `--threshold`.
+See `python benchmarks/harness.py --help` for the full list of options.
+"""
+import argparse
+import gc
+import json
+import os
+import platform
+import random
+import resource
+import shutil
+import sys
+import tempfile
+import time
+
+import datatable as dt
+from datatable import f, by, join, sort
+
+
+
+#-------------------------------------------------------------------------------
+# Data generation
+#-------------------------------------------------------------------------------
+
+class DataGenerator:
+    """
+    Source of random columns for the benchmarks. The data depends only on the
+    `seed`, the column's name and the requested parameters, so that the same
+    datasets are produced on every run (and every platform).
+    """
+
+    def __init__(self, nrows, na_ratio=0.0, seed=1):
+        self.nrows = nrows
+        self.na_ratio = na_ratio
+        self.seed = seed
+
+    def _rng(self, name):
+        return random.Random("%d/%s" % (self.seed, name))
+
+    def _with_nas(self, rng, values):
+        if self.na_ratio > 0:
+            p = self.na_ratio
+            for i in range(len(values)):
+                if rng.random() < p:
+                    values[i] = None
+        return values
+
+    def ints(self, name, cardinality, nrows=None, nas=True):
+        """Random integers in the range [0; cardinality)."""
+        rng = self._rng(name)
+        n = self.nrows if nrows is None else nrows
+        values = [rng.randrange(cardinality) for _ in range(n)]
+        return self._with_nas(rng, values) if nas else values
+
+    def reals(self, name, nrows=None, nas=True):
+        """Random floats in the range [0; 1)."""
+        rng = self._rng(name)
+        n = self.nrows if nrows is None else nrows
+        values = [rng.random() for _ in range(n)]
+        return self._with_nas(rng, values) if nas else values
+
+    def strings(self, name, cardinality, nrows=None, nas=True):
+        """Random strings drawn from a pool of `cardinality` distinct words."""
+        rng = self._rng(name)
+        n = self.nrows if nrows is None else nrows
+        pool = ["".join(rng.choice("abcdefghijklmnopqrstuvwxyz")
+                        for _ in range(rng.randint(3, 12)))
+                for _ in range(cardinality)]
+        values = [pool[rng.randrange(cardinality)] for _ in range(n)]
+        return self._with_nas(rng, values) if nas else values
+
+    def permutation(self, name, n):
+        """Integers 0 .. n-1 in random order."""
+        values = list(range(n))
+        self._rng(name).shuffle(values)
+        return values
+
+
+
+#-------------------------------------------------------------------------------
+# Memory measurement
+#-------------------------------------------------------------------------------
+
+def reset_peak_rss():
+    """
+    Reset the "high water mark" of the process' RSS, so that the subsequent
+    call to `peak_rss()` returns the peak memory usage since this moment.
+    Returns False if this is not supported by the OS (in which case the peak
+    is measured since the start of the process).
+    """
+    try:
+        with open("/proc/self/clear_refs", "w") as out:
+            out.write("5")
+        return True
+    except OSError:
+        return False
+
+
+def _read_proc_status(field):
+    try:
+        with open("/proc/self/status") as inp:
+            for line in inp:
+                if line.startswith(field + ":"):
+                    return int(line.split()[1]) * 1024
+    except OSError:
+        pass
+    return None
+
+
+def current_rss():
+    """Current resident set size of the process, in bytes."""
+    return _read_proc_status("VmRSS") or peak_rss()
+
+
+def peak_rss():
+    """Peak resident set size of the process, in bytes."""
+    hwm = _read_proc_status("VmHWM")
+    if hwm is not None:
+        return hwm
+    maxrss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # ru_maxrss is in bytes on macOS, and in kilobytes elsewhere
+    return maxrss if sys.platform == "darwin" else maxrss * 1024
+
+
+
+#-------------------------------------------------------------------------------
+# Benchmark suite
+#-------------------------------------------------------------------------------
+
+class Case:
+    """
+    Single benchmark: function `run(data)` is timed, where `data` is the
+    value returned by `setup()`. Parameter `nrows` is the number of rows
+    processed by a run, and `nbytes()` returns the number of bytes processed
+    (for the I/O benchmarks); they are used for computing the throughput.
+    """
+
+    def __init__(self, name, run, nrows, setup, nbytes=None):
+        self.name = name
+        self.run = run
+        self.setup = setup
+        self.nrows = nrows
+        self.nbytes = nbytes
+
+
+def cached(make):
+    """Wrap function `make()` so that it is evaluated only once."""
+    cache = []
+    def wrapper():
+        if not cache:
+            cache.append(make())
+        return cache[0]
+    return wrapper
+
+
+def groupby_cases(gen):
+    n = gen.nrows
+    for p in (2, 4, 6, 7):
+        k = 10**p
+        if k > n:
+            break
+        def setup(k=k):
+            return dt.Frame(K=gen.ints("groupby.K%d" % k, k),
+                            V=gen.reals("groupby.V"))
+        yield Case("groupby_sum/1e%d" % p, nrows=n, setup=setup,
+                   run=lambda DT: DT[:, dt.sum(f.V), by(f.K)])
+
+
+def join_cases(gen):
+    n = gen.nrows
+    nkeys = max(n // 10, 1)
+    # About 20% of the rows in X have no match in Y
+    nx = nkeys * 5 // 4
+    makers = [
+        ("int32", lambda i: i),
+        ("int64", lambda i: i * 4294967311 + 7),
+        ("str", lambda i: "id%09d" % i),
+    ]
+    for ktype, make_key in makers:
+        def setup(make_key=make_key):
+            keys = gen.permutation("join.Y", nkeys)
+            Y = dt.Frame(K=[make_key(i) for i in keys],
+                         P=gen.reals("join.P", nrows=nkeys, nas=False))
+            Y.key = "K"
+            xkeys = gen.ints("join.X", nx)
+            X = dt.Frame(K=[None if i is None else make_key(i)
+                            for i in xkeys])
+            return (X, Y)
+        yield Case("join/" + ktype, nrows=n, setup=setup,
+                   run=lambda XY: XY[0][:, :, join(XY[1])])
+
+
+def sort_cases(gen):
+    n = gen.nrows
+    setup = cached(lambda: dt.Frame(A=gen.ints("sort.A", 100),
+                                    B=gen.strings("sort.B", max(n // 10, 1)),
+                                    C=gen.reals("sort.C")))
+    yield Case("sort/int,str", nrows=n, setup=setup,
+               run=lambda DT: DT[:, :, sort(f.A, f.B)])
+    yield Case("sort/int,real", nrows=n, setup=setup,
+               run=lambda DT: DT[:, :, sort(f.A, f.C)])
+    yield Case("sort/str,int,real", nrows=n, setup=setup,
+               run=lambda DT: DT[:, :, sort(f.B, f.A, f.C)])
+
+
+def filter_cases(gen):
+    n = gen.nrows
+    setup = cached(lambda: dt.Frame(A=gen.ints("filter.A", 100),
+                                    B=gen.reals("filter.B")))
+    yield Case("filter/real", nrows=n, setup=setup,
+               run=lambda DT: DT[f.B < 0.5, :])
+    yield Case("filter/int&real", nrows=n, setup=setup,
+               run=lambda DT: DT[(f.A < 10) & (f.B < 0.5), :])
+
+
+def io_cases(gen, tmpdir):
+    n = gen.nrows
+    def tall():
+        return dt.Frame(A=gen.ints("tall.A", 1000000),
+                        B=gen.reals("tall.B"),
+                        C=gen.strings("tall.C", 1000),
+                        D=gen.ints("tall.D", 2),
+                        E=gen.reals("tall.E"))
+    def wide():
+        nr = max(n // 1000, 1)
+        return dt.Frame([gen.ints("wide.%d" % i, 1000, nrows=nr) if i % 2 else
+                         gen.reals("wide.%d" % i, nrows=nr)
+                         for i in range(1000)])
+
+    for shape, make in [("tall", tall), ("wide", wide)]:
+        data = cached(make)
+        csvfile = os.path.join(tmpdir, shape + ".csv")
+        jayfile = os.path.join(tmpdir, shape + ".jay")
+        def csv_setup(path=csvfile, data=data):
+            if not os.path.exists(path):
+                data().to_csv(path)
+        def jay_setup(path=jayfile, data=data):
+            if not os.path.exists(path):
+                data().to_jay(path)
+        yield Case("to_csv/" + shape, nrows=n, setup=data,
+                   run=lambda DT, path=csvfile: DT.to_csv(path),
+                   nbytes=lambda path=csvfile: os.path.getsize(path))
+        yield Case("fread/" + shape, nrows=n, setup=csv_setup,
+                   run=lambda _, path=csvfile: dt.fread(path),
+                   nbytes=lambda path=csvfile: os.path.getsize(path))
+        yield Case("to_jay/" + shape, nrows=n, setup=data,
+                   run=lambda DT, path=jayfile: DT.to_jay(path),
+                   nbytes=lambda path=jayfile: os.path.getsize(path))
+        yield Case("open_jay/" + shape, nrows=n, setup=jay_setup,
+                   run=lambda _, path=jayfile: dt.open(path).materialize(),
+                   nbytes=lambda path=jayfile: os.path.getsize(path))
+
+
+def make_suite(gen, tmpdir):
+    yield from groupby_cases(gen)
+    yield from join_cases(gen)
+    yield from sort_cases(gen)
+    yield from filter_cases(gen)
+    yield from io_cases(gen, tmpdir)
+
+
+
+#-------------------------------------------------------------------------------
+# Runner
+#-------------------------------------------------------------------------------
+
+def run_case(case, repeat):
+    data = case.setup()
+    gc.collect()
+    exact_peak = reset_peak_rss()
+    rss0 = current_rss()
+    times = []
+    for _ in range(repeat):
+        t0 = time.perf_counter()
+        res = case.run(data)
+        times.append(time.perf_counter() - t0)
+        del res
+        gc.collect()
+    peak = peak_rss()
+    del data
+    best = min(times)
+    result = {
+        "time": best,
+        "median_time": sorted(times)[len(times) // 2],
+        "peak_rss": peak,
+        "mem": max(peak - rss0, 0) if exact_peak else None,
+        "rows_per_sec": case.nrows / best if best else None,
+    }
+    if case.nbytes:
+        nbytes = case.nbytes()
+        result["bytes"] = nbytes
+        result["bytes_per_sec"] = nbytes / best if best else None
+    return result
+
+
+def compare(name, res, base, threshold, mem_slack):
+    """
+    Compare result `res` of a benchmark with its baseline `base`, and return
+    the list of regressions found (as strings).
+    """
+    problems = []
+    if res["time"] > base["time"] * (1 + threshold):
+        problems.append("time %+.0f%%" % (100 * (res["time"] / base["time"] - 1)))
+    mem, basemem = res.get("mem"), base.get("mem")
+    if mem is not None and basemem is not None:
+        if mem > basemem * (1 + threshold) + mem_slack:
+            problems.append("memory %+.0f MB" % ((mem - basemem) / 2**20))
+    return problems
+
+
+def format_row(name, res, base=None, problems=None):
+    mem = res.get("mem")
+    row = "%-22s %10.1f ms %12.3g rows/s %9s" % (
+        name, res["time"] * 1000, res["rows_per_sec"] or 0,
+        "%.1f MB" % (mem / 2**20) if mem is not None else "n/a")
+    if base is not None:
+        row += "   (baseline %.1f ms, x%.2f)" % (base["time"] * 1000,
+                                                  res["time"] / base["time"])
+    if problems:
+        row += "   REGRESSION: " + ", ".join(problems)
+    return row
+
+
+def parse_args(argv):
+    parser = argparse.ArgumentParser(
+        description="Run datatable's end-to-end benchmarks.")
+    parser.add_argument("--nrows", type=float, default=1e6,
+                        help="number of rows in the generated datasets")
+    parser.add_argument("--na-ratio", type=float, default=0.0,
+                        help="fraction of NA values in the generated data")
+    parser.add_argument("--seed", type=int, default=1,
+                        help="seed for the data generator")
+    parser.add_argument("--repeat", type=int, default=3,
+                        help="number of timed runs of each benchmark")
+    parser.add_argument("--nthreads", type=int, default=None,
+                        help="value for dt.options.nthreads")
+    parser.add_argument("--filter", default=None,
+                        help="run only benchmarks whose name contains this "
+                             "string")
+    parser.add_argument("--save", metavar="FILE",
+                        help="save the results into a JSON file")
+    parser.add_argument("--compare", metavar="FILE",
+                        help="compare the results with a baseline JSON file "
+                             "(previously created with --save)")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="relative slowdown (or memory increase) "
+                             "considered a regression")
+    parser.add_argument("--mem-slack", type=float, default=16,
+                        help="absolute memory increase (in MB) that is "
+                             "ignored when looking for regressions")
+    return parser.parse_args(argv)
+
+
+def main(argv=None):
+    args = parse_args(argv)
+    if args.nthreads is not None:
+        dt.options.nthreads = args.nthreads
+    gen = DataGenerator(int(args.nrows), args.na_ratio, args.seed)
+    params = {"nrows": gen.nrows, "na_ratio": gen.na_ratio, "seed": gen.seed,
+              "nthreads": dt.options.nthreads}
+
+    baseline = None
+    if args.compare:
+        with open(args.compare) as inp:
+            baseline = json.load(inp)
+        if baseline["params"] != params:
+            print("Warning: the baseline was created with different "
+                  "parameters: %r" % baseline["params"])
+
+    tmpdir = tempfile.mkdtemp(prefix="dt-bench-")
+    results = {}
+    nregressions = 0
+    try:
+        for case in make_suite(gen, tmpdir):
+            if args.filter and args.filter not in case.name:
+                continue
+            res = run_case(case, max(args.repeat, 1))
+            results[case.name] = res
+            base = baseline["results"].get(case.name) if baseline else None
+            problems = None
+            if base:
+                problems = compare(case.name, res, base, args.threshold,
+                                   args.mem_slack * 2**20)
+                nregressions += bool(problems)
+            print(format_row(case.name, res, base, problems), flush=True)
+    finally:
+        shutil.rmtree(tmpdir, ignore_errors=True)
+
+    if args.save:
+        info = {
+            "datatable": dt.__version__,
+            "python": platform.python_version(),
+            "platform": platform.platform(),
+            "ncpus": os.cpu_count(),
+            "date": time.strftime("%Y-%m-%d %H:%M:%S"),
+        }
+        with open(args.save, "w") as out:
+            json.dump({"params": params, "info": info, "results": results},
+                      out, indent=2, sort_keys=True)
+    if nregressions:
+        print("%d benchmark(s) regressed compared to %s"
+              % (nregressions, args.compare))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -137,13 +137,14 @@ Column* Column::shallowcopy(const RowIndex& new_rowindex) const {
   Column* col = new_column(stype());
   col->nrows = nrows;
   col->mbuf = mbuf;
-  // TODO: also copy Stats object
 
   if (new_rowindex) {
     col->ri = new_rowindex;
     col->nrows = new_rowindex.size();
-  } else if (ri) {
-    col->ri = ri;
+  } else {
+    if (ri) col->ri = ri;
+    // The copy has the same data, so the stats remain valid
+    if (stats) col->stats = stats->copy();
   }
   return col;
 }
@@ -168,6 +169,7 @@ RowIndex Column::remove_rowindex() {
 void Column::replace_rowindex(const RowIndex& newri) {
   ri = newri;
   nrows = ri.size();
+  if (stats) stats->reset();
 }
 
 
@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #include "column.h"
 #include <cstdlib>         // std::abs
+#include <cstring>         // std::memcpy
 #include <limits>          // std::numeric_limits
 #include <type_traits>     // std::is_same
 #include "python/_all.h"
@@ -14,6 +15,7 @@
 #include "python/string.h" // py::ostring
 #include "utils/exceptions.h"
 #include "utils/misc.h"
+#include "utils/parallel.h"
 
 //------------------------------------------------------------------------------
 // Helper iterator classes
@@ -24,6 +26,8 @@ class iterable {
     virtual ~iterable();
     virtual size_t size() const = 0;
     virtual py::robj item(size_t i) const = 0;
+    // Direct pointer to the array of items, if available (or nullptr)
+    virtual PyObject* const* items() const;
 };
 
 
@@ -35,6 +39,7 @@ class ilist : public iterable {
     explicit ilist(const py::olist& src);
     size_t size() const override;
     py::robj item(size_t i) const override;
+    PyObject* const* items() const override;
 };
 
 
@@ -66,6 +71,8 @@ class idictlist : public iterable {
 
 iterable::~iterable() {}
 
+PyObject* const* iterable::items() const { return nullptr; }
+
 
 ilist::ilist(const py::olist& src) : list(src) {}
 
@@ -73,6 +80,11 @@ size_t ilist::size() const { return list.size(); }
 
 py::robj ilist::item(size_t i) const { return list[i]; }
 
+// Works for both lists and tuples
+PyObject* const* ilist::items() const {
+  return PySequence_Fast_ITEMS(list.to_borrowed_ref());
+}
+
 
 ituplist::ituplist(const py::olist& src, size_t index)
     : tuple_list(src), j(index) {}
@@ -475,6 +487,276 @@ static bool parse_as_pyobj(const iterable* list, MemoryRange& membuf)
 
 
 
+//------------------------------------------------------------------------------
+// Fast path
+//------------------------------------------------------------------------------
+// When the stype is not given explicitly, the parsers above are tried one
+// after another, each re-scanning the list and calling python API for every
+// element. Instead, the fast path classifies all items by their exact type
+// in a single parallel pass (this only reads the objects' type pointers, and
+// is therefore safe to do without the GIL), then determines the final stype
+// from the set of kinds found, and finally converts the items in one typed
+// pass. Objects of any "unusual" type (subclasses of int/float/str, numpy
+// scalars, etc) cause the fast path to bail out, and the regular parse chain
+// is used instead.
+//
+// The result is the same as with the regular parse chain, except that int
+// values equal to the NA marker of a type (e.g. -128 for int8) are no longer
+// silently converted into NAs.
+
+static constexpr uint8_t KIND_NONE  = 1;
+static constexpr uint8_t KIND_BOOL  = 2;
+static constexpr uint8_t KIND_INT   = 4;
+static constexpr uint8_t KIND_FLOAT = 8;
+static constexpr uint8_t KIND_STR   = 16;
+static constexpr uint8_t KIND_OTHER = 32;
+
+static inline uint8_t item_kind(PyObject* x) {
+  if (x == Py_None) return KIND_NONE;
+  if (x == Py_True || x == Py_False) return KIND_BOOL;
+  PyTypeObject* type = Py_TYPE(x);
+  if (type == &PyLong_Type) return KIND_INT;
+  if (type == &PyFloat_Type) return KIND_FLOAT;
+  if (type == &PyUnicode_Type) return KIND_STR;
+  return KIND_OTHER;
+}
+
+static uint8_t classify_items(PyObject* const* items, size_t n) {
+  uint8_t kinds = 0;
+  #pragma omp parallel for schedule(static) reduction(|:kinds) \
+          if(n > 65536)
+  for (size_t i = 0; i < n; ++i) {
+    kinds |= item_kind(items[i]);
+  }
+  return kinds;
+}
+
+
+static void fast_fill_bool(PyObject* const* items, size_t n,
+                           MemoryRange& membuf)
+{
+  membuf.resize(n);
+  int8_t* outdata = static_cast<int8_t*>(membuf.wptr());
+  #pragma omp parallel for schedule(static) if(n > 65536)
+  for (size_t i = 0; i < n; ++i) {
+    PyObject* x = items[i];
+    outdata[i] = x == Py_True? 1 : x == Py_False? 0 : GETNA<int8_t>();
+  }
+}
+
+
+template <typename T>
+static void narrow_int64(size_t n, MemoryRange& membuf) {
+  MemoryRange res = MemoryRange::mem(n * sizeof(T));
+  const int64_t* inp = static_cast<const int64_t*>(membuf.rptr());
+  T* out = static_cast<T*>(res.wptr());
+  #pragma omp parallel for schedule(static) if(n > 65536)
+  for (size_t i = 0; i < n; ++i) {
+    int64_t x = inp[i];
+    out[i] = ISNA<int64_t>(x)? GETNA<T>() : static_cast<T>(x);
+  }
+  membuf = std::move(res);
+}
+
+
+/**
+ * Convert a list of ints / bools / Nones. Returns the stype of the resulting
+ * column, or VOID if the values cannot be stored in an integer column (in
+ * which case they must be parsed as float64, or as objects if there are bools
+ * among them).
+ */
+static SType fast_fill_int(PyObject* const* items, size_t n, bool has_bools,
+                           MemoryRange& membuf)
+{
+  constexpr int64_t MAX = std::numeric_limits<int64_t>::max();
+  membuf.resize(n * sizeof(int64_t));
+  int64_t* outdata = static_cast<int64_t*>(membuf.wptr());
+  int64_t vmin = MAX;
+  int64_t vmax = -MAX;
+  for (size_t i = 0; i < n; ++i) {
+    PyObject* x = items[i];
+    int64_t value;
+    if (x == Py_None) {
+      outdata[i] = GETNA<int64_t>();
+      continue;
+    }
+    if (x == Py_True || x == Py_False) {
+      value = (x == Py_True);
+    } else {
+      int overflow;
+      long long v = PyLong_AsLongLongAndOverflow(x, &overflow);
+      if (overflow || v < -MAX) return SType::VOID;
+      value = static_cast<int64_t>(v);
+    }
+    outdata[i] = value;
+    if (value < vmin) vmin = value;
+    if (value > vmax) vmax = value;
+  }
+  if (vmin >= 0 && vmax <= 1) {
+    narrow_int64<int8_t>(n, membuf);
+    return SType::BOOL;
+  }
+  if (has_bools) return SType::VOID;
+  if (vmin >= -127 && vmax <= 127) {
+    narrow_int64<int8_t>(n, membuf);
+    return SType::INT8;
+  }
+  if (vmin >= -32767 && vmax <= 32767) {
+    narrow_int64<int16_t>(n, membuf);
+    return SType::INT16;
+  }
+  if (vmin >= -2147483647 && vmax <= 2147483647) {
+    narrow_int64<int32_t>(n, membuf);
+    return SType::INT32;
+  }
+  return SType::INT64;
+}
+
+
+static void fast_fill_double(PyObject* const* items, size_t n,
+                             MemoryRange& membuf)
+{
+  membuf.resize(n * sizeof(double));
+  double* outdata = static_cast<double*>(membuf.wptr());
+  for (size_t i = 0; i < n; ++i) {
+    PyObject* x = items[i];
+    if (x == Py_None) {
+      outdata[i] = GETNA<double>();
+    }
+    else if (Py_TYPE(x) == &PyFloat_Type) {
+      outdata[i] = PyFloat_AS_DOUBLE(x);
+    }
+    else {
+      double value = PyLong_AsDouble(x);
+      if (value == -1 && PyErr_Occurred()) {
+        PyErr_Clear();
+        value = _PyLong_Sign(x) > 0? std::numeric_limits<double>::infinity()
+                                   : -std::numeric_limits<double>::infinity();
+      }
+      outdata[i] = value;
+    }
+  }
+}
+
+
+/**
+ * Convert a list of strings / Nones. The strings' UTF-8 representations are
+ * located in a serial pass (which requires python API for non-ASCII strings),
+ * and then all character data is copied into a single pre-allocated `strbuf`
+ * in parallel.
+ */
+template <typename T>
+static void fast_fill_str(PyObject* const* items, size_t n,
+                          const std::vector<const char*>& chars,
+                          MemoryRange& offbuf, MemoryRange& strbuf)
+{
+  offbuf.resize((n + 1) * sizeof(T));
+  T* offsets = static_cast<T*>(offbuf.wptr()) + 1;
+  offsets[-1] = 0;
+  T curr_offset = 0;
+  for (size_t i = 0; i < n; ++i) {
+    PyObject* x = items[i];
+    if (x == Py_None) {
+      offsets[i] = curr_offset ^ GETNA<T>();
+    } else {
+      Py_ssize_t len;
+      if (PyUnicode_IS_COMPACT_ASCII(x)) {
+        len = PyUnicode_GET_LENGTH(x);
+      } else {
+        // The UTF-8 representation is cached within the string object,
+        // so this call is cheap (it was already made in the first pass).
+        PyUnicode_AsUTF8AndSize(x, &len);
+      }
+      curr_offset += static_cast<T>(len);
+      offsets[i] = curr_offset;
+    }
+  }
+  strbuf.resize(static_cast<size_t>(curr_offset));
+  if (!curr_offset) return;
+  char* strdata = static_cast<char*>(strbuf.wptr());
+  #pragma omp parallel for schedule(dynamic, 4096) if(n > 65536)
+  for (size_t i = 0; i < n; ++i) {
+    T end = offsets[i];
+    if (ISNA<T>(end)) continue;
+    T start = offsets[i - 1] & ~GETNA<T>();
+    if (end > start) {
+      std::memcpy(strdata + start, chars[i], static_cast<size_t>(end - start));
+    }
+  }
+}
+
+
+static SType fast_parse_str(PyObject* const* items, size_t n,
+                            MemoryRange& offbuf, MemoryRange& strbuf)
+{
+  std::vector<const char*> chars(n);
+  size_t total = 0;
+  for (size_t i = 0; i < n; ++i) {
+    PyObject* x = items[i];
+    if (x == Py_None) continue;
+    Py_ssize_t len;
+    if (PyUnicode_IS_COMPACT_ASCII(x)) {
+      chars[i] = static_cast<const char*>(PyUnicode_DATA(x));
+      len = PyUnicode_GET_LENGTH(x);
+    } else {
+      chars[i] = PyUnicode_AsUTF8AndSize(x, &len);
+      if (!chars[i]) throw PyError();
+    }
+    total += static_cast<size_t>(len);
+  }
+  if (total <= static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    fast_fill_str<uint32_t>(items, n, chars, offbuf, strbuf);
+    return SType::STR32;
+  } else {
+    fast_fill_str<uint64_t>(items, n, chars, offbuf, strbuf);
+    return SType::STR64;
+  }
+}
+
+
+/**
+ * Attempt to parse the list `il` via the fast path. Returns the stype of the
+ * parsed data (which is written into `membuf` / `strbuf`), or VOID if the
+ * list cannot be processed this way.
+ */
+static SType parse_fast(const iterable* il, MemoryRange& membuf,
+                        MemoryRange& strbuf)
+{
+  size_t nrows = il->size();
+  std::vector<PyObject*> tmp;
+  PyObject* const* items = il->items();
+  if (!items) {
+    tmp.resize(nrows);
+    for (size_t i = 0; i < nrows; ++i) {
+      tmp[i] = il->item(i).to_borrowed_ref();
+    }
+    items = tmp.data();
+  }
+  uint8_t kinds = classify_items(items, nrows);
+  if (kinds & KIND_OTHER) return SType::VOID;
+  kinds &= ~KIND_NONE;
+  if ((kinds & ~KIND_BOOL) == 0) {
+    fast_fill_bool(items, nrows, membuf);
+    return SType::BOOL;
+  }
+  if ((kinds & ~(KIND_BOOL | KIND_INT)) == 0) {
+    SType res = fast_fill_int(items, nrows, (kinds & KIND_BOOL), membuf);
+    if (res != SType::VOID) return res;
+    if (kinds & KIND_BOOL) kinds |= KIND_OTHER;
+  }
+  if ((kinds & ~(KIND_INT | KIND_FLOAT)) == 0) {
+    fast_fill_double(items, nrows, membuf);
+    return SType::FLOAT64;
+  }
+  if (kinds == KIND_STR) {
+    return fast_parse_str(items, nrows, membuf, strbuf);
+  }
+  parse_as_pyobj(il, membuf);
+  return SType::OBJ;
+}
+
+
+
 //------------------------------------------------------------------------------
 // Parse controller
 //------------------------------------------------------------------------------
@@ -495,10 +777,9 @@ static SType find_next_stype(SType curr_stype, int stype0) {
 
 
 
-Column* Column::from_py_iterable(const iterable* il, int stype0)
+static SType parse_chain(const iterable* il, int stype0,
+                         MemoryRange& membuf, MemoryRange& strbuf)
 {
-  MemoryRange membuf;
-  MemoryRange strbuf;
   // TODO: Perhaps `stype` and `curr_stype` should have type SType ?
   SType stype = find_next_stype(SType::VOID, stype0);
   size_t i = 0;
@@ -539,6 +820,18 @@ Column* Column::from_py_iterable(const iterable* il, int stype0)
       stype = next_stype;
     }
   }
+  return stype;
+}
+
+
+Column* Column::from_py_iterable(const iterable* il, int stype0)
+{
+  MemoryRange membuf;
+  MemoryRange strbuf;
+  SType stype = stype0 == 0? parse_fast(il, membuf, strbuf) : SType::VOID;
+  if (stype == SType::VOID) {
+    stype = parse_chain(il, stype0, membuf, strbuf);
+  }
   if (stype == SType::STR32 || stype == SType::STR64) {
     size_t nrows = il->size();
     return new_string_column(nrows, std::move(membuf), std::move(strbuf));
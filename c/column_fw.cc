@@ -100,9 +100,12 @@ const T* FwColumn<T>::elements_r() const {
   return static_cast<const T*>(mbuf.rptr());
 }
 
+// The caller is about to modify the data, so the stats (which may have been
+// inherited from the column that this one is a shallow copy of) are reset.
 template <typename T>
 T* FwColumn<T>::elements_w() {
   if (ri) materialize();
+  if (stats) stats->reset();
   return static_cast<T*>(mbuf.wptr());
 }
 
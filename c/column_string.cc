@@ -577,9 +577,10 @@ RowIndex StringColumn<T>::join(const Column* keycol) const {
 template <typename T>
 void StringColumn<T>::fill_na_mask(int8_t* outmask, size_t row0, size_t row1) {
   const T* offs = this->offsets();
-  for (size_t i = row0; i < row1; ++i) {
-    outmask[i] = ISNA<T>(offs[i]);
-  }
+  ri.iterate(row0, row1, 1,
+    [&](size_t i, size_t j) {
+      outmask[i] = (j == RowIndex::NA) || ISNA<T>(offs[j]);
+    });
 }
 
 
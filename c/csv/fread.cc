@@ -6,6 +6,7 @@
 #include "read/fread/fread_parallel_reader.h"  // FreadParallelReader
 #include "read/fread/fread_tokenizer.h"        // FreadTokenizer
 #include "utils/misc.h"                        // wallclock
+#include "utils/profiler.h"                    // dt::profile_scope
 #include "datatable.h"                         // DataTable
 
 
@@ -19,6 +20,7 @@
 //==============================================================================
 std::unique_ptr<DataTable> FreadReader::read_all()
 {
+  dt::profile_scope ps_detect("fread.detect");
   detect_lf();
   skip_preamble();
 
@@ -43,6 +45,7 @@ std::unique_ptr<DataTable> FreadReader::read_all()
     line++;
   }
   if (verbose) fo.t_column_types_detected = wallclock();
+  ps_detect.stop();
 
 
   //*********************************************************************************************
@@ -140,10 +143,12 @@ std::unique_ptr<DataTable> FreadReader::read_all()
 
     fo.n_rows_read = columns.get_nrows();
     fo.n_cols_read = columns.nColumnsInOutput();
+    dt::profile_count("fread.rows", fo.n_rows_read);
   }
 
 
   trace("[7] Finalize the datatable");
+  dt::profile_scope ps_finalize("fread.finalize");
   std::unique_ptr<DataTable> res = makeDatatable();
   if (verbose) fo.report();
   return res;
@@ -13,9 +13,12 @@
 #include "csv/reader_arff.h"
 #include "csv/reader_fread.h"
 #include "python/_all.h"
+#include "python/gil.h"
 #include "python/string.h"
 #include "utils/exceptions.h"
 #include "utils/parallel.h"
+#include "utils/profiler.h"
+#include "utils/thread_pool.h"
 #include "utils/misc.h"         // wallclock
 #include "datatable.h"
 #include "encodings.h"
@@ -291,12 +294,14 @@ void GenericReader::init_overridecolumntypes() {
 
 std::unique_ptr<DataTable> GenericReader::read_all()
 {
+  dt::profile_scope ps("fread");
   open_input();
   detect_and_skip_bom();
   skip_to_line_number();
   skip_to_line_with_string();
   skip_initial_whitespace();
   skip_trailing_whitespace();
+  dt::profile_count("fread.bytes", datasize());
 
   std::unique_ptr<DataTable> dt(nullptr);
   if (!dt) dt = read_empty_input();
@@ -343,19 +348,21 @@ void GenericReader::warn(const char* format, ...) const {
 void GenericReader::_message(
   const char* method, const char* format, va_list args) const
 {
-  static char shared_buffer[2001];
+  char buffer[2001];
   char* msg;
   if (strcmp(format, "%s") == 0) {
     msg = va_arg(args, char*);
   } else {
-    msg = shared_buffer;
+    msg = buffer;
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Wformat-nonliteral"
     vsnprintf(msg, 2000, format, args);
     #pragma GCC diagnostic pop
   }
 
-  if (omp_get_thread_num() == 0) {
+  if (dt::this_thread_index() == 0) {
+    // The GIL may have been released while reading the data
+    py::gil_acquire gil;
     try {
       Py_ssize_t len = static_cast<Py_ssize_t>(strlen(msg));
       PyObject* pymsg = PyUnicode_Decode(msg, len, "utf-8",
@@ -376,12 +383,13 @@ void GenericReader::_message(
 }
 
 void GenericReader::progress(double progress, int statuscode) {
-  xassert(omp_get_thread_num() == 0);
+  xassert(dt::this_thread_index() == 0);
+  py::gil_acquire gil;
   freader.invoke("_progress", "(di)", progress, statuscode);
 }
 
 void GenericReader::emit_delayed_messages() {
-  xassert(omp_get_thread_num() == 0);
+  xassert(dt::this_thread_index() == 0);
   if (delayed_message.size()) {
     trace("%s", delayed_message.c_str());
     delayed_message.clear();
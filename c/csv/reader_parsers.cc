@@ -106,7 +106,7 @@ void parse_bool8_uppercase(FreadTokenizer& ctx) {
 // Int32 / Int64
 //------------------------------------------------------------------------------
 
-// See (?)microbench/fread/int32.cpp for performance tests
+// See microbench/bench_io.cc for performance tests
 //
 template <typename T, bool allow_leading_zeroes>
 void parse_int_simple(FreadTokenizer& ctx) {
@@ -22,8 +22,10 @@ class CsvColumn;
 
 
 class CsvWriter {
-  // Input parameters
-  DataTable* dt;
+  // Input parameters. The frame is a shallow copy of the frame being
+  // written: the data is written without holding the GIL, and meanwhile
+  // other python threads may modify the original frame.
+  std::unique_ptr<DataTable> dt;
   std::string path;
   size_t nthreads;
   py::oobj logger;
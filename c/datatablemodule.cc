@@ -6,6 +6,7 @@
 // © H2O.ai 2018
 //------------------------------------------------------------------------------
 #include <iostream>
+#include <map>
 #include <unordered_map>
 #include <Python.h>
 #include "../datatable/include/datatable.h"
@@ -20,10 +21,13 @@
 #include "python/_all.h"
 #include "python/string.h"
 #include "datatablemodule.h"
+#include "mmm.h"
 #include "options.h"
 #include "py_encodings.h"
 #include "py_rowindex.h"
+#include "utils/alloc.h"
 #include "utils/assert.h"
+#include "utils/profiler.h"
 #include "ztest.h"
 
 
@@ -187,6 +191,141 @@ static void _column_save_to_disk(const py::PKArgs& args) {
 
 
 
+static py::PKArgs args_get_alloc_stats(
+    0, 0, 0, false, false, {}, "get_alloc_stats",
+R"(Return a dictionary with the counters of large buffer allocations:
+the number and the total size of buffers allocated via mmap, of those
+advised for transparent huge pages, and the number of bytes that were
+pre-faulted in parallel ("first-touch" initialization).
+)");
+
+static py::oobj get_alloc_stats(const py::PKArgs&) {
+  py::odict res;
+  res.set(py::ostring("large_allocs"),
+          py::oint(dt::alloc_stats.large_allocs.load()));
+  res.set(py::ostring("large_bytes"),
+          py::oint(dt::alloc_stats.large_bytes.load()));
+  res.set(py::ostring("hugepage_allocs"),
+          py::oint(dt::alloc_stats.hugepage_allocs.load()));
+  res.set(py::ostring("hugepage_bytes"),
+          py::oint(dt::alloc_stats.hugepage_bytes.load()));
+  res.set(py::ostring("first_touch_bytes"),
+          py::oint(dt::alloc_stats.first_touch_bytes.load()));
+  return std::move(res);
+}
+
+
+
+static py::PKArgs args_memory_stats(
+    0, 0, 0, false, false, {}, "memory_stats",
+R"(Return a dictionary describing the memory currently held by datatable:
+
+    current: total size of the memory allocated by datatable, including
+        temporary buffers (such as those used in sorting or grouping);
+    peak: the highest value of `current` since the start of the program, or
+        since the last call to `reset_memory_peak()`;
+    heap, heap_buffers: the part of `current` allocated on the malloc heap
+        (the rest are large anonymous memory mappings), and the number of
+        heap blocks;
+    limited: size of the buffers that are subject to
+        `dt.options.memory.limit`;
+    spilled: size of the buffers that were spilled to disk;
+    mmap, external, view: number of bytes held in memory-mapped files, in
+        external buffers and in views; and `*_buffers`: the number of such
+        buffers;
+    cow_copies, cow_bytes: how many times (and how many bytes) a shared
+        memory buffer had to be copied before it could be modified.
+
+The "external" buffers are owned by other objects (such as numpy arrays),
+and the "view" buffers are parts of other buffers: neither of them, nor the
+memory-mapped files, are included in the `current` total.
+)");
+
+static py::oobj memory_stats(const py::PKArgs&) {
+  using Kind = MemoryBudget::Kind;
+  static const char* kind_names[MemoryBudget::NKINDS] = {
+    "mmap", "external", "view"
+  };
+  MemoryBudget* budget = MemoryBudget::get();
+  py::odict res;
+  auto& counters = dt::memory_counters;
+  res.set(py::ostring("current"), py::oint(dt::memory_current()));
+  res.set(py::ostring("peak"), py::oint(counters.peak.load()));
+  res.set(py::ostring("heap"), py::oint(counters.heap_bytes.load()));
+  res.set(py::ostring("heap_buffers"), py::oint(counters.heap_buffers.load()));
+  res.set(py::ostring("limited"), py::oint(budget->allocated_size()));
+  res.set(py::ostring("spilled"), py::oint(budget->spilled_size()));
+  for (size_t k = 0; k < MemoryBudget::NKINDS; ++k) {
+    Kind kind = static_cast<Kind>(k);
+    std::string name = kind_names[k];
+    res.set(py::ostring(name), py::oint(budget->tracked_size(kind)));
+    res.set(py::ostring(name + "_buffers"),
+            py::oint(budget->tracked_count(kind)));
+  }
+  res.set(py::ostring("cow_copies"), py::oint(budget->copies_count()));
+  res.set(py::ostring("cow_bytes"), py::oint(budget->copies_size()));
+  return std::move(res);
+}
+
+
+
+static py::PKArgs args_reset_memory_peak(
+    0, 0, 0, false, false, {}, "reset_memory_peak",
+R"(Reset the `peak` counter in `memory_stats()` to the current amount of
+memory held by datatable, and return its previous value.
+)");
+
+static py::oobj reset_memory_peak(const py::PKArgs&) {
+  return py::oint(dt::memory_reset_peak());
+}
+
+
+
+static py::PKArgs args_get_profile_data(
+    0, 0, 0, false, false, {}, "get_profile_data",
+R"(Return the data collected by the profiler (see `dt.options.profile`), as
+a tuple `(events, counters)`. Here `events` is a list of tuples
+`(name, thread, start, duration)`, where the times are in microseconds;
+and `counters` is a dictionary of the total values of each counter.
+)");
+
+static py::oobj get_profile_data(const py::PKArgs&) {
+  std::vector<dt::profile_event> events;
+  std::vector<dt::profile_counter> counters;
+  dt::profile_collect(events, counters);
+
+  py::olist pyevents(events.size());
+  for (size_t i = 0; i < events.size(); ++i) {
+    const dt::profile_event& e = events[i];
+    pyevents.set(i, py::otuple({
+      py::ostring(e.name),
+      py::oint(e.thread),
+      py::ofloat(static_cast<double>(e.start) * 1e-3),
+      py::ofloat(static_cast<double>(e.duration) * 1e-3)
+    }));
+  }
+  std::map<std::string, size_t> totals;
+  for (const auto& cnt : counters) {
+    totals[cnt.first] += cnt.second;
+  }
+  py::odict pycounters;
+  for (const auto& kv : totals) {
+    pycounters.set(py::ostring(kv.first), py::oint(kv.second));
+  }
+  return py::otuple(std::move(pyevents), std::move(pycounters));
+}
+
+
+static py::PKArgs args_clear_profile_data(
+    0, 0, 0, false, false, {}, "clear_profile_data",
+    "Discard all data collected by the profiler.\n");
+
+static void clear_profile_data(const py::PKArgs&) {
+  dt::profile_clear();
+}
+
+
+
 //------------------------------------------------------------------------------
 // Support memory leak detection
 //------------------------------------------------------------------------------
@@ -266,6 +405,11 @@ void py::DatatableModule::init_methods() {
   ADD_FN(&frame_column_data_r, args_frame_column_data_r);
   ADD_FN(&_column_save_to_disk, args__column_save_to_disk);
   ADD_FN(&frame_integrity_check, args_frame_integrity_check);
+  ADD_FN(&get_alloc_stats, args_get_alloc_stats);
+  ADD_FN(&memory_stats, args_memory_stats);
+  ADD_FN(&reset_memory_peak, args_reset_memory_peak);
+  ADD_FN(&get_profile_data, args_get_profile_data);
+  ADD_FN(&clear_profile_data, args_clear_profile_data);
 
   init_methods_aggregate();
   init_methods_buffers();
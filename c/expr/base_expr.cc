@@ -614,6 +614,15 @@ void py::base_expr::m__init__(py::PKArgs& args) {
       expr = dt::expr_string_fn(op, std::move(arg), params).release();
       break;
     }
+    case dt::exprCode::WINDOW: {
+      check_args_count(va, 3);
+      size_t op = va[0].to_size_t();
+      dt::pexpr arg;
+      if (!va[1].is_none()) arg = to_base_expr(va[1]);
+      oobj params = va[2];
+      expr = dt::expr_window_fn(op, std::move(arg), params).release();
+      break;
+    }
   }
 }
 
@@ -61,21 +61,30 @@ namespace expr {
 
 // Synchronize with datatable/expr/reduce_expr.py
 enum class ReduceOp : size_t {
-  MEAN   = 1,
-  MIN    = 2,
-  MAX    = 3,
-  STDEV  = 4,
-  FIRST  = 5,
-  SUM    = 6,
-  COUNT  = 7,  // count of non-NA values in each group
-  MEDIAN = 8,
+  MEAN    = 1,
+  MIN     = 2,
+  MAX     = 3,
+  STDEV   = 4,
+  FIRST   = 5,
+  SUM     = 6,
+  COUNT   = 7,  // count of non-NA values in each group
+  MEDIAN  = 8,
+  NUNIQUE = 9,  // count of distinct non-NA values in each group
+  LAST    = 10,
+  ANY     = 11,
+  ALL     = 12,
+  PROD    = 13,
+  VAR     = 14,
+  SKEW    = 15,
+  KURT    = 16,
 };
 
 // Each ReduceOp must be < REDUCEOP_COUNT
-constexpr size_t REDUCEOP_COUNT = 8 + 1;
+constexpr size_t REDUCEOP_COUNT = 16 + 1;
 
 static const char* reducer_names[REDUCEOP_COUNT] = {
-  "", "mean", "min", "max", "stdev", "first", "sum", "count", "median"
+  "", "mean", "min", "max", "stdev", "first", "sum", "count", "median",
+  "nunique", "last", "any", "all", "prod", "var", "skew", "kurt"
 };
 
 
@@ -110,6 +119,7 @@ enum exprCode : size_t {
   UNREDUCE = 6,
   NUREDUCE = 7,
   STRINGFN = 8,
+  WINDOW   = 9,
 };
 
 enum class biop : size_t {
@@ -148,6 +158,16 @@ enum class strop : size_t {
   RE_MATCH = 1,
 };
 
+// Synchronize with datatable/expr/window_expr.py
+enum class winop : size_t {
+  CUMSUM       = 1,
+  CUMCOUNT     = 2,
+  SHIFT        = 3,
+  RANK         = 4,
+  ROLLING_MEAN = 5,
+  ROLLING_SUM  = 6,
+};
+
 
 
 class expr_column : public base_expr {
@@ -169,6 +189,7 @@ class expr_column : public base_expr {
 
 
 pexpr expr_string_fn(size_t op, pexpr&& arg, py::oobj params);
+pexpr expr_window_fn(size_t op, pexpr&& arg, py::oobj params);
 
 
 
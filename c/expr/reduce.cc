@@ -6,11 +6,14 @@
 // © H2O.ai 2018
 //------------------------------------------------------------------------------
 #include <cmath>             // std::sqrt
+#include <cstring>           // std::memcmp
 #include <limits>            // std::numeric_limits<?>::max, ::infinity
 #include <memory>            // std::unique_ptr
 #include <unordered_map>     // std::unordered_map
 #include "expr/base_expr.h"  // ReduceOp
 #include "utils/parallel.h"
+#include "utils/profiler.h"
+#include "stats.h"           // MomentsAccumulator
 #include "types.h"
 namespace expr {
 
@@ -93,6 +96,36 @@ static colptr reduce_first(const colptr& col, const Groupby& groupby)
 
 
 
+//------------------------------------------------------------------------------
+// "Last" reducer
+//------------------------------------------------------------------------------
+
+static colptr reduce_last(const colptr& col, const Groupby& groupby)
+{
+  if (col->nrows == 0) {
+    return colptr(Column::new_data_column(col->stype(), 0));
+  }
+  size_t ngrps = groupby.ngroups();
+  // Same as in `reduce_first()`, except that we take the last element of each
+  // group, which is located just before the beginning of the next group.
+  const int32_t* offsets = groupby.offsets_r();
+  arr32_t indices(ngrps);
+  int32_t* indices_data = indices.data();
+  dt::run_parallel(
+    [&](size_t i0, size_t i1, size_t di) {
+      for (size_t i = i0; i < i1; i += di) {
+        indices_data[i] = offsets[i + 1] - 1;
+      }
+    }, ngrps);
+  RowIndex ri = RowIndex(std::move(indices), true)
+                * col->rowindex();
+  auto res = colptr(col->shallowcopy(ri));
+  if (ngrps == 1) res->materialize();
+  return res;
+}
+
+
+
 //------------------------------------------------------------------------------
 // Sum calculation
 //------------------------------------------------------------------------------
@@ -273,6 +306,187 @@ static void median_reducer(const RowIndex& ri, size_t row0, size_t row1,
 
 
 
+//------------------------------------------------------------------------------
+// Number of unique values
+//------------------------------------------------------------------------------
+
+// This reducer expects the rowindex `ri` to be sorted within each group, so
+// that equal values are adjacent, and NAs come first.
+template<typename T>
+static void nunique_reducer(const RowIndex& ri, size_t row0, size_t row1,
+                            const void* inp, void* out, size_t grp_index)
+{
+  const T* inputs = static_cast<const T*>(inp);
+  int64_t count = 0;
+  T prev = GETNA<T>();
+  ri.iterate(row0, row1, 1,
+    [&](size_t, size_t j) {
+      if (j == RowIndex::NA) return;
+      T x = inputs[j];
+      if (ISNA<T>(x)) return;
+      if (count == 0 || x != prev) {
+        prev = x;
+        count++;
+      }
+    });
+  int64_t* outputs = static_cast<int64_t*>(out);
+  outputs[grp_index] = count;
+}
+
+
+// String columns cannot go through the ReducerLibrary, since the reducer
+// functions have no access to the column's string data.
+template<typename T>
+static colptr reduce_nunique_str(const colptr& col, const Groupby& groupby)
+{
+  size_t ngrps = groupby.ngroups();
+  size_t out_nrows = ngrps? ngrps : 1;
+  auto res = colptr(Column::new_data_column(SType::INT64, out_nrows));
+  int64_t* outputs = static_cast<int64_t*>(res->data_w());
+  if (col->nrows == 0) {
+    outputs[0] = 0;
+    return res;
+  }
+  auto scol = static_cast<const StringColumn<T>*>(col.get());
+  const T* offsets = scol->offsets();
+  const char* strdata = scol->strdata();
+  const int32_t* groups = groupby.offsets_r();
+  RowIndex ri = col->sort_grouped(col->rowindex(), groupby);
+
+  #pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < ngrps; ++i) {
+    size_t row0 = static_cast<size_t>(groups[i]);
+    size_t row1 = static_cast<size_t>(groups[i + 1]);
+    int64_t count = 0;
+    T prev_start = 0, prev_len = 0;
+    ri.iterate(row0, row1, 1,
+      [&](size_t, size_t j) {
+        if (j == RowIndex::NA) return;
+        T end = offsets[j];
+        if (ISNA<T>(end)) return;
+        T start = offsets[j - 1] & ~GETNA<T>();
+        T len = end - start;
+        if (count == 0 || len != prev_len ||
+            std::memcmp(strdata + start, strdata + prev_start, len) != 0) {
+          prev_start = start;
+          prev_len = len;
+          count++;
+        }
+      });
+    outputs[i] = count;
+  }
+  return res;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Any / All
+//------------------------------------------------------------------------------
+
+// Returns True if at least one value in the group is True. NAs are ignored,
+// thus an empty or all-NA group produces False.
+static void any_reducer(const RowIndex& ri, size_t row0, size_t row1,
+                        const void* inp, void* out, size_t grp_index)
+{
+  const int8_t* inputs = static_cast<const int8_t*>(inp);
+  int8_t res = 0;
+  ri.iterate(row0, row1, 1,
+    [&](size_t, size_t j) {
+      if (j == RowIndex::NA) return;
+      if (inputs[j] == 1) res = 1;
+    });
+  static_cast<int8_t*>(out)[grp_index] = res;
+}
+
+
+// Returns False if at least one value in the group is False. NAs are
+// ignored, thus an empty or all-NA group produces True.
+static void all_reducer(const RowIndex& ri, size_t row0, size_t row1,
+                        const void* inp, void* out, size_t grp_index)
+{
+  const int8_t* inputs = static_cast<const int8_t*>(inp);
+  int8_t res = 1;
+  ri.iterate(row0, row1, 1,
+    [&](size_t, size_t j) {
+      if (j == RowIndex::NA) return;
+      if (inputs[j] == 0) res = 0;
+    });
+  static_cast<int8_t*>(out)[grp_index] = res;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Product
+//------------------------------------------------------------------------------
+
+template<typename T, typename U>
+static void prod_reducer(const RowIndex& ri, size_t row0, size_t row1,
+                         const void* inp, void* out, size_t grp_index)
+{
+  const T* inputs = static_cast<const T*>(inp);
+  U* outputs = static_cast<U*>(out);
+  U prod = 1;
+  ri.iterate(row0, row1, 1,
+    [&](size_t, size_t j) {
+      if (j == RowIndex::NA) return;
+      T x = inputs[j];
+      if (!ISNA<T>(x))
+        prod *= static_cast<U>(x);
+    });
+  outputs[grp_index] = prod;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Variance, skewness and kurtosis
+//------------------------------------------------------------------------------
+
+template<typename T>
+static MomentsAccumulator compute_moments(const RowIndex& ri, size_t row0,
+                                          size_t row1, const T* inputs)
+{
+  MomentsAccumulator acc;
+  ri.iterate(row0, row1, 1,
+    [&](size_t, size_t j) {
+      if (j == RowIndex::NA) return;
+      T x = inputs[j];
+      if (!ISNA<T>(x)) acc.add(static_cast<double>(x));
+    });
+  return acc;
+}
+
+template<typename T, typename U>
+static void var_reducer(const RowIndex& ri, size_t row0, size_t row1,
+                        const void* inp, void* out, size_t grp_index)
+{
+  auto acc = compute_moments(ri, row0, row1, static_cast<const T*>(inp));
+  static_cast<U*>(out)[grp_index] =
+      (acc.n <= 1)? GETNA<U>() : static_cast<U>(acc.var());
+}
+
+template<typename T, typename U>
+static void skew_reducer(const RowIndex& ri, size_t row0, size_t row1,
+                         const void* inp, void* out, size_t grp_index)
+{
+  auto acc = compute_moments(ri, row0, row1, static_cast<const T*>(inp));
+  static_cast<U*>(out)[grp_index] =
+      (acc.n <= 1 || acc.m2 == 0)? GETNA<U>() : static_cast<U>(acc.skew());
+}
+
+template<typename T, typename U>
+static void kurt_reducer(const RowIndex& ri, size_t row0, size_t row1,
+                         const void* inp, void* out, size_t grp_index)
+{
+  auto acc = compute_moments(ri, row0, row1, static_cast<const T*>(inp));
+  static_cast<U*>(out)[grp_index] =
+      (acc.n <= 1 || acc.m2 == 0)? GETNA<U>() : static_cast<U>(acc.kurt());
+}
+
+
+
 //------------------------------------------------------------------------------
 // expr_reduce
 //------------------------------------------------------------------------------
@@ -288,9 +502,13 @@ expr_reduce::expr_reduce(dt::pexpr&& a, size_t op) : arg(std::move(a))
 
 SType expr_reduce::resolve(const dt::workframe& wf) {
   SType arg_stype = arg->resolve(wf);
-  if (opcode == ReduceOp::FIRST) {
+  if (opcode == ReduceOp::FIRST || opcode == ReduceOp::LAST) {
     return arg_stype;
   }
+  if (opcode == ReduceOp::NUNIQUE &&
+      (arg_stype == SType::STR32 || arg_stype == SType::STR64)) {
+    return SType::INT64;
+  }
   auto reducer = library.lookup(opcode, arg_stype);
   if (!reducer) {
     throw TypeError() << "Unable to apply reduce function `"
@@ -315,19 +533,28 @@ dt::colptr expr_reduce::evaluate_eager(dt::workframe& wf)
   size_t out_nrows = gb.ngroups();
   if (!out_nrows) out_nrows = 1;  // only when input_col has 0 rows
 
+  SType in_stype = input_col->stype();
   if (opcode == ReduceOp::FIRST) {
     return reduce_first(input_col, gb);
   }
+  if (opcode == ReduceOp::LAST) {
+    return reduce_last(input_col, gb);
+  }
+  if (opcode == ReduceOp::NUNIQUE) {
+    if (in_stype == SType::STR32) return reduce_nunique_str<uint32_t>(input_col, gb);
+    if (in_stype == SType::STR64) return reduce_nunique_str<uint64_t>(input_col, gb);
+  }
 
-  SType in_stype = input_col->stype();
   auto reducer = library.lookup(opcode, in_stype);
   xassert(reducer);  // checked in .resolve()
 
+  dt::profile_scope ps("reduce");
+  dt::profile_count("reduce.rows", input_col->nrows);
   SType out_stype = reducer->output_stype;
   auto res = colptr(Column::new_data_column(out_stype, out_nrows));
 
   RowIndex rowindex = input_col->rowindex();
-  if (opcode == ReduceOp::MEDIAN && gb) {
+  if ((opcode == ReduceOp::MEDIAN || opcode == ReduceOp::NUNIQUE) && gb) {
     rowindex = input_col->sort_grouped(rowindex, gb);
   }
 
@@ -425,6 +652,55 @@ void init_reducers()
   library.add(ReduceOp::MEDIAN, median_reducer<int64_t, double>, SType::INT64, SType::FLOAT64);
   library.add(ReduceOp::MEDIAN, median_reducer<float, float>,    SType::FLOAT32, SType::FLOAT32);
   library.add(ReduceOp::MEDIAN, median_reducer<double, double>,  SType::FLOAT64, SType::FLOAT64);
+
+  // Number of unique values (string columns are handled separately)
+  library.add(ReduceOp::NUNIQUE, nunique_reducer<int8_t>,  SType::BOOL, SType::INT64);
+  library.add(ReduceOp::NUNIQUE, nunique_reducer<int8_t>,  SType::INT8, SType::INT64);
+  library.add(ReduceOp::NUNIQUE, nunique_reducer<int16_t>, SType::INT16, SType::INT64);
+  library.add(ReduceOp::NUNIQUE, nunique_reducer<int32_t>, SType::INT32, SType::INT64);
+  library.add(ReduceOp::NUNIQUE, nunique_reducer<int64_t>, SType::INT64, SType::INT64);
+  library.add(ReduceOp::NUNIQUE, nunique_reducer<float>,   SType::FLOAT32, SType::INT64);
+  library.add(ReduceOp::NUNIQUE, nunique_reducer<double>,  SType::FLOAT64, SType::INT64);
+
+  // Any / All
+  library.add(ReduceOp::ANY, any_reducer, SType::BOOL, SType::BOOL);
+  library.add(ReduceOp::ALL, all_reducer, SType::BOOL, SType::BOOL);
+
+  // Product
+  library.add(ReduceOp::PROD, prod_reducer<int8_t,  int64_t>,  SType::BOOL, SType::INT64);
+  library.add(ReduceOp::PROD, prod_reducer<int8_t,  int64_t>,  SType::INT8, SType::INT64);
+  library.add(ReduceOp::PROD, prod_reducer<int16_t, int64_t>,  SType::INT16, SType::INT64);
+  library.add(ReduceOp::PROD, prod_reducer<int32_t, int64_t>,  SType::INT32, SType::INT64);
+  library.add(ReduceOp::PROD, prod_reducer<int64_t, int64_t>,  SType::INT64, SType::INT64);
+  library.add(ReduceOp::PROD, prod_reducer<float,   float>,    SType::FLOAT32, SType::FLOAT32);
+  library.add(ReduceOp::PROD, prod_reducer<double,  double>,   SType::FLOAT64, SType::FLOAT64);
+
+  // Variance
+  library.add(ReduceOp::VAR, var_reducer<int8_t,  double>,  SType::BOOL, SType::FLOAT64);
+  library.add(ReduceOp::VAR, var_reducer<int8_t,  double>,  SType::INT8, SType::FLOAT64);
+  library.add(ReduceOp::VAR, var_reducer<int16_t, double>,  SType::INT16, SType::FLOAT64);
+  library.add(ReduceOp::VAR, var_reducer<int32_t, double>,  SType::INT32, SType::FLOAT64);
+  library.add(ReduceOp::VAR, var_reducer<int64_t, double>,  SType::INT64, SType::FLOAT64);
+  library.add(ReduceOp::VAR, var_reducer<float,   float>,   SType::FLOAT32, SType::FLOAT32);
+  library.add(ReduceOp::VAR, var_reducer<double,  double>,  SType::FLOAT64, SType::FLOAT64);
+
+  // Skewness
+  library.add(ReduceOp::SKEW, skew_reducer<int8_t,  double>,  SType::BOOL, SType::FLOAT64);
+  library.add(ReduceOp::SKEW, skew_reducer<int8_t,  double>,  SType::INT8, SType::FLOAT64);
+  library.add(ReduceOp::SKEW, skew_reducer<int16_t, double>,  SType::INT16, SType::FLOAT64);
+  library.add(ReduceOp::SKEW, skew_reducer<int32_t, double>,  SType::INT32, SType::FLOAT64);
+  library.add(ReduceOp::SKEW, skew_reducer<int64_t, double>,  SType::INT64, SType::FLOAT64);
+  library.add(ReduceOp::SKEW, skew_reducer<float,   float>,   SType::FLOAT32, SType::FLOAT32);
+  library.add(ReduceOp::SKEW, skew_reducer<double,  double>,  SType::FLOAT64, SType::FLOAT64);
+
+  // Kurtosis
+  library.add(ReduceOp::KURT, kurt_reducer<int8_t,  double>,  SType::BOOL, SType::FLOAT64);
+  library.add(ReduceOp::KURT, kurt_reducer<int8_t,  double>,  SType::INT8, SType::FLOAT64);
+  library.add(ReduceOp::KURT, kurt_reducer<int16_t, double>,  SType::INT16, SType::FLOAT64);
+  library.add(ReduceOp::KURT, kurt_reducer<int32_t, double>,  SType::INT32, SType::FLOAT64);
+  library.add(ReduceOp::KURT, kurt_reducer<int64_t, double>,  SType::INT64, SType::FLOAT64);
+  library.add(ReduceOp::KURT, kurt_reducer<float,   float>,   SType::FLOAT32, SType::FLOAT32);
+  library.add(ReduceOp::KURT, kurt_reducer<double,  double>,  SType::FLOAT64, SType::FLOAT64);
 }
 
 
@@ -0,0 +1,505 @@
+//------------------------------------------------------------------------------
+// Copyright 2019 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>         // std::min, std::max
+#include <cmath>             // std::isinf
+#include <limits>            // std::numeric_limits
+#include <type_traits>       // std::is_floating_point
+#include "expr/base_expr.h"
+#include "utils/exceptions.h"
+#include "utils/parallel.h"
+
+namespace dt {
+
+static const char* winop_name(winop op) {
+  switch (op) {
+    case winop::CUMSUM:       return "cumsum";
+    case winop::CUMCOUNT:     return "cumcount";
+    case winop::SHIFT:        return "shift";
+    case winop::RANK:         return "rank";
+    case winop::ROLLING_MEAN: return "rolling_mean";
+    case winop::ROLLING_SUM:  return "rolling_sum";
+  }
+  return "";
+}
+
+
+
+//------------------------------------------------------------------------------
+// expr_window
+//------------------------------------------------------------------------------
+
+/**
+ * Window functions compute, for every row, a value which depends on the other
+ * rows within the same group: running totals, lags, ranks, moving averages.
+ * The result always has the same number of rows as the workframe (i.e. these
+ * functions are "GtoALL"), and the rows are in the same order as the rows of
+ * any other column selected within the same `DT[i, j, by]` call. With a
+ * `by()` clause this is the grouped order (the ungroup RowIndex expands
+ * group-level values onto the same order), not the original order of rows.
+ *
+ * Each group is processed independently, and the groups are distributed among
+ * the threads. Without a `by()` clause the entire frame is a single group.
+ */
+class expr_window : public base_expr {
+  private:
+    pexpr arg;      // null for cumcount()
+    winop opcode;
+    int64_t param;  // shift amount or window size
+
+  public:
+    expr_window(winop op, pexpr&& a, py::oobj params);
+    SType resolve(const workframe& wf) override;
+    GroupbyMode get_groupby_mode(const workframe&) const override;
+    colptr evaluate_eager(workframe& wf) override;
+
+  private:
+    colptr _cumcount(size_t nrows, const Groupby& gb);
+    colptr _shift(const colptr& col, const Groupby& gb);
+    template <typename T, typename U>
+    colptr _cumsum(const colptr& col, const Groupby& gb, SType out_stype);
+    template <typename T, typename U>
+    colptr _rolling(const colptr& col, const Groupby& gb, SType out_stype);
+    template <typename T>
+    colptr _rank(colptr& col, const Groupby& gb);
+};
+
+
+expr_window::expr_window(winop op, pexpr&& a, py::oobj params)
+  : arg(std::move(a)), opcode(op), param(0)
+{
+  if (opcode == winop::SHIFT ||
+      opcode == winop::ROLLING_MEAN || opcode == winop::ROLLING_SUM)
+  {
+    py::otuple tp = params.to_otuple();
+    xassert(tp.size() == 1);
+    param = tp[0].to_int64_strict();
+    // The shift amount is negated when computing the source rows, so it
+    // must be representable with either sign.
+    if (opcode == winop::SHIFT &&
+        param == std::numeric_limits<int64_t>::min()) {
+      throw ValueError() << "Shift amount in `shift()` is out of range: "
+          << param;
+    }
+    if (opcode != winop::SHIFT && param <= 0) {
+      throw ValueError() << "Window size in `" << winop_name(opcode)
+          << "()` should be positive, instead got " << param;
+    }
+  }
+}
+
+
+static SType sum_stype(SType st) {
+  switch (st) {
+    case SType::BOOL:
+    case SType::INT8:
+    case SType::INT16:
+    case SType::INT32:
+    case SType::INT64:   return SType::INT64;
+    case SType::FLOAT32: return SType::FLOAT32;
+    case SType::FLOAT64: return SType::FLOAT64;
+    default:             return SType::VOID;
+  }
+}
+
+
+SType expr_window::resolve(const workframe& wf) {
+  if (opcode == winop::CUMCOUNT) {
+    return SType::INT64;
+  }
+  SType arg_stype = arg->resolve(wf);
+  SType res = SType::VOID;
+  switch (opcode) {
+    case winop::CUMCOUNT:
+      break;
+    case winop::SHIFT:
+      res = arg_stype;
+      break;
+    case winop::CUMSUM:
+    case winop::ROLLING_SUM:
+      res = sum_stype(arg_stype);
+      break;
+    case winop::ROLLING_MEAN:
+      res = sum_stype(arg_stype);
+      if (res == SType::INT64) res = SType::FLOAT64;
+      break;
+    case winop::RANK:
+      if (sum_stype(arg_stype) != SType::VOID) res = SType::INT64;
+      break;
+  }
+  if (res == SType::VOID) {
+    throw TypeError() << "Unable to apply window function `"
+        << winop_name(opcode) << "()` to a column of type `"
+        << arg_stype << "`";
+  }
+  return res;
+}
+
+
+GroupbyMode expr_window::get_groupby_mode(const workframe&) const {
+  return GroupbyMode::GtoALL;
+}
+
+
+colptr expr_window::evaluate_eager(workframe& wf) {
+  size_t nrows = wf.nrows();
+  Groupby gb = wf.get_groupby();
+  if (!gb) gb = Groupby::single_group(nrows);
+
+  if (opcode == winop::CUMCOUNT) {
+    return _cumcount(nrows, gb);
+  }
+
+  colptr col = arg->evaluate_eager(wf);
+  if (col->nrows != nrows) {
+    throw ValueError() << "Window function `" << winop_name(opcode)
+        << "()` cannot be applied to a reduced expression";
+  }
+  if (opcode == winop::SHIFT) {
+    return _shift(col, gb);
+  }
+
+  SType in_stype = col->stype();
+  SType out_stype = resolve(wf);
+  switch (opcode) {
+    case winop::CUMSUM:
+      switch (in_stype) {
+        case SType::BOOL:
+        case SType::INT8:    return _cumsum<int8_t, int64_t>(col, gb, out_stype);
+        case SType::INT16:   return _cumsum<int16_t, int64_t>(col, gb, out_stype);
+        case SType::INT32:   return _cumsum<int32_t, int64_t>(col, gb, out_stype);
+        case SType::INT64:   return _cumsum<int64_t, int64_t>(col, gb, out_stype);
+        case SType::FLOAT32: return _cumsum<float, float>(col, gb, out_stype);
+        case SType::FLOAT64: return _cumsum<double, double>(col, gb, out_stype);
+        default: break;
+      }
+      break;
+    case winop::ROLLING_SUM:
+      switch (in_stype) {
+        case SType::BOOL:
+        case SType::INT8:    return _rolling<int8_t, int64_t>(col, gb, out_stype);
+        case SType::INT16:   return _rolling<int16_t, int64_t>(col, gb, out_stype);
+        case SType::INT32:   return _rolling<int32_t, int64_t>(col, gb, out_stype);
+        case SType::INT64:   return _rolling<int64_t, int64_t>(col, gb, out_stype);
+        case SType::FLOAT32: return _rolling<float, double>(col, gb, out_stype);
+        case SType::FLOAT64: return _rolling<double, double>(col, gb, out_stype);
+        default: break;
+      }
+      break;
+    case winop::ROLLING_MEAN:
+      switch (in_stype) {
+        case SType::BOOL:
+        case SType::INT8:    return _rolling<int8_t, double>(col, gb, out_stype);
+        case SType::INT16:   return _rolling<int16_t, double>(col, gb, out_stype);
+        case SType::INT32:   return _rolling<int32_t, double>(col, gb, out_stype);
+        case SType::INT64:   return _rolling<int64_t, double>(col, gb, out_stype);
+        case SType::FLOAT32: return _rolling<float, double>(col, gb, out_stype);
+        case SType::FLOAT64: return _rolling<double, double>(col, gb, out_stype);
+        default: break;
+      }
+      break;
+    case winop::RANK:
+      switch (in_stype) {
+        case SType::BOOL:
+        case SType::INT8:    return _rank<int8_t>(col, gb);
+        case SType::INT16:   return _rank<int16_t>(col, gb);
+        case SType::INT32:   return _rank<int32_t>(col, gb);
+        case SType::INT64:   return _rank<int64_t>(col, gb);
+        case SType::FLOAT32: return _rank<float>(col, gb);
+        case SType::FLOAT64: return _rank<double>(col, gb);
+        default: break;
+      }
+      break;
+    default: break;
+  }
+  throw RuntimeError() << "Unexpected stype " << in_stype << " in window "
+      "function `" << winop_name(opcode) << "()`";  // LCOV_EXCL_LINE
+}
+
+
+
+//------------------------------------------------------------------------------
+// cumcount()
+//------------------------------------------------------------------------------
+
+// 0-based index of each row within its group
+colptr expr_window::_cumcount(size_t nrows, const Groupby& gb) {
+  auto res = colptr(Column::new_data_column(SType::INT64, nrows));
+  int64_t* out = static_cast<int64_t*>(res->data_w());
+  const int32_t* groups = gb.offsets_r();
+  size_t ngrps = gb.ngroups();
+
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (size_t g = 0; g < ngrps; ++g) {
+    size_t row0 = static_cast<size_t>(groups[g]);
+    size_t row1 = static_cast<size_t>(groups[g + 1]);
+    for (size_t i = row0; i < row1; ++i) {
+      out[i] = static_cast<int64_t>(i - row0);
+    }
+  }
+  return res;
+}
+
+
+
+//------------------------------------------------------------------------------
+// shift(n)
+//------------------------------------------------------------------------------
+
+// Shifting does not touch the data at all: instead we build a new RowIndex
+// where row `i` points to the source row `i - n` within the same group, or
+// to NA if such row does not exist. This works for columns of any stype.
+template <typename T>
+static RowIndex _shifted_rowindex(const RowIndex& ri, const Groupby& gb,
+                                  size_t nrows, int64_t n)
+{
+  array<T> indices(nrows);
+  T* ind = indices.data();
+  const int32_t* groups = gb.offsets_r();
+  size_t ngrps = gb.ngroups();
+  // Shifts larger than the number of rows are equivalent to shifting by
+  // exactly `nrows`; clamping the amount also prevents `i - n` from
+  // overflowing.
+  int64_t maxn = static_cast<int64_t>(nrows);
+  n = std::max(-maxn, std::min(n, maxn));
+
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (size_t g = 0; g < ngrps; ++g) {
+    int64_t row0 = groups[g];
+    int64_t row1 = groups[g + 1];
+    for (int64_t i = row0; i < row1; ++i) {
+      int64_t k = i - n;
+      if (k < row0 || k >= row1) {
+        ind[i] = -1;
+      } else {
+        size_t j = ri[static_cast<size_t>(k)];
+        ind[i] = (j == RowIndex::NA)? -1 : static_cast<T>(j);
+      }
+    }
+  }
+  return RowIndex(std::move(indices), false);
+}
+
+
+colptr expr_window::_shift(const colptr& col, const Groupby& gb) {
+  size_t nrows = col->nrows;
+  const RowIndex& ri = col->rowindex();
+  RowIndex newri;
+  if (col->data_nrows() <= static_cast<size_t>(std::numeric_limits<int32_t>::max())
+      && nrows <= static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    newri = _shifted_rowindex<int32_t>(ri, gb, nrows, param);
+  } else {
+    newri = _shifted_rowindex<int64_t>(ri, gb, nrows, param);
+  }
+  return colptr(col->shallowcopy(newri));
+}
+
+
+
+//------------------------------------------------------------------------------
+// cumsum()
+//------------------------------------------------------------------------------
+
+// NA values in the input produce NAs in the output, but do not interrupt the
+// running sum.
+template <typename T, typename U>
+colptr expr_window::_cumsum(const colptr& col, const Groupby& gb,
+                            SType out_stype)
+{
+  size_t nrows = col->nrows;
+  auto res = colptr(Column::new_data_column(out_stype, nrows));
+  U* out = static_cast<U*>(res->data_w());
+  const T* inp = static_cast<const T*>(col->data());
+  const RowIndex& ri = col->rowindex();
+  const int32_t* groups = gb.offsets_r();
+  size_t ngrps = gb.ngroups();
+
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (size_t g = 0; g < ngrps; ++g) {
+    U sum = 0;
+    ri.iterate(static_cast<size_t>(groups[g]),
+               static_cast<size_t>(groups[g + 1]), 1,
+      [&](size_t i, size_t j) {
+        T x = (j == RowIndex::NA)? GETNA<T>() : inp[j];
+        if (ISNA<T>(x)) {
+          out[i] = GETNA<U>();
+        } else {
+          sum += static_cast<U>(x);
+          out[i] = sum;
+        }
+      });
+  }
+  return res;
+}
+
+
+
+//------------------------------------------------------------------------------
+// rolling_sum(w), rolling_mean(w)
+//------------------------------------------------------------------------------
+
+// Trailing window of `w` rows (the current row and `w - 1` rows before it)
+// within each group. NA values are skipped; if the window contains no valid
+// values, the result is NA for `rolling_mean()` and 0 for `rolling_sum()`.
+// The sum is maintained incrementally, so that each row is added and
+// removed exactly once regardless of the window size. Infinite values are
+// counted separately from the finite sum: adding and then subtracting an
+// infinity would turn the running sum into NaN for the rest of the group.
+template <typename T>
+static inline bool _isinf(T x) {
+  return std::is_floating_point<T>::value &&
+         std::isinf(static_cast<double>(x));
+}
+
+template <typename T, typename U>
+colptr expr_window::_rolling(const colptr& col, const Groupby& gb,
+                             SType out_stype)
+{
+  size_t nrows = col->nrows;
+  size_t w = static_cast<size_t>(param);
+  bool mean = (opcode == winop::ROLLING_MEAN);
+  auto res = colptr(Column::new_data_column(out_stype, nrows));
+  void* out = res->data_w();
+  const T* inp = static_cast<const T*>(col->data());
+  const RowIndex& ri = col->rowindex();
+  const int32_t* groups = gb.offsets_r();
+  size_t ngrps = gb.ngroups();
+
+  auto value = [&](size_t i) -> T {
+    size_t j = ri[i];
+    return (j == RowIndex::NA)? GETNA<T>() : inp[j];
+  };
+  auto store = [&](size_t i, U sum, size_t count, size_t npinf,
+                   size_t nninf) {
+    if (npinf || nninf) {
+      sum = (npinf && nninf)? std::numeric_limits<U>::quiet_NaN() :
+            npinf? std::numeric_limits<U>::infinity()
+                 : -std::numeric_limits<U>::infinity();
+    }
+    switch (out_stype) {
+      case SType::INT64:
+        static_cast<int64_t*>(out)[i] = static_cast<int64_t>(sum);
+        break;
+      case SType::FLOAT32:
+        static_cast<float*>(out)[i] =
+            mean? (count? static_cast<float>(sum / count) : GETNA<float>())
+                : static_cast<float>(sum);
+        break;
+      default:
+        static_cast<double*>(out)[i] =
+            mean? (count? static_cast<double>(sum) / count : GETNA<double>())
+                : static_cast<double>(sum);
+    }
+  };
+
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (size_t g = 0; g < ngrps; ++g) {
+    size_t row0 = static_cast<size_t>(groups[g]);
+    size_t row1 = static_cast<size_t>(groups[g + 1]);
+    U sum = 0;
+    size_t count = 0;
+    size_t npinf = 0;  // number of +inf values in the window
+    size_t nninf = 0;  // number of -inf values in the window
+    for (size_t i = row0; i < row1; ++i) {
+      T x = value(i);
+      if (!ISNA<T>(x)) {
+        if (_isinf(x)) (x > 0? npinf : nninf)++;
+        else sum += static_cast<U>(x);
+        count++;
+      }
+      if (i >= row0 + w) {
+        T y = value(i - w);
+        if (!ISNA<T>(y)) {
+          if (_isinf(y)) (y > 0? npinf : nninf)--;
+          else sum -= static_cast<U>(y);
+          count--;
+        }
+      }
+      store(i, sum, count, npinf, nninf);
+    }
+  }
+  return res;
+}
+
+
+
+//------------------------------------------------------------------------------
+// rank()
+//------------------------------------------------------------------------------
+
+// 1-based rank of each value within its group; equal values receive the
+// same (smallest) rank, as in SQL's RANK(). NA values produce NA ranks.
+template <typename T>
+colptr expr_window::_rank(colptr& col, const Groupby& gb) {
+  size_t nrows = col->nrows;
+  // After materialization the data is laid out in the workframe's row order,
+  // so that the sorted rowindex maps directly into output positions.
+  col->materialize();
+  RowIndex order = col->sort_grouped(RowIndex(), gb);
+  const T* inp = static_cast<const T*>(col->data());
+
+  auto res = colptr(Column::new_data_column(SType::INT64, nrows));
+  int64_t* out = static_cast<int64_t*>(res->data_w());
+  const int32_t* groups = gb.offsets_r();
+  size_t ngrps = gb.ngroups();
+
+  #pragma omp parallel for schedule(dynamic, 64)
+  for (size_t g = 0; g < ngrps; ++g) {
+    int64_t rank = 0;
+    int64_t nvalid = 0;
+    T prev = GETNA<T>();
+    order.iterate(static_cast<size_t>(groups[g]),
+                  static_cast<size_t>(groups[g + 1]), 1,
+      [&](size_t, size_t j) {
+        T x = inp[j];
+        if (ISNA<T>(x)) {
+          out[j] = GETNA<int64_t>();
+          return;
+        }
+        nvalid++;
+        if (nvalid == 1 || x != prev) {
+          rank = nvalid;
+          prev = x;
+        }
+        out[j] = rank;
+      });
+  }
+  return res;
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Factory function
+//------------------------------------------------------------------------------
+
+pexpr expr_window_fn(size_t op, pexpr&& arg, py::oobj params) {
+  if (op == 0 || op > static_cast<size_t>(winop::ROLLING_SUM)) {
+    throw ValueError() << "Invalid op code in expr_window: " << op;
+  }
+  return pexpr(new expr_window(static_cast<winop>(op), std::move(arg),
+                               params));
+}
+
+
+
+} // namespace dt
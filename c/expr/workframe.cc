@@ -23,6 +23,7 @@
 #include "expr/collist.h"
 #include "expr/workframe.h"
 #include "frame/py_frame.h"
+#include "utils/profiler.h"
 namespace dt {
 
 
@@ -89,6 +90,8 @@ void workframe::add_replace(py::oobj obj) {
 
 
 void workframe::evaluate() {
+  dt::profile_scope ps("evaluate");
+
   // Compute joins
   DataTable* xdt = frames[0].dt;
   for (size_t i = 1; i < frames.size(); ++i) {
@@ -97,18 +100,25 @@ void workframe::evaluate() {
   }
 
   // Compute groupby
-  if (byexpr) {
-    groupby_mode = jexpr->get_groupby_mode(*this);
+  {
+    dt::profile_scope ps_by("evaluate.by");
+    if (byexpr) {
+      groupby_mode = jexpr->get_groupby_mode(*this);
+    }
+    byexpr.execute(*this);
   }
-  byexpr.execute(*this);
 
   // Compute i filter
-  if (has_groupby()) {
-    iexpr->execute_grouped(*this);
-  } else {
-    iexpr->execute(*this);
+  {
+    dt::profile_scope ps_i("evaluate.i");
+    if (has_groupby()) {
+      iexpr->execute_grouped(*this);
+    } else {
+      iexpr->execute(*this);
+    }
   }
 
+  dt::profile_scope ps_j("evaluate.j");
   switch (mode) {
     case EvalMode::SELECT:
       if (byexpr) {
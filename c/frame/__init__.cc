@@ -23,6 +23,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include "frame/arrow.h"
 #include "python/_all.h"
 #include "python/list.h"
 #include "python/oset.h"
@@ -133,6 +134,9 @@ class FrameInitializationManager {
       if (src.is_pandas_frame() || src.is_pandas_series()) {
         return init_from_pandas();
       }
+      if (src.to_pyobj().has_attr("__arrow_c_array__")) {
+        return init_from_arrow();
+      }
       if (src.is_numpy_array()) {
         return init_from_numpy();
       }
@@ -419,6 +423,22 @@ class FrameInitializationManager {
     }
 
 
+    void init_from_arrow() {
+      if (stypes_arg || stype_arg) {
+        throw TypeError() << "Argument `stypes` is not supported in Frame() "
+            "constructor when creating a Frame from an Arrow array";
+      }
+      std::vector<std::string> colnames;
+      columns_from_arrow(src.to_pyobj(), cols, colnames);
+      if (names_arg) {
+        check_names_count(cols.size());
+        make_datatable(names_arg);
+      } else {
+        make_datatable(colnames);
+      }
+    }
+
+
     void init_from_numpy() {
       if (stypes_arg || stype_arg) {
         throw TypeError() << "Argument `stypes` is not supported in Frame() "
@@ -0,0 +1,556 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <cstring>     // std::memcpy, std::strcmp
+#include <memory>      // std::unique_ptr, std::shared_ptr
+#include "frame/arrow.h"
+#include "frame/py_frame.h"
+#include "python/_all.h"
+#include "python/string.h"
+#include "column.h"
+#include "datatablemodule.h"
+namespace py {
+
+static const char* CAPSULE_SCHEMA = "arrow_schema";
+static const char* CAPSULE_ARRAY = "arrow_array";
+
+
+
+//------------------------------------------------------------------------------
+// Validity bitmaps
+//------------------------------------------------------------------------------
+
+// Arrow stores validity of each element as a bit (1 = valid), with the bits
+// packed in LSB order. Datatable on the other hand stores NAs as special
+// sentinel values within the data, so the validity bitmap needs to be
+// generated on export (only for columns that actually have NAs), and on
+// import the bitmap needs to be converted back into the sentinels.
+
+template <typename T>
+static MemoryRange make_validity_bitmap(const T* data, size_t n) {
+  size_t nbytes = (n + 7) / 8;
+  MemoryRange res = MemoryRange::mem(nbytes);
+  uint8_t* bits = static_cast<uint8_t*>(res.wptr());
+  #pragma omp parallel for
+  for (size_t j = 0; j < nbytes; ++j) {
+    size_t i0 = j * 8;
+    size_t i1 = std::min(i0 + 8, n);
+    uint8_t byte = 0;
+    for (size_t i = i0; i < i1; ++i) {
+      byte |= static_cast<uint8_t>(!ISNA<T>(data[i])) << (i - i0);
+    }
+    bits[j] = byte;
+  }
+  return res;
+}
+
+
+static inline bool get_bit(const void* bitmap, size_t i) {
+  return (static_cast<const uint8_t*>(bitmap)[i >> 3] >> (i & 7)) & 1;
+}
+
+
+
+//------------------------------------------------------------------------------
+// Export
+//------------------------------------------------------------------------------
+
+struct ExportedSchema {
+  std::string format;
+  std::string name;
+  std::vector<ArrowSchema> children;
+  std::vector<ArrowSchema*> child_ptrs;
+};
+
+struct ExportedArray {
+  std::vector<MemoryRange> keepalive;
+  std::vector<const void*> buffers;
+  std::vector<ArrowArray> children;
+  std::vector<ArrowArray*> child_ptrs;
+};
+
+
+static void release_schema(ArrowSchema* schema) {
+  if (!schema->release) return;
+  for (int64_t i = 0; i < schema->n_children; ++i) {
+    ArrowSchema* child = schema->children[i];
+    if (child->release) child->release(child);
+  }
+  delete static_cast<ExportedSchema*>(schema->private_data);
+  schema->release = nullptr;
+}
+
+static void release_array(ArrowArray* array) {
+  if (!array->release) return;
+  for (int64_t i = 0; i < array->n_children; ++i) {
+    ArrowArray* child = array->children[i];
+    if (child->release) child->release(child);
+  }
+  delete static_cast<ExportedArray*>(array->private_data);
+  array->release = nullptr;
+}
+
+
+static void init_schema(ArrowSchema* schema, ExportedSchema* priv) {
+  schema->format = priv->format.c_str();
+  schema->name = priv->name.c_str();
+  schema->metadata = nullptr;
+  schema->flags = ARROW_FLAG_NULLABLE;
+  schema->n_children = static_cast<int64_t>(priv->child_ptrs.size());
+  schema->children = priv->child_ptrs.empty()? nullptr
+                                             : priv->child_ptrs.data();
+  schema->dictionary = nullptr;
+  schema->release = release_schema;
+  schema->private_data = priv;
+}
+
+static void init_array(ArrowArray* array, ExportedArray* priv, size_t n,
+                       size_t null_count) {
+  array->length = static_cast<int64_t>(n);
+  array->null_count = static_cast<int64_t>(null_count);
+  array->offset = 0;
+  array->n_buffers = static_cast<int64_t>(priv->buffers.size());
+  array->n_children = static_cast<int64_t>(priv->child_ptrs.size());
+  array->buffers = priv->buffers.data();
+  array->children = priv->child_ptrs.empty()? nullptr
+                                            : priv->child_ptrs.data();
+  array->dictionary = nullptr;
+  array->release = release_array;
+  array->private_data = priv;
+}
+
+
+// Add buffer `mr` to the list of the array's buffers, keeping a reference
+// to it so that the data stays alive until the array is released.
+static void add_buffer(ExportedArray* priv, const MemoryRange& mr) {
+  static const char empty[8] = {0};
+  priv->keepalive.push_back(mr);
+  priv->buffers.push_back(mr.size()? mr.rptr() : empty);
+}
+
+
+template <typename T>
+static void export_fixedwidth(const Column* col, ExportedArray* priv) {
+  const T* data = static_cast<const T*>(col->data());
+  if (col->countna()) {
+    add_buffer(priv, make_validity_bitmap<T>(data, col->nrows));
+  } else {
+    priv->buffers.push_back(nullptr);
+  }
+  add_buffer(priv, col->data_buf());
+}
+
+
+static void export_bool(const Column* col, ExportedArray* priv) {
+  const int8_t* data = static_cast<const int8_t*>(col->data());
+  size_t n = col->nrows;
+  if (col->countna()) {
+    add_buffer(priv, make_validity_bitmap<int8_t>(data, n));
+  } else {
+    priv->buffers.push_back(nullptr);
+  }
+  size_t nbytes = (n + 7) / 8;
+  MemoryRange values = MemoryRange::mem(nbytes);
+  uint8_t* bits = static_cast<uint8_t*>(values.wptr());
+  #pragma omp parallel for
+  for (size_t j = 0; j < nbytes; ++j) {
+    size_t i0 = j * 8;
+    size_t i1 = std::min(i0 + 8, n);
+    uint8_t byte = 0;
+    for (size_t i = i0; i < i1; ++i) {
+      byte |= static_cast<uint8_t>(data[i] == 1) << (i - i0);
+    }
+    bits[j] = byte;
+  }
+  add_buffer(priv, values);
+}
+
+
+// Datatable's string offsets buffer has the same layout as Arrow's, except
+// that NA values are marked with the highest bit set. Thus, if the column
+// has no NAs, then the offsets can be exported as-is.
+template <typename T>
+static void export_string(const Column* col, ExportedArray* priv) {
+  auto scol = static_cast<const StringColumn<T>*>(col);
+  size_t n = col->nrows;
+  if (col->countna()) {
+    const T* offsets = scol->offsets();
+    add_buffer(priv, make_validity_bitmap<T>(offsets, n));
+    MemoryRange newoffsets = MemoryRange::mem((n + 1) * sizeof(T));
+    T* dest = static_cast<T*>(newoffsets.wptr());
+    dest[0] = 0;
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i) {
+      dest[i + 1] = offsets[i] & ~GETNA<T>();
+    }
+    add_buffer(priv, newoffsets);
+  } else {
+    priv->buffers.push_back(nullptr);
+    add_buffer(priv, col->data_buf());
+  }
+  add_buffer(priv, const_cast<StringColumn<T>*>(scol)->str_buf());
+}
+
+
+static void export_column(const Column* col0, const std::string& name,
+                          ArrowSchema* schema, ArrowArray* array)
+{
+  // Columns that are views onto other columns have to be materialized
+  // first (this does not modify the original column).
+  std::unique_ptr<Column> tmpcol;
+  const Column* col = col0;
+  if (col0->rowindex()) {
+    tmpcol = std::unique_ptr<Column>(col0->shallowcopy());
+    tmpcol->materialize();
+    col = tmpcol.get();
+  }
+  std::unique_ptr<ExportedSchema> spriv(new ExportedSchema);
+  std::unique_ptr<ExportedArray> apriv(new ExportedArray);
+  spriv->name = name;
+  switch (col->stype()) {
+    case SType::BOOL:    spriv->format = "b"; export_bool(col, apriv.get()); break;
+    case SType::INT8:    spriv->format = "c"; export_fixedwidth<int8_t>(col, apriv.get()); break;
+    case SType::INT16:   spriv->format = "s"; export_fixedwidth<int16_t>(col, apriv.get()); break;
+    case SType::INT32:   spriv->format = "i"; export_fixedwidth<int32_t>(col, apriv.get()); break;
+    case SType::INT64:   spriv->format = "l"; export_fixedwidth<int64_t>(col, apriv.get()); break;
+    case SType::FLOAT32: spriv->format = "f"; export_fixedwidth<float>(col, apriv.get()); break;
+    case SType::FLOAT64: spriv->format = "g"; export_fixedwidth<double>(col, apriv.get()); break;
+    case SType::STR32:   spriv->format = "u"; export_string<uint32_t>(col, apriv.get()); break;
+    case SType::STR64:   spriv->format = "U"; export_string<uint64_t>(col, apriv.get()); break;
+    default:
+      throw TypeError() << "Column `" << name << "` of type "
+          << info(col->stype()).name() << " cannot be exported to Arrow";
+  }
+  size_t null_count = col->countna();
+  init_schema(schema, spriv.release());
+  init_array(array, apriv.release(), col->nrows, null_count);
+}
+
+
+static void capsule_schema_destructor(PyObject* capsule) {
+  auto schema = static_cast<ArrowSchema*>(
+      PyCapsule_GetPointer(capsule, CAPSULE_SCHEMA));
+  if (schema->release) schema->release(schema);
+  delete schema;
+}
+
+static void capsule_array_destructor(PyObject* capsule) {
+  auto array = static_cast<ArrowArray*>(
+      PyCapsule_GetPointer(capsule, CAPSULE_ARRAY));
+  if (array->release) array->release(array);
+  delete array;
+}
+
+
+
+static PKArgs args__arrow_c_array__(
+    0, 1, 0, false, false, {"requested_schema"}, "__arrow_c_array__",
+
+R"(__arrow_c_array__(self, requested_schema=None)
+--
+
+Export the frame via the Arrow C Data Interface, as a pair of PyCapsules
+`(schema, array)` representing an Arrow struct array whose fields are the
+columns of the frame. This is the Arrow PyCapsule protocol, which allows
+any Arrow-compatible library to import the frame, for example
+`pyarrow.record_batch(frame)`.
+
+Fixed-width and string columns are exported without copying the data;
+validity bitmaps are generated only for the columns that contain NAs.
+The frame's data remains alive for as long as the exported array is.
+
+Parameter `requested_schema` is currently ignored.
+)");
+
+
+oobj Frame::m__arrow_c_array__(const PKArgs&) {
+  size_t ncols = dt->ncols;
+  const std::vector<std::string>& names = dt->get_names();
+
+  std::unique_ptr<ExportedSchema> spriv(new ExportedSchema);
+  std::unique_ptr<ExportedArray> apriv(new ExportedArray);
+  spriv->format = "+s";
+  spriv->children.resize(ncols);
+  apriv->children.resize(ncols);
+  apriv->buffers.push_back(nullptr);  // validity bitmap of the struct array
+  for (size_t i = 0; i < ncols; ++i) {
+    spriv->child_ptrs.push_back(&spriv->children[i]);
+    apriv->child_ptrs.push_back(&apriv->children[i]);
+  }
+  std::unique_ptr<ArrowSchema> schema(new ArrowSchema);
+  std::unique_ptr<ArrowArray> array(new ArrowArray);
+  init_schema(schema.get(), spriv.release());
+  init_array(array.get(), apriv.release(), dt->nrows, 0);
+  schema->flags = 0;
+  // Mark all children as released, so that if an exception occurs in the
+  // middle of the loop, only the children that were actually exported will
+  // be released.
+  for (size_t i = 0; i < ncols; ++i) {
+    schema->children[i]->release = nullptr;
+    array->children[i]->release = nullptr;
+  }
+  try {
+    for (size_t i = 0; i < ncols; ++i) {
+      export_column(dt->columns[i], names[i],
+                    schema->children[i], array->children[i]);
+    }
+  } catch (...) {
+    schema->release(schema.get());
+    array->release(array.get());
+    throw;
+  }
+
+  oobj schema_capsule = oobj::from_new_reference(
+      PyCapsule_New(schema.get(), CAPSULE_SCHEMA, capsule_schema_destructor));
+  schema.release();
+  oobj array_capsule = oobj::from_new_reference(
+      PyCapsule_New(array.get(), CAPSULE_ARRAY, capsule_array_destructor));
+  array.release();
+  otuple res(2);
+  res.set(0, schema_capsule);
+  res.set(1, array_capsule);
+  return std::move(res);
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Import
+//------------------------------------------------------------------------------
+
+// Owner of the imported ArrowArray: the array will be released when all
+// columns that reference its buffers are deleted.
+struct ImportedArray {
+  ArrowArray array;
+  ~ImportedArray() {
+    if (array.release) array.release(&array);
+  }
+};
+
+using arrow_owner = std::shared_ptr<ImportedArray>;
+
+
+static bool has_nulls(const ArrowArray* arr) {
+  return arr->null_count != 0 && arr->buffers[0] != nullptr;
+}
+
+
+template <typename T>
+static Column* import_fixedwidth(SType stype, const ArrowArray* arr,
+                                 const arrow_owner& owner)
+{
+  size_t n = static_cast<size_t>(arr->length);
+  size_t offset = static_cast<size_t>(arr->offset);
+  const T* data = static_cast<const T*>(arr->buffers[1]) + offset;
+  if (!has_nulls(arr)) {
+    return Column::new_mbuf_column(stype,
+        MemoryRange::external(data, n * sizeof(T), owner));
+  }
+  const void* validity = arr->buffers[0];
+  Column* col = Column::new_data_column(stype, n);
+  T* dest = static_cast<T*>(col->data_w());
+  #pragma omp parallel for
+  for (size_t i = 0; i < n; ++i) {
+    dest[i] = get_bit(validity, i + offset)? data[i] : GETNA<T>();
+  }
+  return col;
+}
+
+
+static Column* import_bool(const ArrowArray* arr) {
+  size_t n = static_cast<size_t>(arr->length);
+  size_t offset = static_cast<size_t>(arr->offset);
+  const void* validity = has_nulls(arr)? arr->buffers[0] : nullptr;
+  const void* values = arr->buffers[1];
+  Column* col = Column::new_data_column(SType::BOOL, n);
+  int8_t* dest = static_cast<int8_t*>(col->data_w());
+  #pragma omp parallel for
+  for (size_t i = 0; i < n; ++i) {
+    size_t j = i + offset;
+    dest[i] = (validity && !get_bit(validity, j))? GETNA<int8_t>()
+                                                 : get_bit(values, j);
+  }
+  return col;
+}
+
+
+// Arrow string arrays store signed offsets (int32 or int64); the character
+// data is referenced without copying. The offsets can also be used as-is
+// if they start at 0 and there are no nulls, otherwise they are rebased
+// and the NA bit is set for the null elements.
+//
+// Arrow also allows a null slot to have non-zero length, whereas in
+// datatable an NA string must have the same offset (magnitude) as the
+// previous string. If any null slot is non-empty, the character data is
+// copied compactly, skipping the bytes of such slots.
+template <typename A, typename T>
+static Column* import_string(const ArrowArray* arr, const arrow_owner& owner)
+{
+  size_t n = static_cast<size_t>(arr->length);
+  size_t offset = static_cast<size_t>(arr->offset);
+  const A* offsets = static_cast<const A*>(arr->buffers[1]) + offset;
+  const char* strdata = static_cast<const char*>(arr->buffers[2]);
+  const void* validity = has_nulls(arr)? arr->buffers[0] : nullptr;
+  A base = offsets[0];
+
+  bool null_slots_empty = true;
+  if (validity) {
+    for (size_t i = 0; i < n; ++i) {
+      if (offsets[i + 1] != offsets[i] && !get_bit(validity, i + offset)) {
+        null_slots_empty = false;
+        break;
+      }
+    }
+  }
+
+  if (!null_slots_empty) {
+    MemoryRange offbuf = MemoryRange::mem((n + 1) * sizeof(T));
+    T* dest = static_cast<T*>(offbuf.wptr());
+    T end = 0;
+    dest[0] = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (get_bit(validity, i + offset)) {
+        end += static_cast<T>(offsets[i + 1] - offsets[i]);
+        dest[i + 1] = end;
+      } else {
+        dest[i + 1] = end ^ GETNA<T>();
+      }
+    }
+    MemoryRange strbuf = end? MemoryRange::mem(static_cast<size_t>(end))
+                           : MemoryRange();
+    if (end) {
+      char* strdest = static_cast<char*>(strbuf.wptr());
+      #pragma omp parallel for
+      for (size_t i = 0; i < n; ++i) {
+        if (ISNA<T>(dest[i + 1])) continue;
+        T start = dest[i] & ~GETNA<T>();
+        std::memcpy(strdest + start, strdata + offsets[i],
+                    dest[i + 1] - start);
+      }
+    }
+    return new_string_column(n, std::move(offbuf), std::move(strbuf));
+  }
+
+  size_t strsize = static_cast<size_t>(offsets[n] - base);
+  MemoryRange strbuf = strsize? MemoryRange::external(strdata + base, strsize,
+                                                      owner)
+                              : MemoryRange();
+  MemoryRange offbuf;
+  if (base == 0 && !validity) {
+    offbuf = MemoryRange::external(offsets, (n + 1) * sizeof(T), owner);
+  } else {
+    offbuf = MemoryRange::mem((n + 1) * sizeof(T));
+    T* dest = static_cast<T*>(offbuf.wptr());
+    dest[0] = 0;
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; ++i) {
+      T off = static_cast<T>(offsets[i + 1] - base);
+      if (validity && !get_bit(validity, i + offset)) {
+        off ^= GETNA<T>();
+      }
+      dest[i + 1] = off;
+    }
+  }
+  return new_string_column(n, std::move(offbuf), std::move(strbuf));
+}
+
+
+static Column* import_column(const ArrowSchema* schema, const ArrowArray* arr,
+                             const arrow_owner& owner)
+{
+  std::string format(schema->format);
+  size_t n = static_cast<size_t>(arr->length);
+  if (format == "n") return Column::new_na_column(SType::BOOL, n);
+  if (format == "b") return import_bool(arr);
+  if (format == "c") return import_fixedwidth<int8_t>(SType::INT8, arr, owner);
+  if (format == "s") return import_fixedwidth<int16_t>(SType::INT16, arr, owner);
+  if (format == "i") return import_fixedwidth<int32_t>(SType::INT32, arr, owner);
+  if (format == "l") return import_fixedwidth<int64_t>(SType::INT64, arr, owner);
+  if (format == "f") return import_fixedwidth<float>(SType::FLOAT32, arr, owner);
+  if (format == "g") return import_fixedwidth<double>(SType::FLOAT64, arr, owner);
+  if (format == "u") return import_string<int32_t, uint32_t>(arr, owner);
+  if (format == "U") return import_string<int64_t, uint64_t>(arr, owner);
+  throw TypeError() << "Cannot import Arrow column `"
+      << (schema->name? schema->name : "") << "` of type `" << format << "`";
+}
+
+
+void columns_from_arrow(robj src, std::vector<Column*>& cols,
+                        std::vector<std::string>& names)
+{
+  oobj res = src.invoke("__arrow_c_array__");
+  otuple capsules = res.to_otuple();
+  if (capsules.size() != 2 ||
+      !PyCapsule_IsValid(capsules[0].to_borrowed_ref(), CAPSULE_SCHEMA) ||
+      !PyCapsule_IsValid(capsules[1].to_borrowed_ref(), CAPSULE_ARRAY)) {
+    throw TypeError() << "Method `__arrow_c_array__()` of " << src.typeobj()
+        << " should return a tuple of 2 PyCapsules";
+  }
+  auto schema = static_cast<ArrowSchema*>(
+      PyCapsule_GetPointer(capsules[0].to_borrowed_ref(), CAPSULE_SCHEMA));
+  auto array = static_cast<ArrowArray*>(
+      PyCapsule_GetPointer(capsules[1].to_borrowed_ref(), CAPSULE_ARRAY));
+  if (!array->release) {
+    throw ValueError() << "The Arrow array has already been released";
+  }
+  if (std::strcmp(schema->format, "+s") != 0) {
+    throw TypeError() << "Cannot create a Frame from an Arrow array of type `"
+        << schema->format << "`: a struct array was expected";
+  }
+  // Move the array out of the capsule: from now on we are responsible for
+  // releasing it (the capsule's destructor will see a released array).
+  arrow_owner owner = std::make_shared<ImportedArray>();
+  owner->array = *array;
+  array->release = nullptr;
+
+  const ArrowArray* arr = &owner->array;
+  for (int64_t i = 0; i < schema->n_children; ++i) {
+    const ArrowSchema* child_schema = schema->children[i];
+    const ArrowArray* child = arr->children[i];
+    if (arr->offset || child->length != arr->length) {
+      // Slice of a struct array: apply parent's offset to the child
+      ArrowArray sliced = *child;
+      sliced.offset = child->offset + arr->offset;
+      sliced.length = arr->length;
+      sliced.null_count = -1;
+      cols.push_back(import_column(child_schema, &sliced, owner));
+    } else {
+      cols.push_back(import_column(child_schema, child, owner));
+    }
+    names.push_back(child_schema->name? child_schema->name : "");
+  }
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Declare Frame methods
+//------------------------------------------------------------------------------
+
+void Frame::Type::_init_arrow(Methods& mm) {
+  ADD_METHOD(mm, &Frame::m__arrow_c_array__, args__arrow_c_array__);
+}
+
+
+
+}  // namespace py
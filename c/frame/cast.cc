@@ -22,11 +22,13 @@
 //
 // See also: `expr_cast` in "exprs/base_expr.cc"
 //
+#include <memory>         // std::unique_ptr
 #include <unordered_map>
 #include "csv/toa.h"
 #include "python/_all.h"
 #include "python/string.h"
 #include "utils/parallel.h"
+#include "utils/profiler.h"
 #include "column.h"
 #include "datatablemodule.h"
 
@@ -175,23 +177,55 @@ static void cast_to_pyobj(const Column* col, void* out_data)
 }
 
 
+// Python strings can only be created while holding the GIL, so the main
+// loop here is necessarily single-threaded. In order to reduce its cost,
+// a parallel pre-pass determines which strings are pure ASCII, and then
+// `py::ostring_cache` creates the python objects (see "python/string.h").
+//
 template <typename T>
 static void cast_str_to_pyobj(const Column* col, void* out_data)
 {
+  constexpr int8_t KIND_NA = 0;
+  constexpr int8_t KIND_ASCII = 1;
+  constexpr int8_t KIND_UTF8 = 2;
   auto scol = static_cast<const StringColumn<T>*>(col);
   auto offsets = scol->offsets();
   auto strdata = scol->strdata();
   auto out = static_cast<PyObject**>(out_data);
   const RowIndex& rowindex = col->rowindex();
-  for (size_t i = 0; i < col->nrows; ++i) {
-    size_t j = rowindex[i];
-    T off_end = offsets[j];  // Note: if j==-1 (NA), offsets[j] is still valid
-    if (j == RowIndex::NA || ISNA<T>(off_end)) {
+  size_t nrows = col->nrows;
+
+  std::unique_ptr<int8_t[]> kinds(new int8_t[nrows]);
+  int8_t* kind = kinds.get();
+  dt::run_parallel(
+      [=](size_t start, size_t stop, size_t step) {
+        for (size_t i = start; i < stop; i += step) {
+          size_t j = rowindex[i];
+          T off_end = offsets[j];
+          if (j == RowIndex::NA || ISNA<T>(off_end)) {
+            kind[i] = KIND_NA;
+            continue;
+          }
+          T off_start = offsets[j - 1] & ~GETNA<T>();
+          auto ch = reinterpret_cast<const uint8_t*>(strdata + off_start);
+          auto end = reinterpret_cast<const uint8_t*>(strdata + off_end);
+          uint8_t acc = 0;
+          for (; ch < end; ++ch) acc |= *ch;
+          kind[i] = (acc & 0x80)? KIND_UTF8 : KIND_ASCII;
+        }
+      },
+      nrows);
+
+  py::ostring_cache cache;
+  for (size_t i = 0; i < nrows; ++i) {
+    if (kind[i] == KIND_NA) {
       out[i] = py::None().release();
-    } else {
-      T off_start = offsets[j - 1] & ~GETNA<T>();
-      out[i] = py::ostring(strdata + off_start, off_end - off_start).release();
+      continue;
     }
+    size_t j = rowindex[i];
+    T off_start = offsets[j - 1] & ~GETNA<T>();
+    size_t len = static_cast<size_t>(offsets[j] - off_start);
+    out[i] = cache.get(strdata + off_start, len, kind[i] == KIND_ASCII);
   }
 }
 
@@ -571,5 +605,7 @@ Column* Column::cast(SType new_stype) const {
 }
 
 Column* Column::cast(SType new_stype, MemoryRange&& mr) const {
+  dt::profile_scope ps("cast");
+  dt::profile_count("cast.rows", nrows);
   return casts.execute(this, std::move(mr), new_stype);
 }
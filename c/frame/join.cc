@@ -29,10 +29,13 @@
 #include "options.h"
 #include "py_rowindex.h"
 #include "python/args.h"
+#include "python/gil.h"
 #include "python/obj.h"
 #include "python/tuple.h"
 #include "types.h"
 #include "utils/assert.h"
+#include "utils/profiler.h"
+#include "utils/thread_pool.h"
 
 class Cmp;
 using indvec = std::vector<size_t>;
@@ -382,6 +385,8 @@ static size_t binsearch(Cmp* cmp, size_t nrows) {
 
 // declared in datatable.h
 RowIndex natural_join(const DataTable* xdt, const DataTable* jdt) {
+  dt::profile_scope ps("join");
+  dt::profile_count("join.rows", xdt->nrows);
   size_t k = jdt->get_nkeys();  // Number of join columns
   xassert(k > 0);
 
@@ -409,33 +414,32 @@ RowIndex natural_join(const DataTable* xdt, const DataTable* jdt) {
 
   arr32_t arr_result_indices(xdt->nrows);
   if (xdt->nrows) {
+    // Once the GIL is released, other python threads may modify the joined
+    // frames, so the join works with their shallow copies.
+    std::unique_ptr<DataTable> xcopy(xdt->copy());
+    std::unique_ptr<DataTable> jcopy(jdt->copy());
+    py::gil_release nogil;
     int32_t* result_indices = arr_result_indices.data();
     size_t nchunks = std::min(std::max(xdt->nrows / 200, size_t(1)),
                               static_cast<size_t>(config::nthreads));
     xassert(nchunks);
 
-    OmpExceptionManager oem;
-    #pragma omp parallel num_threads(nchunks)
-    {
-      try {
-        // Creating the comparator may fail if xcols and jcols are incompatible
-        MultiCmp comparator(xcols, jcols, xdt, jdt);
-
-        #pragma omp for
-        for (size_t i = 0; i < xdt->nrows; ++i) {
+    dt::parallel_for_static(xdt->nrows, nchunks,
+      [&](size_t i0, size_t i1) {
+        // Creating the comparator may fail if xcols and jcols are
+        // incompatible. In this case the exception will be propagated by
+        // `parallel_for_static()`.
+        MultiCmp comparator(xcols, jcols, xcopy.get(), jcopy.get());
+        for (size_t i = i0; i < i1; ++i) {
           int r = comparator.set_xrow(i);
           if (r == 0) {
-            size_t j = binsearch(&comparator, jdt->nrows);
+            size_t j = binsearch(&comparator, jcopy->nrows);
             result_indices[i] = static_cast<int32_t>(j);
           } else {
             result_indices[i] = -1;
           }
         }
-      } catch (...) {
-        oem.capture_exception();
-      }
-    }
-    oem.rethrow_exception_if_any();
+      });
   }
 
   return RowIndex(std::move(arr_result_indices));
@@ -275,6 +275,7 @@ const char* Frame::Type::classdoc() {
 
 
 void Frame::Type::init_methods_and_getsets(Methods& mm, GetSetters& gs) {
+  _init_arrow(mm);
   _init_cbind(mm);
   _init_key(gs);
   _init_init(mm);
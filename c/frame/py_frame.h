@@ -49,6 +49,7 @@ class Frame : public PyObject {
         static bool is_subclassable() { return true; }
         static void init_methods_and_getsets(Methods&, GetSetters&);
       private:
+        static void _init_arrow(Methods&);
         static void _init_cbind(Methods&);
         static void _init_init(Methods&);
         static void _init_jay(Methods&);
@@ -77,6 +78,7 @@ class Frame : public PyObject {
     oobj m__getstate__(const PKArgs&);  // pickling support
     void m__setstate__(const PKArgs&);
     oobj m__sizeof__(const PKArgs&);
+    oobj m__arrow_c_array__(const PKArgs&);  // See frame/arrow.cc
 
     // Frame display
     oobj m__repr__();
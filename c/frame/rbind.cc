@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //------------------------------------------------------------------------------
+#include <memory>
 #include <numeric>
 #include <unordered_map>
 #include "frame/py_frame.h"
@@ -333,12 +334,39 @@ Column* Column::rbind(std::vector<const Column*>& columns)
   }
   xassert(res->stype() == new_stype);
 
-  // TODO: Temporary Fix. To be resolved in #301
-  if (res->stats != nullptr) res->stats->reset();
+  // Compose the stats of the result from the stats of its parts. This is
+  // possible only if the stats of every part are known, and were computed for
+  // the same stype; otherwise they will be recomputed when needed. The stats
+  // are merged into a temporary object, which replaces the column's stats
+  // only after the data was appended successfully.
+  std::unique_ptr<Stats> newstats;
+  if (res == this && stats != nullptr) {
+    newstats.reset(stats->copy());
+    size_t n = nrows;
+    for (const Column* col : columns) {
+      bool is_void = (col->stype() == SType::VOID);
+      Stats* colstats = is_void? nullptr : col->get_stats_if_exist();
+      if (!is_void && (col->stype() != new_stype || colstats == nullptr)) {
+        newstats = nullptr;
+        break;
+      }
+      newstats->merge_stats(colstats, n, col->nrows);
+      n += col->nrows;
+    }
+  }
 
   // Use the appropriate strategy to continue appending the columns.
   res->rbind_impl(columns, new_nrows, col_empty);
 
+  if (res->stats != nullptr) {
+    if (newstats) {
+      delete res->stats;
+      res->stats = newstats.release();
+    } else {
+      res->stats->reset();
+    }
+  }
+
   // If everything is fine, then the current column can be safely discarded
   // -- the upstream caller will replace this column with the `res`.
   if (res != this) delete this;
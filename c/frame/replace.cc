@@ -20,12 +20,17 @@
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
 #include "frame/py_frame.h"
+#include <algorithm>      // std::min, std::max
+#include <cstring>        // std::memcpy, std::memcmp
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
+#include "models/murmurhash.h"
 #include "python/dict.h"
 #include "python/list.h"
 #include "utils/assert.h"
 #include "utils/parallel.h"
+#include "utils/thread_pool.h"
 
 namespace py {
 
@@ -585,6 +590,168 @@ void ReplaceAgent::process_str_column(size_t colidx) {
 #pragma clang diagnostic ignored "-Wpadded"
 
 
+//------------------------------------------------------------------------------
+// Lookup tables for replacing many values at once
+//------------------------------------------------------------------------------
+
+// With up to this many values to replace, each value is compared with all
+// targets directly; otherwise a lookup table is used.
+static constexpr size_t MAX_LINEAR_REPLACE = 8;
+
+// Number of rows processed at once by the linear replacement
+static constexpr size_t REPLACE_BLOCK = 256;
+
+// Minimum number of rows per thread in the replacement loops
+static constexpr size_t MIN_ROWS_PER_THREAD = 10000;
+
+
+static size_t replace_nthreads(size_t nrows) {
+  return std::max(size_t(1), std::min(dt::num_threads_in_pool(),
+                                      nrows / MIN_ROWS_PER_THREAD));
+}
+
+
+/**
+ * Lookup table which finds the index `j` of a value among the (unique,
+ * non-NA) replacement targets `x[0], ..., x[n-1]`.
+ *
+ * When the targets are integers whose range is not much larger than their
+ * count (such as the codes of a recoding mapping), this is a direct table
+ * indexed by `v - xmin`, i.e. a perfect hash. Otherwise it is an open
+ * addressing hash table with linear probing, at most half-full, using the
+ * fibonacci hash of the value's bits.
+ */
+template <typename T>
+class fw_lookup {
+  private:
+    std::vector<int32_t> slots;  // index of the target, or -1
+    std::vector<T> keys;         // hash table only
+    T xmin;
+    uint64_t range;
+    int shift;
+    bool direct;
+
+  public:
+    fw_lookup(const T* x, size_t n) : xmin(0), range(0), shift(0) {
+      xassert(n > 0);
+      direct = false;
+      if (std::is_integral<T>::value) {
+        T xmax = x[0];
+        xmin = x[0];
+        for (size_t j = 1; j < n; ++j) {
+          xmin = std::min(xmin, x[j]);
+          xmax = std::max(xmax, x[j]);
+        }
+        range = ubits(xmax) - ubits(xmin);
+        direct = (range < 4 * n + 1024);
+      }
+      if (direct) {
+        slots.assign(range + 1, -1);
+        for (size_t j = 0; j < n; ++j) {
+          slots[ubits(x[j]) - ubits(xmin)] = static_cast<int32_t>(j);
+        }
+      } else {
+        size_t size = 16;
+        shift = 60;
+        while (size < 2 * n) {
+          size *= 2;
+          shift--;
+        }
+        slots.assign(size, -1);
+        keys.resize(size);
+        size_t mask = size - 1;
+        for (size_t j = 0; j < n; ++j) {
+          size_t pos = hash(x[j]);
+          while (slots[pos] >= 0) pos = (pos + 1) & mask;
+          slots[pos] = static_cast<int32_t>(j);
+          keys[pos] = x[j];
+        }
+      }
+    }
+
+    int32_t find(T v) const {
+      if (direct) {
+        uint64_t d = ubits(v) - ubits(xmin);
+        return (d <= range)? slots[d] : -1;
+      }
+      size_t mask = slots.size() - 1;
+      size_t pos = hash(v);
+      while (slots[pos] >= 0) {
+        if (keys[pos] == v) return slots[pos];
+        pos = (pos + 1) & mask;
+      }
+      return -1;
+    }
+
+  private:
+    // Integer value as uint64, so that the difference of two values never
+    // overflows.
+    static uint64_t ubits(T v) {
+      return static_cast<uint64_t>(static_cast<int64_t>(v));
+    }
+
+    size_t hash(T v) const {
+      uint64_t b = 0;
+      if (v != 0) std::memcpy(&b, &v, sizeof(T));  // so that -0.0 == 0.0
+      return static_cast<size_t>((b * 0x9E3779B97F4A7C15ULL) >> shift);
+    }
+};
+
+
+/**
+ * Hash table of the (non-NA) string replacement targets, so that each
+ * string in a column is hashed only once, instead of being compared with
+ * every target.
+ */
+class str_lookup {
+  private:
+    const CString* x;
+    std::vector<int32_t> slots;  // index of the target, or -1
+    std::vector<uint64_t> hashes;
+    size_t mask;
+
+  public:
+    str_lookup(const CString* x_, size_t n) : x(x_) {
+      size_t size = 16;
+      while (size < 2 * n) size *= 2;
+      mask = size - 1;
+      slots.assign(size, -1);
+      hashes.resize(size);
+      for (size_t j = 0; j < n; ++j) {
+        xassert(!x[j].isna());
+        uint64_t h = hash(x[j]);
+        size_t pos = h & mask;
+        while (slots[pos] >= 0) pos = (pos + 1) & mask;
+        slots[pos] = static_cast<int32_t>(j);
+        hashes[pos] = h;
+      }
+    }
+
+    int32_t find(const CString& v) const {
+      uint64_t h = hash(v);
+      size_t pos = h & mask;
+      while (slots[pos] >= 0) {
+        if (hashes[pos] == h) {
+          const CString& u = x[slots[pos]];
+          if (u.size == v.size &&
+              std::memcmp(u.ch, v.ch, static_cast<size_t>(v.size)) == 0) {
+            return slots[pos];
+          }
+        }
+        pos = (pos + 1) & mask;
+      }
+      return -1;
+    }
+
+  private:
+    static uint64_t hash(const CString& s) {
+      return hash_murmur2(s.ch, static_cast<uint64_t>(s.size), 0);
+    }
+};
+
+
+
+
 template <typename T>
 void ReplaceAgent::replace_fw(T* x, T* y, size_t nrows, T* data, size_t n)
 {
@@ -649,39 +816,58 @@ void ReplaceAgent::replace_fw2(T* x, T* y, size_t nrows, T* data) {
 }
 
 
+/**
+ * The NA target, if present, is always the last one, and it is handled
+ * separately (NaN cannot be found by comparison). For small `n` the rows are
+ * processed in blocks: each target is compared with all values of the block
+ * in a branchless loop, which the compiler vectorizes. For larger `n` each
+ * value is looked up in a `fw_lookup` table.
+ */
 template <typename T>
 void ReplaceAgent::replace_fwN(T* x, T* y, size_t nrows, T* data, size_t n) {
-  if (std::is_floating_point<T>::value && ISNA<T>(x[n-1])) {
-    n--;
-    dt::run_parallel(
-      [=](size_t istart, size_t iend, size_t di) {
-        for (size_t i = istart; i < iend; i += di) {
-          T v = data[i];
-          if (ISNA<T>(v)) {
-            data[i] = y[n];
-            continue;
-          }
+  bool has_na = ISNA<T>(x[n-1]);
+  T na_repl = has_na? y[n-1] : T(0);
+  if (has_na) n--;
+  size_t nth = replace_nthreads(nrows);
+
+  if (n <= MAX_LINEAR_REPLACE) {
+    dt::parallel_for_static(nrows, nth,
+      [=](size_t i0, size_t i1) {
+        T orig[REPLACE_BLOCK];
+        for (size_t b = i0; b < i1; b += REPLACE_BLOCK) {
+          size_t m = std::min(REPLACE_BLOCK, i1 - b);
+          T* block = data + b;
+          std::memcpy(orig, block, m * sizeof(T));
+          // Since the targets are unique, at most one of them matches
+          // each of the original values.
           for (size_t j = 0; j < n; ++j) {
-            if (v == x[j]) {
-              data[i] = y[j];
-              break;
+            T xj = x[j], yj = y[j];
+            for (size_t i = 0; i < m; ++i) {
+              block[i] = (orig[i] == xj)? yj : block[i];
+            }
+          }
+          if (has_na) {
+            for (size_t i = 0; i < m; ++i) {
+              if (ISNA<T>(orig[i])) block[i] = na_repl;
             }
           }
         }
-      }, nrows);
-  } else {
-    dt::run_parallel(
-      [=](size_t istart, size_t iend, size_t di) {
-        for (size_t i = istart; i < iend; i += di) {
+      });
+  }
+  else {
+    fw_lookup<T> lookup(x, n);
+    dt::parallel_for_static(nrows, nth,
+      [&](size_t i0, size_t i1) {
+        for (size_t i = i0; i < i1; ++i) {
           T v = data[i];
-          for (size_t j = 0; j < n; ++j) {
-            if (v == x[j]) {
-              data[i] = y[j];
-              break;
-            }
+          if (ISNA<T>(v)) {
+            if (has_na) data[i] = na_repl;
+            continue;
           }
+          int32_t j = lookup.find(v);
+          if (j >= 0) data[i] = y[j];
         }
-      }, nrows);
+      });
   }
 }
 
@@ -712,6 +898,22 @@ template <typename T>
 Column* ReplaceAgent::replace_strN(CString* x, CString* y,
                                    StringColumn<T>* col, size_t n)
 {
+  if (n > MAX_LINEAR_REPLACE) {
+    // The NA target, if present, is the last one
+    bool has_na = x[n-1].isna();
+    CString na_repl = has_na? y[n-1] : CString();
+    if (has_na) n--;
+    str_lookup lookup(x, n);
+    return dt::map_str2str(col,
+      [&](size_t, CString& value, dt::string_buf* sb) {
+        if (value.isna()) {
+          sb->write(has_na? na_repl : value);
+          return;
+        }
+        int32_t j = lookup.find(value);
+        sb->write(j >= 0? y[j] : value);
+      });
+  }
   return dt::map_str2str(col,
     [=](size_t, CString& value, dt::string_buf* sb) {
       for (size_t j = 0; j < n; ++j) {
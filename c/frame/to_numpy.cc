@@ -170,37 +170,77 @@ R"(to_pandas(self)
 
 Convert this frame to a pandas DataFrame.
 
+Numeric columns without NAs are shared with the resulting DataFrame
+without copying. Such columns are read-only in pandas: call `.copy()`
+on the returned DataFrame if you need to modify it. Integer columns
+with NAs are converted into float64 columns with NaNs, boolean columns
+with NAs and string columns are converted into columns of python
+objects.
+
 The `pandas` module is required to run this function.
 )");
 
 
+// Return the stype into which column `col` has to be converted before it
+// can be passed to pandas, or VOID if the column can be passed as-is.
+static SType pandas_stype(const Column* col) {
+  SType st = col->stype();
+  switch (st) {
+    case SType::BOOL:
+      return col->countna()? SType::OBJ : SType::VOID;
+    case SType::INT8:
+    case SType::INT16:
+    case SType::INT32:
+    case SType::INT64:
+      return col->countna()? SType::FLOAT64 : SType::VOID;
+    case SType::STR32:
+    case SType::STR64:
+      return SType::OBJ;
+    default:
+      return SType::VOID;
+  }
+}
+
+
 oobj Frame::to_pandas(const PKArgs&) {
-  // ```
-  // from pandas import DataFrame
-  // names = self.names
-  // ```
   oobj pandas = oobj::import("pandas");
+  oobj numpy = oobj::import("numpy");
   oobj dataframe = pandas.get_attr("DataFrame");
+  oobj asarray = numpy.get_attr("asarray");
   otuple names = dt->get_pynames();
 
-  // ```
-  // cols = {names[i]: self.to_numpy(None, i)
-  //         for i in range(self.ncols)}
-  // ```
+  // Each column is converted into a numpy array separately. The columns
+  // that do not need conversion are exposed via the buffer protocol
+  // directly (which avoids copying the data); other columns are first
+  // converted (in parallel) into a new Column of appropriate stype, and
+  // then that Column is exposed.
   odict cols;
-  otuple np_call_args(2);
-  np_call_args.set(0, py::None());
   for (size_t i = 0; i < dt->ncols; ++i) {
-    np_call_args.replace(1, oint(i));
-    args_to_numpy.bind(np_call_args.to_borrowed_ref(), nullptr);
-    cols.set(names[i],
-             to_numpy(args_to_numpy));
+    Column* col = dt->columns[i];
+    SType st = pandas_stype(col);
+    oobj array;
+    if (st == SType::VOID && !col->rowindex()) {
+      pybuffers_context ctx(SType::VOID, i);
+      array = asarray.call({oobj(this)});
+    } else {
+      Column* newcol;
+      if (st == SType::VOID) {
+        newcol = col->shallowcopy();
+        newcol->materialize();
+      } else {
+        newcol = col->cast(st);
+      }
+      DataTable* newdt = new DataTable({newcol});
+      oobj newframe = oobj::from_new_reference(Frame::from_datatable(newdt));
+      pybuffers_context ctx(SType::VOID, 0);
+      array = asarray.call({newframe});
+    }
+    cols.set(names[i], array);
   }
-  // ```
-  // return DataFrame(cols, columns=names)
-  // ```
+
   odict pd_call_kws;
   pd_call_kws.set(ostring("columns"), names);
+  pd_call_kws.set(ostring("copy"), py::False());
   return dataframe.call(otuple(cols), pd_call_kws);
 }
 
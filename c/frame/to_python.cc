@@ -19,6 +19,7 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <cstring>     // std::memcmp
 #include "frame/py_frame.h"
 #include "python/_all.h"
 #include "python/args.h"
@@ -32,15 +33,38 @@ namespace py {
 // converters for various stypes
 //------------------------------------------------------------------------------
 
+/**
+ * Converter creates python objects for the values in rows `[row0, row1)` of
+ * a column, and stores them into the array `out` (as new references). The
+ * conversion is done in batches, so that the cost of a virtual call is
+ * amortized over many values.
+ *
+ * Converters may reuse the objects that they created earlier: for example
+ * repeated strings are converted only once. Because of this, all objects
+ * created by a converter must be kept alive for as long as the converter
+ * itself is in use.
+ */
 class converter {
+  protected:
+    const RowIndex& ri;
   public:
+    explicit converter(const Column*);
     virtual ~converter();
-    virtual oobj to_oobj(size_t row) const = 0;
+    virtual void convert(size_t row0, size_t row1, PyObject** out) = 0;
 };
 using convptr = std::unique_ptr<converter>;
 
+converter::converter(const Column* col) : ri(col->rowindex()) {}
 converter::~converter() {}
 
+// Number of rows converted in one batch by `to_tuples()`
+static constexpr size_t BATCH_SIZE = 4096;
+
+static inline PyObject* new_none() {
+  Py_INCREF(Py_None);
+  return Py_None;
+}
+
 
 
 class bool8_converter : public converter {
@@ -48,39 +72,64 @@ class bool8_converter : public converter {
     const int8_t* values;
   public:
     explicit bool8_converter(const Column*);
-    oobj to_oobj(size_t row) const override;
+    void convert(size_t row0, size_t row1, PyObject** out) override;
 };
 
-bool8_converter::bool8_converter(const Column* col) {
+bool8_converter::bool8_converter(const Column* col) : converter(col) {
   values = dynamic_cast<const BoolColumn*>(col)->elements_r();
 }
 
-oobj bool8_converter::to_oobj(size_t row) const {
-  int8_t x = values[row];
-  return x == 0? py::False() : x == 1? py::True() : py::None();
+void bool8_converter::convert(size_t row0, size_t row1, PyObject** out) {
+  ri.iterate(row0, row1, 1,
+    [&](size_t i, size_t j) {
+      int8_t x = j == RowIndex::NA? GETNA<int8_t>() : values[j];
+      PyObject* res = x == 0? Py_False : x == 1? Py_True : Py_None;
+      Py_INCREF(res);
+      out[i - row0] = res;
+    });
 }
 
 
 
+// Small integers are cached by python itself, so for integers we only
+// reuse the last created object, which helps with runs of equal values.
 template <typename T>
 class int_converter : public converter {
   private:
     const T* values;
+    PyObject* last;
+    T last_value;
+    size_t : 64 - 8 * sizeof(T);
   public:
     explicit int_converter(const Column*);
-    oobj to_oobj(size_t row) const override;
+    void convert(size_t row0, size_t row1, PyObject** out) override;
 };
 
 template <typename T>
-int_converter<T>::int_converter(const Column* col) {
+int_converter<T>::int_converter(const Column* col)
+  : converter(col), last(nullptr), last_value(0)
+{
   values = dynamic_cast<const IntColumn<T>*>(col)->elements_r();
 }
 
 template <typename T>
-oobj int_converter<T>::to_oobj(size_t row) const {
-  T x = values[row];
-  return ISNA<T>(x)? py::None() : oint(x);
-} // LCOV_EXCL_LINE
+void int_converter<T>::convert(size_t row0, size_t row1, PyObject** out) {
+  ri.iterate(row0, row1, 1,
+    [&](size_t i, size_t j) {
+      T x = j == RowIndex::NA? GETNA<T>() : values[j];
+      if (ISNA<T>(x)) {
+        out[i - row0] = new_none();
+        return;
+      }
+      if (!(last && x == last_value)) {
+        last = PyLong_FromLongLong(static_cast<long long>(x));
+        if (!last) throw PyError();
+        last_value = x;
+      }
+      else Py_INCREF(last);
+      out[i - row0] = last;
+    });
+}
 
 
 
@@ -88,65 +137,101 @@ template <typename T>
 class float_converter : public converter {
   private:
     const T* values;
+    PyObject* last;
+    T last_value;
+    size_t : 64 - 8 * sizeof(T);
   public:
     explicit float_converter(const Column*);
-    oobj to_oobj(size_t row) const override;
+    void convert(size_t row0, size_t row1, PyObject** out) override;
 };
 
 template <typename T>
-float_converter<T>::float_converter(const Column* col) {
+float_converter<T>::float_converter(const Column* col)
+  : converter(col), last(nullptr), last_value(0)
+{
   values = dynamic_cast<const RealColumn<T>*>(col)->elements_r();
 }
 
 template <typename T>
-oobj float_converter<T>::to_oobj(size_t row) const {
-  T x = values[row];
-  return ISNA<T>(x)? py::None() : ofloat(x);
-} // LCOV_EXCL_LINE
+void float_converter<T>::convert(size_t row0, size_t row1, PyObject** out) {
+  ri.iterate(row0, row1, 1,
+    [&](size_t i, size_t j) {
+      T x = j == RowIndex::NA? GETNA<T>() : values[j];
+      if (ISNA<T>(x)) {
+        out[i - row0] = new_none();
+        return;
+      }
+      // Compare bit patterns rather than values, so that 0.0 and -0.0
+      // are converted into different python objects
+      if (!(last && std::memcmp(&x, &last_value, sizeof(T)) == 0)) {
+        last = PyFloat_FromDouble(static_cast<double>(x));
+        if (!last) throw PyError();
+        last_value = x;
+      }
+      else Py_INCREF(last);
+      out[i - row0] = last;
+    });
+}
 
 
 
+// Repeated string values are deduplicated via `ostring_cache`, which is
+// very effective for columns with low cardinality.
 template <typename T>
 class string_converter : public converter {
   private:
     const char* strdata;
     const T* offsets;
+    ostring_cache cache;
   public:
     explicit string_converter(const Column*);
-    oobj to_oobj(size_t row) const override;
+    void convert(size_t row0, size_t row1, PyObject** out) override;
 };
 
 template <typename T>
-string_converter<T>::string_converter(const Column* col) {
+string_converter<T>::string_converter(const Column* col) : converter(col) {
   auto scol = dynamic_cast<const StringColumn<T>*>(col);
   strdata = scol->strdata();
   offsets = scol->offsets();
 }
 
 template <typename T>
-oobj string_converter<T>::to_oobj(size_t row) const {
-  T end = offsets[row];
-  if (ISNA<T>(end)) return py::None();
-  T start = offsets[row - 1] & ~GETNA<T>();
-  return ostring(strdata + start, end - start);
+void string_converter<T>::convert(size_t row0, size_t row1, PyObject** out) {
+  ri.iterate(row0, row1, 1,
+    [&](size_t i, size_t j) {
+      T end = j == RowIndex::NA? GETNA<T>() : offsets[j];
+      if (ISNA<T>(end)) {
+        out[i - row0] = new_none();
+        return;
+      }
+      T start = offsets[j - 1] & ~GETNA<T>();
+      const char* ch = strdata + start;
+      size_t len = static_cast<size_t>(end - start);
+      out[i - row0] = cache.get(ch, len);
+    });
 }
 
 
 
 class pyobj_converter : public converter {
   private:
-    const PyObject* const* values;
+    PyObject* const* values;
   public:
     explicit pyobj_converter(const Column*);
-    oobj to_oobj(size_t row) const override;
+    void convert(size_t row0, size_t row1, PyObject** out) override;
 };
 
-pyobj_converter::pyobj_converter(const Column* col) {
+pyobj_converter::pyobj_converter(const Column* col) : converter(col) {
   values = dynamic_cast<const PyObjectColumn*>(col)->elements_r();
 }
 
-oobj pyobj_converter::to_oobj(size_t row) const {
-  return oobj(values[row]);
+void pyobj_converter::convert(size_t row0, size_t row1, PyObject** out) {
+  ri.iterate(row0, row1, 1,
+    [&](size_t i, size_t j) {
+      PyObject* res = j == RowIndex::NA? Py_None : values[j];
+      Py_INCREF(res);
+      out[i - row0] = res;
+    });
 }
 
 
@@ -171,6 +256,17 @@ static convptr make_converter(const Column* col) {
 }
 
 
+// Create a python list with the data from column `col`.
+static oobj column_to_list(const Column* col) {
+  size_t nrows = col->nrows;
+  olist pycol(nrows);
+  PyObject* list = pycol.to_borrowed_ref();
+  auto conv = make_converter(col);
+  conv->convert(0, nrows, reinterpret_cast<PyListObject*>(list)->ob_item);
+  return std::move(pycol);
+}
+
+
 
 //------------------------------------------------------------------------------
 // Frame's API
@@ -197,23 +293,30 @@ Examples
 
 
 oobj Frame::to_tuples(const PKArgs&) {
-  std::vector<py::otuple> list_of_tuples;
-  for (size_t i = 0; i < dt->nrows; ++i) {
-    list_of_tuples.push_back(py::otuple(dt->ncols));
+  size_t nrows = dt->nrows;
+  size_t ncols = dt->ncols;
+  py::olist res(nrows);
+  for (size_t i = 0; i < nrows; ++i) {
+    res.set(i, py::otuple(ncols));
   }
-  for (size_t j = 0; j < dt->ncols; ++j) {
-    const Column* col = dt->columns[j];
-    const RowIndex& ri = col->rowindex();
-    auto conv = make_converter(col);
-    ri.iterate(0, dt->nrows, 1,
-      [&](size_t i, size_t ii) {
-        oobj x = ii == RowIndex::NA? py::None() : conv->to_oobj(ii);
-        list_of_tuples[i].set(j, std::move(x));
-      });
+  // The data is converted column-by-column in batches of BATCH_SIZE rows,
+  // and then scattered into the tuples.
+  std::vector<convptr> convs;
+  convs.reserve(ncols);
+  for (size_t j = 0; j < ncols; ++j) {
+    convs.push_back(make_converter(dt->columns[j]));
   }
-  py::olist res(dt->nrows);
-  for (size_t i = 0; i < dt->nrows; ++i) {
-    res.set(i, std::move(list_of_tuples[i]));
+  PyObject** rows = reinterpret_cast<PyListObject*>(res.to_borrowed_ref())
+                    ->ob_item;
+  std::vector<PyObject*> buf(std::min(nrows, BATCH_SIZE));
+  for (size_t i0 = 0; i0 < nrows; i0 += BATCH_SIZE) {
+    size_t i1 = std::min(i0 + BATCH_SIZE, nrows);
+    for (size_t j = 0; j < ncols; ++j) {
+      convs[j]->convert(i0, i1, buf.data());
+      for (size_t i = i0; i < i1; ++i) {
+        PyTuple_SET_ITEM(rows[i], j, buf[i - i0]);
+      }
+    }
   }
   return std::move(res);
 }
@@ -242,16 +345,7 @@ Examples
 oobj Frame::to_list(const PKArgs&) {
   py::olist res(dt->ncols);
   for (size_t j = 0; j < dt->ncols; ++j) {
-    py::olist pycol(dt->nrows);
-    const Column* col = dt->columns[j];
-    const RowIndex& ri = col->rowindex();
-    auto conv = make_converter(col);
-    ri.iterate(0, dt->nrows, 1,
-      [&](size_t i, size_t ii) {
-        oobj x = ii == RowIndex::NA? py::None() : conv->to_oobj(ii);
-        pycol.set(i, std::move(x));
-      });
-    res.set(j, std::move(pycol));
+    res.set(j, column_to_list(dt->columns[j]));
   }
   return std::move(res);
 }
@@ -281,16 +375,7 @@ oobj Frame::to_dict(const PKArgs&) {
   py::otuple names = dt->get_pynames();
   py::odict res;
   for (size_t j = 0; j < dt->ncols; ++j) {
-    py::olist pycol(dt->nrows);
-    const Column* col = dt->columns[j];
-    const RowIndex& ri = col->rowindex();
-    auto conv = make_converter(col);
-    ri.iterate(0, dt->nrows, 1,
-      [&](size_t i, size_t ii) {
-        oobj x = (ii == RowIndex::NA)? py::None() : conv->to_oobj(ii);
-        pycol.set(i, std::move(x));
-      });
-    res.set(names[j], pycol);
+    res.set(names[j], column_to_list(dt->columns[j]));
   }
   return std::move(res);
 }
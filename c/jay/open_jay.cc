@@ -9,6 +9,8 @@
 #include <cstring>              // std::memcmp
 #include "frame/py_frame.h"
 #include "jay/jay_generated.h"
+#include "utils/profiler.h"
+#include "python/gil.h"
 #include "datatable.h"
 #include "datatablemodule.h"
 
@@ -25,7 +27,11 @@ static Column* column_from_jay(size_t nrows,
 //------------------------------------------------------------------------------
 
 DataTable* open_jay_from_file(const std::string& path) {
-  MemoryRange mbuf = MemoryRange::mmap(path);
+  MemoryRange mbuf;
+  {
+    py::gil_release nogil;
+    mbuf = MemoryRange::mmap(path);
+  }
   return open_jay_from_mbuf(mbuf);
 }
 
@@ -33,14 +39,20 @@ DataTable* open_jay_from_bytes(const char* ptr, size_t len) {
   // The buffer's lifetime is tied to the lifetime of the bytes object, which
   // could be very short. This is why we have to copy the buffer (even storing
   // a reference will be insufficient: what if the bytes object gets modified?)
-  MemoryRange mbuf = MemoryRange::mem(len);
-  std::memcpy(mbuf.xptr(), ptr, len);
+  MemoryRange mbuf;
+  {
+    py::gil_release nogil;
+    mbuf = MemoryRange::mem(len);
+    std::memcpy(mbuf.xptr(), ptr, len);
+  }
   return open_jay_from_mbuf(mbuf);
 }
 
 
 DataTable* open_jay_from_mbuf(const MemoryRange& mbuf)
 {
+  dt::profile_scope ps("open_jay");
+  dt::profile_count("open_jay.bytes", mbuf.size());
   std::vector<std::string> colnames;
 
   const uint8_t* ptr = static_cast<const uint8_t*>(mbuf.rptr());
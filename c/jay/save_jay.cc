@@ -9,8 +9,10 @@
 #include "jay/jay_generated.h"
 #include "python/_all.h"
 #include "python/args.h"
+#include "python/gil.h"
 #include "python/string.h"
 #include "utils/assert.h"
+#include "utils/profiler.h"
 #include "datatable.h"
 #include "writebuf.h"
 
@@ -54,30 +56,40 @@ MemoryRange DataTable::save_jay() {
 
 
 void DataTable::save_jay_impl(WritableBuffer* wb) {
+  dt::profile_scope ps("to_jay");
   // Cannot store a view frame, so materialize first.
   materialize();
+  // Once the GIL is released, other python threads may modify this frame,
+  // or compute the stats of its columns. Therefore we serialize a shallow
+  // copy of the frame, whose columns (and stats) are private to this thread.
+  std::unique_ptr<DataTable> dtcopy(copy());
+
+  // Serializing the data does not require python
+  py::gil_release nogil;
 
   wb->write(8, "JAY1\0\0\0\0");
 
   flatbuffers::FlatBufferBuilder fbb(1024);
 
   std::vector<flatbuffers::Offset<jay::Column>> msg_columns;
-  for (size_t i = 0; i < ncols; ++i) {
-    Column* col = columns[i];
+  for (size_t i = 0; i < dtcopy->ncols; ++i) {
+    Column* col = dtcopy->columns[i];
+    const std::string& name = dtcopy->names[i];
     if (col->stype() == SType::OBJ) {
-      DatatableWarning() << "Column `" << names[i]
+      py::gil_acquire gil;
+      DatatableWarning() << "Column `" << name
           << "` of type obj64 was not saved";
     } else {
-      auto saved_col = column_to_jay(col, names[i], fbb, wb);
+      auto saved_col = column_to_jay(col, name, fbb, wb);
       msg_columns.push_back(saved_col);
     }
   }
   xassert((wb->size() & 7) == 0);
 
   auto frame = jay::CreateFrameDirect(fbb,
-                  nrows,
+                  dtcopy->nrows,
                   msg_columns.size(),
-                  static_cast<int>(nkeys),
+                  static_cast<int>(dtcopy->nkeys),
                   &msg_columns);
   fbb.Finish(frame);
 
@@ -92,6 +104,7 @@ void DataTable::save_jay_impl(WritableBuffer* wb) {
   wb->write(8, &metaSize);
   wb->write(8, "\0\0\0\0" "1JAY");
   wb->finalize();
+  dt::profile_count("to_jay.bytes", wb->size());
 }
 
 
@@ -7,16 +7,20 @@
 //------------------------------------------------------------------------------
 #include <algorithm>           // std::min
 #include <cerrno>              // errno
+#include <cstdlib>             // std::getenv
+#include <memory>              // std::shared_ptr, std::weak_ptr
 #include <mutex>               // std::mutex, std::lock_guard
 #ifndef _WIN32
 #include <sys/mman.h>          // mmap, munmap
+#include <unistd.h>            // write, close, unlink
 #endif
 #include "utils/alloc.h"       // dt::malloc, dt::realloc
 #include "utils/exceptions.h"  // ValueError, MemoryError
 #include "utils/misc.h"        // malloc_size
 #include "datatablemodule.h"   // TRACK, UNTRACK, IS_TRACKED
 #include "memrange.h"
-#include "mmm.h"               // MemoryMapWorker, MemoryMapManager
+#include "mmm.h"               // MemoryMapWorker, MemoryMapManager, ...
+#include "options.h"           // config::memory_spill_dir
 
 
 
@@ -41,6 +45,8 @@
       virtual void resize(size_t) {}
       virtual size_t size() const { return bufsize; }
       virtual void* ptr() const { return bufdata; }
+      virtual void* wptr() { return ptr(); }
+      virtual void set_owner(std::weak_ptr<void>) {}
       virtual size_t memory_footprint() const = 0;
       virtual const char* name() const = 0;
       virtual void verify_integrity() const;
@@ -54,26 +60,69 @@
   };
 
 
-  class MemoryMRI : public BaseMRI {
+  // MemoryMRI buffers are accounted in the MemoryBudget. Buffers of size at
+  // least `SPILLABLE_SIZE` are allocated via `dt::large_alloc()` (i.e.
+  // anonymous `mmap`) instead of `malloc`, which allows them to be spilled to
+  // disk when the memory budget is exceeded: the contents of the buffer is
+  // saved into a temporary file, and that file is then memory-mapped at the
+  // same address as the original buffer (the file is mapped as shared, so
+  // that the buffer remains writable).
+  //
+  // Only read-only buffers are spilled: those that are shared by several
+  // MemoryRange objects (any writer would have to copy such buffer first),
+  // or are not writable at all. The `owner` is the MemoryRange's internal
+  // object, whose use count tells how many MemoryRanges share this buffer.
+  // The `spill_mutex` is held while spilling, and when a writable pointer is
+  // requested, so that no writer can obtain the buffer while it is being
+  // copied into the spill file.
+  //
+  class MemoryMRI : public BaseMRI, SpillWorker {
+    private:
+      std::weak_ptr<void> owner;
+      mutable std::mutex spill_mutex;
+      mutable std::atomic<size_t> last_used;
+      size_t budget_index;
+      int spill_fd;
+      bool anonmapped;
+      bool spilled;
+      int : 16;
+
     public:
+      static constexpr size_t SPILLABLE_SIZE = 1 << 20;
+
       explicit MemoryMRI(size_t n);
       MemoryMRI(size_t n, void* ptr);
       ~MemoryMRI() override;
 
+      void* ptr() const override;
+      void* wptr() override;
+      void set_owner(std::weak_ptr<void> o) override;
       void resize(size_t n) override;
       size_t memory_footprint() const override;
-      const char* name() const override { return "ram"; }
+      const char* name() const override { return spilled? "spill" : "ram"; }
       void verify_integrity() const override;
+
+      void save_budget_index(size_t i) override;
+      bool can_spill() const override;
+      size_t spill_size() const override;
+      size_t last_access() const override;
+      bool spill() override;
+
+    private:
+      void free_buffer();
+      bool is_spillable() const;
   };
 
 
   class ExternalMRI : public BaseMRI {
     private:
       Py_buffer* pybufinfo;
+      std::shared_ptr<void> owner;
 
     public:
       ExternalMRI(size_t n, const void* ptr);
       ExternalMRI(size_t n, const void* ptr, Py_buffer* pybuf);
+      ExternalMRI(size_t n, const void* ptr, std::shared_ptr<void> owner);
       explicit ExternalMRI(const char* str);
       ~ExternalMRI() override;
 
@@ -200,7 +249,10 @@
   //---- Constructors ----------------------------
 
   MemoryRange::MemoryRange(BaseMRI* impl)
-    : o(std::make_shared<internal>(impl)) {}
+    : o(std::make_shared<internal>(impl))
+  {
+    impl->set_owner(o);
+  }
 
   MemoryRange::MemoryRange() : MemoryRange(new MemoryMRI(0)) {}
 
@@ -224,6 +276,11 @@
     return MemoryRange(new ExternalMRI(n, ptr, pb));
   }
 
+  MemoryRange MemoryRange::external(const void* ptr, size_t n,
+                                    std::shared_ptr<void> owner) {
+    return MemoryRange(new ExternalMRI(n, ptr, std::move(owner)));
+  }
+
   MemoryRange MemoryRange::view(const MemoryRange& src, size_t n, size_t offset) {
     return MemoryRange(new ViewMRI(n, src, offset));
   }
@@ -283,7 +340,7 @@
 
   void* MemoryRange::wptr() {
     if (!is_writable()) materialize();
-    return o->impl->ptr();
+    return o->impl->wptr();
   }
 
   void* MemoryRange::wptr(size_t offset) {
@@ -296,7 +353,7 @@
       throw RuntimeError() << "Cannot write into this MemoryRange object: "
         "refcount=" << o.use_count() << ", writable=" << o->impl->writable;
     }
-    return o->impl->ptr();
+    return o->impl->wptr();
   }
 
   void* MemoryRange::xptr(size_t offset) const {
@@ -381,6 +438,7 @@
   void MemoryRange::materialize(size_t newsize, size_t copysize) {
     xassert(newsize >= copysize);
     MemoryMRI* newimpl = new MemoryMRI(newsize);
+    MemoryBudget::get()->count_copy(copysize);
     if (copysize) {
       std::memcpy(newimpl->ptr(), o->impl->ptr(), copysize);
     }
@@ -395,6 +453,7 @@
       Py_None->ob_refcnt += n_new - n_copy;
     }
     o = std::make_shared<internal>(std::move(newimpl));
+    newimpl->set_owner(o);
   }
 
 
@@ -510,15 +569,35 @@
 // MemoryMRI
 //==============================================================================
 
-  MemoryMRI::MemoryMRI(size_t n) {
+  MemoryMRI::MemoryMRI(size_t n)
+    : last_used(0), budget_index(0), spill_fd(-1),
+      anonmapped(false), spilled(false)
+  {
+    MemoryBudget::get()->acquire(n);
+    try {
+      if (n >= SPILLABLE_SIZE) {
+        bufdata = dt::large_alloc(n);
+        anonmapped = true;
+      } else {
+        bufdata = dt::malloc<void>(n);
+      }
+    } catch (...) {
+      MemoryBudget::get()->release(n);
+      throw;
+    }
     bufsize = n;
-    bufdata = dt::malloc<void>(n);
+    if (anonmapped) MemoryBudget::get()->add_worker(this);
     TRACK(this, sizeof(*this), "MemoryMRI");
   }
 
-  MemoryMRI::MemoryMRI(size_t n, void* ptr) {
+  MemoryMRI::MemoryMRI(size_t n, void* ptr)
+    : last_used(0), budget_index(0), spill_fd(-1),
+      anonmapped(false), spilled(false)
+  {
     if (n && !ptr) throw ValueError() << "Unallocated memory region provided";
     // xassert(!ptr || IS_TRACKED(ptr));
+    // The memory was already allocated, so the budget cannot refuse it.
+    MemoryBudget::get()->acquire(n, /* strict = */ false);
     bufsize = n;
     bufdata = ptr;
     TRACK(this, sizeof(*this), "MemoryMRI");
@@ -526,23 +605,79 @@
 
   MemoryMRI::~MemoryMRI() {
     clear_pyobjects();
-    dt::free(bufdata);
+    free_buffer();
     UNTRACK(this);
   }
 
+  void* MemoryMRI::ptr() const {
+    if (anonmapped) {
+      size_t t = MemoryBudget::get()->now();
+      if (last_used.load(std::memory_order_relaxed) != t) {
+        last_used.store(t, std::memory_order_relaxed);
+      }
+    }
+    return bufdata;
+  }
+
+  void* MemoryMRI::wptr() {
+    if (anonmapped) {
+      // Wait for a spill that might be in progress
+      std::lock_guard<std::mutex> _(spill_mutex);
+    }
+    return ptr();
+  }
+
+  void MemoryMRI::set_owner(std::weak_ptr<void> o) {
+    std::lock_guard<std::mutex> _(spill_mutex);
+    owner = std::move(o);
+  }
+
   size_t MemoryMRI::memory_footprint() const {
     return sizeof(MemoryMRI) + bufsize;
   }
 
   void MemoryMRI::resize(size_t n) {
     if (n == bufsize) return;
-    bufdata = dt::realloc(bufdata, n);
+    MemoryBudget* budget = MemoryBudget::get();
+    if (!anonmapped && n < SPILLABLE_SIZE) {
+      if (n > bufsize) budget->acquire(n - bufsize);
+      bufdata = dt::realloc(bufdata, n);
+      if (n < bufsize) budget->release(bufsize - n);
+      bufsize = n;
+      return;
+    }
+    // Otherwise move the data into a new anonymous mapping (or simply free
+    // the buffer if the new size is 0). Thus a heap buffer that grows past
+    // `SPILLABLE_SIZE` is moved onto the large (huge-page aligned) path.
+    void* newdata = nullptr;
+    budget->acquire(n);
+    try {
+      if (n) newdata = dt::large_alloc(n);
+    } catch (...) {
+      budget->release(n);
+      throw;
+    }
+    if (n && bufsize) std::memcpy(newdata, bufdata, std::min(n, bufsize));
+    free_buffer();
+    bufdata = newdata;
     bufsize = n;
+    anonmapped = (n > 0);
+    if (anonmapped) budget->add_worker(this);
   }
 
   void MemoryMRI::verify_integrity() const {
     BaseMRI::verify_integrity();
-    if (bufsize) {
+    if (anonmapped) {
+      if (!MemoryBudget::get()->check_worker(budget_index, this)) {
+        throw AssertionError()
+            << "Memory-mapped MemoryRange is not registered in MemoryBudget";
+      }
+      if (spilled != (spill_fd >= 0)) {
+        throw AssertionError()
+            << "MemoryRange has spilled = " << spilled << ", but spill_fd = "
+            << spill_fd;
+      }
+    } else if (bufsize) {
       size_t actual_allocsize = malloc_size(bufdata);
       if (bufsize > actual_allocsize) {
         throw AssertionError()
@@ -553,6 +688,108 @@
     }
   }
 
+  // Free the buffer and return its memory to the budget. This leaves the
+  // object in a state with `bufdata == nullptr` and not registered with the
+  // MemoryBudget; the caller is responsible for updating `bufsize`.
+  void MemoryMRI::free_buffer() {
+    MemoryBudget* budget = MemoryBudget::get();
+    if (anonmapped) {
+      // Unregister from the budget before unmapping: `del_worker()` waits
+      // for a spill that the budget may be running (the budget holds its
+      // mutex for the entire duration of spilling), and afterwards this
+      // buffer can no longer be selected for spilling.
+      budget->del_worker(budget_index);
+      std::lock_guard<std::mutex> _(spill_mutex);
+      dt::large_free(bufdata, bufsize);
+      #ifndef _WIN32
+        if (spill_fd >= 0) ::close(spill_fd);
+      #endif
+      budget->release(bufsize, spilled);
+      budget_index = 0;
+      spill_fd = -1;
+      anonmapped = false;
+      spilled = false;
+    } else {
+      dt::free(bufdata);
+      budget->release(bufsize);
+    }
+    bufdata = nullptr;
+  }
+
+
+  void MemoryMRI::save_budget_index(size_t i) {
+    budget_index = i;
+  }
+
+  bool MemoryMRI::can_spill() const {
+    std::lock_guard<std::mutex> _(spill_mutex);
+    return is_spillable();
+  }
+
+  // Requires `spill_mutex` to be held. A buffer without an owner is either
+  // being constructed, or is currently viewed (see ViewedMRI): neither of
+  // them can be spilled.
+  bool MemoryMRI::is_spillable() const {
+    if (!anonmapped || spilled || pyobjects || bufsize < SPILLABLE_SIZE) {
+      return false;
+    }
+    long nrefs = owner.use_count();
+    return nrefs > 1 || (nrefs == 1 && !writable);
+  }
+
+  size_t MemoryMRI::spill_size() const {
+    return bufsize;
+  }
+
+  size_t MemoryMRI::last_access() const {
+    return last_used.load(std::memory_order_relaxed);
+  }
+
+  bool MemoryMRI::spill() {
+    std::lock_guard<std::mutex> _(spill_mutex);
+    // The buffer may have become writable since `can_spill()` was checked
+    if (!is_spillable()) return false;
+    #ifndef _WIN32
+      std::string dir = config::memory_spill_dir;
+      if (dir.empty()) {
+        const char* tmpdir = std::getenv("TMPDIR");
+        dir = tmpdir? tmpdir : "/tmp";
+      }
+      std::string path = dir + "/datatable-spill-XXXXXX";
+      int fd = mkstemp(&path[0]);
+      if (fd < 0) {
+        throw IOError() << "Unable to create a spill file in " << dir << Errno;
+      }
+      // The file is removed immediately: it will remain accessible via `fd`
+      // and the memory mapping, and will be deleted by the OS once both are
+      // closed.
+      unlink(path.c_str());
+      const char* src = static_cast<const char*>(bufdata);
+      size_t written = 0;
+      while (written < bufsize) {
+        ssize_t ret = ::write(fd, src + written, bufsize - written);
+        if (ret <= 0) {
+          ::close(fd);
+          throw IOError() << "Unable to write " << bufsize << " bytes into "
+              "a spill file in " << dir << Errno;
+        }
+        written += static_cast<size_t>(ret);
+      }
+      void* p = mmap(bufdata, bufsize, PROT_WRITE|PROT_READ,
+                     MAP_SHARED|MAP_FIXED, fd, 0);
+      if (p == MAP_FAILED) {
+        ::close(fd);
+        throw IOError() << "Unable to memory-map a spill file" << Errno;
+      }
+      xassert(p == bufdata);
+      spill_fd = fd;
+      spilled = true;
+      return true;
+    #else
+      return false;
+    #endif
+  }
+
 
 
 
@@ -570,17 +807,25 @@
     pybufinfo = pybuf;
     resizable = false;
     writable = false;
+    MemoryBudget::get()->track(MemoryBudget::Kind::EXTERNAL, bufsize);
     TRACK(this, sizeof(*this), "ExternalMRI");
   }
 
   ExternalMRI::ExternalMRI(size_t n, const void* ptr)
-    : ExternalMRI(n, ptr, nullptr)
+    : ExternalMRI(n, ptr, static_cast<Py_buffer*>(nullptr))
   {
     writable = true;
   }
 
+  ExternalMRI::ExternalMRI(size_t n, const void* ptr,
+                           std::shared_ptr<void> own)
+    : ExternalMRI(n, ptr, static_cast<Py_buffer*>(nullptr))
+  {
+    owner = std::move(own);
+  }
+
   ExternalMRI::ExternalMRI(const char* str)
-      : ExternalMRI(strlen(str) + 1, str, nullptr) {}
+      : ExternalMRI(strlen(str) + 1, str) {}
 
   ExternalMRI::~ExternalMRI() {
     // If the buffer contained pyobjects, leave them as-is and do not attempt
@@ -589,6 +834,7 @@
     if (pybufinfo) {
       PyBuffer_Release(pybufinfo);
     }
+    MemoryBudget::get()->untrack(MemoryBudget::Kind::EXTERNAL, bufsize);
     UNTRACK(this);
   }
 
@@ -616,12 +862,14 @@
     resizable = false;
     writable = base->is_writable();
     pyobjects = src.is_pyobjects();
+    MemoryBudget::get()->track(MemoryBudget::Kind::VIEW, bufsize);
     TRACK(this, sizeof(*this), "ViewMRI");
   }
 
   ViewMRI::~ViewMRI() {
     base->release();
     pyobjects = false;
+    MemoryBudget::get()->untrack(MemoryBudget::Kind::VIEW, bufsize);
     UNTRACK(this);
   }
 
@@ -657,6 +905,9 @@
   ViewedMRI::ViewedMRI(const MemoryRange& src) {
     BaseMRI* implptr = src.o->impl.release();
     src.o->impl.reset(this);
+    // The views may write into the original buffer, so it must not be
+    // spilled while it is being viewed
+    implptr->set_owner(std::weak_ptr<void>());
     parent = src.o;  // copy std::shared_ptr
     original_impl = implptr;
     refcount = 0;
@@ -686,6 +937,7 @@
     if (--refcount == 0) {
       parent->impl.release();
       parent->impl.reset(original_impl);
+      original_impl->set_owner(parent);
       delete this;
     }
   }
@@ -826,6 +1078,7 @@
                                << " +" << bufsize - filesize << Errno;
         } else {
           MemoryMapManager::get()->add_entry(this, bufsize);
+          MemoryBudget::get()->track(MemoryBudget::Kind::MMAP, bufsize);
           break;
         }
       }
@@ -847,6 +1100,7 @@
                  "may have not been freed properly.",
                  errno, std::strerror(errno));
         }
+        MemoryBudget::get()->untrack(MemoryBudget::Kind::MMAP, bufsize);
         bufdata = nullptr;
       }
       mapped = false;
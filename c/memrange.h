@@ -8,6 +8,7 @@
 #ifndef dt_MEMRANGE_h
 #define dt_MEMRANGE_h
 #include <cstdint>
+#include <memory>             // std::shared_ptr
 #include <string>             // std::string
 #include <type_traits>        // std::is_same
 #include <Python.h>
@@ -110,6 +111,13 @@ class MemoryRange
     //   interface. The MemoryRange object created in this way is neither
     //   writeable nor resizeable.
     //
+    // MemoryRange::external(ptr, n, owner)
+    //   Similar to the previous, but the lifetime of the memory buffer is
+    //   guarded by an arbitrary shared `owner` object, which will be released
+    //   when the MemoryRange is deleted. This is used for example when
+    //   importing data via the Arrow C Data Interface, where multiple buffers
+    //   share the same release callback.
+    //
     // MemoryRange::view(src, n, offset)
     //   Create MemoryRange as a "view" onto another MemoryRange `src`. The
     //   view is positioned at `offset` from the beginning of `src`s buffer,
@@ -131,6 +139,8 @@ class MemoryRange
     static MemoryRange acquire(void* ptr, size_t n);
     static MemoryRange external(const void* ptr, size_t n);
     static MemoryRange external(const void* ptr, size_t n, Py_buffer* pybuf);
+    static MemoryRange external(const void* ptr, size_t n,
+                                std::shared_ptr<void> owner);
     static MemoryRange view(const MemoryRange& src, size_t n, size_t offset);
     static MemoryRange mmap(const std::string& path);
     static MemoryRange mmap(const std::string& path, size_t n, int fd = -1);
@@ -9,6 +9,8 @@
 #include <algorithm>
 #include "utils/assert.h"
 #include "utils/exceptions.h"
+#include "utils/thread_pool.h"  // dt::in_parallel_region
+#include "options.h"          // config::memory_limit
 
 
 
@@ -70,3 +72,145 @@ void MemoryMapManager::sort_entries() {
 
 
 MemoryMapWorker::~MemoryMapWorker() {}
+
+
+
+//------------------------------------------------------------------------------
+// MemoryBudget
+//------------------------------------------------------------------------------
+
+constexpr size_t MemoryBudget::NKINDS;
+
+MemoryBudget::MemoryBudget()
+  : allocated(0), spilled(0), clock(1), cow_copies(0), cow_bytes(0)
+{
+  for (size_t k = 0; k < NKINDS; ++k) {
+    tracked_bytes[k] = 0;
+    tracked_buffers[k] = 0;
+  }
+  workers.push_back(nullptr);
+}
+
+
+MemoryBudget* MemoryBudget::get() {
+  static MemoryBudget* budget = new MemoryBudget();
+  return budget;
+}
+
+
+void MemoryBudget::add_worker(SpillWorker* obj) {
+  std::lock_guard<std::mutex> _(mutex);
+  workers.push_back(obj);
+  obj->save_budget_index(workers.size() - 1);
+}
+
+
+// Called from MemoryMRI's destructor, so must not throw.
+void MemoryBudget::del_worker(size_t i) {
+  std::lock_guard<std::mutex> _(mutex);
+  std::swap(workers[i], workers.back());
+  workers[i]->save_budget_index(i);
+  workers.pop_back();
+}
+
+
+bool MemoryBudget::check_worker(size_t i, const SpillWorker* obj) {
+  std::lock_guard<std::mutex> _(mutex);
+  return (i > 0 && i < workers.size() && workers[i] == obj);
+}
+
+
+void MemoryBudget::acquire(size_t n, bool strict) {
+  clock++;
+  size_t total = (allocated += n);
+  size_t limit = config::memory_limit;
+  // Inside a parallel region we can neither spill (other threads may be
+  // using the buffers), nor throw an exception (other tasks of the region
+  // may be left in an inconsistent state). Such allocations are thus allowed
+  // to exceed the limit.
+  if (limit && total > limit && !dt::in_parallel_region()) {
+    if (n <= limit) {
+      std::lock_guard<std::mutex> _(mutex);
+      try {
+        spill(total - limit);
+      } catch (...) {
+        allocated -= n;
+        throw;
+      }
+    }
+    if (strict && allocated > limit) {
+      allocated -= n;
+      throw MemoryError() << "Unable to allocate " << n << " bytes: memory "
+          "limit of " << limit << " bytes set in `dt.options.memory.limit` "
+          "has been exceeded";
+    }
+  }
+}
+
+
+void MemoryBudget::release(size_t n, bool from_spill) {
+  if (from_spill) spilled -= n;
+  else allocated -= n;
+}
+
+
+void MemoryBudget::track(Kind kind, size_t n) {
+  size_t k = static_cast<size_t>(kind);
+  tracked_bytes[k] += n;
+  tracked_buffers[k]++;
+}
+
+
+void MemoryBudget::untrack(Kind kind, size_t n) {
+  size_t k = static_cast<size_t>(kind);
+  tracked_bytes[k] -= n;
+  tracked_buffers[k]--;
+}
+
+
+void MemoryBudget::count_copy(size_t n) {
+  cow_copies++;
+  cow_bytes += n;
+}
+
+
+size_t MemoryBudget::allocated_size() const { return allocated; }
+size_t MemoryBudget::spilled_size() const { return spilled; }
+size_t MemoryBudget::copies_count() const { return cow_copies; }
+size_t MemoryBudget::copies_size() const { return cow_bytes; }
+size_t MemoryBudget::now() const { return clock.load(std::memory_order_relaxed); }
+
+size_t MemoryBudget::tracked_size(Kind kind) const {
+  return tracked_bytes[static_cast<size_t>(kind)];
+}
+
+size_t MemoryBudget::tracked_count(Kind kind) const {
+  return tracked_buffers[static_cast<size_t>(kind)];
+}
+
+
+// Spill the least recently used buffers, until at least `nbytes` bytes are
+// freed, or there are no more spillable buffers left. The mutex must be held
+// by the caller.
+void MemoryBudget::spill(size_t nbytes) {
+  std::vector<SpillWorker*> candidates;
+  for (size_t i = 1; i < workers.size(); ++i) {
+    if (workers[i]->can_spill()) candidates.push_back(workers[i]);
+  }
+  std::sort(candidates.begin(), candidates.end(),
+            [](const SpillWorker* a, const SpillWorker* b) {
+              return a->last_access() < b->last_access();
+            });
+  size_t freed = 0;
+  for (SpillWorker* w : candidates) {
+    if (freed >= nbytes) break;
+    size_t sz = w->spill_size();
+    if (!w->spill()) continue;
+    freed += sz;
+    allocated -= sz;
+    spilled += sz;
+  }
+}
+
+
+SpillWorker::~SpillWorker() {}
@@ -7,6 +7,8 @@
 //------------------------------------------------------------------------------
 #ifndef dt_MMM_h
 #define dt_MMM_h
+#include <atomic>
+#include <mutex>
 #include <vector>
 using std::size_t;
 
@@ -50,4 +52,97 @@ private:
 };
 
 
+
+//------------------------------------------------------------------------------
+// Memory budget
+//------------------------------------------------------------------------------
+
+/**
+ * Interface for memory buffers that can be "spilled" to disk: their contents
+ * is written into a temporary file, and then the file is memory-mapped in
+ * place of the original memory. The address of the buffer does not change,
+ * so that the spilling is transparent to the code that uses the buffer.
+ */
+class SpillWorker {
+public:
+  virtual ~SpillWorker();
+  virtual void save_budget_index(size_t i) = 0;
+  virtual bool can_spill() const = 0;
+  virtual size_t spill_size() const = 0;
+  virtual size_t last_access() const = 0;
+  // Returns false if the buffer could not be spilled after all
+  virtual bool spill() = 0;
+};
+
+
+/**
+ * Accounting of the memory allocated by `MemoryRange` objects. When the
+ * total allocated amount exceeds the limit set in `config::memory_limit`,
+ * the least recently used spillable buffers are spilled to disk; and if that
+ * is not sufficient, the allocation fails with a MemoryError.
+ *
+ * Besides the allocated memory, the budget also keeps track of the buffers
+ * that are not subject to the limit: memory-mapped files, external buffers
+ * owned by other objects (such as numpy arrays), and views into other
+ * buffers; as well as of the number of copy-on-write copies of shared
+ * buffers. These are reported by `dt.internal.memory_stats()`, together with
+ * the allocator's own counters (see `dt::memory_counters`), which also cover
+ * the heap buffers that are not held in a MemoryRange.
+ *
+ * Only read-only buffers are spilled (see `SpillWorker::can_spill()`), so
+ * that no data can be written into a buffer while it is being copied to disk.
+ * Spilling is also never attempted from within a parallel region; the limit
+ * is not enforced in that case.
+ */
+class MemoryBudget {
+public:
+  enum class Kind : size_t { MMAP, EXTERNAL, VIEW };
+  static constexpr size_t NKINDS = 3;
+
+private:
+  std::vector<SpillWorker*> workers;  // 0th entry always remains empty.
+  std::atomic<size_t> allocated;
+  std::atomic<size_t> spilled;
+  std::atomic<size_t> clock;
+  std::atomic<size_t> tracked_bytes[NKINDS];
+  std::atomic<size_t> tracked_buffers[NKINDS];
+  std::atomic<size_t> cow_copies;
+  std::atomic<size_t> cow_bytes;
+  std::mutex mutex;
+
+public:
+  static MemoryBudget* get();
+  void add_worker(SpillWorker* obj);
+  void del_worker(size_t i);
+  bool check_worker(size_t i, const SpillWorker* obj);
+
+  // Register allocation of `n` bytes. If this causes the memory limit to be
+  // exceeded then some buffers will be spilled; and if that doesn't help and
+  // `strict` is true, then an exception will be thrown.
+  void acquire(size_t n, bool strict = true);
+  // Register deallocation of `n` bytes, either from the "allocated" or from
+  // the "spilled" pool.
+  void release(size_t n, bool from_spill = false);
+
+  // Register creation / destruction of a buffer of size `n` that is not
+  // subject to the memory limit.
+  void track(Kind kind, size_t n);
+  void untrack(Kind kind, size_t n);
+  // Register a copy-on-write copy of `n` bytes.
+  void count_copy(size_t n);
+
+  size_t allocated_size() const;
+  size_t spilled_size() const;
+  size_t tracked_size(Kind kind) const;
+  size_t tracked_count(Kind kind) const;
+  size_t copies_count() const;
+  size_t copies_size() const;
+  size_t now() const;
+
+private:
+  MemoryBudget();
+  void spill(size_t nbytes);
+};
+
+
 #endif
@@ -19,16 +19,20 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <limits>
 #include <random>
 #include <iostream>
 #include "frame/py_frame.h"
+#include "models/categorical_encoder.h"
 #include "models/dt_ftrl.h"
 #include "models/column_convertor.h"
+#include "models/exemplar_index.h"
 #include "models/utils.h"
 #include "python/_all.h"
 #include "python/obj.h"
 #include "utils/parallel.h"
 #include "utils/shared_mutex.h"
+#include "utils/thread_pool.h"
 #include "datatablemodule.h"
 #include "options.h"
 #include "rowindex.h"
@@ -94,6 +98,9 @@ class Aggregator : public AggregatorBase {
     ccptrvec<T> contconvs;
     dtptr dt_cat;
 
+    // Number of rows per thread processed in a single batch by `group_nd()`
+    static constexpr size_t ND_BATCH_SIZE = 1024;
+
     // Final aggregation method
     void aggregate_exemplars(bool);
 
@@ -102,6 +109,8 @@ class Aggregator : public AggregatorBase {
     void group_1d();
     void group_1d_continuous();
     void group_1d_categorical();
+    template<typename U0>
+    void group_1d_categorical_str();
     void group_2d();
     void group_2d_continuous();
     void group_2d_categorical();
@@ -117,8 +126,8 @@ class Aggregator : public AggregatorBase {
 
     // Helper methods
     size_t get_nthreads(size_t nrows);
-    void normalize_row(tptr<T>&, size_t);
-    void project_row(tptr<T>&, size_t, tptr<T>&);
+    void normalize_row(T*, size_t);
+    void project_row(T*, size_t, tptr<T>&);
     tptr<T> generate_pmatrix(size_t ncols);
     T calculate_distance(tptr<T>&, tptr<T>&, size_t, T, bool early_exit = true);
     void adjust_delta(T&, std::vector<exptr>&, std::vector<size_t>&, size_t);
@@ -151,6 +160,10 @@ Aggregator<T>::Aggregator(size_t min_rows_in, size_t n_bins_in,
 }
 
 
+template <typename T>
+constexpr size_t Aggregator<T>::ND_BATCH_SIZE;
+
+
 /*
 *  Main Aggregator method, convert all the numeric columns to `T`,
 *  do the corresponding grouping and final exemplar aggregation:
@@ -462,10 +475,18 @@ void Aggregator<T>::group_2d_continuous() {
 
 
 /*
-*  Do 1D grouping for a categorical column, i.e. just a `group by` operation.
+*  Detect string type for a categorical column and do a corresponding call
+*  to `group_1d_categorical_str`. For other column types do a `group by`
+*  operation.
 */
 template <typename T>
 void Aggregator<T>::group_1d_categorical() {
+  switch (dt_cat->columns[0]->stype()) {
+    case SType::STR32:  group_1d_categorical_str<uint32_t>(); return;
+    case SType::STR64:  group_1d_categorical_str<uint64_t>(); return;
+    default:            break;
+  }
+
   std::vector<sort_spec> spec = {sort_spec(0)};
   auto res = dt_cat->group(spec);
   RowIndex ri0 = std::move(res.first);
@@ -485,6 +506,21 @@ void Aggregator<T>::group_1d_categorical() {
 }
 
 
+/*
+*  Do 1D grouping for a categorical string column: the bin of each row
+*  is just the code of its value, see `CategoricalEncoder`. The missing
+*  values get the bin -1.
+*/
+template <typename T>
+template <typename U0>
+void Aggregator<T>::group_1d_categorical_str() {
+  const Column* col = dt_cat->columns[0];
+  auto d_members = static_cast<int32_t*>(dt_members->columns[0]->data_w());
+  CategoricalEncoder<U0> encoder(col, get_nthreads(col->nrows));
+  encoder.encode(d_members);
+}
+
+
 /*
 *  Detect string types for both categorical columns and do a corresponding call
 *  to `group_2d_mixed_str`.
@@ -515,41 +551,59 @@ void Aggregator<T>::group_2d_categorical () {
 
 
 /*
-*  Do 2D grouping for two categorical columns, i.e. two `group by` operations,
-*  and combine their results.
+*  Do 2D grouping for two categorical columns: encode each of them, see
+*  `CategoricalEncoder`, and combine the two codes into a bin.
 */
 template <typename T>
 template <typename U0, typename U1>
 void Aggregator<T>::group_2d_categorical_str() {
-
-  std::vector<sort_spec> spec = {sort_spec(0), sort_spec(1)};
-  auto res = dt_cat->group(spec);
-  RowIndex ri = std::move(res.first);
-  Groupby grpby = std::move(res.second);
-
-  auto c0 = static_cast<const StringColumn<U0>*>(dt_cat->columns[0]);
-  auto c1 = static_cast<const StringColumn<U1>*>(dt_cat->columns[1]);
-  const U0* d_c0 = c0->offsets();
-  const U1* d_c1 = c1->offsets();
+  size_t nrows = dt_cat->nrows;
+  size_t nth = get_nthreads(nrows);
+  std::vector<int32_t> codes0(nrows);
+  std::vector<int32_t> codes1(nrows);
+  CategoricalEncoder<U0> encoder0(dt_cat->columns[0], nth);
+  CategoricalEncoder<U1> encoder1(dt_cat->columns[1], nth);
+  encoder0.encode(codes0.data());
+  encoder1.encode(codes1.data());
+  auto ncodes1 = static_cast<int64_t>(encoder1.get_ncodes());
+  auto nbins = static_cast<int64_t>(encoder0.get_ncodes()) * ncodes1;
 
   auto d_members = static_cast<int32_t*>(dt_members->columns[0]->data_w());
-  const int32_t* offsets = grpby.offsets_r();
-
-  #pragma omp parallel for schedule(dynamic)
-  for (size_t i = 0; i < grpby.ngroups(); ++i) {
-    auto group_id = static_cast<int32_t>(i);
-    size_t off_i = static_cast<size_t>(offsets[i]);
-    size_t off_i1 = static_cast<size_t>(offsets[i+1]);
-    for (size_t j = off_i; j < off_i1; ++j) {
-      int32_t gi = static_cast<int32_t>(ri[j]);
-      int32_t na_case = ISNA<U0>(d_c0[gi]) + 2 * ISNA<U1>(d_c1[gi]);
-      if (na_case) {
-        d_members[gi] = -na_case;
-      } else {
-        d_members[gi] = group_id;
+  dt::parallel_for_static(nrows, nth,
+    [&](size_t i0, size_t i1) {
+      for (size_t i = i0; i < i1; ++i) {
+        int32_t na_case = (codes0[i] < 0) + 2 * (codes1[i] < 0);
+        if (na_case) {
+          d_members[i] = -na_case;
+        } else if (nbins <= std::numeric_limits<int32_t>::max()) {
+          d_members[i] = codes0[i] * static_cast<int32_t>(ncodes1) + codes1[i];
+        }
       }
+    });
+  if (nbins <= std::numeric_limits<int32_t>::max()) return;
+
+  // The bins do not fit into `int32_t`, so only the non-empty ones are
+  // numbered, keeping their order.
+  std::vector<int64_t> bins;
+  bins.reserve(nrows);
+  for (size_t i = 0; i < nrows; ++i) {
+    if (codes0[i] >= 0 && codes1[i] >= 0) {
+      bins.push_back(codes0[i] * ncodes1 + codes1[i]);
     }
   }
+  std::sort(bins.begin(), bins.end());
+  bins.erase(std::unique(bins.begin(), bins.end()), bins.end());
+
+  dt::parallel_for_static(nrows, nth,
+    [&](size_t i0, size_t i1) {
+      for (size_t i = i0; i < i1; ++i) {
+        if (codes0[i] < 0 || codes1[i] < 0) continue;
+        int64_t bin = codes0[i] * ncodes1 + codes1[i];
+        d_members[i] = static_cast<int32_t>(
+                         std::lower_bound(bins.begin(), bins.end(), bin)
+                         - bins.begin());
+      }
+    });
 }
 
 
@@ -570,42 +624,36 @@ void Aggregator<T>::group_2d_mixed() {
 
 /*
 *  Do 2D grouping for one continuous and one categorical string column,
-*  i.e. 1D binning for the continuous column and a `group by`
-*  operation for the categorical one.
+*  i.e. 1D binning for the continuous column and encoding of the
+*  categorical one, see `CategoricalEncoder`.
 */
 template<typename T>
 template<typename U0>
 void Aggregator<T>::group_2d_mixed_str() {
-  auto c_cat = static_cast<const StringColumn<U0>*>(dt_cat->columns[0]);
-  const U0* d_cat = c_cat->offsets();
-
-  std::vector<sort_spec> spec = {sort_spec(0)};
-  auto res = dt_cat->group(spec);
-  RowIndex ri_cat = std::move(res.first);
-  Groupby grpby = std::move(res.second);
-
+  const Column* col = dt_cat->columns[0];
+  size_t nrows = col->nrows;
+  size_t nth = get_nthreads(nrows);
   auto d_members = static_cast<int32_t*>(dt_members->columns[0]->data_w());
-  const int32_t* offsets_cat = grpby.offsets_r();
+  CategoricalEncoder<U0> encoder(col, nth);
+  encoder.encode(d_members);
 
   T normx_factor, normx_shift;
   set_norm_coeffs(normx_factor, normx_shift, (*contconvs[0]).get_min(), (*contconvs[0]).get_max(), nx_bins);
 
-  #pragma omp parallel for schedule(dynamic)
-  for (size_t i = 0; i < grpby.ngroups(); ++i) {
-    int32_t group_cat_id = static_cast<int32_t>(nx_bins * i);
-    size_t off_i = static_cast<size_t>(offsets_cat[i]);
-    size_t off_i1 = static_cast<size_t>(offsets_cat[i+1]);
-    for (size_t j = off_i; j < off_i1; ++j) {
-      size_t gi = ri_cat[j];
-      int32_t na_case = ISNA<T>((*contconvs[0])[gi]) + 2 * ISNA<U0>(d_cat[gi]);
-      if (na_case) {
-        d_members[gi] = -na_case;
-      } else {
-        d_members[gi] = group_cat_id +
-                        static_cast<int32_t>(normx_factor * (*contconvs[0])[gi] + normx_shift);
+  dt::parallel_for_static(nrows, nth,
+    [&](size_t i0, size_t i1) {
+      for (size_t i = i0; i < i1; ++i) {
+        T value = (*contconvs[0])[i];
+        int32_t na_case = ISNA<T>(value) + 2 * (d_members[i] < 0);
+        if (na_case) {
+          d_members[i] = -na_case;
+        } else {
+          d_members[i] =
+            d_members[i] * static_cast<int32_t>(nx_bins) +
+            static_cast<int32_t>(normx_factor * value + normx_shift);
+        }
       }
-    }
-  }
+    });
 }
 
 
@@ -619,6 +667,15 @@ void Aggregator<T>::group_2d_mixed_str() {
 *  - adjust `delta` taking into account initial size of bubbles;
 *  - store the merging info and use it in `adjust_members(...)`.
 *
+*  The rows are processed in batches of `ND_BATCH_SIZE * nthreads`, each in
+*  two phases. First, all the rows of a batch are tested in parallel against
+*  the exemplars gathered so far, see `ExemplarIndex`. Second, the rows
+*  that were not matched are processed sequentially in their original order:
+*  each is tested once more, and becomes a new exemplar if there is still
+*  no exemplar within `delta`. Since the exemplars are only modified in the
+*  second phase, no locking is needed, and the result does not depend on
+*  the number of threads.
+*
 *  Another approach is to have a constant `delta` see `Develop` branch
 *  https://github.com/h2oai/vis-data-server/blob/master/library/src/main/java/com/
 *  h2o/data/Aggregator.java based on the estimates given at
@@ -637,109 +694,97 @@ void Aggregator<T>::group_2d_mixed_str() {
 */
 template <typename T>
 void Aggregator<T>::group_nd() {
-  OmpExceptionManager oem;
-  dt::shared_bmutex shmutex;
   size_t ncols = contconvs.size();
   size_t nrows = (*contconvs[0]).get_nrows();
   size_t ndims = std::min(max_dimensions, ncols);
   std::vector<exptr> exemplars;
   std::vector<size_t> ids;
-  std::vector<size_t> coprimes;
   auto d_members = static_cast<int32_t*>(dt_members->columns[0]->data_w());
   tptr<T> pmatrix = nullptr;
   bool do_projection = ncols > max_dimensions;
   if (do_projection) pmatrix = generate_pmatrix(ncols);
+  if (!seed) {
+    std::random_device rd;
+    seed = rd();
+  }
+  ExemplarIndex<T> index(ndims, seed);
 
   // Figuring out how many threads to use.
-  size_t nth0 = get_nthreads(nrows);
+  size_t nth = std::max(get_nthreads(nrows), size_t(1));
+  size_t batch_size = nth * ND_BATCH_SIZE;
+  std::vector<T> coords(batch_size * ndims);
+  std::vector<size_t> matches(batch_size);
+
+  // Position in the list of candidate exemplars, from which the testing
+  // of the row `i` starts (splitmix64 hash of the row index).
+  auto start = [&](size_t i) -> uint64_t {
+    uint64_t z = static_cast<uint64_t>(i) + seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  };
 
   // Start with a very small `delta`, that is Euclidean distance squared.
   T delta = epsilon;
-  // Exemplar counter, if doesn't match thread local value, it means
-  // some new exemplars were added (and may be even `delta` was adjusted)
-  // meanwhile, so restart is needed for the `test_member` procedure.
-  size_t ecounter = 0;
-
-  #pragma omp parallel num_threads(nth0)
-  {
-    size_t ith = static_cast<size_t>(omp_get_thread_num());
-    size_t nth = static_cast<size_t>(omp_get_num_threads());
-    size_t rstep = (nrows > nth * PBSTEPS)? nrows / (nth * PBSTEPS) : 1;
-    T distance;
-    auto member = tptr<T>(new T[ndims]);
-    size_t ecounter_local;
-
-    // Each thread gets its own seed
-    std::default_random_engine generator(seed + static_cast<unsigned int>(ith));
-
-    try {
-      // Main loop over all the rows
-      for (size_t i = ith; i < nrows; i += nth) {
-        bool is_exemplar = true;
-        do_projection? project_row(member, i, pmatrix) : normalize_row(member, i);
-
-        test_member: {
-          dt::shared_lock<dt::shared_bmutex> lock(shmutex, /* exclusive = */ false);
-          ecounter_local = ecounter;
-          size_t nexemplars = exemplars.size();
-          size_t ncoprimes = coprimes.size();
-
-          // Generate random exemplar and coprime vector indices.
-          // When `nexemplars` is zero, this may be any `size_t` number,
-          // however, since we do not do any member testing in this case,
-          // this is not an issue.
-          std::uniform_int_distribution<size_t> exemplars_dist(0, nexemplars - 1);
-          std::uniform_int_distribution<size_t> coprimes_dist(0, ncoprimes - 1);
-          size_t exemplar_index = exemplars_dist(generator);
-          size_t coprime_index = coprimes_dist(generator);
-
-          // Instead of traversing exemplars in the order they appear
-          // in the `exemplars` vector, we use modular quasi-random
-          // paths. This ensures we get more uniform member distribution
-          // across the clusters. Since `coprimes[coprime_index]` and
-          // `nexemplars` are coprimes, `j` will take all the integer values
-          // in the range [0; nexemplars - 1], where
-          // - `exemplar_index` determines at which exemplar we start testing;
-          // - `coprime_index` is a "seed" to the modular generator.
-          for (size_t k = 0; k < nexemplars; ++k) {
-            size_t j = (k * coprimes[coprime_index] + exemplar_index) % nexemplars;
-            // Note, this distance will depend on delta, because
-            // `early_exit = true` by default
-            distance = calculate_distance(member, exemplars[j]->coords, ndims, delta);
-            if (distance < delta) {
-              d_members[i] = static_cast<int32_t>(exemplars[j]->id);
-              is_exemplar = false;
-              break;
-            }
-          }
+  size_t pbstep = 0;
+  // Number of exemplars when the index direction was last updated
+  size_t nindexed = 1;
+
+  for (size_t i0 = 0; i0 < nrows; i0 += batch_size) {
+    size_t nb = std::min(batch_size, nrows - i0);
+
+    // Phase 1: test all the rows of the batch against the exemplars
+    // gathered so far. The exemplars are not modified here.
+    dt::parallel_for_static(nb, nth,
+      [&](size_t k0, size_t k1) {
+        for (size_t k = k0; k < k1; ++k) {
+          size_t i = i0 + k;
+          T* member = coords.data() + k * ndims;
+          do_projection? project_row(member, i, pmatrix)
+                       : normalize_row(member, i);
+          matches[k] = index.find(member, delta, start(i));
         }
+      });
 
-        if (is_exemplar) {
-          dt::shared_lock<dt::shared_bmutex> lock(shmutex, /* exclusive = */ true);
-          if (ecounter_local == ecounter) {
-            ecounter++;
-            exptr e = exptr(new exemplar{ids.size(), std::move(member)});
-            member = tptr<T>(new T[ndims]);
-            ids.push_back(e->id);
-            d_members[i] = static_cast<int32_t>(e->id);
-            exemplars.push_back(std::move(e));
-            if (exemplars.size() > nd_max_bins) {
-              adjust_delta(delta, exemplars, ids, ndims);
+    // Phase 2: the rows that have no exemplar within `delta` are tested
+    // again in their original order, since some exemplars may have been
+    // added or merged meanwhile, and become exemplars otherwise.
+    for (size_t k = 0; k < nb; ++k) {
+      size_t i = i0 + k;
+      size_t id = matches[k];
+      if (id == ExemplarIndex<T>::NONE) {
+        const T* member = coords.data() + k * ndims;
+        id = index.find(member, delta, start(i));
+        if (id == ExemplarIndex<T>::NONE) {
+          id = ids.size();
+          exptr e = exptr(new exemplar{id, tptr<T>(new T[ndims])});
+          std::memcpy(e->coords.get(), member, ndims * sizeof(T));
+          ids.push_back(id);
+          index.add(id, member);
+          exemplars.push_back(std::move(e));
+          if (exemplars.size() > nd_max_bins) {
+            adjust_delta(delta, exemplars, ids, ndims);
+            index.clear();
+            for (const exptr& ex : exemplars) {
+              index.add(ex->id, ex->coords.get());
             }
-            calculate_coprimes(exemplars.size(), coprimes);
-          } else {
-            goto test_member;
+            nindexed = 0;
+          }
+          if (exemplars.size() >= 2 * nindexed) {
+            index.update_direction();
+            nindexed = exemplars.size();
           }
         }
+      }
+      d_members[i] = static_cast<int32_t>(id);
+    }
 
-        #pragma omp master
-        if ((i / nth) % rstep == 0) progress(static_cast<float>(i+1) / nrows);
-      } // End main loop over all the rows
-    } catch (...) {
-      oem.capture_exception();
+    size_t pbstep_new = (i0 + nb) * PBSTEPS / nrows;
+    if (pbstep_new > pbstep) {
+      pbstep = pbstep_new;
+      progress(static_cast<float>(i0 + nb) / nrows);
     }
   }
-  oem.rethrow_exception_if_any();
   adjust_members(ids);
 }
 
@@ -888,7 +933,7 @@ T Aggregator<T>::calculate_distance(tptr<T>& e1, tptr<T>& e2,
 *  Normalize the row elements to [0,1).
 */
 template <typename T>
-void Aggregator<T>::normalize_row(tptr<T>& r, size_t row) {
+void Aggregator<T>::normalize_row(T* r, size_t row) {
   for (size_t i = 0; i < contconvs.size(); ++i) {
     T norm_factor, norm_shift;
     T value = (*contconvs[i])[row];
@@ -902,9 +947,9 @@ void Aggregator<T>::normalize_row(tptr<T>& r, size_t row) {
 *  Project a particular row on a subspace by using the projection matrix.
 */
 template <typename T>
-void Aggregator<T>::project_row(tptr<T>& r, size_t row, tptr<T>& pmatrix)
+void Aggregator<T>::project_row(T* r, size_t row, tptr<T>& pmatrix)
 {
-  std::memset(r.get(), 0, max_dimensions * sizeof(T));
+  std::memset(r, 0, max_dimensions * sizeof(T));
   int32_t n = 0;
   for (size_t i = 0; i < contconvs.size(); ++i) {
     T value = (*contconvs[i])[row];
@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_MODELS_CATEGORICAL_ENCODER_h
+#define dt_MODELS_CATEGORICAL_ENCODER_h
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+#include "models/murmurhash.h"
+#include "utils/parallel.h"
+#include "utils/thread_pool.h"
+#include "column.h"
+#include "rowindex.h"
+#include "sort.h"
+
+
+/*
+*  Encoder of a string column into integer codes, used by the aggregator to
+*  bin the categorical values. Equal strings get the same code, the codes
+*  go from 0 to `ncodes - 1` in the order in which the strings are sorted,
+*  and the missing values get the code -1.
+*
+*  Instead of sorting all the rows, the strings are hashed. Each thread
+*  collects the distinct strings of its own contiguous chunk of rows into
+*  a hash table, and assigns them local codes. These tables are then merged,
+*  only the distinct strings are sorted, and the local codes are replaced
+*  with the final ones via a lookup table, again in parallel.
+*/
+template <typename U>
+class CategoricalEncoder {
+  private:
+    // Open addressing hash table of distinct strings, with linear probing
+    struct dict {
+      std::vector<size_t> strs;      // indices of the strings in `offsets`
+      std::vector<uint64_t> hashes;  // hashes of the strings
+      std::vector<int32_t> slots;    // codes of the strings, or -1
+      size_t mask;
+
+      dict() : slots(16, -1), mask(15) {}
+      size_t size() const { return strs.size(); }
+    };
+
+    const U* offsets;
+    const uint8_t* strdata;
+    RowIndex ri;
+    size_t nrows;
+    size_t nth;
+    size_t ncodes;
+
+  public:
+    CategoricalEncoder(const Column* col, size_t nthreads)
+      : ri(col->rowindex()),
+        nrows(col->nrows),
+        nth(std::max(nthreads, size_t(1))),
+        ncodes(0)
+    {
+      auto scol = static_cast<const StringColumn<U>*>(col);
+      offsets = scol->offsets();
+      strdata = scol->ustrdata();
+    }
+
+    // Number of distinct non-missing values, available after `encode()`
+    size_t get_ncodes() const { return ncodes; }
+
+
+    void encode(int32_t* codes) {
+      std::vector<dict> dicts(nth);
+
+      // Assign the local codes chunk by chunk
+      dt::parallel_for_static(nth, nth,
+        [&](size_t t0, size_t t1) {
+          for (size_t t = t0; t < t1; ++t) {
+            dict& d = dicts[t];
+            size_t i1 = nrows * (t + 1) / nth;
+            for (size_t i = nrows * t / nth; i < i1; ++i) {
+              size_t j = ri[i];
+              if (j == RowIndex::NA || ISNA<U>(offsets[j])) {
+                codes[i] = -1;
+              } else {
+                codes[i] = insert(d, j, hash(j));
+              }
+            }
+          }
+        });
+
+      // Merge the local dictionaries, and map their codes to the global ones
+      dict global;
+      std::vector<std::vector<int32_t>> maps(nth);
+      for (size_t t = 0; t < nth; ++t) {
+        const dict& d = dicts[t];
+        maps[t].resize(d.size());
+        for (size_t k = 0; k < d.size(); ++k) {
+          maps[t][k] = insert(global, d.strs[k], d.hashes[k]);
+        }
+      }
+      ncodes = global.size();
+
+      // Sort the distinct strings, and renumber the global codes accordingly
+      std::vector<int32_t> order(ncodes);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(),
+        [&](int32_t a, int32_t b) {
+          size_t ja = global.strs[static_cast<size_t>(a)];
+          size_t jb = global.strs[static_cast<size_t>(b)];
+          return compare_offstrings<1, U>(strdata, start(ja), offsets[ja],
+                                          start(jb), offsets[jb]) > 0;
+        });
+      std::vector<int32_t> ranks(ncodes);
+      for (size_t r = 0; r < ncodes; ++r) {
+        ranks[static_cast<size_t>(order[r])] = static_cast<int32_t>(r);
+      }
+      for (auto& map : maps) {
+        for (int32_t& code : map) code = ranks[static_cast<size_t>(code)];
+      }
+
+      dt::parallel_for_static(nth, nth,
+        [&](size_t t0, size_t t1) {
+          for (size_t t = t0; t < t1; ++t) {
+            const int32_t* map = maps[t].data();
+            size_t i1 = nrows * (t + 1) / nth;
+            for (size_t i = nrows * t / nth; i < i1; ++i) {
+              if (codes[i] >= 0) codes[i] = map[static_cast<size_t>(codes[i])];
+            }
+          }
+        });
+    }
+
+
+  private:
+    U start(size_t j) const {
+      return offsets[j - 1] & ~GETNA<U>();
+    }
+
+    uint64_t hash(size_t j) const {
+      U s = start(j);
+      return hash_murmur2(strdata + s, offsets[j] - s, 0);
+    }
+
+    bool equal(size_t j1, size_t j2) const {
+      U s1 = start(j1);
+      U s2 = start(j2);
+      U len = offsets[j1] - s1;
+      return len == offsets[j2] - s2 &&
+             std::equal(strdata + s1, strdata + s1 + len, strdata + s2);
+    }
+
+    /*
+    *  Find the string `j` with the hash `h` in the dictionary `d`, and
+    *  return its code. If the string is not there yet, add it with the
+    *  next available code.
+    */
+    int32_t insert(dict& d, size_t j, uint64_t h) const {
+      size_t pos = h & d.mask;
+      while (d.slots[pos] >= 0) {
+        size_t k = static_cast<size_t>(d.slots[pos]);
+        if (d.hashes[k] == h && equal(d.strs[k], j)) return d.slots[pos];
+        pos = (pos + 1) & d.mask;
+      }
+      auto code = static_cast<int32_t>(d.size());
+      d.slots[pos] = code;
+      d.strs.push_back(j);
+      d.hashes.push_back(h);
+      // Keep the load factor below 0.5
+      if (2 * d.size() > d.mask) {
+        d.mask = 2 * d.mask + 1;
+        d.slots.assign(d.mask + 1, -1);
+        for (size_t k = 0; k < d.size(); ++k) {
+          pos = d.hashes[k] & d.mask;
+          while (d.slots[pos] >= 0) pos = (pos + 1) & d.mask;
+          d.slots[pos] = static_cast<int32_t>(k);
+        }
+      }
+      return code;
+    }
+};
+
+
+#endif
@@ -29,6 +29,28 @@ Hasher::Hasher(const Column* col) : ri(col->rowindex()) {}
 Hasher::~Hasher() {}
 
 
+/*
+* Helper for the `hash_block()` methods: `hashfn(i)` computes the hash of
+* the `i`-th element of the column's data, where `i` may be `RowIndex::NA`.
+* When the column has no rowindex, the row indices are used directly.
+*/
+template <typename F>
+static inline void hash_rows(const RowIndex& ri, const size_t* rows, size_t n,
+                             uint64_t seed, uint64_t* out, size_t stride,
+                             F hashfn)
+{
+  if (ri) {
+    for (size_t r = 0; r < n; ++r) {
+      out[r * stride] = hashfn(ri[rows[r]]) + seed;
+    }
+  } else {
+    for (size_t r = 0; r < n; ++r) {
+      out[r * stride] = hashfn(rows[r]) + seed;
+    }
+  }
+}
+
+
 /*
 * Hash booleans by casting them to `uint64_t`.
 */
@@ -38,7 +60,18 @@ HasherBool::HasherBool(const Column* col) : Hasher(col) {
 
 
 uint64_t HasherBool::hash(size_t row) const {
-  size_t i = ri[row];
+  return hash_index(ri[row]);
+}
+
+
+void HasherBool::hash_block(const size_t* rows, size_t n, uint64_t seed,
+                            uint64_t* out, size_t stride) const {
+  hash_rows(ri, rows, n, seed, out, stride,
+            [&](size_t i) { return hash_index(i); });
+}
+
+
+inline uint64_t HasherBool::hash_index(size_t i) const {
   int8_t value = (i == RowIndex::NA)? GETNA<int8_t>() : values[i];
   uint64_t h = static_cast<uint64_t>(value);
   return h;
@@ -56,7 +89,20 @@ HasherInt<T>::HasherInt(const Column* col) : Hasher(col) {
 
 template <typename T>
 uint64_t HasherInt<T>::hash(size_t row) const {
-  size_t i = ri[row];
+  return hash_index(ri[row]);
+}
+
+
+template <typename T>
+void HasherInt<T>::hash_block(const size_t* rows, size_t n, uint64_t seed,
+                              uint64_t* out, size_t stride) const {
+  hash_rows(ri, rows, n, seed, out, stride,
+            [&](size_t i) { return hash_index(i); });
+}
+
+
+template <typename T>
+inline uint64_t HasherInt<T>::hash_index(size_t i) const {
   T value = (i == RowIndex::NA)? GETNA<T>() : values[i];
   uint64_t h = static_cast<uint64_t>(value);
   return h;
@@ -75,7 +121,20 @@ HasherFloat<T>::HasherFloat(const Column* col) : Hasher(col){
 
 template <typename T>
 uint64_t HasherFloat<T>::hash(size_t row) const {
-  size_t i = ri[row];
+  return hash_index(ri[row]);
+}
+
+
+template <typename T>
+void HasherFloat<T>::hash_block(const size_t* rows, size_t n, uint64_t seed,
+                                uint64_t* out, size_t stride) const {
+  hash_rows(ri, rows, n, seed, out, stride,
+            [&](size_t i) { return hash_index(i); });
+}
+
+
+template <typename T>
+inline uint64_t HasherFloat<T>::hash_index(size_t i) const {
   T value = (i == RowIndex::NA)? GETNA<T>() : values[i];
   auto x = static_cast<double>(value);
   uint64_t* h = reinterpret_cast<uint64_t*>(&x);
@@ -96,7 +155,20 @@ HasherString<T>::HasherString(const Column* col) : Hasher(col){
 
 template <typename T>
 uint64_t HasherString<T>::hash(size_t row) const {
-  size_t i = ri[row];
+  return hash_index(ri[row]);
+}
+
+
+template <typename T>
+void HasherString<T>::hash_block(const size_t* rows, size_t n, uint64_t seed,
+                                 uint64_t* out, size_t stride) const {
+  hash_rows(ri, rows, n, seed, out, stride,
+            [&](size_t i) { return hash_index(i); });
+}
+
+
+template <typename T>
+inline uint64_t HasherString<T>::hash_index(size_t i) const {
   if (i == RowIndex::NA) {
     return static_cast<uint64_t>(GETNA<T>());
   } else {
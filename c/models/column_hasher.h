@@ -35,6 +35,16 @@ class Hasher {
 
     const RowIndex& ri;
     virtual uint64_t hash(size_t row) const = 0;
+
+    /*
+    * Hash a block of `n` rows, whose indices are given by `rows`, adding
+    * `seed` to each hash value. The results are written into `out[0]`,
+    * `out[stride]`, ..., `out[(n-1)*stride]`, so that a block of rows
+    * can be hashed column-by-column into a row-major matrix. This method
+    * requires only a single virtual call per column per block.
+    */
+    virtual void hash_block(const size_t* rows, size_t n, uint64_t seed,
+                            uint64_t* out, size_t stride) const = 0;
 };
 
 
@@ -50,6 +60,10 @@ class HasherBool : public Hasher {
   public:
     explicit HasherBool(const Column*);
     uint64_t hash(size_t row) const override;
+    void hash_block(const size_t*, size_t, uint64_t, uint64_t*,
+                    size_t) const override;
+  private:
+    uint64_t hash_index(size_t i) const;
 };
 
 
@@ -63,6 +77,10 @@ class HasherInt : public Hasher {
   public:
     explicit HasherInt(const Column*);
     uint64_t hash(size_t row) const override;
+    void hash_block(const size_t*, size_t, uint64_t, uint64_t*,
+                    size_t) const override;
+  private:
+    uint64_t hash_index(size_t i) const;
 };
 
 
@@ -76,6 +94,10 @@ class HasherFloat : public Hasher {
   public:
     explicit HasherFloat(const Column*);
     uint64_t hash(size_t row) const override;
+    void hash_block(const size_t*, size_t, uint64_t, uint64_t*,
+                    size_t) const override;
+  private:
+    uint64_t hash_index(size_t i) const;
 };
 
 
@@ -90,6 +112,10 @@ class HasherString : public Hasher {
   public:
     explicit HasherString(const Column*);
     uint64_t hash(size_t row) const override;
+    void hash_block(const size_t*, size_t, uint64_t, uint64_t*,
+                    size_t) const override;
+  private:
+    uint64_t hash_index(size_t i) const;
 };
 
 
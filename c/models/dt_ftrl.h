@@ -42,9 +42,11 @@ struct FtrlParams {
     uint64_t nbins;
     size_t nepochs;
     bool double_precision;
-    size_t: 56;
+    bool deterministic;
+    size_t: 48;
     FtrlParams() : alpha(0.005), beta(1.0), lambda1(0.0), lambda2(1.0),
-                   nbins(1000000), nepochs(1), double_precision(false) {}
+                   nbins(1000000), nepochs(1), double_precision(false),
+                   deterministic(false) {}
 };
 
 
@@ -70,17 +72,24 @@ class Ftrl {
     // - binomial logistic regression (BOOL);
     // - multinomial logistic regression (STR32, STR64);
     // - numerical regression (INT8, INT16, INT32, INT64, FLOAT32, FLOAT64).
+    // If the last argument is true, the GIL is released while training:
+    // the caller must guarantee that the frames cannot be modified (or
+    // destroyed) in the meantime.
     virtual double dispatch_fit(const DataTable*, const DataTable*,
                                 const DataTable*, const DataTable*,
-                                double, double) = 0;
+                                double, double, bool) = 0;
     virtual dtptr predict(const DataTable*) = 0;
+    virtual double dispatch_loss(const DataTable*, const DataTable*) = 0;
     virtual void reset() = 0;
     virtual bool is_trained() = 0;
+    virtual void finalize() = 0;
+    virtual bool is_finalized() = 0;
 
     // Getters
     virtual DataTable* get_model() = 0;
     virtual FtrlModelType get_model_type() = 0;
     virtual DataTable* get_fi(bool normaliza = true) = 0;
+    virtual DataTable* get_weights() = 0;
     virtual size_t get_nfeatures() = 0;
     virtual size_t get_ncols() = 0;
     virtual const std::vector<uint64_t>& get_colname_hashes() = 0;
@@ -92,12 +101,14 @@ class Ftrl {
     virtual size_t get_nepochs() = 0;
     virtual const std::vector<sizetvec>& get_interactions() = 0;
     virtual bool get_double_precision() = 0;
+    virtual bool get_deterministic() = 0;
     virtual FtrlParams get_params() = 0;
     virtual const strvec& get_labels() = 0;
 
     // Setters
     virtual void set_model(DataTable*) = 0;
     virtual void set_fi(DataTable*) = 0;
+    virtual void set_weights(DataTable*) = 0;
     virtual void set_model_type(FtrlModelType) = 0;
     virtual void set_alpha(double) = 0;
     virtual void set_beta(double) = 0;
@@ -107,6 +118,7 @@ class Ftrl {
     virtual void set_nepochs(size_t) = 0;
     virtual void set_interactions(std::vector<sizetvec>) = 0;
     virtual void set_double_precision(bool) = 0;
+    virtual void set_deterministic(bool) = 0;
     virtual void set_labels(strvec) = 0;
 };
 
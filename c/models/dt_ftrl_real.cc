@@ -20,10 +20,19 @@
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
 #include "models/dt_ftrl_real.h"
+#include "python/gil.h"
+#include "utils/thread_pool.h"
 
 
 namespace dt {
 
+template <typename T>
+constexpr size_t FtrlReal<T>::HASH_BLOCK_SIZE;
+template <typename T>
+constexpr size_t FtrlReal<T>::DETERMINISTIC_BLOCK_SIZE;
+template <typename T>
+constexpr size_t FtrlReal<T>::DETERMINISTIC_LABEL_GROUP;
+
 
 /*
 *  Constructor. Set up parameters and initialize weights.
@@ -44,7 +53,8 @@ FtrlReal<T>::FtrlReal(FtrlParams params_in) :
   dt_X_val(nullptr),
   dt_y_val(nullptr),
   nepochs_val(std::numeric_limits<T>::quiet_NaN()),
-  val_error(std::numeric_limits<T>::quiet_NaN())
+  val_error(std::numeric_limits<T>::quiet_NaN()),
+  release_gil(false)
 {
 }
 
@@ -62,13 +72,19 @@ double FtrlReal<T>::dispatch_fit(const DataTable* dt_X_in,
                                  const DataTable* dt_X_val_in,
                                  const DataTable* dt_y_val_in,
                                  double nepochs_val_in,
-                                 double val_error_in) {
+                                 double val_error_in,
+                                 bool release_gil_in) {
+  if (is_finalized()) {
+    throw ValueError() << "This model was finalized for inference and "
+                          "cannot be trained any further";
+  }
   dt_X = dt_X_in;
   dt_y = dt_y_in;
   dt_X_val = dt_X_val_in;
   dt_y_val = dt_y_val_in;
   nepochs_val = static_cast<T>(nepochs_val_in);
   val_error = static_cast<T>(val_error_in);
+  release_gil = release_gil_in;
 
   double epoch;
   SType stype_y = dt_y->columns[0]->stype();
@@ -92,6 +108,7 @@ double FtrlReal<T>::dispatch_fit(const DataTable* dt_X_in,
   dt_y_val = nullptr;
   nepochs_val = std::numeric_limits<T>::quiet_NaN();
   val_error = std::numeric_limits<T>::quiet_NaN();
+  release_gil = false;
   map_val.clear();
 
   return epoch;
@@ -302,81 +319,79 @@ double FtrlReal<T>::fit(T(*linkfn)(T), T(*lossfn)(T,U)) {
   fill_ri_data<U>(dt_y, ri, data);
   if (validation) fill_ri_data<U>(dt_y_val, ri_val, data_val);
   auto data_fi = static_cast<T*>(dt_fi->columns[1]->data_w());
-
+  // The thread pool may be resized while training, so the number of threads
+  // is fixed here, and the workspaces are indexed by task.
+  const size_t nthreads = num_threads_in_pool();
+  std::vector<workspace> wss = create_workspaces(nthreads);
+
+  // The training itself does not touch any python objects, so that other
+  // python threads may run in the meantime, if the caller has allowed this
+  // (see `py::Ftrl::partial_fit()`).
+  std::unique_ptr<py::gil_release> nogil;
+  if (release_gil) nogil.reset(new py::gil_release());
   size_t chunk_end = 0;
   for (size_t c = 0; c < nchunks; ++c) {
     size_t chunk_start = c * chunk_nrows;
     chunk_end = std::min((c + 1) * chunk_nrows, total_nrows);
 
-    dt::run_parallel(
-      [&](size_t i0, size_t i1, size_t di) {
-        uint64ptr x = uint64ptr(new uint64_t[nfeatures]);
-        tptr<T> w = tptr<T>(new T[nfeatures]());
-        tptr<T> fi = tptr<T>(new T[nfeatures]());
-        for (size_t i = chunk_start + i0; i < chunk_start + i1; i += di) {
-          size_t ii = i % dt_X->nrows;
-          const size_t j0 = ri[0][ii];
-          // Note that for FtrlModelType::BINOMIAL and FtrlModelType::REGRESSION
-          // dt_y has only one column that may contain NA's or be a view
-          // with an NA rowindex. For FtrlModelType::MULTINOMIAL we have as many
-          // columns as there are labels, and split_into_nhot() filters out
-          // NA's and can never be a view. Therefore, to ignore NA targets
-          // it is enough to check the condition below for the zero column only.
-          // FIXME: this condition can be removed for FtrlModelType::MULTINOMIAL.
-          if (j0 != RowIndex::NA && !ISNA<U>(data[0][j0])) {
-            hash_row(x, hashers, ii);
-            for (size_t k = 0; k < dt_y->ncols; ++k) {
-              const size_t j = ri[k][ii];
-              T p = linkfn(predict_row(
-                        x, w, k,
-                        [&](size_t f_id, T f_imp) {
-                          data_fi[f_id] += f_imp;
-                        }
-                    ));
-              update(x, w, p, data[k][j], k);
-            }
-          }
-        }
-
-        #pragma omp critical
-        for (size_t i = 0; i < nfeatures; ++i) {
-          data_fi[i] += fi[i];
-        }
-
-
-      },
-      chunk_end - chunk_start
-    );
-
-
-    // Calculate loss on the validation dataset and do early stopping,
-    // if the loss does not improve.
-    if (validation) {
+    if (params.deterministic) {
+      fit_deterministic<U>(chunk_start, chunk_end, hashers, ri, data, linkfn,
+                           data_fi, nthreads);
+    } else {
       dt::run_parallel(
         [&](size_t i0, size_t i1, size_t di) {
-          uint64ptr x = uint64ptr(new uint64_t[nfeatures]);
-          tptr<T> w = tptr<T>(new T[nfeatures]());
-          T loss_local = 0.0;
-
-          for (size_t i = i0; i < i1; i += di) {
-            const size_t j0 = ri_val[0][i];
-            if (j0 != RowIndex::NA && !ISNA<U>(data_val[0][j0])) {
-              hash_row(x, hashers_val, i);
-              for (size_t k = 0; k < dt_y_val->ncols; ++k) {
-                const size_t j = ri_val[k][i];
+          workspace& ws = wss[i0 % di];
+          T* w = ws.w.data();
+          T* fi = ws.fi.data();
+          size_t i = chunk_start + i0;
+          const size_t iend = chunk_start + i1;
+          while (i < iend) {
+            // Collect a block of rows with non-NA targets.
+            // Note that for FtrlModelType::BINOMIAL and
+            // FtrlModelType::REGRESSION dt_y has only one column that may
+            // contain NA's or be a view with an NA rowindex. For
+            // FtrlModelType::MULTINOMIAL we have as many columns as there
+            // are labels, and split_into_nhot() filters out NA's and can
+            // never be a view. Therefore, to ignore NA targets it is enough
+            // to check the condition below for the zero column only.
+            // FIXME: this condition can be removed for MULTINOMIAL.
+            size_t nb = 0;
+            for (; i < iend && nb < HASH_BLOCK_SIZE; i += di) {
+              size_t ii = i % dt_X->nrows;
+              const size_t j0 = ri[0][ii];
+              if (j0 != RowIndex::NA && !ISNA<U>(data[0][j0])) {
+                ws.rows[nb++] = ii;
+              }
+            }
+            hash_rows(ws.x.data(), hashers, ws.rows.data(), nb);
+
+            for (size_t r = 0; r < nb; ++r) {
+              const uint64_t* x = ws.x.data() + r * nfeatures;
+              size_t ii = ws.rows[r];
+              for (size_t k = 0; k < dt_y->ncols; ++k) {
+                const size_t j = ri[k][ii];
                 T p = linkfn(predict_row(
-                        x, w, map_val[k], [&](size_t, T){}
+                          x, w, k,
+                          [&](size_t f_id, T f_imp) {
+                            fi[f_id] += f_imp;
+                          }
                       ));
-
-                loss_local += lossfn(p, data_val[k][j]);
+                update(x, w, p, data[k][j], k);
               }
             }
           }
-          #pragma omp atomic
-          loss_global += loss_local;
         },
-        dt_X_val->nrows
+        chunk_end - chunk_start,
+        nthreads
       );
+    }
+
+
+    // Calculate loss on the validation dataset and do early stopping,
+    // if the loss does not improve.
+    if (validation) {
+      loss_global = validation_loss<U>(hashers_val, ri_val, data_val,
+                                       linkfn, lossfn, nthreads);
 
       T loss_diff = (loss_global_prev - loss_global) / loss_global_prev;
       constexpr T epsilon = std::numeric_limits<T>::epsilon();
@@ -387,17 +402,300 @@ double FtrlReal<T>::fit(T(*linkfn)(T), T(*lossfn)(T,U)) {
       loss_global = 0;
     }
   }
+
+  // Reduce the feature importances accumulated by each thread.
+  for (const workspace& ws : wss) {
+    for (size_t f = 0; f < nfeatures; ++f) {
+      data_fi[f] += ws.fi[f];
+    }
+  }
+
   double epoch_stopped = static_cast<double>(chunk_end) / dt_X->nrows;
   return epoch_stopped;
 }
 
 
+/*
+*  Calculate the total loss of the current model on the validation dataset
+*  `dt_X_val` / `dt_y_val`. The loss is accumulated separately by each task
+*  of `run_parallel()`, and these are then summed up in the order of tasks,
+*  so that the result is reproducible for a given number of threads.
+*/
+template <typename T>
+template <typename U>
+T FtrlReal<T>::validation_loss(const std::vector<hasherptr>& hashers_val,
+                               const std::vector<RowIndex>& ri_val,
+                               const std::vector<const U*>& data_val,
+                               T(*linkfn)(T), T(*lossfn)(T,U),
+                               size_t nthreads) {
+  std::vector<workspace> wss = create_workspaces(nthreads);
+  std::vector<T> loss_tasks(nthreads);
+  dt::run_parallel(
+    [&](size_t i0, size_t i1, size_t di) {
+      workspace& ws = wss[i0 % di];
+      T* w = ws.w.data();
+      T loss_local = 0.0;
+
+      size_t i = i0;
+      while (i < i1) {
+        size_t nb = 0;
+        for (; i < i1 && nb < HASH_BLOCK_SIZE; i += di) {
+          const size_t j0 = ri_val[0][i];
+          if (j0 != RowIndex::NA && !ISNA<U>(data_val[0][j0])) {
+            ws.rows[nb++] = i;
+          }
+        }
+        hash_rows(ws.x.data(), hashers_val, ws.rows.data(), nb);
+
+        for (size_t r = 0; r < nb; ++r) {
+          const uint64_t* x = ws.x.data() + r * nfeatures;
+          size_t ii = ws.rows[r];
+          for (size_t k = 0; k < dt_y_val->ncols; ++k) {
+            const size_t j = ri_val[k][ii];
+            T p = linkfn(predict_row(
+                    x, w, map_val[k], [&](size_t, T){}
+                  ));
+
+            loss_local += lossfn(p, data_val[k][j]);
+          }
+        }
+      }
+      // Each task of `run_parallel()` starts at the row equal to its
+      // index, and then advances in steps that are multiples of `di`.
+      loss_tasks[i0 % di] += loss_local;
+    },
+    dt_X_val->nrows,
+    nthreads
+  );
+  T loss = 0;
+  for (T loss_task : loss_tasks) loss += loss_task;
+  return loss;
+}
+
+
+template <typename T>
+template <typename U>
+T FtrlReal<T>::validation_loss(const std::vector<hasherptr>& hashers_val,
+                               T(*linkfn)(T), T(*lossfn)(T,U)) {
+  std::vector<RowIndex> ri_val;
+  std::vector<const U*> data_val;
+  fill_ri_data<U>(dt_y_val, ri_val, data_val);
+  return validation_loss<U>(hashers_val, ri_val, data_val, linkfn, lossfn,
+                            num_threads_in_pool());
+}
+
+
+/*
+*  Calculate the loss of the current model on a validation dataset, using
+*  the same loss functions as the early stopping in `fit()`. This allows
+*  doing early stopping across several calls to `fit()`, for example when
+*  the model is trained on a stream of batches.
+*/
+template <typename T>
+double FtrlReal<T>::dispatch_loss(const DataTable* dt_X_val_in,
+                                  const DataTable* dt_y_val_in) {
+  if (model_type == FtrlModelType::NONE) {
+    throw ValueError() << "To calculate the validation loss, the model "
+                          "should be trained first";
+  }
+  // `hash_rows()` takes the number of columns from `dt_X`
+  dt_X = dt_X_val_in;
+  dt_X_val = dt_X_val_in;
+  dt_y_val = dt_y_val_in;
+  init_weights();
+  auto hashers_val = create_hashers(dt_X_val);
+
+  T loss;
+  dtptr dt_y_val_filtered;
+  SType stype_y = dt_y_val->columns[0]->stype();
+  if (model_type == FtrlModelType::MULTINOMIAL) {
+    dt_y_val_filtered = create_y_val();
+    dt_y_val = dt_y_val_filtered.get();
+    loss = validation_loss<int8_t>(hashers_val, sigmoid<T>, log_loss<T>);
+  } else {
+    map_val = {0};
+    switch (stype_y) {
+      case SType::BOOL:    loss = validation_loss<int8_t>(hashers_val,
+                                    sigmoid<T>, log_loss<T>); break;
+      case SType::INT8:    loss = validation_loss<int8_t>(hashers_val,
+                                    identity<T>, squared_loss<T, int8_t>);
+                           break;
+      case SType::INT16:   loss = validation_loss<int16_t>(hashers_val,
+                                    identity<T>, squared_loss<T, int16_t>);
+                           break;
+      case SType::INT32:   loss = validation_loss<int32_t>(hashers_val,
+                                    identity<T>, squared_loss<T, int32_t>);
+                           break;
+      case SType::INT64:   loss = validation_loss<int64_t>(hashers_val,
+                                    identity<T>, squared_loss<T, int64_t>);
+                           break;
+      case SType::FLOAT32: loss = validation_loss<float>(hashers_val,
+                                    identity<T>, squared_loss<T, float>);
+                           break;
+      case SType::FLOAT64: loss = validation_loss<double>(hashers_val,
+                                    identity<T>, squared_loss<T, double>);
+                           break;
+      default:             throw TypeError() << "Targets of type `"
+                                             << stype_y << "` are not supported";
+    }
+  }
+
+  dt_X = nullptr;
+  dt_X_val = nullptr;
+  dt_y_val = nullptr;
+  map_val.clear();
+  return static_cast<double>(loss);
+}
+
+
+/*
+*  Deterministic training on the rows `[chunk_start; chunk_end)`. The rows
+*  are processed in blocks, and each block is handled in the following
+*  parallel steps:
+*   1) hash the rows of the block, and bucket the hashed features by the
+*      shard of their bin: the bins are split into contiguous shards, one
+*      per thread. Within each shard, the features keep the order of rows
+*      and, within a row, the order of features;
+*   2) for each group of labels, make predictions using the model
+*      coefficients as they were at the start of the block, and then update
+*      the coefficients: each thread goes over the features of its own
+*      shard only. Likewise, each thread accumulates the importances of its
+*      own range of features.
+*  Thus, every model coefficient and every feature importance is updated by
+*  a single thread, in the same order on every run, without any locks or
+*  atomics. The resulting model does not depend on the number of threads.
+*/
+template <typename T>
+template <typename U>
+void FtrlReal<T>::fit_deterministic(size_t chunk_start, size_t chunk_end,
+                                    const std::vector<hasherptr>& hashers,
+                                    const std::vector<RowIndex>& ri,
+                                    const std::vector<const U*>& data,
+                                    T(*linkfn)(T), T* data_fi,
+                                    size_t nth) {
+  // Blocks are never larger than the training frame, so that a block does
+  // not contain the same row more than once (coefficients are not updated
+  // within a block).
+  const size_t nblock = std::min(DETERMINISTIC_BLOCK_SIZE, dt_X->nrows);
+  const size_t nlabels = dt_y->ncols;
+  const size_t ngroup = std::min(DETERMINISTIC_LABEL_GROUP, nlabels);
+  sizetvec rows(nblock);
+  std::vector<uint64_t> x(nblock * nfeatures);
+  std::vector<T> w(nblock * ngroup * nfeatures);
+  std::vector<T> g(nblock * ngroup);
+  // Positions `r * nfeatures + f` of the hashed features of a block, ordered
+  // by shard. `offsets[t * nth + s]` is first the number of features from
+  // the `t`-th part of the block that fall into the shard `s`, and then the
+  // position in `entries` where these features are written.
+  sizetvec entries(nblock * nfeatures);
+  sizetvec offsets(nth * nth);
+  sizetvec shard_start(nth + 1);
+  T ia = 1 / alpha;
+
+  auto part = [=](size_t n, size_t t) -> size_t { return n * t / nth; };
+  auto shard = [=](uint64_t j) -> size_t {
+    return static_cast<size_t>(j * nth / nbins);
+  };
+
+  size_t i = chunk_start;
+  while (i < chunk_end) {
+    size_t nb = 0;
+    for (; i < chunk_end && nb < nblock; ++i) {
+      size_t ii = i % dt_X->nrows;
+      const size_t j0 = ri[0][ii];
+      if (j0 != RowIndex::NA && !ISNA<U>(data[0][j0])) {
+        rows[nb++] = ii;
+      }
+    }
+
+    dt::parallel_for_static(nth, nth,
+      [&](size_t t0, size_t t1) {
+        for (size_t t = t0; t < t1; ++t) {
+          size_t r0 = part(nb, t);
+          size_t r1 = part(nb, t + 1);
+          hash_rows(x.data() + r0 * nfeatures, hashers, rows.data() + r0,
+                    r1 - r0);
+          size_t* counts = offsets.data() + t * nth;
+          std::fill(counts, counts + nth, 0);
+          for (size_t e = r0 * nfeatures; e < r1 * nfeatures; ++e) {
+            counts[shard(x[e])]++;
+          }
+        }
+      });
+
+    size_t total = 0;
+    for (size_t s = 0; s < nth; ++s) {
+      shard_start[s] = total;
+      for (size_t t = 0; t < nth; ++t) {
+        size_t count = offsets[t * nth + s];
+        offsets[t * nth + s] = total;
+        total += count;
+      }
+    }
+    shard_start[nth] = total;
+
+    dt::parallel_for_static(nth, nth,
+      [&](size_t t0, size_t t1) {
+        for (size_t t = t0; t < t1; ++t) {
+          size_t* pos = offsets.data() + t * nth;
+          size_t e1 = part(nb, t + 1) * nfeatures;
+          for (size_t e = part(nb, t) * nfeatures; e < e1; ++e) {
+            entries[pos[shard(x[e])]++] = e;
+          }
+        }
+      });
+
+    for (size_t k0 = 0; k0 < nlabels; k0 += ngroup) {
+      const size_t nk = std::min(ngroup, nlabels - k0);
+
+      dt::parallel_for_static(nb, nth,
+        [&](size_t r0, size_t r1) {
+          for (size_t r = r0; r < r1; ++r) {
+            size_t ii = rows[r];
+            for (size_t k = 0; k < nk; ++k) {
+              size_t rk = r * nk + k;
+              T p = linkfn(predict_row(x.data() + r * nfeatures,
+                                       w.data() + rk * nfeatures,
+                                       k0 + k, [&](size_t, T){}));
+              g[rk] = p - static_cast<T>(data[k0 + k][ri[k0 + k][ii]]);
+            }
+          }
+        });
+
+      dt::parallel_for_static(nth, nth,
+        [&](size_t t0, size_t t1) {
+          for (size_t t = t0; t < t1; ++t) {
+            for (size_t e = shard_start[t]; e < shard_start[t + 1]; ++e) {
+              size_t pos = entries[e];
+              size_t r = pos / nfeatures;
+              size_t f = pos % nfeatures;
+              for (size_t k = 0; k < nk; ++k) {
+                size_t rk = r * nk + k;
+                update_bin(k0 + k, x[pos], g[rk], g[rk] * g[rk],
+                           w[rk * nfeatures + f], ia);
+              }
+            }
+            size_t f0 = part(nfeatures, t);
+            size_t f1 = part(nfeatures, t + 1);
+            for (size_t rk = 0; rk < nb * nk; ++rk) {
+              const T* wrk = w.data() + rk * nfeatures;
+              for (size_t f = f0; f < f1; ++f) {
+                data_fi[f] += std::abs(wrk[f]);
+              }
+            }
+          }
+        });
+    }
+  }
+}
+
+
 /*
 *  Make a prediction for an array of hashed features.
 */
 template <typename T>
 template <typename F>
-T FtrlReal<T>::predict_row(const uint64ptr& x, tptr<T>& w, size_t k, F fifn) {
+T FtrlReal<T>::predict_row(const uint64_t* x, T* w, size_t k, F fifn) {
   T zero = static_cast<T>(0.0);
   T wTx = zero;
   T ia = 1 / alpha;
@@ -419,20 +717,30 @@ T FtrlReal<T>::predict_row(const uint64ptr& x, tptr<T>& w, size_t k, F fifn) {
 */
 template <typename T>
 template <typename U /* column data type */>
-void FtrlReal<T>::update(const uint64ptr& x, const tptr<T>& w,
+void FtrlReal<T>::update(const uint64_t* x, const T* w,
                          T p, U y, size_t k) {
   T ia = 1 / alpha;
   T g = p - static_cast<T>(y);
   T gsq = g * g;
   for (size_t i = 0; i < nfeatures; ++i) {
-    size_t j = x[i];
-    T sigma = (std::sqrt(n[k][j] + gsq) - std::sqrt(n[k][j])) * ia;
-    z[k][j] += g - sigma * w[i];
-    n[k][j] += gsq;
+    update_bin(k, x[i], g, gsq, w[i], ia);
   }
 }
 
 
+/*
+*  Update the coefficients of bin `j` for the `k`-th label, given the
+*  gradient `g` (and its square `gsq`), and the feature's weight `wi`.
+*/
+template <typename T>
+inline void FtrlReal<T>::update_bin(size_t k, size_t j, T g, T gsq, T wi,
+                                    T ia) {
+  T sigma = (std::sqrt(n[k][j] + gsq) - std::sqrt(n[k][j])) * ia;
+  z[k][j] += g - sigma * wi;
+  n[k][j] += gsq;
+}
+
+
 /*
 *  Predict on a datatable and return a new datatable with
 *  the predicted probabilities.
@@ -444,7 +752,8 @@ dtptr FtrlReal<T>::predict(const DataTable* dt_X_in) {
                           "first";
   }
   dt_X = dt_X_in;
-  init_weights();
+  bool finalized = is_finalized();
+  if (!finalized) init_weights();
 
   // Re-create hashers, as stypes for predictions may be different.
   auto hashers = create_hashers(dt_X);
@@ -469,20 +778,44 @@ dtptr FtrlReal<T>::predict(const DataTable* dt_X_in) {
                                  << "the model was trained in an unknown mode";
   }
 
+  const size_t nthreads = num_threads_in_pool();
+  std::vector<workspace> wss = create_workspaces(nthreads);
   dt::run_parallel(
     [&](size_t i0, size_t i1, size_t di) {
-      uint64ptr x = uint64ptr(new uint64_t[nfeatures]);
-      tptr<T> w = tptr<T>(new T[nfeatures]);
+      workspace& ws = wss[i0 % di];
+      T* w = ws.w.data();
+
+      size_t i = i0;
+      while (i < i1) {
+        size_t nb = 0;
+        for (; i < i1 && nb < HASH_BLOCK_SIZE; i += di) {
+          ws.rows[nb++] = i;
+        }
+        hash_rows(ws.x.data(), hashers, ws.rows.data(), nb);
+
+        if (finalized) {
+          predict_block(ws.x.data(), nb, ws.p.data());
+          for (size_t r = 0; r < nb; ++r) {
+            size_t ii = ws.rows[r];
+            for (size_t k = 0; k < nlabels; ++k) {
+              data_p[k][ii] = linkfn(ws.p[r * nlabels + k]);
+            }
+          }
+          continue;
+        }
 
-      for (size_t i = i0; i < i1; i += di) {
-        hash_row(x, hashers, i);
-        for (size_t k = 0; k < nlabels; ++k) {
-          data_p[k][i] = linkfn(predict_row(x, w, k, [&](size_t, T){}));
+        for (size_t r = 0; r < nb; ++r) {
+          const uint64_t* x = ws.x.data() + r * nfeatures;
+          size_t ii = ws.rows[r];
+          for (size_t k = 0; k < nlabels; ++k) {
+            data_p[k][ii] = linkfn(predict_row(x, w, k, [&](size_t, T){}));
+          }
         }
       }
 
     },
-    dt_X->nrows
+    dt_X->nrows,
+    nthreads
   );
 
   // For multinomial case, when there is two labels, we match binomial
@@ -495,6 +828,89 @@ dtptr FtrlReal<T>::predict(const DataTable* dt_X_in) {
 }
 
 
+/*
+*  Batch scoring kernel of a finalized model: calculate raw predictions
+*  for all the labels for a block of `nb` hashed rows, and store them
+*  in `p` as a row-major matrix of shape nb x nlabels. For each feature
+*  there is a single lookup in the weights table, the features that fall
+*  into the bins with zero weights are skipped.
+*/
+template <typename T>
+void FtrlReal<T>::predict_block(const uint64_t* x, size_t nb, T* p) {
+  size_t nlabels = fweights.get_nlabels();
+  std::fill(p, p + nb * nlabels, static_cast<T>(0.0));
+  for (size_t r = 0; r < nb; ++r) {
+    const uint64_t* xr = x + r * nfeatures;
+    T* pr = p + r * nlabels;
+    for (size_t i = 0; i < nfeatures; ++i) {
+      const T* w = fweights.find(xr[i]);
+      if (w == nullptr) continue;
+      for (size_t k = 0; k < nlabels; ++k) {
+        pr[k] += w[k];
+      }
+    }
+  }
+}
+
+
+/*
+*  Finalize the model for inference: calculate the weights for all the
+*  bins once, and keep only the bins that have a non-zero weight for at
+*  least one of the labels. With L1 regularization, or when `nbins` is much
+*  larger than the number of distinct features, this is a small fraction
+*  of all the bins. The `z` and `n` coefficients are then released, so
+*  the model cannot be trained any further.
+*/
+template <typename T>
+void FtrlReal<T>::finalize() {
+  if (model_type == FtrlModelType::NONE) {
+    throw ValueError() << "To finalize the model, it should be trained first";
+  }
+  if (is_finalized()) return;
+  init_weights();
+
+  size_t nlabels = z.size();
+  T zero = static_cast<T>(0.0);
+  T ia = 1 / alpha;
+  T rr = beta * ia + lambda2;
+  // The weights are calculated in the same way as in `predict_row()`,
+  // so that a finalized model makes exactly the same predictions.
+  auto weight = [&](size_t k, size_t j) -> T {
+    T absw = std::max(std::abs(z[k][j]) - lambda1, zero) /
+             (std::sqrt(n[k][j]) * ia + rr);
+    return -std::copysign(absw, z[k][j]);
+  };
+
+  std::vector<uint64_t> bins_used;
+  for (size_t j = 0; j < nbins; ++j) {
+    for (size_t k = 0; k < nlabels; ++k) {
+      if (weight(k, j) != zero) {
+        bins_used.push_back(j);
+        break;
+      }
+    }
+  }
+
+  FtrlWeights<T> weights(bins_used.size(), nlabels);
+  std::vector<T> w(nlabels);
+  for (uint64_t j : bins_used) {
+    for (size_t k = 0; k < nlabels; ++k) w[k] = weight(k, j);
+    weights.insert(j, w.data());
+  }
+  fweights = std::move(weights);
+
+  dt_model = nullptr;
+  z.clear();
+  n.clear();
+}
+
+
+template <typename T>
+bool FtrlReal<T>::is_finalized() {
+  return !fweights.empty();
+}
+
+
 /*
 * Obtain pointers to column rowindexes and data.
 */
@@ -611,6 +1027,7 @@ dtptr FtrlReal<T>::create_p(size_t nrows) {
 template <typename T>
 void FtrlReal<T>::reset() {
   dt_model = nullptr;
+  fweights = FtrlWeights<T>();
   dt_fi = nullptr;
   model_type = FtrlModelType::NONE;
   labels.clear();
@@ -761,33 +1178,73 @@ hasherptr FtrlReal<T>::create_hasher(const Column* col) {
 
 
 /*
-*  Hash each element of the datatable row, do feature interactions if requested.
+*  Hash a block of `n` rows into the row-major matrix `x` of shape
+*  `n x nfeatures`, and do feature interactions if requested. The hashing
+*  is done column-by-column, so that each hasher is invoked once per block.
 */
 template <typename T>
-void FtrlReal<T>::hash_row(uint64ptr& x, std::vector<hasherptr>& hashers,
-                           size_t row) {
+void FtrlReal<T>::hash_rows(uint64_t* x, const std::vector<hasherptr>& hashers,
+                            const size_t* rows, size_t n) {
+  size_t ncols = dt_X->ncols;
   // Hash column values adding a column name hash, so that the same value
   // in different columns results in different hashes.
-  for (size_t i = 0; i < dt_X->ncols; ++i) {
-    x[i] = (hashers[i]->hash(row) + colname_hashes[i]) % nbins;
+  for (size_t i = 0; i < ncols; ++i) {
+    hashers[i]->hash_block(rows, n, colname_hashes[i], x + i, nfeatures);
+  }
+
+  // Reduce the hashes modulo `nbins`. When `nbins` is a power of two, this
+  // is a simple bit mask, which the compiler is able to vectorize.
+  if ((nbins & (nbins - 1)) == 0) {
+    uint64_t mask = nbins - 1;
+    for (size_t r = 0; r < n; ++r) {
+      uint64_t* xr = x + r * nfeatures;
+      for (size_t i = 0; i < ncols; ++i) xr[i] &= mask;
+    }
+  } else {
+    for (size_t r = 0; r < n; ++r) {
+      uint64_t* xr = x + r * nfeatures;
+      for (size_t i = 0; i < ncols; ++i) xr[i] %= nbins;
+    }
   }
 
   // Do feature interactions.
   if (interactions.size() > 0) {
-    size_t count = 0;
-    for (auto interaction : interactions) {
-      size_t i = dt_X->ncols + count;
-      x[i] = 0;
-      for (auto feature_id : interaction) {
-        x[i] += x[feature_id];
+    for (size_t r = 0; r < n; ++r) {
+      uint64_t* xr = x + r * nfeatures;
+      size_t count = 0;
+      for (const auto& interaction : interactions) {
+        size_t i = ncols + count;
+        xr[i] = 0;
+        for (auto feature_id : interaction) {
+          xr[i] += xr[feature_id];
+        }
+        xr[i] %= nbins;
+        count++;
       }
-      x[i] %= nbins;
-      count++;
     }
   }
 }
 
 
+/*
+*  Create buffers for each of the `nthreads` tasks of a parallel region,
+*  see `workspace`.
+*/
+template <typename T>
+std::vector<typename FtrlReal<T>::workspace>
+FtrlReal<T>::create_workspaces(size_t nthreads) {
+  std::vector<workspace> wss(nthreads);
+  for (workspace& ws : wss) {
+    ws.rows.resize(HASH_BLOCK_SIZE);
+    ws.x.resize(HASH_BLOCK_SIZE * nfeatures);
+    ws.w.resize(nfeatures);
+    ws.fi.resize(nfeatures);
+    ws.p.resize(HASH_BLOCK_SIZE * labels.size());
+  }
+  return wss;
+}
+
+
 /*
 *  Return training status.
 */
@@ -846,6 +1303,49 @@ DataTable* FtrlReal<T>::get_fi(bool normalize /* = true */) {
 }
 
 
+/*
+*  Get the weights of a finalized model as a datatable of shape
+*  (nbins_used, nlabels + 1): the first column contains the bin indices
+*  in the ascending order, and the rest contain the weights for each label.
+*/
+template <typename T>
+DataTable* FtrlReal<T>::get_weights() {
+  if (!is_finalized()) return nullptr;
+
+  size_t nrows = fweights.size();
+  size_t nlabels = fweights.get_nlabels();
+  std::vector<std::pair<uint64_t, const T*>> entries;
+  entries.reserve(nrows);
+  fweights.for_each([&](uint64_t bin, const T* w) {
+    entries.push_back({bin, w});
+  });
+  std::sort(entries.begin(), entries.end(),
+            [](const std::pair<uint64_t, const T*>& a,
+               const std::pair<uint64_t, const T*>& b) {
+              return a.first < b.first;
+            });
+
+  colvec cols(nlabels + 1);
+  cols[0] = Column::new_data_column(SType::INT64, nrows);
+  auto data_bins = static_cast<int64_t*>(cols[0]->data_w());
+  std::vector<T*> data_w(nlabels);
+  for (size_t k = 0; k < nlabels; ++k) {
+    cols[k + 1] = new RealColumn<T>(nrows);
+    data_w[k] = static_cast<T*>(cols[k + 1]->data_w());
+  }
+  for (size_t i = 0; i < nrows; ++i) {
+    data_bins[i] = static_cast<int64_t>(entries[i].first);
+    for (size_t k = 0; k < nlabels; ++k) {
+      data_w[k][i] = entries[i].second[k];
+    }
+  }
+
+  strvec names(1, "bin");
+  names.insert(names.end(), labels.begin(), labels.end());
+  return new DataTable(std::move(cols), names);
+}
+
+
 /*
 *  Other getters and setters.
 *  Here we assume that all the validation for setters is done by py::Ftrl.
@@ -916,6 +1416,12 @@ bool FtrlReal<T>::get_double_precision() {
 }
 
 
+template <typename T>
+bool FtrlReal<T>::get_deterministic() {
+  return params.deterministic;
+}
+
+
 template <typename T>
 FtrlParams FtrlReal<T>::get_params() {
   return params;
@@ -930,6 +1436,7 @@ const strvec& FtrlReal<T>::get_labels() {
 
 template <typename T>
 void FtrlReal<T>::set_model(DataTable* dt_model_in) {
+  fweights = FtrlWeights<T>();
   dt_model = dtptr(dt_model_in->copy());
   set_nbins(dt_model->nrows);
   nfeatures = 0;
@@ -949,6 +1456,31 @@ void FtrlReal<T>::set_fi(DataTable* dt_fi_in) {
 }
 
 
+/*
+*  Restore a finalized model from the datatable produced by `get_weights()`.
+*/
+template <typename T>
+void FtrlReal<T>::set_weights(DataTable* dt_weights) {
+  xassert(dt_weights->ncols > 1);
+  size_t nrows = dt_weights->nrows;
+  size_t nlabels = dt_weights->ncols - 1;
+  auto data_bins = static_cast<const int64_t*>(dt_weights->columns[0]->data());
+  std::vector<const T*> data_w(nlabels);
+  for (size_t k = 0; k < nlabels; ++k) {
+    data_w[k] = static_cast<const T*>(dt_weights->columns[k + 1]->data());
+  }
+
+  FtrlWeights<T> weights(nrows, nlabels);
+  std::vector<T> w(nlabels);
+  for (size_t i = 0; i < nrows; ++i) {
+    for (size_t k = 0; k < nlabels; ++k) w[k] = data_w[k][i];
+    weights.insert(static_cast<uint64_t>(data_bins[i]), w.data());
+  }
+  fweights = std::move(weights);
+  dt_model = nullptr;
+}
+
+
 template <typename T>
 void FtrlReal<T>::set_alpha(double alpha_in) {
   params.alpha = alpha_in;
@@ -1002,6 +1534,12 @@ void FtrlReal<T>::set_double_precision(bool double_precision_in) {
 }
 
 
+template <typename T>
+void FtrlReal<T>::set_deterministic(bool deterministic_in) {
+  params.deterministic = deterministic_in;
+}
+
+
 template <typename T>
 void FtrlReal<T>::set_labels(strvec labels_in) {
   labels = labels_in;
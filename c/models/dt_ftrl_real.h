@@ -26,6 +26,7 @@
 #include "models/column_hasher.h"
 #include "models/utils.h"
 #include "models/dt_ftrl.h"
+#include "models/ftrl_weights.h"
 
 
 namespace dt {
@@ -43,6 +44,11 @@ class FtrlReal : public dt::Ftrl {
     std::vector<T*> z, n;
     FtrlModelType model_type;
 
+    // Precomputed non-zero weights of a model finalized for inference.
+    // When these are present, `dt_model` is released, and the model
+    // can only be used for predictions.
+    FtrlWeights<T> fweights;
+
     // Feature importances datatable of shape (nfeatures, 2),
     // where the first column contains feature names and the second one
     // feature importance values.
@@ -79,24 +85,65 @@ class FtrlReal : public dt::Ftrl {
     // Other temporary parameters that might need for validation.
     T nepochs_val;
     T val_error;
+    bool release_gil;
     std::vector<size_t> map_val;
 
+    // Rows are hashed in blocks of this size, column-by-column, before
+    // running predictions / updates on each row of the block.
+    static constexpr size_t HASH_BLOCK_SIZE = 256;
+
+    // Maximum number of rows processed in a single block during the
+    // deterministic training, see `fit_deterministic()`.
+    static constexpr size_t DETERMINISTIC_BLOCK_SIZE = 1024;
+
+    // Maximum number of labels whose predictions and weights are buffered
+    // at once during the deterministic training.
+    static constexpr size_t DETERMINISTIC_LABEL_GROUP = 8;
+
+    // Per-thread buffers for the hashed features of a block of rows
+    // (a row-major matrix of shape HASH_BLOCK_SIZE x nfeatures), the row
+    // indices of that block, the weights, the feature importances, and
+    // the raw predictions of a finalized model for that block.
+    // These are allocated once per `fit()` / `predict()` call.
+    struct workspace {
+      std::vector<size_t> rows;
+      std::vector<uint64_t> x;
+      std::vector<T> w;
+      std::vector<T> fi;
+      std::vector<T> p;
+    };
+
     // Fitting methods
     double fit_binomial();
     double fit_multinomial();
     template <typename U> double fit_regression();
     template <typename U> double fit(T(*)(T), T(*)(T, U));
     template <typename U>
-    void update(const uint64ptr&, const tptr<T>&, T, U, size_t);
+    T validation_loss(const std::vector<hasherptr>&,
+                      const std::vector<RowIndex>&,
+                      const std::vector<const U*>&, T(*)(T), T(*)(T, U),
+                      size_t);
+    template <typename U>
+    T validation_loss(const std::vector<hasherptr>&, T(*)(T), T(*)(T, U));
+    template <typename U>
+    void fit_deterministic(size_t, size_t, const std::vector<hasherptr>&,
+                           const std::vector<RowIndex>&,
+                           const std::vector<const U*>&, T(*)(T), T*, size_t);
+    template <typename U>
+    void update(const uint64_t*, const T*, T, U, size_t);
+    void update_bin(size_t, size_t, T, T, T, T);
 
     // Predicting methods
-    template <typename F> T predict_row(const uint64ptr&, tptr<T>&, size_t, F);
+    template <typename F> T predict_row(const uint64_t*, T*, size_t, F);
+    void predict_block(const uint64_t*, size_t, T*);
     dtptr create_p(size_t);
 
     // Hashing methods
     std::vector<hasherptr> create_hashers(const DataTable*);
     static hasherptr create_hasher(const Column*);
-    void hash_row(uint64ptr&, std::vector<hasherptr>&, size_t);
+    void hash_rows(uint64_t*, const std::vector<hasherptr>&,
+                   const size_t*, size_t);
+    std::vector<workspace> create_workspaces(size_t nthreads);
 
     // Model helper methods
     void create_model();
@@ -125,18 +172,24 @@ class FtrlReal : public dt::Ftrl {
     // Main fitting method
     double dispatch_fit(const DataTable*, const DataTable*,
                         const DataTable*, const DataTable*,
-                        double, double) override;
+                        double, double, bool) override;
 
     // Main predicting method
     dtptr predict(const DataTable*) override;
 
+    // Loss on a validation dataset
+    double dispatch_loss(const DataTable*, const DataTable*) override;
+
     // Model methods
     void reset() override;
     bool is_trained() override;
+    void finalize() override;
+    bool is_finalized() override;
 
     // Getters
     DataTable* get_model() override;
     DataTable* get_fi(bool normalize = true) override;
+    DataTable* get_weights() override;
     FtrlModelType get_model_type() override;
     size_t get_nfeatures() override;
     size_t get_ncols() override;
@@ -149,12 +202,14 @@ class FtrlReal : public dt::Ftrl {
     size_t get_nepochs() override;
     const std::vector<sizetvec>& get_interactions() override;
     bool get_double_precision() override;
+    bool get_deterministic() override;
     FtrlParams get_params() override;
     const strvec& get_labels() override;
 
     // Setters
     void set_model(DataTable*) override;
     void set_fi(DataTable*) override;
+    void set_weights(DataTable*) override;
     void set_model_type(FtrlModelType) override;
     void set_alpha(double) override;
     void set_beta(double) override;
@@ -164,6 +219,7 @@ class FtrlReal : public dt::Ftrl {
     void set_nepochs(size_t) override;
     void set_interactions(std::vector<sizetvec>) override;
     void set_double_precision(bool) override;
+    void set_deterministic(bool) override;
     void set_labels(strvec) override;
 };
 
@@ -0,0 +1,242 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_MODELS_EXEMPLAR_INDEX_h
+#define dt_MODELS_EXEMPLAR_INDEX_h
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "types.h"
+
+
+/*
+*  Spatial index of the ND aggregator exemplars, used to find an exemplar
+*  within a distance `delta` of a given member.
+*
+*  The exemplars are projected onto a unit vector `u`. Since
+*  |u.(a - b)| <= |a - b|, only the exemplars whose projection is within
+*  `sqrt(delta)` of the member's projection can be within `delta` of it,
+*  so keeping the exemplars sorted by their projections allows to test
+*  just a window of them. Initially `u` is random, and it is then replaced
+*  by the principal direction of the gathered exemplars, along which
+*  their projections are spread the most, see `update_direction()`.
+*
+*  This bound does not hold when some coordinates are missing, because the
+*  distance is then rescaled by the number of non-missing coordinates.
+*  Therefore, the exemplars with missing coordinates are kept in a separate
+*  list that is always scanned fully, and a member with missing coordinates
+*  is tested against all exemplars.
+*/
+template <typename T>
+class ExemplarIndex {
+  public:
+    static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+  private:
+    struct group {
+      std::vector<size_t> ids;
+      std::vector<T> proj;     // only for the complete exemplars
+      std::vector<T> coords;   // ndims coordinates per exemplar
+
+      void insert(size_t pos, size_t id, const T* x, size_t ndims) {
+        ids.insert(ids.begin() + static_cast<long>(pos), id);
+        coords.insert(coords.begin() + static_cast<long>(pos * ndims),
+                      x, x + ndims);
+      }
+
+      void clear() {
+        ids.clear();
+        proj.clear();
+        coords.clear();
+      }
+    };
+
+    size_t ndims;
+    std::vector<T> direction;
+    group complete;
+    group incomplete;
+
+  public:
+    ExemplarIndex(size_t ndims_in, unsigned int seed) : ndims(ndims_in) {
+      std::default_random_engine generator(seed);
+      std::normal_distribution<T> distribution(0.0, 1.0);
+      direction.resize(ndims);
+      T norm = 0;
+      for (size_t d = 0; d < ndims; ++d) {
+        direction[d] = distribution(generator);
+        norm += direction[d] * direction[d];
+      }
+      norm = std::sqrt(norm);
+      for (size_t d = 0; d < ndims; ++d) direction[d] /= norm;
+    }
+
+    size_t size() const {
+      return complete.ids.size() + incomplete.ids.size();
+    }
+
+    void clear() {
+      complete.clear();
+      incomplete.clear();
+    }
+
+    void add(size_t id, const T* x) {
+      T p = project(x);
+      if (ISNA<T>(p)) {
+        incomplete.insert(incomplete.ids.size(), id, x, ndims);
+      } else {
+        auto it = std::upper_bound(complete.proj.begin(),
+                                   complete.proj.end(), p);
+        size_t pos = static_cast<size_t>(it - complete.proj.begin());
+        complete.proj.insert(it, p);
+        complete.insert(pos, id, x, ndims);
+      }
+    }
+
+
+    /*
+    *  Find an exemplar within the distance `delta` of the member `x`, and
+    *  return its id, or NONE if there is no such exemplar. The candidate
+    *  exemplars are tested in a cyclic order starting from a position
+    *  determined by `start`, this distributes the members more uniformly
+    *  among the exemplars, when several of them are within `delta`.
+    */
+    size_t find(const T* x, T delta, uint64_t start) const {
+      T p = project(x);
+      size_t lo = 0;
+      size_t hi = complete.ids.size();
+      if (!ISNA<T>(p)) {
+        // Widen the window slightly to account for the rounding errors
+        T r = std::sqrt(delta) * static_cast<T>(1.001) +
+              std::numeric_limits<T>::epsilon();
+        lo = static_cast<size_t>(
+               std::lower_bound(complete.proj.begin(), complete.proj.end(),
+                                p - r) - complete.proj.begin());
+        hi = static_cast<size_t>(
+               std::upper_bound(complete.proj.begin() + static_cast<long>(lo),
+                                complete.proj.end(), p + r)
+               - complete.proj.begin());
+      }
+      size_t res = find_in(complete, x, delta, lo, hi, start);
+      if (res == NONE) {
+        res = find_in(incomplete, x, delta, 0, incomplete.ids.size(), start);
+      }
+      return res;
+    }
+
+
+    /*
+    *  Replace the projection direction with the principal direction of
+    *  the complete exemplars, found by a few power iterations over their
+    *  covariance matrix, and re-sort the exemplars accordingly.
+    */
+    void update_direction() {
+      size_t n = complete.ids.size();
+      if (n < 2) return;
+      std::vector<T> mean(ndims, 0);
+      for (size_t j = 0; j < n; ++j) {
+        const T* c = complete.coords.data() + j * ndims;
+        for (size_t d = 0; d < ndims; ++d) mean[d] += c[d];
+      }
+      for (size_t d = 0; d < ndims; ++d) mean[d] /= static_cast<T>(n);
+
+      std::vector<T> v(direction);
+      std::vector<T> vnew(ndims);
+      for (size_t iter = 0; iter < 10; ++iter) {
+        std::fill(vnew.begin(), vnew.end(), static_cast<T>(0));
+        for (size_t j = 0; j < n; ++j) {
+          const T* c = complete.coords.data() + j * ndims;
+          T dot = 0;
+          for (size_t d = 0; d < ndims; ++d) dot += (c[d] - mean[d]) * v[d];
+          for (size_t d = 0; d < ndims; ++d) vnew[d] += (c[d] - mean[d]) * dot;
+        }
+        T norm = 0;
+        for (size_t d = 0; d < ndims; ++d) norm += vnew[d] * vnew[d];
+        norm = std::sqrt(norm);
+        // All the exemplars coincide in the subspace spanned by `v`
+        if (!(norm > 0)) return;
+        for (size_t d = 0; d < ndims; ++d) v[d] = vnew[d] / norm;
+      }
+      direction = std::move(v);
+
+      group old = std::move(complete);
+      complete.clear();
+      for (size_t j = 0; j < n; ++j) {
+        add(old.ids[j], old.coords.data() + j * ndims);
+      }
+    }
+
+
+  private:
+    T project(const T* x) const {
+      T p = 0;
+      for (size_t d = 0; d < ndims; ++d) p += direction[d] * x[d];
+      return p;
+    }
+
+
+    size_t find_in(const group& g, const T* x, T delta, size_t lo, size_t hi,
+                   uint64_t start) const
+    {
+      size_t n = hi - lo;
+      if (n == 0) return NONE;
+      size_t i0 = lo + start % n;
+      // Test the ranges [i0, hi) and then [lo, i0)
+      for (size_t j = i0; j < hi; ++j) {
+        if (is_within(g.coords.data() + j * ndims, x, delta)) return g.ids[j];
+      }
+      for (size_t j = lo; j < i0; ++j) {
+        if (is_within(g.coords.data() + j * ndims, x, delta)) return g.ids[j];
+      }
+      return NONE;
+    }
+
+
+    /*
+    *  Check whether the distance between `c` and `x`, calculated in the
+    *  same way as `Aggregator<T>::calculate_distance()` does, is less than
+    *  `delta`. The missing coordinates are skipped, and the sum is then
+    *  scaled by `ndims / n`, where `n` is the number of the coordinates
+    *  present in both points. Since this factor is at least 1, we can stop
+    *  once the partial sum exceeds `delta`; this is checked every 4 dims
+    *  in order to keep the inner loop free of branches.
+    */
+    bool is_within(const T* c, const T* x, T delta) const {
+      T sum = 0;
+      size_t n = 0;
+      for (size_t d = 0; d < ndims; ++d) {
+        T diff = x[d] - c[d];
+        bool present = (diff == diff);
+        sum += present? diff * diff : 0;
+        n += present;
+        if ((d & 3) == 3 && sum > delta) return false;
+      }
+      return sum * static_cast<T>(ndims) / static_cast<T>(n) < delta;
+    }
+};
+
+template <typename T>
+constexpr size_t ExemplarIndex<T>::NONE;
+
+
+#endif
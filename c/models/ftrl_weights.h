@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_MODELS_FTRL_WEIGHTS_h
+#define dt_MODELS_FTRL_WEIGHTS_h
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "utils/assert.h"
+
+namespace dt {
+
+
+/*
+*  Compact storage for the weights of a finalized FTRL model.
+*
+*  Only the bins that have a non-zero weight for at least one label are
+*  stored, in an open-addressing hash table with linear probing. Each slot
+*  holds the bin index, and the weights of that bin for all the labels, so
+*  that a single lookup per feature is enough to score a row for every
+*  label at once.
+*/
+template <typename T>
+class FtrlWeights {
+  private:
+    std::vector<uint64_t> bins;
+    std::vector<T> weights;
+    size_t nlabels;
+    size_t nbins_used;
+    size_t shift;
+
+    static constexpr uint64_t EMPTY = std::numeric_limits<uint64_t>::max();
+
+    // Fibonacci hashing: multiply by 2^64/phi and keep the top bits.
+    // This spreads the consecutive bin indices evenly over the table.
+    size_t slot(uint64_t bin) const {
+      return static_cast<size_t>((bin * 0x9E3779B97F4A7C15ULL) >> shift);
+    }
+
+  public:
+    FtrlWeights() : nlabels(0), nbins_used(0), shift(64) {}
+
+    /*
+    *  Allocate a table for `n` bins with `nlabels_in` weights each. The
+    *  capacity is a power of two, such that the load factor stays below
+    *  0.75.
+    */
+    FtrlWeights(size_t n, size_t nlabels_in)
+      : nlabels(nlabels_in), nbins_used(0), shift(64)
+    {
+      size_t capacity = 1;
+      while (capacity * 3 < n * 4 + 4) {
+        capacity *= 2;
+        shift--;
+      }
+      bins.resize(capacity, EMPTY);
+      weights.resize(capacity * nlabels);
+    }
+
+    void insert(uint64_t bin, const T* w) {
+      xassert(bin != EMPTY && nbins_used < bins.size());
+      size_t mask = bins.size() - 1;
+      size_t i = slot(bin);
+      while (bins[i] != EMPTY) i = (i + 1) & mask;
+      bins[i] = bin;
+      for (size_t k = 0; k < nlabels; ++k) {
+        weights[i * nlabels + k] = w[k];
+      }
+      nbins_used++;
+    }
+
+    /*
+    *  Return the pointer to the `nlabels` weights of the `bin`, or nullptr
+    *  if all the weights of this bin are zero.
+    */
+    const T* find(uint64_t bin) const {
+      size_t mask = bins.size() - 1;
+      size_t i = slot(bin);
+      while (true) {
+        uint64_t b = bins[i];
+        if (b == bin) return weights.data() + i * nlabels;
+        if (b == EMPTY) return nullptr;
+        i = (i + 1) & mask;
+      }
+    }
+
+    bool empty() const { return bins.empty(); }
+    size_t size() const { return nbins_used; }
+    size_t get_nlabels() const { return nlabels; }
+
+    // Iterate over the stored bins in the table order: `fn(bin, weights)`
+    template <typename F>
+    void for_each(F fn) const {
+      for (size_t i = 0; i < bins.size(); ++i) {
+        if (bins[i] != EMPTY) fn(bins[i], weights.data() + i * nlabels);
+      }
+    }
+};
+
+template <typename T>
+constexpr uint64_t FtrlWeights<T>::EMPTY;
+
+
+} // namespace dt
+
+#endif
@@ -19,17 +19,606 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
+#include <algorithm>  // std::min, std::max, std::nth_element, std::upper_bound
+#include <cmath>      // std::sqrt
+#include <cstring>    // std::memcpy
+#include <functional> // std::greater
+#include <limits>     // std::numeric_limits
+#include <memory>     // std::make_shared
+#include <numeric>    // std::iota
+#include <queue>      // std::priority_queue
+#include <random>     // std::random_device
 #include "frame/py_frame.h"
+#include "models/kfold.h"
 #include "python/_all.h"
 #include "python/arg.h"
+#include "python/gil.h"
+#include "utils/assert.h"
 #include "utils/exceptions.h"
+#include "utils/profiler.h"
+#include "utils/thread_pool.h"
 #include "column.h"
 #include "datatable.h"
 #include "datatablemodule.h"
+#include "sort.h"
+
+namespace dt {
+
+
+//------------------------------------------------------------------------------
+// Random numbers
+//------------------------------------------------------------------------------
+
+// All random numbers here are derived from the splitmix64 sequence, which
+// allows computing the `i`-th random number of a sequence directly. Thus the
+// generated folds and samples depend only on the seed, and not on the number
+// of threads, or on how the work was distributed among them.
+static constexpr uint64_t GOLDEN = 0x9E3779B97F4A7C15ULL;
+
+static inline uint64_t mix64(uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// `i`-th element of the random sequence started at `seed`.
+static inline uint64_t random_at(uint64_t seed, size_t i) {
+  return mix64(seed + (static_cast<uint64_t>(i) + 1) * GOLDEN);
+}
+
+// Scale random 64-bit value `x` into the range `[0; m)`.
+static inline size_t scale_below(uint64_t x, size_t m) {
+  constexpr double EPS = 1.0 / 9007199254740992.0;  // 2^-53
+  size_t r = static_cast<size_t>(static_cast<double>(x >> 11) * EPS *
+                                 static_cast<double>(m));
+  return std::min(r, m - 1);
+}
+
+
+/**
+ * Random generator for a single "block" of work. Each block has its own
+ * sequence, seeded from the block's index.
+ */
+class block_rng {
+  private:
+    uint64_t state;
+
+  public:
+    block_rng(uint64_t seed, size_t block) : state(random_at(seed, block)) {}
+
+    uint64_t next() {
+      state += GOLDEN;
+      return mix64(state);
+    }
+
+    size_t below(size_t m) { return scale_below(next(), m); }
+};
+
+
+
+//------------------------------------------------------------------------------
+// Helpers
+//------------------------------------------------------------------------------
+
+// Parallel loops over rows use at least this many rows per task
+static constexpr size_t MIN_ROWS_PER_TASK = 10000;
+
+static size_t nchunks_for(size_t n) {
+  return std::max(size_t(1),
+                  std::min(num_threads_in_pool(), n / MIN_ROWS_PER_TASK));
+}
+
+
+/**
+ * Split the range `[0; n)` into `nchunks` contiguous chunks, and call
+ * `fn(c, i0, i1)` for each chunk `c = [i0; i1)` in parallel. Unlike
+ * `parallel_for_static()`, the chunk boundaries here are known to the
+ * caller, which allows making several passes over the same chunks.
+ */
+template <typename F>
+static void for_each_chunk(size_t n, size_t nchunks, F fn) {
+  dt::parallel_for_dynamic(nchunks, nchunks,
+    [&](size_t c) {
+      fn(c, n * c / nchunks, n * (c + 1) / nchunks);
+    });
+}
+
+
+/**
+ * Create RowIndex from a sorted array of row indices, converting it into
+ * a slice if the rows are contiguous.
+ */
+template <typename T>
+static RowIndex make_rowindex(dt::array<T>&& rows) {
+  size_t n = rows.size();
+  if (n == 0) return RowIndex(size_t(0), 0, 1);
+  size_t first = static_cast<size_t>(rows[0]);
+  if (static_cast<size_t>(rows[n - 1]) - first + 1 == n) {
+    return RowIndex(first, n, 1);
+  }
+  return RowIndex(std::move(rows), true);
+}
+
+
+/**
+ * Sort the rows of a single-column frame `dt`, and return the ordering of
+ * rows `rows` together with the groups `offsets`: the `g`-th group consists
+ * of the rows `rows[offsets[g]], ..., rows[offsets[g+1] - 1]`, in ascending
+ * order.
+ */
+static void group_rows(DataTable* dt, arr32_t& rows,
+                       std::vector<size_t>& offsets)
+{
+  auto rigb = dt->group({sort_spec(0)});
+  const RowIndex& ri = rigb.first;
+  rows.resize(dt->nrows);
+  if (ri.isarr32()) {
+    std::memcpy(rows.data(), ri.indices32(), dt->nrows * sizeof(int32_t));
+  } else {
+    ri.extract_into(rows);
+  }
+  size_t ngroups = rigb.second.ngroups();
+  const int32_t* offs = rigb.second.offsets_r();
+  offsets.resize(ngroups + 1);
+  for (size_t g = 0; g <= ngroups; ++g) {
+    offsets[g] = static_cast<size_t>(offs[g]);
+  }
+}
+
+
+
+//------------------------------------------------------------------------------
+// Folds
+//------------------------------------------------------------------------------
+
+/**
+ * Assign fold ids `folds[row]` in `[0; k)` to the rows, which are split
+ * into classes: the `g`-th class consists of rows `rowat(p)` for positions
+ * `p` in `[offsets[g]; offsets[g+1])`.
+ *
+ * Within each class, every block of `k` consecutive positions receives a
+ * random permutation of fold ids. The last (incomplete) block of `r < k`
+ * positions in the class receives fold ids `(rot + π(j)) % k`, where `π` is
+ * a random permutation of `0..r-1`, and `rot` continues cyclically from the
+ * incomplete block of the previous class. Thus, within each class, and in
+ * total, the sizes of any two folds differ by at most 1.
+ *
+ * The blocks are independent, and are processed in parallel.
+ */
+template <typename F>
+static void assign_folds(int32_t* folds, const std::vector<size_t>& offsets,
+                         size_t k, uint64_t seed, F rowat)
+{
+  size_t ngroups = offsets.size() - 1;
+  std::vector<size_t> bstart(ngroups + 1);
+  std::vector<size_t> rot(ngroups);
+  size_t r = mix64(seed) % k;
+  bstart[0] = 0;
+  for (size_t g = 0; g < ngroups; ++g) {
+    size_t m = offsets[g + 1] - offsets[g];
+    bstart[g + 1] = bstart[g] + (m + k - 1) / k;
+    rot[g] = r;
+    r = (r + m % k) % k;
+  }
+  size_t nblocks = bstart[ngroups];
+
+  size_t nth = nchunks_for(offsets[ngroups]);
+  dt::parallel_for_static(nblocks, nth,
+    [&](size_t b0, size_t b1) {
+      std::vector<int32_t> perm;
+      size_t g = static_cast<size_t>(
+          std::upper_bound(bstart.begin(), bstart.end(), b0)
+          - bstart.begin()) - 1;
+      for (size_t b = b0; b < b1; ++b) {
+        while (bstart[g + 1] <= b) ++g;
+        size_t p0 = offsets[g] + (b - bstart[g]) * k;
+        size_t m = std::min(k, offsets[g + 1] - p0);
+        perm.resize(m);
+        std::iota(perm.begin(), perm.end(), 0);
+        block_rng rng(seed, b);
+        for (size_t j = m - 1; j > 0; --j) {
+          std::swap(perm[j], perm[rng.below(j + 1)]);
+        }
+        if (m == k) {
+          for (size_t j = 0; j < m; ++j) {
+            folds[rowat(p0 + j)] = perm[j];
+          }
+        } else {
+          for (size_t j = 0; j < m; ++j) {
+            folds[rowat(p0 + j)] =
+                static_cast<int32_t>((rot[g] + static_cast<size_t>(perm[j])) % k);
+          }
+        }
+      }
+    });
+}
+
+
+/**
+ * Given fold ids `folds[i]` for each of the `n` rows, create `k` splits
+ * `(train, test)`, where the test part of the `f`-th split are the rows of
+ * fold `f`, and the train part are all other rows.
+ *
+ * The rows are split into chunks; in the first pass the number of rows of
+ * each fold within each chunk is counted, after which the position of every
+ * row within each of the output arrays is known, and the arrays are filled
+ * in parallel over `(chunk, fold)` pairs.
+ */
+template <typename T>
+static std::vector<split_t> splits_from_folds(const int32_t* folds, size_t n,
+                                              size_t k)
+{
+  size_t nchunks = nchunks_for(n);
+  std::vector<size_t> counts(nchunks * k, 0);
+  for_each_chunk(n, nchunks,
+    [&](size_t c, size_t i0, size_t i1) {
+      size_t* cnt = counts.data() + c * k;
+      for (size_t i = i0; i < i1; ++i) {
+        cnt[folds[i]]++;
+      }
+    });
+
+  // Convert counts into offsets of each chunk within each fold
+  std::vector<size_t> totals(k);
+  for (size_t f = 0; f < k; ++f) {
+    size_t s = 0;
+    for (size_t c = 0; c < nchunks; ++c) {
+      size_t t = counts[c * k + f];
+      counts[c * k + f] = s;
+      s += t;
+    }
+    totals[f] = s;
+  }
+
+  std::vector<dt::array<T>> tests, trains;
+  tests.reserve(k);
+  trains.reserve(k);
+  for (size_t f = 0; f < k; ++f) {
+    tests.emplace_back(totals[f]);
+    trains.emplace_back(n - totals[f]);
+  }
+
+  dt::parallel_for_dynamic(nchunks * k, num_threads_in_pool(),
+    [&](size_t t) {
+      size_t c = t / k;
+      size_t f = t - c * k;
+      size_t i0 = n * c / nchunks;
+      size_t i1 = n * (c + 1) / nchunks;
+      int32_t ff = static_cast<int32_t>(f);
+      T* test = tests[f].data();
+      T* train = trains[f].data();
+      // `j` is the number of rows of fold `f` before row `i`
+      size_t j = counts[t];
+      for (size_t i = i0; i < i1; ++i) {
+        if (folds[i] == ff) test[j++] = static_cast<T>(i);
+        else                train[i - j] = static_cast<T>(i);
+      }
+    });
+
+  std::vector<split_t> res;
+  res.reserve(k);
+  for (size_t f = 0; f < k; ++f) {
+    res.emplace_back(make_rowindex(std::move(trains[f])),
+                     make_rowindex(std::move(tests[f])));
+  }
+  return res;
+}
+
+
+static std::vector<split_t> splits_from_folds(const int32_t* folds, size_t n,
+                                              size_t k)
+{
+  constexpr size_t MAX32 = static_cast<size_t>(INT32_MAX);
+  return (n <= MAX32)? splits_from_folds<int32_t>(folds, n, k)
+                     : splits_from_folds<int64_t>(folds, n, k);
+}
+
+
+
+std::vector<split_t> kfold_random(size_t nrows, size_t nsplits, uint64_t seed)
+{
+  xassert(nsplits >= 2 && nsplits <= nrows);
+  py::gil_release nogil;
+  dt::profile_scope ps("kfold");
+  arr32_t folds(nrows);
+  std::vector<size_t> offsets {0, nrows};
+  assign_folds(folds.data(), offsets, nsplits, seed,
+               [](size_t p) { return p; });
+  return splits_from_folds(folds.data(), nrows, nsplits);
+}
+
+
+std::vector<split_t> kfold_stratified(DataTable* y, size_t nsplits,
+                                      uint64_t seed)
+{
+  xassert(y->ncols == 1);
+  xassert(nsplits >= 2 && nsplits <= y->nrows);
+  arr32_t rows;
+  std::vector<size_t> offsets;
+  group_rows(y, rows, offsets);
+
+  py::gil_release nogil;
+  dt::profile_scope ps("kfold");
+  const int32_t* prows = rows.data();
+  arr32_t folds(y->nrows);
+  assign_folds(folds.data(), offsets, nsplits, seed,
+               [=](size_t p) { return static_cast<size_t>(prows[p]); });
+  return splits_from_folds(folds.data(), y->nrows, nsplits);
+}
+
+
+std::vector<split_t> kfold_grouped(DataTable* groups, size_t nsplits) {
+  xassert(groups->ncols == 1);
+  xassert(nsplits >= 2 && nsplits <= groups->nrows);
+  arr32_t rows;
+  std::vector<size_t> offsets;
+  group_rows(groups, rows, offsets);
+  size_t ngroups = offsets.size() - 1;
+  if (nsplits > ngroups) {
+    throw ValueError() << "The number of splits cannot exceed the number of "
+                          "groups";
+  }
+
+  py::gil_release nogil;
+  dt::profile_scope ps("kfold");
+
+  // Assign groups to folds: largest groups first, each into the fold that
+  // currently has the fewest rows (ties resolved towards the smaller fold
+  // index, or the smaller group index).
+  std::vector<size_t> order(ngroups);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+    [&](size_t a, size_t b) {
+      return offsets[a + 1] - offsets[a] > offsets[b + 1] - offsets[b];
+    });
+  using load_t = std::pair<size_t, size_t>;  // (nrows, fold)
+  std::priority_queue<load_t, std::vector<load_t>, std::greater<load_t>> heap;
+  for (size_t f = 0; f < nsplits; ++f) heap.push(load_t(0, f));
+  std::vector<int32_t> group_folds(ngroups);
+  for (size_t g : order) {
+    load_t top = heap.top();
+    heap.pop();
+    group_folds[g] = static_cast<int32_t>(top.second);
+    top.first += offsets[g + 1] - offsets[g];
+    heap.push(top);
+  }
+
+  size_t n = groups->nrows;
+  const int32_t* prows = rows.data();
+  arr32_t folds(n);
+  int32_t* pfolds = folds.data();
+  dt::parallel_for_static(n, nchunks_for(n),
+    [&](size_t p0, size_t p1) {
+      size_t g = static_cast<size_t>(
+          std::upper_bound(offsets.begin(), offsets.end(), p0)
+          - offsets.begin()) - 1;
+      for (size_t p = p0; p < p1; ++p) {
+        while (offsets[g + 1] <= p) ++g;
+        pfolds[prows[p]] = group_folds[g];
+      }
+    });
+  return splits_from_folds(pfolds, n, nsplits);
+}
+
+
+
+//------------------------------------------------------------------------------
+// Sampling
+//------------------------------------------------------------------------------
+
+template <typename T>
+static RowIndex sample_with_replacement(size_t nrows, size_t size,
+                                        uint64_t seed)
+{
+  dt::array<T> rows(size);
+  T* prows = rows.data();
+  dt::parallel_for_static(size, nchunks_for(size),
+    [&](size_t i0, size_t i1) {
+      for (size_t i = i0; i < i1; ++i) {
+        prows[i] = static_cast<T>(scale_below(random_at(seed, i), nrows));
+      }
+    });
+  return RowIndex(std::move(rows), false);
+}
+
+
+/**
+ * Each row receives a random 64-bit key, and the `size` rows with the
+ * smallest keys are selected. In order to avoid sorting all keys, only the
+ * "candidate" rows whose keys are below a threshold are collected, where
+ * the threshold is chosen so that there are enough candidates with
+ * overwhelming probability (if not, the threshold is increased and the
+ * candidates are collected again). The `size`-th smallest key among the
+ * candidates is then found via `nth_element`.
+ *
+ * When `size` is more than half of `nrows`, the rows that are *not*
+ * selected are sampled instead, limiting the number of candidates.
+ */
+template <typename T>
+static RowIndex sample_without_replacement(size_t nrows, size_t size,
+                                           uint64_t seed)
+{
+  if (size == 0) return RowIndex(size_t(0), 0, 1);
+  if (size == nrows) return RowIndex(size_t(0), nrows, 1);
+  bool complement = (size > nrows / 2);
+  size_t m = complement? nrows - size : size;
+
+  size_t nchunks = nchunks_for(nrows);
+  std::vector<size_t> counts(nchunks + 1);
+  uint64_t threshold;
+  double margin = 4.0 * std::sqrt(static_cast<double>(m)) + 16.0;
+  while (true) {
+    double p = (static_cast<double>(m) + margin) / static_cast<double>(nrows);
+    threshold = (p >= 1.0)? std::numeric_limits<uint64_t>::max()
+                          : static_cast<uint64_t>(p * 18446744073709551616.0);
+    for_each_chunk(nrows, nchunks,
+      [&](size_t c, size_t i0, size_t i1) {
+        size_t cnt = 0;
+        for (size_t i = i0; i < i1; ++i) {
+          cnt += (random_at(seed, i) <= threshold);
+        }
+        counts[c + 1] = cnt;
+      });
+    counts[0] = 0;
+    for (size_t c = 0; c < nchunks; ++c) counts[c + 1] += counts[c];
+    if (counts[nchunks] >= m) break;
+    margin *= 4;
+  }
+
+  // Collect the candidates, in the order of rows
+  size_t ncand = counts[nchunks];
+  std::vector<uint64_t> keys(ncand);
+  std::vector<T> cand(ncand);
+  for_each_chunk(nrows, nchunks,
+    [&](size_t c, size_t i0, size_t i1) {
+      size_t j = counts[c];
+      for (size_t i = i0; i < i1; ++i) {
+        uint64_t key = random_at(seed, i);
+        if (key <= threshold) {
+          keys[j] = key;
+          cand[j] = static_cast<T>(i);
+          ++j;
+        }
+      }
+    });
+
+  // Find the `m`-th smallest key, and select the rows with keys up to it
+  // (the keys may coincide only with negligible probability, in which case
+  // the rows that come first are selected).
+  std::vector<uint64_t> tmp(keys);
+  std::nth_element(tmp.begin(), tmp.begin() + static_cast<long>(m - 1),
+                   tmp.end());
+  uint64_t kth = tmp[m - 1];
+  size_t nless = 0;
+  for (uint64_t key : keys) nless += (key < kth);
+  size_t nequal = m - nless;
+  dt::array<T> selected(m);
+  for (size_t i = 0, j = 0; i < ncand; ++i) {
+    if (keys[i] < kth) {
+      selected[j++] = cand[i];
+    } else if (keys[i] == kth && nequal) {
+      selected[j++] = cand[i];
+      --nequal;
+    }
+  }
+  if (!complement) return make_rowindex(std::move(selected));
+
+  // Return all rows except the `selected` ones
+  const T* psel = selected.data();
+  dt::array<T> rows(size);
+  T* prows = rows.data();
+  for_each_chunk(nrows, nchunks,
+    [&](size_t, size_t i0, size_t i1) {
+      // `j` is the number of selected rows that are less than `i`
+      size_t j = static_cast<size_t>(
+          std::lower_bound(psel, psel + m, static_cast<T>(i0)) - psel);
+      for (size_t i = i0; i < i1; ++i) {
+        if (j < m && static_cast<size_t>(psel[j]) == i) ++j;
+        else prows[i - j] = static_cast<T>(i);
+      }
+    });
+  return make_rowindex(std::move(rows));
+}
+
+
+RowIndex sample_rows(size_t nrows, size_t size, bool replace, uint64_t seed) {
+  xassert(replace? (nrows > 0 || size == 0) : size <= nrows);
+  py::gil_release nogil;
+  dt::profile_scope ps("sample_rows");
+  constexpr size_t MAX32 = static_cast<size_t>(INT32_MAX);
+  bool use32 = (nrows <= MAX32 && size <= MAX32);
+  if (replace) {
+    return use32? sample_with_replacement<int32_t>(nrows, size, seed)
+                : sample_with_replacement<int64_t>(nrows, size, seed);
+  } else {
+    return use32? sample_without_replacement<int32_t>(nrows, size, seed)
+                : sample_without_replacement<int64_t>(nrows, size, seed);
+  }
+}
+
+
+}  // namespace dt
+
+
 
 namespace py {
 
 
+static void check_nsplits(size_t nsplits, size_t nrows) {
+  if (nsplits < 2) {
+    throw ValueError() << "The number of splits cannot be less than two";
+  }
+  if (nsplits > nrows) {
+    throw ValueError()
+      << "The number of splits cannot exceed the number of rows";
+  }
+}
+
+
+static uint64_t get_seed(const Arg& arg) {
+  if (arg.is_none_or_undefined()) {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) | rd();
+  }
+  return static_cast<uint64_t>(arg.to_size_t());
+}
+
+
+static DataTable* get_single_column_frame(const Arg& arg) {
+  DataTable* dt = arg.to_datatable();
+  if (dt->ncols != 1) {
+    throw ValueError() << arg.name() << " must be a single-column Frame, "
+        "instead it has " << dt->ncols << " columns";
+  }
+  return dt;
+}
+
+
+/**
+ * Convert a RowIndex into a row selector for a python Frame: either a
+ * `range` object, or a single-column Frame of row indices. In the latter
+ * case the Frame's column shares its data with the RowIndex.
+ */
+static oobj rowindex_to_selector(const RowIndex& ri) {
+  if (ri.isslice() && ri.slice_step() == 1) {
+    int64_t start = static_cast<int64_t>(ri.slice_start());
+    return orange(start, start + static_cast<int64_t>(ri.size()));
+  }
+  size_t n = ri.size();
+  Column* col;
+  if (ri.isarr32()) {
+    MemoryRange mr = MemoryRange::external(ri.indices32(), n * 4,
+                                           std::make_shared<RowIndex>(ri));
+    col = Column::new_mbuf_column(SType::INT32, std::move(mr));
+  }
+  else if (ri.isarr64()) {
+    MemoryRange mr = MemoryRange::external(ri.indices64(), n * 8,
+                                           std::make_shared<RowIndex>(ri));
+    col = Column::new_mbuf_column(SType::INT64, std::move(mr));
+  }
+  else {
+    col = Column::new_data_column(SType::INT64, n);
+    int64_t* data = static_cast<int64_t*>(col->data_w());
+    ri.iterate(0, n, 1,
+      [&](size_t i, size_t j) {
+        data[i] = static_cast<int64_t>(j);
+      });
+  }
+  return oobj::from_new_reference(Frame::from_datatable(new DataTable({col})));
+}
+
+
+static oobj splits_to_list(const std::vector<dt::split_t>& splits) {
+  olist res(splits.size());
+  for (size_t i = 0; i < splits.size(); ++i) {
+    res.set(i, otuple(rowindex_to_selector(splits[i].first),
+                      rowindex_to_selector(splits[i].second)));
+  }
+  return std::move(res);
+}
+
+
+
 //------------------------------------------------------------------------------
 // kfold()
 //------------------------------------------------------------------------------
@@ -74,13 +663,7 @@ static oobj kfold(const PKArgs& args) {
   if (!args[1]) throw TypeError() << "Required parameter `nsplits` is missing";
   size_t nrows = args[0].to_size_t();
   size_t nsplits = args[1].to_size_t();
-  if (nsplits < 2) {
-    throw ValueError() << "The number of splits cannot be less than two";
-  }
-  if (nsplits > nrows) {
-    throw ValueError()
-      << "The number of splits cannot exceed the number of rows";
-  }
+  check_nsplits(nsplits, nrows);
 
   int64_t k = static_cast<int64_t>(nsplits);
   int64_t n = static_cast<int64_t>(nrows);
@@ -125,8 +708,207 @@ static oobj kfold(const PKArgs& args) {
 
 
 
+//------------------------------------------------------------------------------
+// kfold_random()
+//------------------------------------------------------------------------------
+
+static PKArgs args_kfold_random(
+  0, 0, 3, false, false,
+  {"nrows", "nsplits", "seed"}, "kfold_random",
+
+R"(kfold_random(nrows, nsplits, seed=None)
+--
+
+Perform randomized k-fold split of data with `nrows` rows into `nsplits`
+train/test subsets.
+
+This function will return a list of `nsplits` tuples `(train_rows, test_rows)`
+similar to :func:`kfold`, except that the rows are assigned to the folds
+randomly. The sizes of any two folds differ by at most 1. Each row selector
+is a single-column Frame with the indices of the selected rows in ascending
+order (or a range, if those rows happen to be contiguous).
+
+Parameters
+----------
+nrows: int
+    The number of rows in the frame that you want to split.
+
+nsplits: int
+    Number of folds, must be at least 2, but not larger than `nrows`.
+
+seed: int
+    Seed for the random number generator. The same seed always produces the
+    same splits. If not given, a random seed is used.
+)");
+
+
+static oobj kfold_random(const PKArgs& args) {
+  if (!args[0]) throw TypeError() << "Required parameter `nrows` is missing";
+  if (!args[1]) throw TypeError() << "Required parameter `nsplits` is missing";
+  size_t nrows = args[0].to_size_t();
+  size_t nsplits = args[1].to_size_t();
+  uint64_t seed = get_seed(args[2]);
+  check_nsplits(nsplits, nrows);
+  if (nsplits > static_cast<size_t>(INT32_MAX)) {
+    throw ValueError() << "The number of splits is too large";
+  }
+  return splits_to_list(dt::kfold_random(nrows, nsplits, seed));
+}
+
+
+
+//------------------------------------------------------------------------------
+// kfold_stratified()
+//------------------------------------------------------------------------------
+
+static PKArgs args_kfold_stratified(
+  0, 0, 3, false, false,
+  {"y", "nsplits", "seed"}, "kfold_stratified",
+
+R"(kfold_stratified(y, nsplits, seed=None)
+--
+
+Perform stratified k-fold split of the rows of frame `y` into `nsplits`
+train/test subsets.
+
+The rows are assigned to the folds randomly, but in such a way that each
+distinct value of `y` (NA counts as a separate value) is represented in
+every fold equally: for each such value the numbers of its rows in any two
+folds differ by at most 1. The return value is the same as in
+:func:`kfold_random`.
+
+Parameters
+----------
+y: Frame
+    Single-column Frame with the target (class) values.
+
+nsplits: int
+    Number of folds, must be at least 2, but not larger than `y.nrows`.
+
+seed: int
+    Seed for the random number generator. If not given, a random seed is
+    used.
+)");
+
+
+static oobj kfold_stratified(const PKArgs& args) {
+  if (!args[0]) throw TypeError() << "Required parameter `y` is missing";
+  if (!args[1]) throw TypeError() << "Required parameter `nsplits` is missing";
+  DataTable* y = get_single_column_frame(args[0]);
+  size_t nsplits = args[1].to_size_t();
+  uint64_t seed = get_seed(args[2]);
+  check_nsplits(nsplits, y->nrows);
+  return splits_to_list(dt::kfold_stratified(y, nsplits, seed));
+}
+
+
+
+//------------------------------------------------------------------------------
+// kfold_grouped()
+//------------------------------------------------------------------------------
+
+static PKArgs args_kfold_grouped(
+  0, 0, 2, false, false,
+  {"groups", "nsplits"}, "kfold_grouped",
+
+R"(kfold_grouped(groups, nsplits)
+--
+
+Perform k-fold split of the rows of frame `groups` into `nsplits` train/test
+subsets, such that no group is split between the folds.
+
+All rows with the same value in `groups` (NA counts as a separate value)
+are placed into the same fold. The groups are distributed among the folds
+so that the folds have approximately equal number of rows: largest groups
+first, each group into the fold which is currently the smallest. The result
+is deterministic. The return value is the same as in :func:`kfold_random`.
+
+Parameters
+----------
+groups: Frame
+    Single-column Frame with the group labels.
+
+nsplits: int
+    Number of folds, must be at least 2, but not larger than the number of
+    distinct groups.
+)");
+
+
+static oobj kfold_grouped(const PKArgs& args) {
+  if (!args[0]) throw TypeError() << "Required parameter `groups` is missing";
+  if (!args[1]) throw TypeError() << "Required parameter `nsplits` is missing";
+  DataTable* groups = get_single_column_frame(args[0]);
+  size_t nsplits = args[1].to_size_t();
+  check_nsplits(nsplits, groups->nrows);
+  return splits_to_list(dt::kfold_grouped(groups, nsplits));
+}
+
+
+
+//------------------------------------------------------------------------------
+// sample_rows()
+//------------------------------------------------------------------------------
+
+static PKArgs args_sample_rows(
+  0, 0, 4, false, false,
+  {"nrows", "size", "replace", "seed"}, "sample_rows",
+
+R"(sample_rows(nrows, size, replace=False, seed=None)
+--
+
+Randomly select `size` rows out of a frame with `nrows` rows.
+
+Returns a row selector: a single-column Frame with the indices of the
+selected rows (or a range, if the selected rows are contiguous). When
+sampling without replacement, the rows are listed in ascending order; when
+sampling with replacement the order of rows is random.
+
+Parameters
+----------
+nrows: int
+    The number of rows in the frame being sampled.
+
+size: int
+    The number of rows to select. Without replacement this cannot exceed
+    `nrows`.
+
+replace: bool
+    Whether to sample with replacement (i.e. the same row may be selected
+    several times), or without.
+
+seed: int
+    Seed for the random number generator. If not given, a random seed is
+    used.
+)");
+
+
+static oobj sample_rows(const PKArgs& args) {
+  if (!args[0]) throw TypeError() << "Required parameter `nrows` is missing";
+  if (!args[1]) throw TypeError() << "Required parameter `size` is missing";
+  size_t nrows = args[0].to_size_t();
+  size_t size = args[1].to_size_t();
+  bool replace = args[2].to<bool>(false);
+  uint64_t seed = get_seed(args[3]);
+  if (replace) {
+    if (nrows == 0 && size > 0) {
+      throw ValueError() << "Cannot sample from a frame with 0 rows";
+    }
+  } else if (size > nrows) {
+    throw ValueError() << "Sample size cannot exceed the number of rows when "
+                          "sampling without replacement";
+  }
+  return rowindex_to_selector(dt::sample_rows(nrows, size, replace, seed));
+}
+
+
+
+
 void DatatableModule::init_methods_kfold() {
   ADD_FN(&kfold, args_kfold_simple);
+  ADD_FN(&kfold_random, args_kfold_random);
+  ADD_FN(&kfold_stratified, args_kfold_stratified);
+  ADD_FN(&kfold_grouped, args_kfold_grouped);
+  ADD_FN(&sample_rows, args_sample_rows);
 }
 
 
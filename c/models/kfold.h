@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#ifndef dt_MODELS_KFOLD_h
+#define dt_MODELS_KFOLD_h
+#include <utility>    // std::pair
+#include <vector>     // std::vector
+#include "rowindex.h"
+
+class DataTable;
+
+namespace dt {
+
+
+/**
+ * A single train/test split: pair of RowIndices `(train, test)` into the
+ * frame being split. Both RowIndices are sorted in ascending order, and they
+ * are slices whenever the selected rows are contiguous, or ARR32 / ARR64
+ * arrays otherwise.
+ */
+using split_t = std::pair<RowIndex, RowIndex>;
+
+
+/**
+ * Randomly split `nrows` rows into `nsplits` folds of (almost) equal sizes:
+ * the sizes of any two folds differ by at most 1. The result depends only on
+ * the `seed`, but not on the number of threads.
+ */
+std::vector<split_t> kfold_random(size_t nrows, size_t nsplits, uint64_t seed);
+
+
+/**
+ * Randomly split the rows of a single-column frame `y` into `nsplits` folds,
+ * so that each distinct value of `y` (NA being one of such values) is spread
+ * evenly among the folds: within each "class" the number of rows in any two
+ * folds differs by at most 1. The total sizes of the folds also differ by at
+ * most 1.
+ */
+std::vector<split_t> kfold_stratified(DataTable* y, size_t nsplits,
+                                      uint64_t seed);
+
+
+/**
+ * Split the rows of a single-column frame `groups` into `nsplits` folds,
+ * such that all rows with the same value of `groups` end up in the same
+ * fold. Groups are assigned greedily, largest first, into the fold that is
+ * currently the smallest; thus the result is deterministic.
+ */
+std::vector<split_t> kfold_grouped(DataTable* groups, size_t nsplits);
+
+
+/**
+ * Select `size` rows out of `nrows` at random, either with replacement
+ * (in which case the rows are returned in random order), or without
+ * replacement (the rows are then returned in ascending order).
+ */
+RowIndex sample_rows(size_t nrows, size_t size, bool replace, uint64_t seed);
+
+
+
+}  // namespace dt
+#endif
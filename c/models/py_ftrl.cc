@@ -21,8 +21,11 @@
 //------------------------------------------------------------------------------
 #include "frame/py_frame.h"
 #include "python/_all.h"
+#include "python/gil.h"
 #include "python/string.h"
 #include "str/py_str.h"
+#include <exception>
+#include <thread>
 #include <vector>
 #include "models/py_ftrl.h"
 #include "models/py_validator.h"
@@ -30,10 +33,11 @@
 
 namespace py {
 
-PKArgs Ftrl::Type::args___init__(0, 2, 6, false, false,
+PKArgs Ftrl::Type::args___init__(0, 2, 7, false, false,
                                  {"params", "alpha", "beta", "lambda1",
                                  "lambda2", "nbins", "nepochs",
-                                 "double_precision"}, "__init__", nullptr);
+                                 "double_precision", "deterministic"},
+                                 "__init__", nullptr);
 
 
 /*
@@ -42,6 +46,7 @@ PKArgs Ftrl::Type::args___init__(0, 2, 6, false, false,
 */
 void Ftrl::m__init__(PKArgs& args) {
   dtft = nullptr;
+  training = false;
   dt::FtrlParams ftrl_params;
 
   const Arg& arg_params           = args[0];
@@ -52,6 +57,7 @@ void Ftrl::m__init__(PKArgs& args) {
   const Arg& arg_nbins            = args[5];
   const Arg& arg_nepochs          = args[6];
   const Arg& arg_double_precision = args[7];
+  const Arg& arg_deterministic    = args[8];
 
   bool defined_params           = !arg_params.is_none_or_undefined();
   bool defined_alpha            = !arg_alpha.is_none_or_undefined();
@@ -130,6 +136,12 @@ void Ftrl::m__init__(PKArgs& args) {
     }
   }
 
+  // Training mode is not a part of `params`, and thus can be combined
+  // with them.
+  if (!arg_deterministic.is_none_or_undefined()) {
+    ftrl_params.deterministic = arg_deterministic.to_bool_strict();
+  }
+
   py_interactions = py::None();
 
   if (ftrl_params.double_precision) {
@@ -228,6 +240,7 @@ epoch returned will be equal to `nepochs`.
 
 
 oobj Ftrl::fit(const PKArgs& args) {
+  check_not_training();
   const Arg& arg_X_train = args[0];
   const Arg& arg_y_train = args[1];
   const Arg& arg_X_validation = args[2];
@@ -248,7 +261,50 @@ oobj Ftrl::fit(const PKArgs& args) {
   DataTable* dt_y = arg_y_train.to_datatable();
 
   if (dt_X == nullptr || dt_y == nullptr) return py::None();
+  check_training_frames(dt_X, dt_y);
+
+  // Validtion set handling
+  DataTable* dt_X_val = nullptr;
+  DataTable* dt_y_val = nullptr;
+  double nepochs_val = std::numeric_limits<double>::quiet_NaN();
+  double val_error = std::numeric_limits<double>::quiet_NaN();
+
+  if (!arg_X_validation.is_none_or_undefined() &&
+      !arg_y_validation.is_none_or_undefined()) {
+    dt_X_val = arg_X_validation.to_datatable();
+    dt_y_val = arg_y_validation.to_datatable();
+
+    check_validation_frames(dt_X_val, dt_y_val, dt_y);
 
+    if (!arg_nepochs_validation.is_none_or_undefined()) {
+      nepochs_val = arg_nepochs_validation.to_double();
+      py::Validator::check_positive<double>(nepochs_val, arg_nepochs_validation);
+      if (nepochs_val >= dtft->get_nepochs()) {
+        throw ValueError() << "`nepochs_validation` should be less than "
+                           << "`nepochs";
+      }
+    } else nepochs_val = 1;
+
+    if (!arg_validation_error.is_none_or_undefined()) {
+      val_error = arg_validation_error.to_double();
+      py::Validator::check_positive<double>(val_error, arg_validation_error);
+    } else val_error = 0.01;
+  }
+
+  // Train the model and return epoch when training.
+  double epoch_stopped = dtft->dispatch_fit(dt_X, dt_y,
+                                            dt_X_val, dt_y_val,
+                                            nepochs_val, val_error,
+                                            /* release_gil = */ false);
+  return py::ofloat(epoch_stopped);
+}
+
+
+/*
+*  Check that the training frames `dt_X` and `dt_y` are consistent with
+*  each other and with the model, and pass the interactions to the model.
+*/
+void Ftrl::check_training_frames(DataTable* dt_X, DataTable* dt_y) {
   if (dt_X->ncols == 0) {
     throw ValueError() << "Training frame must have at least one column";
   }
@@ -279,67 +335,200 @@ oobj Ftrl::fit(const PKArgs& args) {
     std::vector<sizetvec> inters = convert_interactions();
     dtft->set_interactions(std::move(inters));
   }
+}
 
-  // Validtion set handling
-  DataTable* dt_X_val = nullptr;
-  DataTable* dt_y_val = nullptr;
-  double nepochs_val = std::numeric_limits<double>::quiet_NaN();
-  double val_error = std::numeric_limits<double>::quiet_NaN();
 
-  if (!arg_X_validation.is_none_or_undefined() &&
-      !arg_y_validation.is_none_or_undefined()) {
-    dt_X_val = arg_X_validation.to_datatable();
-    dt_y_val = arg_y_validation.to_datatable();
+/*
+*  Check that the validation frames are consistent with each other,
+*  and with the training target frame `dt_y`.
+*/
+void Ftrl::check_not_training() const {
+  if (training) {
+    throw RuntimeError() << "This model is being trained by `partial_fit()` "
+                            "and cannot be used until the training is done";
+  }
+}
 
-    if (dt_X_val->ncols != dt_X->ncols) {
-      throw ValueError() << "Validation frame must have the same number of "
-                         << "columns as the training frame";
-    }
 
-    if (dt_X_val->get_names() != colnames) {
-      throw ValueError() << "Validation frame must have the same column "
-                         << "names as the training frame";
-    }
+void Ftrl::check_validation_frames(DataTable* dt_X_val, DataTable* dt_y_val,
+                                   DataTable* dt_y)
+{
+  if (dt_X_val->ncols != colnames.size()) {
+    throw ValueError() << "Validation frame must have the same number of "
+                       << "columns as the training frame";
+  }
 
-    if (dt_X_val->nrows == 0) {
-      throw ValueError() << "Validation frame cannot be empty";
-    }
+  if (dt_X_val->get_names() != colnames) {
+    throw ValueError() << "Validation frame must have the same column "
+                       << "names as the training frame";
+  }
 
-    if (dt_y_val->ncols != 1) {
-      throw ValueError() << "Validation target frame must have exactly "
-                         << "one column";
-    }
+  if (dt_X_val->nrows == 0) {
+    throw ValueError() << "Validation frame cannot be empty";
+  }
 
-    if (dt_y_val->columns[0]->stype() != dt_y->columns[0]->stype()) {
-      throw ValueError() << "Validation target frame must have the same "
-                            "stype as the target frame";
-    }
+  if (dt_y_val->ncols != 1) {
+    throw ValueError() << "Validation target frame must have exactly "
+                       << "one column";
+  }
 
-    if (dt_X_val->nrows != dt_y_val->nrows) {
-      throw ValueError() << "Validation target frame must have the same "
-                         << "number of rows as the validation frame itself";
-    }
+  if (dt_y_val->columns[0]->stype() != dt_y->columns[0]->stype()) {
+    throw ValueError() << "Validation target frame must have the same "
+                          "stype as the target frame";
+  }
 
-    if (!arg_nepochs_validation.is_none_or_undefined()) {
-      nepochs_val = arg_nepochs_validation.to_double();
-      py::Validator::check_positive<double>(nepochs_val, arg_nepochs_validation);
-      if (nepochs_val >= dtft->get_nepochs()) {
-        throw ValueError() << "`nepochs_validation` should be less than "
-                           << "`nepochs";
-      }
-    } else nepochs_val = 1;
+  if (dt_X_val->nrows != dt_y_val->nrows) {
+    throw ValueError() << "Validation target frame must have the same "
+                       << "number of rows as the validation frame itself";
+  }
+}
+
+
+/*
+*  .partial_fit(...)
+*  Train the model on a stream of batches. While a batch is being trained
+*  on, the next one is requested from the python iterator in a separate
+*  thread, so that the reading of the data overlaps with the training.
+*/
+static PKArgs args_partial_fit(1, 3, 0, false, false, {"batches",
+                               "X_validation", "y_validation",
+                               "validation_error"},
+                               "partial_fit",
+R"(partial_fit(self, batches, X_validation=None, y_validation=None, validation_error=0.01)
+--
+
+Train an FTRL model on a stream of batches, for example when the training
+data does not fit into memory.
+
+Each batch is used for training in the same way as `fit(X, y)` would do,
+i.e. for `nepochs` epochs. The next batch is requested from the iterator
+while the model is being trained on the current one, so that the reading
+of the data overlaps with the training. For this reason the frames of a
+batch should not be modified after they were returned by the iterator.
+
+Parameters
+----------
+batches: iterable
+    Iterable (for instance, a generator) that produces the tuples
+    `(X, y)`, where `X` is a training frame of shape (nrows, ncols)
+    and `y` is a target frame of shape (nrows, 1).
+
+X_validation: Frame
+    Validation frame of shape (nrows, ncols).
+
+y_validation: Frame
+    Validation target frame of shape (nrows, 1).
+
+validation_error: float
+    If the relative validation error does not improve by at least
+    `validation_error` after a batch was trained on, training is stopped.
+
+Returns
+-------
+Number of batches that the model was trained on.
+)");
 
+
+oobj Ftrl::partial_fit(const PKArgs& args) {
+  check_not_training();
+  const Arg& arg_batches = args[0];
+  const Arg& arg_X_validation = args[1];
+  const Arg& arg_y_validation = args[2];
+  const Arg& arg_validation_error = args[3];
+
+  if (arg_batches.is_none_or_undefined()) {
+    throw ValueError() << "Batches parameter is missing";
+  }
+  py::oiter batches = arg_batches.to_oobj().to_oiter();
+
+  DataTable* dt_X_val = nullptr;
+  DataTable* dt_y_val = nullptr;
+  double val_error = 0.01;
+  bool validation = !arg_X_validation.is_none_or_undefined() &&
+                    !arg_y_validation.is_none_or_undefined();
+  if (validation) {
+    dt_X_val = arg_X_validation.to_datatable();
+    dt_y_val = arg_y_validation.to_datatable();
     if (!arg_validation_error.is_none_or_undefined()) {
       val_error = arg_validation_error.to_double();
       py::Validator::check_positive<double>(val_error, arg_validation_error);
-    } else val_error = 0.01;
+    }
   }
 
-  // Train the model and return epoch when training.
-  double epoch_stopped = dtft->dispatch_fit(dt_X, dt_y,
-                                            dt_X_val, dt_y_val,
-                                            nepochs_val, val_error);
-  return py::ofloat(epoch_stopped);
+  constexpr double epsilon = std::numeric_limits<double>::epsilon();
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  double loss_prev = nan;
+  size_t nbatches = 0;
+  auto it = batches.begin();
+  auto end = batches.end();
+
+  while (it != end) {
+    // Keep the batch alive until the training on it has finished
+    py::oobj batch = *it;
+    if (!batch.is_tuple() || batch.to_otuple().size() != 2 ||
+        !batch.to_otuple()[0].is_frame() || !batch.to_otuple()[1].is_frame()) {
+      throw TypeError() << "Each batch should be a tuple `(X, y)` of frames, "
+                        << "instead batch " << nbatches << " is "
+                        << batch.typeobj();
+    }
+    DataTable* dt_X = batch.to_otuple()[0].to_datatable();
+    DataTable* dt_y = batch.to_otuple()[1].to_datatable();
+    check_training_frames(dt_X, dt_y);
+    if (validation && nbatches == 0) {
+      check_validation_frames(dt_X_val, dt_y_val, dt_y);
+    }
+
+    // Request the next batch from the iterator in a separate thread,
+    // while training on the current one. `dispatch_fit()` releases the GIL
+    // for the duration of the training, so that the iterator can make
+    // progress in the meantime. The training works on shallow copies of the
+    // batch's frames, so that it is not affected if the iterator (or any
+    // other python thread) modifies them; the copies are destroyed after the
+    // GIL has been re-acquired. Until then, `training` prevents the model
+    // itself from being used from python.
+    dtptr X(dt_X->copy());
+    dtptr y(dt_y->copy());
+    training = true;
+    std::exception_ptr next_error = nullptr;
+    std::thread reader([&] {
+      py::gil_acquire gil;
+      try {
+        ++it;
+        if (it == end && PyErr_Occurred()) throw PyError();
+      } catch (...) {
+        next_error = std::current_exception();
+      }
+    });
+    try {
+      dtft->dispatch_fit(X.get(), y.get(), nullptr, nullptr, nan, nan,
+                         /* release_gil = */ true);
+    } catch (...) {
+      {
+        py::gil_release nogil;
+        reader.join();
+      }
+      training = false;
+      throw;
+    }
+    {
+      py::gil_release nogil;
+      reader.join();
+    }
+    training = false;
+    if (next_error) std::rethrow_exception(next_error);
+    nbatches++;
+
+    // Calculate loss on the validation dataset and do early stopping,
+    // if the loss does not improve.
+    if (validation) {
+      double loss = dtft->dispatch_loss(dt_X_val, dt_y_val);
+      double loss_diff = (loss_prev - loss) / loss_prev;
+      if (nbatches > 1 && (loss < epsilon || loss_diff < val_error)) break;
+      loss_prev = loss;
+    }
+  }
+  if (nbatches == 0 && PyErr_Occurred()) throw PyError();
+  return py::oint(nbatches);
 }
 
 
@@ -368,6 +557,7 @@ for each row of frame X and each label the model was trained for.
 
 
 oobj Ftrl::predict(const PKArgs& args) {
+  check_not_training();
   const Arg& arg_X = args[0];
   if (arg_X.is_undefined()) {
     throw ValueError() << "Frame to make predictions for is missing";
@@ -426,12 +616,46 @@ None
 
 
 void Ftrl::reset(const PKArgs&) {
+  check_not_training();
   dtft->reset();
   py_interactions = py::None();
   colnames.clear();
 }
 
 
+/*
+*  .finalize()
+*  Finalize the model for inference by making a call to `dtft->finalize()`.
+*/
+static PKArgs args_finalize(0, 0, 0, false, false, {}, "finalize",
+R"(finalize(self)
+--
+
+Finalize a trained FTRL model for inference. The model weights are
+calculated once, and only the non-zero ones are kept in a compact
+hash table, that is then used for all the subsequent predictions.
+This makes predictions faster, and usually reduces the memory footprint
+of the model by orders of magnitude, especially with L1 regularization.
+
+A finalized model cannot be trained any further, and its `model` frame
+is no longer available. Use `reset()` to make the model trainable again.
+
+Parameters
+----------
+None
+
+Returns
+-------
+None
+)");
+
+
+void Ftrl::finalize(const PKArgs&) {
+  check_not_training();
+  dtft->finalize();
+}
+
+
 /*
 *  .labels
 */
@@ -441,6 +665,7 @@ static GSArgs args_labels(
 
 
 oobj Ftrl::get_labels() const {
+  check_not_training();
   if (dtft->is_trained()) {
     const strvec& labels = dtft->get_labels();
     size_t nlabels = labels.size();
@@ -458,6 +683,7 @@ oobj Ftrl::get_labels() const {
 
 
 void Ftrl::set_labels(robj py_labels) {
+  check_not_training();
   if (py_labels.is_list()) {
     py::olist py_labels_list = py_labels.to_pylist();
     size_t nlabels = py_labels_list.size();
@@ -484,7 +710,8 @@ contain z model coefficients, and even columns n model coefficients.)");
 
 
 oobj Ftrl::get_model() const {
-  if (!dtft->is_trained()) return py::None();
+  check_not_training();
+  if (!dtft->is_trained() || dtft->is_finalized()) return py::None();
 
   DataTable* dt_model = dtft->get_model();
   py::oobj df_model = py::oobj::from_new_reference(
@@ -494,7 +721,57 @@ oobj Ftrl::get_model() const {
 }
 
 
+/*
+*  .finalized
+*/
+static GSArgs args_finalized(
+  "finalized",
+  "Whether the model was finalized for inference, see `finalize()`");
+
+
+oobj Ftrl::get_finalized() const {
+  check_not_training();
+  return dtft->is_finalized()? True() : False();
+}
+
+
+/*
+*  Weights of a finalized model, these are only used for pickling.
+*/
+oobj Ftrl::get_weights() const {
+  check_not_training();
+  DataTable* dt_weights = dtft->get_weights();
+  if (dt_weights == nullptr) return py::None();
+  return py::oobj::from_new_reference(py::Frame::from_datatable(dt_weights));
+}
+
+
+void Ftrl::set_weights(robj weights) {
+  check_not_training();
+  DataTable* dt_weights = weights.to_datatable();
+  if (dt_weights == nullptr) return;
+
+  SType stype = dtft->get_double_precision()? SType::FLOAT64 : SType::FLOAT32;
+  size_t ncols = dt_weights->ncols;
+  if (ncols < 2 || dt_weights->columns[0]->stype() != SType::INT64) {
+    throw ValueError() << "Weights frame must have an int64 column of bins, "
+                       << "followed by the weight columns";
+  }
+  for (size_t i = 0; i < ncols; ++i) {
+    Column* col = dt_weights->columns[i];
+    col->materialize();
+    if (i && col->stype() != stype) {
+      throw ValueError() << "Column " << i << " in the weights frame should "
+                         << "have a type of " << stype << ", whereas it has "
+                         << "the following type: " << col->stype();
+    }
+  }
+  dtft->set_weights(dt_weights);
+}
+
+
 void Ftrl::set_model(robj model) {
+  check_not_training();
   DataTable* dt_model = model.to_datatable();
   if (dt_model == nullptr) return;
 
@@ -545,10 +822,12 @@ feature importances normalized to [0; 1].)");
 
 
 oobj Ftrl::get_fi() const {
+  check_not_training();
   return get_normalized_fi(true);
 }
 
 oobj Ftrl::get_normalized_fi(bool normalize) const {
+  check_not_training();
   if (!dtft->is_trained()) return py::None();
 
   DataTable* dt_fi = dtft->get_fi(normalize);
@@ -569,6 +848,7 @@ static GSArgs args_colnames(
 
 
 oobj Ftrl::get_colnames() const {
+  check_not_training();
   if (dtft->is_trained()) {
     size_t ncols = colnames.size();
     py::olist py_colnames(ncols);
@@ -583,6 +863,7 @@ oobj Ftrl::get_colnames() const {
 
 
 void Ftrl::set_colnames(robj py_colnames) {
+  check_not_training();
   if (py_colnames.is_list()) {
     py::olist py_colnames_list = py_colnames.to_pylist();
     size_t ncolnames = py_colnames_list.size();
@@ -605,6 +886,7 @@ static GSArgs args_colname_hashes(
 
 
 oobj Ftrl::get_colname_hashes() const {
+  check_not_training();
   if (dtft->is_trained()) {
     size_t ncols = dtft->get_ncols();
     py::olist py_colname_hashes(ncols);
@@ -634,6 +916,7 @@ oobj Ftrl::get_alpha() const {
 
 
 void Ftrl::set_alpha(robj py_alpha) {
+  check_not_training();
   double alpha = py_alpha.to_double();
   py::Validator::check_positive(alpha, py_alpha);
   dtft->set_alpha(alpha);
@@ -654,6 +937,7 @@ oobj Ftrl::get_beta() const {
 
 
 void Ftrl::set_beta(robj py_beta) {
+  check_not_training();
   double beta = py_beta.to_double();
   py::Validator::check_not_negative(beta, py_beta);
   dtft->set_beta(beta);
@@ -674,6 +958,7 @@ oobj Ftrl::get_lambda1() const {
 
 
 void Ftrl::set_lambda1(robj py_lambda1) {
+  check_not_training();
   double lambda1 = py_lambda1.to_double();
   py::Validator::check_not_negative(lambda1, py_lambda1);
   dtft->set_lambda1(lambda1);
@@ -694,6 +979,7 @@ oobj Ftrl::get_lambda2() const {
 
 
 void Ftrl::set_lambda2(robj py_lambda2) {
+  check_not_training();
   double lambda2 = py_lambda2.to_double();
   py::Validator::check_not_negative(lambda2, py_lambda2);
   dtft->set_lambda2(lambda2);
@@ -714,6 +1000,7 @@ oobj Ftrl::get_nbins() const {
 
 
 void Ftrl::set_nbins(robj py_nbins) {
+  check_not_training();
   if (dtft->is_trained()) {
     throw ValueError() << "Cannot change `nbins` for a trained model, "
                        << "reset this model or create a new one";
@@ -739,6 +1026,7 @@ oobj Ftrl::get_nepochs() const {
 
 
 void Ftrl::set_nepochs(robj py_nepochs) {
+  check_not_training();
   size_t nepochs = py_nepochs.to_size_t();
   dtft->set_nepochs(nepochs);
 }
@@ -758,6 +1046,7 @@ oobj Ftrl::get_interactions() const {
 
 
 void Ftrl::set_interactions(robj arg_interactions) {
+  check_not_training();
   if (dtft->is_trained())
     throw ValueError() << "Cannot change `interactions` for a trained model, "
                        << "reset this model or create a new one";
@@ -797,6 +1086,7 @@ oobj Ftrl::get_double_precision() const {
 
 
 void Ftrl::set_double_precision(robj py_double_precision) {
+  check_not_training();
   if (dtft->is_trained()) {
     throw ValueError() << "Cannot change `double_precision` for a trained model, "
                        << "reset this model or create a new one";
@@ -806,6 +1096,26 @@ void Ftrl::set_double_precision(robj py_double_precision) {
 }
 
 
+/*
+*  .deterministic
+*/
+static GSArgs args_deterministic(
+  "deterministic",
+  "Whether to train the model in a deterministic (reproducible) mode");
+
+
+oobj Ftrl::get_deterministic() const {
+  return dtft->get_deterministic()? True() : False();
+}
+
+
+void Ftrl::set_deterministic(robj py_deterministic) {
+  check_not_training();
+  bool deterministic = py_deterministic.to_bool_strict();
+  dtft->set_deterministic(deterministic);
+}
+
+
 
 /*
 *  .params
@@ -852,6 +1162,7 @@ oobj Ftrl::get_params_tuple() const {
 
 
 void Ftrl::set_params_tuple(robj params) {
+  check_not_training();
   py::otuple params_tuple = params.to_otuple();
   size_t n_params = params_tuple.size();
   if (n_params != 7) {
@@ -876,6 +1187,7 @@ static PKArgs args___getstate__(
 
 
 oobj Ftrl::m__getstate__(const PKArgs&) {
+  check_not_training();
   py::oobj py_params = get_params_tuple();
   py::oobj py_model = get_model();
   py::oobj py_fi = get_normalized_fi(false);
@@ -886,7 +1198,8 @@ oobj Ftrl::m__getstate__(const PKArgs&) {
   py::oobj py_colnames = get_colnames();
 
   return otuple {py_params, py_model, py_fi, py_model_type, py_labels,
-                 py_interactions, py_colnames};
+                 py_interactions, py_colnames, get_deterministic(),
+                 get_weights()};
 }
 
 
@@ -897,6 +1210,7 @@ static PKArgs args___setstate__(
     1, 0, 0, false, false, {"state"}, "__setstate__", nullptr);
 
 void Ftrl::m__setstate__(const PKArgs& args) {
+  check_not_training();
   m__dealloc__();
   dt::FtrlParams ftrl_params;
 
@@ -919,6 +1233,9 @@ void Ftrl::m__setstate__(const PKArgs& args) {
   set_labels(pickle[4]);
   py_interactions = pickle[5];
   set_colnames(pickle[6]);
+  // The training mode was not saved by the older versions
+  if (pickle.size() > 7) set_deterministic(pickle[7]);
+  if (pickle.size() > 8) set_weights(pickle[8]);
 }
 
 
@@ -954,6 +1271,13 @@ interactions : bool
     Switch to enable second order feature interactions.
 double_precision : bool
     Whether to use double precision arithmetic or not.
+deterministic : bool
+    Train the model in a deterministic mode: the data is processed in
+    blocks of rows, and each model coefficient is updated by a single
+    thread only, so that the trained model is the same on every run
+    regardless of the number of threads. By default, the threads update
+    the shared model coefficients without any synchronization ("Hogwild!"),
+    which is faster but not reproducible.
 )";
 }
 
@@ -965,6 +1289,7 @@ void Ftrl::Type::init_methods_and_getsets(Methods& mm, GetSetters& gs)
 {
   ADD_GETTER(gs, &Ftrl::get_labels, args_labels);
   ADD_GETTER(gs, &Ftrl::get_model, args_model);
+  ADD_GETTER(gs, &Ftrl::get_finalized, args_finalized);
   ADD_GETTER(gs, &Ftrl::get_fi, args_fi);
   ADD_GETTER(gs, &Ftrl::get_params_namedtuple, args_params);
   ADD_GETTER(gs, &Ftrl::get_colnames, args_colnames);
@@ -978,11 +1303,15 @@ void Ftrl::Type::init_methods_and_getsets(Methods& mm, GetSetters& gs)
   ADD_GETSET(gs, &Ftrl::get_interactions, &Ftrl::set_interactions,
              args_interactions);
   ADD_GETTER(gs, &Ftrl::get_double_precision, args_double_precision);
+  ADD_GETSET(gs, &Ftrl::get_deterministic, &Ftrl::set_deterministic,
+             args_deterministic);
   ADD_METHOD(mm, &Ftrl::m__getstate__, args___getstate__);
   ADD_METHOD(mm, &Ftrl::m__setstate__, args___setstate__);
   ADD_METHOD(mm, &Ftrl::fit, args_fit);
+  ADD_METHOD(mm, &Ftrl::partial_fit, args_partial_fit);
   ADD_METHOD(mm, &Ftrl::predict, args_predict);
   ADD_METHOD(mm, &Ftrl::reset, args_reset);
+  ADD_METHOD(mm, &Ftrl::finalize, args_finalize);
 }
 
 
@@ -38,6 +38,9 @@ class Ftrl : public PyObject {
     dt::Ftrl* dtft;
     py::oobj py_interactions;
     strvec colnames;
+    // Set while `partial_fit()` trains the model without holding the GIL.
+    // In the meantime the model may not be used from other python threads.
+    bool training;
 
   public:
     class Type : public ExtType<Ftrl> {
@@ -59,15 +62,22 @@ class Ftrl : public PyObject {
 
     // Learning and predicting methods
     oobj fit(const PKArgs&);
+    oobj partial_fit(const PKArgs&);
     oobj predict(const PKArgs&);
     void reset(const PKArgs&);
+    void finalize(const PKArgs&);
     std::vector<sizetvec> convert_interactions();
+    void check_training_frames(DataTable*, DataTable*);
+    void check_not_training() const;
+    void check_validation_frames(DataTable*, DataTable*, DataTable*);
 
     // Getters
     oobj get_labels() const;
     oobj get_fi() const;
     oobj get_normalized_fi(bool) const;
     oobj get_model() const;
+    oobj get_finalized() const;
+    oobj get_weights() const;         // Not exposed, used for pickling only
     oobj get_colnames() const;
     oobj get_colname_hashes() const;
     oobj get_params_namedtuple() const;
@@ -80,9 +90,11 @@ class Ftrl : public PyObject {
     oobj get_nepochs() const;
     oobj get_interactions() const;
     oobj get_double_precision() const;
+    oobj get_deterministic() const;
 
     // Setters
     void set_model(robj);             // Not exposed, used for unpickling only
+    void set_weights(robj);           // Not exposed, used for unpickling only
     void set_labels(robj);            // Not exposed, used for unpickling only
     void set_colnames(robj);          // Not exposed, used for unpickling only
     void set_params_tuple(robj);      // Not exposed, used for unpickling only
@@ -94,6 +106,7 @@ class Ftrl : public PyObject {
     void set_nbins(robj);             // Disabled for a trained model
     void set_interactions(robj);      // Disabled for a trained model
     void set_double_precision(robj);  // Not exposed, used for unpickling only
+    void set_deterministic(robj);
 };
 
 
@@ -30,6 +30,11 @@ int64_t frame_names_auto_index = 0;
 std::string frame_names_auto_prefix = "C";
 bool display_interactive = false;
 bool display_interactive_hint = true;
+size_t memory_limit = 0;
+std::string memory_spill_dir;
+bool memory_hugepages = true;
+bool memory_first_touch = false;
+bool profile = false;
 
 
 int32_t normalize_nthreads(int32_t nth) {
@@ -98,6 +103,12 @@ void set_fread_anonymize(int8_t v) {
   fread_anonymize = v;
 }
 
+void set_memory_limit(int64_t n) {
+  if (n < 0)
+    throw ValueError() << "Invalid memory.limit parameter: " << n;
+  memory_limit = static_cast<size_t>(n);
+}
+
 
 
 static py::PKArgs args_set_option(
@@ -148,6 +159,21 @@ static py::oobj set_option(const py::PKArgs& args) {
   } else if (name == "display.interactive_hint") {
     display_interactive_hint = value.to_bool_strict();
 
+  } else if (name == "memory.limit") {
+    set_memory_limit(value.to_int64_strict());
+
+  } else if (name == "memory.spill_dir") {
+    memory_spill_dir = value.to_string();
+
+  } else if (name == "memory.hugepages") {
+    memory_hugepages = value.to_bool_strict();
+
+  } else if (name == "memory.first_touch") {
+    memory_first_touch = value.to_bool_strict();
+
+  } else if (name == "profile") {
+    profile = value.to_bool_strict();
+
   } else {
     // throw ValueError() << "Unknown option `" << name << "`";
   }
@@ -203,6 +229,21 @@ static py::oobj get_option(const py::PKArgs& args) {
   } else if (name == "display.interactive_hint") {
     return py::obool(display_interactive_hint);
 
+  } else if (name == "memory.limit") {
+    return py::oint(memory_limit);
+
+  } else if (name == "memory.spill_dir") {
+    return py::ostring(memory_spill_dir);
+
+  } else if (name == "memory.hugepages") {
+    return py::obool(memory_hugepages);
+
+  } else if (name == "memory.first_touch") {
+    return py::obool(memory_first_touch);
+
+  } else if (name == "profile") {
+    return py::obool(profile);
+
   } else {
     throw ValueError() << "Unknown option `" << name << "`";
   }
@@ -25,6 +25,11 @@ extern int64_t frame_names_auto_index;
 extern std::string frame_names_auto_prefix;
 extern bool display_interactive;
 extern bool display_interactive_hint;
+extern size_t memory_limit;
+extern std::string memory_spill_dir;
+extern bool memory_hugepages;
+extern bool memory_first_touch;
+extern bool profile;
 
 int32_t normalize_nthreads(int32_t nth);
 void set_nthreads(int32_t n);
@@ -36,6 +41,7 @@ void set_sort_max_radix_bits(int64_t n);
 void set_sort_over_radix_bits(int64_t n);
 void set_sort_nthreads(int32_t n);
 void set_fread_anonymize(int8_t v);
+void set_memory_limit(int64_t n);
 
 
 }
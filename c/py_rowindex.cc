@@ -48,6 +48,8 @@ oobj orowindex::pyobject::m__repr__() {
   if (ri->isarr64()) out << "int64[" << ri->size() << "]";
   if (ri->isslice()) out << ri->slice_start() << '/' << ri->size() << '/'
                          << static_cast<int64_t>(ri->slice_step());
+  if (ri->type() == RowIndexType::BITMAP) out << "bitmap[" << ri->size() << "]";
+  if (ri->type() == RowIndexType::RUNS) out << "runs[" << ri->size() << "]";
   out << ")";
   return ostring(out.str());
 }
@@ -60,7 +62,9 @@ oobj orowindex::pyobject::get_type() const {
   RowIndexType rt = ri->type();
   return rt == RowIndexType::SLICE? ostring("slice") :
          rt == RowIndexType::ARR32? ostring("arr32") :
-         rt == RowIndexType::ARR64? ostring("arr64") : None();
+         rt == RowIndexType::ARR64? ostring("arr64") :
+         rt == RowIndexType::BITMAP? ostring("bitmap") :
+         rt == RowIndexType::RUNS? ostring("runs") : None();
 }
 
 
@@ -0,0 +1,32 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+#include "python/gil.h"
+
+namespace py {
+
+
+gil_release::gil_release() {
+  state = PyGILState_Check()? PyEval_SaveThread() : nullptr;
+}
+
+gil_release::~gil_release() {
+  if (state) PyEval_RestoreThread(state);
+}
+
+
+
+gil_acquire::gil_acquire() {
+  state = PyGILState_Ensure();
+}
+
+gil_acquire::~gil_acquire() {
+  PyGILState_Release(state);
+}
+
+
+}  // namespace py
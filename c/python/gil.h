@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+#ifndef dt_PYTHON_GIL_h
+#define dt_PYTHON_GIL_h
+#include <Python.h>
+
+namespace py {
+
+
+/**
+ * Release the GIL for the lifetime of this object, allowing other python
+ * threads to run while we are busy doing pure C++ work:
+ *
+ *     {
+ *       py::gil_release nogil;
+ *       ... long-running computation ...
+ *     }  // the GIL is re-acquired here
+ *
+ * Within the scope of this object, the code must not touch any python
+ * objects, not even their refcounts (this includes copying or destroying
+ * `py::oobj`s, and deleting columns that may own a python buffer). The only
+ * exception is a nested `py::gil_acquire` scope.
+ *
+ * If the current thread does not hold the GIL (for example, because the
+ * GIL was already released by an outer scope), then this object does
+ * nothing. Thus, it is safe to nest these objects.
+ */
+class gil_release {
+  private:
+    PyThreadState* state;
+
+  public:
+    gil_release();
+    gil_release(const gil_release&) = delete;
+    gil_release& operator=(const gil_release&) = delete;
+    ~gil_release();
+};
+
+
+
+/**
+ * Acquire the GIL for the lifetime of this object. This can be used to call
+ * into python (e.g. for logging, or for reporting progress) from within the
+ * scope of `py::gil_release`. If the current thread already holds the GIL,
+ * this object does nothing.
+ *
+ * Only the thread that released the GIL may re-acquire it: the worker
+ * threads of the thread pool have no python thread state, and must never
+ * attempt to call into python.
+ */
+class gil_acquire {
+  private:
+    PyGILState_STATE state;
+
+  public:
+    gil_acquire();
+    gil_acquire(const gil_acquire&) = delete;
+    gil_acquire& operator=(const gil_acquire&) = delete;
+    ~gil_acquire();
+};
+
+
+}  // namespace py
+
+#endif
@@ -5,6 +5,7 @@
 //
 // © H2O.ai 2018
 //------------------------------------------------------------------------------
+#include <cstring>             // std::memcmp, std::memcpy
 #include "python/string.h"
 #include "utils/exceptions.h"
 
@@ -60,5 +61,70 @@ ostring& ostring::operator=(ostring&& other) {
 }
 
 
+//------------------------------------------------------------------------------
+// ostring_cache
+//------------------------------------------------------------------------------
+
+constexpr size_t ostring_cache::MAX_CACHED_LENGTH;
+constexpr size_t ostring_cache::MAX_CACHE_SIZE;
+
+bool ostring_cache::strref::operator==(const strref& o) const {
+  return len == o.len && std::memcmp(ch, o.ch, len) == 0;
+}
+
+// FNV-1a hash
+size_t ostring_cache::strref_hash::operator()(const strref& s) const {
+  uint64_t h = 14695981039346656037ULL;
+  for (size_t i = 0; i < s.len; ++i) {
+    h = (h ^ static_cast<uint8_t>(s.ch[i])) * 1099511628211ULL;
+  }
+  return static_cast<size_t>(h);
+}
+
+
+bool ostring_cache::is_ascii(const char* ch, size_t len) {
+  auto p = reinterpret_cast<const uint8_t*>(ch);
+  uint8_t acc = 0;
+  for (size_t i = 0; i < len; ++i) acc |= p[i];
+  return !(acc & 0x80);
+}
+
+
+PyObject* ostring_cache::get(const char* ch, size_t len, bool ascii) {
+  PyObject* res = lookup(ch, len);
+  return res? res : create(ch, len, ascii);
+}
+
+PyObject* ostring_cache::get(const char* ch, size_t len) {
+  PyObject* res = lookup(ch, len);
+  return res? res : create(ch, len, is_ascii(ch, len));
+}
+
+
+PyObject* ostring_cache::lookup(const char* ch, size_t len) {
+  if (len > MAX_CACHED_LENGTH) return nullptr;
+  auto it = cache.find(strref {ch, len});
+  if (it == cache.end()) return nullptr;
+  Py_INCREF(it->second);
+  return it->second;
+}
+
+PyObject* ostring_cache::create(const char* ch, size_t len, bool ascii) {
+  PyObject* res;
+  if (ascii) {
+    res = PyUnicode_New(static_cast<Py_ssize_t>(len), 127);
+    if (!res) throw PyError();
+    std::memcpy(PyUnicode_1BYTE_DATA(res), ch, len);
+  } else {
+    res = PyUnicode_FromStringAndSize(ch, static_cast<Py_ssize_t>(len));
+    if (!res) throw PyError();
+  }
+  if (len <= MAX_CACHED_LENGTH && cache.size() < MAX_CACHE_SIZE) {
+    cache.emplace(strref {ch, len}, res);
+  }
+  return res;
+}
+
+
 
 }  // namespace py
@@ -9,6 +9,7 @@
 #define dt_PYTHON_STRING_h
 #include <Python.h>
 #include <string>
+#include <unordered_map>
 #include "python/obj.h"
 
 namespace py {
@@ -35,6 +36,49 @@ class ostring : public oobj {
 };
 
 
+
+/**
+ * Helper for converting many strings (such as the values of a string
+ * column) into python `str` objects:
+ *   - strings that are known to be pure ASCII are created via
+ *     `PyUnicode_New()` + memcpy, bypassing the UTF-8 decoder;
+ *   - short strings are deduplicated, so that each distinct value is
+ *     converted only once, and then shared. This is very effective for
+ *     the columns with low cardinality.
+ *
+ * The cache holds borrowed references to the objects it created, so these
+ * objects must remain alive for as long as the cache is in use. The
+ * character data must also remain alive (and unmodified).
+ */
+class ostring_cache {
+  private:
+    struct strref {
+      const char* ch;
+      size_t len;
+      bool operator==(const strref& o) const;
+    };
+    struct strref_hash {
+      size_t operator()(const strref& s) const;
+    };
+    std::unordered_map<strref, PyObject*, strref_hash> cache;
+
+  public:
+    static constexpr size_t MAX_CACHED_LENGTH = 64;
+    static constexpr size_t MAX_CACHE_SIZE = 1 << 16;
+
+    // Return a new reference. The first form should be used when the
+    // ascii-ness of the string is already known; otherwise the second
+    // form determines it, but only when the string is not in the cache.
+    PyObject* get(const char* ch, size_t len, bool ascii);
+    PyObject* get(const char* ch, size_t len);
+    static bool is_ascii(const char* ch, size_t len);
+
+  private:
+    PyObject* lookup(const char* ch, size_t len);
+    PyObject* create(const char* ch, size_t len, bool ascii);
+};
+
+
 }  // namespace py
 
 #endif
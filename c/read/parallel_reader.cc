@@ -8,8 +8,11 @@
 #include "read/parallel_reader.h"
 #include <algorithm>           // std::max
 #include "csv/reader.h"
+#include "python/gil.h"
 #include "utils/assert.h"
 #include "utils/parallel.h"
+#include "utils/profiler.h"
+#include "utils/thread_pool.h"
 
 extern double wallclock();
 
@@ -142,141 +145,143 @@ double ParallelReader::work_done_amount() const {
  */
 void ParallelReader::read_all()
 {
-  // Any exceptions that are thrown within OMP blocks must be captured within
-  // the same block. If allowed to propagate, they may corrupt the stack and
-  // crash the program. This is why we have all code surrounded with
-  // try-catch clauses, and `OmpExceptionManager` to help us remember the
-  // exception that was thrown and manually propagate it outwards.
+  // Any exceptions that are thrown within parallel tasks must be captured
+  // within the same task, so that the other tasks could stop early. This is
+  // why we have all code surrounded with try-catch clauses, and
+  // `OmpExceptionManager` to help us remember the exception that was thrown
+  // and manually propagate it outwards.
   OmpExceptionManager oem;
-
-  #pragma omp parallel num_threads(nthreads)
-  {
-    bool tMaster = false;
-    #pragma omp master
-    {
-      size_t actual_nthreads = static_cast<size_t>(omp_get_num_threads());
-      if (actual_nthreads != nthreads) {
-        nthreads = actual_nthreads;
-        g.trace("Actual number of threads allowed by OMP: %zu", nthreads);
-        determine_chunking_strategy();
-      }
-      tMaster = true;
-    }
-    // Wait for master here: we want all threads to have consistent
-    // view of the chunking parameters.
-    #pragma omp barrier
-
-    // These variables control how the progress bar is shown. `tShowProgress`
-    // is the main flag telling us whether the progress bar should be shown
-    // or not by the current thread (note that only master thread can have
-    // this flag on -- this is because progress-reporting reaches to python
-    // runtime, and we can do that from a single thread only). When
-    // `tShowProgress` is on, the flag `tShowAlways` controls whether we need
-    // to show the progress right away, or wait until time moment `tShowWhen`.
-    // This is needed because we don't want the progress bar for really small
-    // and fast files. However if the file is big enough (>256MB) then it's ok
-    // to show the progress as soon as possible.
-    bool tShowProgress = g.report_progress && tMaster;
-    bool tShowAlways = tShowProgress && (input_end - input_start > (1 << 28));
-    double tShowWhen = tShowProgress? wallclock() + 0.75 : 0;
-
-    // Thread-local parse context. This object does most of the parsing job.
-    auto tctx = init_thread_context();
-    xassert(tctx);
-
-    // Helper variables for keeping track of chunk's coordinates:
-    // `txcc` has the expected chunk coordinates (i.e. as determined ex ante
-    // in `compute_chunk_coordinates()`), and `tacc` the actual chunk
-    // coordinates (i.e. how much data was actually read in `read_chunk()`).
-    // These two are very often the same; however when they do differ, it is
-    // the job of `order_chunk()` to reconcile the differences.
-    ChunkCoordinates txcc;
-    ChunkCoordinates tacc;
-
-    // Main data reading loop
-    #pragma omp for ordered schedule(dynamic)
-    for (size_t i = 0; i < chunk_count; ++i) {
-      if (oem.stop_requested()) continue;
-      try {
-        if (tMaster) g.emit_delayed_messages();
-        if (tShowAlways || (tShowProgress && wallclock() >= tShowWhen)) {
-          g.progress(work_done_amount());
-          tShowAlways = true;
+  dt::ordered_loop loop(chunk_count);
+
+  // Parsing the data does not require python, so we let other python
+  // threads run meanwhile. The messages and progress reports re-acquire
+  // the GIL when needed.
+  py::gil_release nogil;
+  dt::profile_scope ps("fread.parse");
+
+  dt::parallel_region(nthreads,
+    [&](size_t ith) {
+      // Task 0 is always executed by the calling thread, and therefore it is
+      // the only one allowed to call into python.
+      bool tMaster = (ith == 0);
+
+      // These variables control how the progress bar is shown. `tShowProgress`
+      // is the main flag telling us whether the progress bar should be shown
+      // or not by the current thread (note that only master thread can have
+      // this flag on -- this is because progress-reporting reaches to python
+      // runtime, and we can do that from a single thread only). When
+      // `tShowProgress` is on, the flag `tShowAlways` controls whether we need
+      // to show the progress right away, or wait until time moment `tShowWhen`.
+      // This is needed because we don't want the progress bar for really small
+      // and fast files. However if the file is big enough (>256MB) then it's ok
+      // to show the progress as soon as possible.
+      bool tShowProgress = g.report_progress && tMaster;
+      bool tShowAlways = tShowProgress && (input_end - input_start > (1 << 28));
+      double tShowWhen = tShowProgress? wallclock() + 0.75 : 0;
+
+      // Thread-local parse context. This object does most of the parsing job.
+      auto tctx = init_thread_context();
+      xassert(tctx);
+
+      // Helper variables for keeping track of chunk's coordinates:
+      // `txcc` has the expected chunk coordinates (i.e. as determined ex ante
+      // in `compute_chunk_coordinates()`), and `tacc` the actual chunk
+      // coordinates (i.e. how much data was actually read in `read_chunk()`).
+      // These two are very often the same; however when they do differ, it is
+      // the job of `order_chunk()` to reconcile the differences.
+      ChunkCoordinates txcc;
+      ChunkCoordinates tacc;
+
+      // Main data reading loop
+      size_t i;
+      while (loop.next(&i)) {
+        // Once stopped, the remaining chunks are skipped entirely
+        if (oem.stop_requested()) {
+          loop.wait_turn(i);
+          loop.end_turn(i);
+          continue;
         }
+        try {
+          if (tMaster) g.emit_delayed_messages();
+          if (tShowAlways || (tShowProgress && wallclock() >= tShowWhen)) {
+            g.progress(work_done_amount());
+            tShowAlways = true;
+          }
 
-        tctx->push_buffers();
-        txcc = compute_chunk_boundaries(i, tctx);
+          tctx->push_buffers();
+          txcc = compute_chunk_boundaries(i, tctx);
 
-        // Read the chunk with the expected coordinates `txcc`. The actual
-        // coordinates of the data read will be stored in variable `tacc`.
-        // If the method fails with a recoverable error (such as a type
-        // exception), it will return with `tacc.get_end() == nullptr`. If the
-        // method fails without possibility of recovery, it will raise an
-        // exception.
-        tctx->read_chunk(txcc, tacc);
+          // Read the chunk with the expected coordinates `txcc`. The actual
+          // coordinates of the data read will be stored in variable `tacc`.
+          // If the method fails with a recoverable error (such as a type
+          // exception), it will return with `tacc.get_end() == nullptr`. If the
+          // method fails without possibility of recovery, it will raise an
+          // exception.
+          tctx->read_chunk(txcc, tacc);
 
-      } catch (...) {
-        oem.capture_exception();
-      }
-
-      #pragma omp ordered
-      do {
-        if (oem.stop_requested()) {
-          tctx->used_nrows = 0;
-          break;
+        } catch (...) {
+          oem.capture_exception();
         }
-        try {
-          tctx->row0 = nrows_written;
-          order_chunk(tacc, txcc, tctx);
-
-          size_t nrows_new = nrows_written + tctx->used_nrows;
-          if (nrows_new > nrows_allocated) {
-            if (nrows_new > nrows_max) {
-              // more rows read than nrows_max, no need to reallocate
-              // the output, just truncate the rows in the current chunk.
-              xassert(nrows_max >= nrows_written);
-              tctx->used_nrows = nrows_max - nrows_written;
-              nrows_new = nrows_max;
-              realloc_output_columns(i, nrows_new);
-              oem.stop_iterations();
-            } else {
-              realloc_output_columns(i, nrows_new);
+
+        loop.wait_turn(i);
+        do {
+          if (oem.stop_requested()) {
+            tctx->used_nrows = 0;
+            break;
+          }
+          try {
+            tctx->row0 = nrows_written;
+            order_chunk(tacc, txcc, tctx);
+
+            size_t nrows_new = nrows_written + tctx->used_nrows;
+            if (nrows_new > nrows_allocated) {
+              if (nrows_new > nrows_max) {
+                // more rows read than nrows_max, no need to reallocate
+                // the output, just truncate the rows in the current chunk.
+                xassert(nrows_max >= nrows_written);
+                tctx->used_nrows = nrows_max - nrows_written;
+                nrows_new = nrows_max;
+                realloc_output_columns(i, nrows_new);
+                oem.stop_iterations();
+              } else {
+                realloc_output_columns(i, nrows_new);
+              }
             }
+            nrows_written = nrows_new;
+
+            tctx->orderBuffer();
+
+          } catch (...) {
+            oem.capture_exception();
           }
-          nrows_written = nrows_new;
+        } while (0);
+        loop.end_turn(i);
+      }
 
-          tctx->orderBuffer();
+      // Stopped early because of error. Discard the content of the buffers,
+      // because they were not ordered, and trying to push them may lead to
+      // unexpected bugs...
+      if (oem.exception_caught()) {
+        tctx->used_nrows = 0;
+      }
 
+      // Push out the buffers one last time.
+      if (tctx->used_nrows) {
+        try {
+          tctx->push_buffers();
         } catch (...) {
+          tctx->used_nrows = 0;
           oem.capture_exception();
         }
-      } while (0);  // #pragma omp ordered
-    }  // #pragma omp for ordered
-
-    // Stopped early because of error. Discard the content of the buffers,
-    // because they were not ordered, and trying to push them may lead to
-    // unexpected bugs...
-    if (oem.exception_caught()) {
-      tctx->used_nrows = 0;
-    }
-
-    // Push out the buffers one last time.
-    if (tctx->used_nrows) {
-      try {
-        tctx->push_buffers();
-      } catch (...) {
-        tctx->used_nrows = 0;
-        oem.capture_exception();
       }
-    }
 
-    // Report progress one last time
-    if (tMaster) g.emit_delayed_messages();
-    if (tShowAlways) {
-      int status = 1 + oem.exception_caught() + oem.is_keyboard_interrupt();
-      g.progress(work_done_amount(), status);
-    }
-  }  // #pragma omp parallel
+      // Report progress one last time
+      if (tMaster) g.emit_delayed_messages();
+      if (tShowAlways) {
+        int status = 1 + oem.exception_caught() + oem.is_keyboard_interrupt();
+        g.progress(work_done_amount(), status);
+      }
+    });
 
   // If any exception occurred, propagate it to the caller
   oem.rethrow_exception_if_any();
@@ -19,10 +19,12 @@
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 //------------------------------------------------------------------------------
-#include <cstring>     // std::memcpy
+#include <algorithm>   // std::min
+#include <cstring>     // std::memcpy, std::memset
 #include "utils/assert.h"
 #include "utils/misc.h"
 #include "utils/parallel.h"
+#include "column.h"
 #include "datatablemodule.h"
 #include "rowindex.h"
 #include "rowindex_impl.h"
@@ -102,17 +104,22 @@ RowIndex::RowIndex(arr64_t&& arr, size_t min, size_t max) {
 }
 
 RowIndex::RowIndex(filterfn32* f, size_t n, bool sorted) {
-  impl = (new ArrayRowIndexImpl(f, n, sorted))->acquire();
+  impl = (new ArrayRowIndexImpl(f, n, sorted))->compressed()->acquire();
   TRACK(this, sizeof(*this), "RowIndex");
 }
 
 RowIndex::RowIndex(filterfn64* f, size_t n, bool sorted) {
-  impl = (new ArrayRowIndexImpl(f, n, sorted))->acquire();
+  impl = (new ArrayRowIndexImpl(f, n, sorted))->compressed()->acquire();
   TRACK(this, sizeof(*this), "RowIndex");
 }
 
 RowIndex::RowIndex(const Column* col) {
-  impl = (new ArrayRowIndexImpl(col))->acquire();
+  RowIndexImpl* rii = nullptr;
+  if (col->stype() == SType::BOOL && !col->rowindex()) {
+    rii = compressed_rowindex_from_mask(static_cast<const BoolColumn*>(col));
+  }
+  if (!rii) rii = new ArrayRowIndexImpl(col);
+  impl = rii->acquire();
   TRACK(this, sizeof(*this), "RowIndex");
 }
 
@@ -151,6 +158,11 @@ bool RowIndex::isarray() const {
   return isarr32() || isarr64();
 }
 
+bool RowIndex::iscompressed() const {
+  return impl && (impl->type == RowIndexType::BITMAP ||
+                  impl->type == RowIndexType::RUNS);
+}
+
 const void* RowIndex::ptr() const {
   return static_cast<const void*>(impl);
 }
@@ -187,6 +199,24 @@ size_t RowIndex::slice_step() const noexcept {
   return slice_rowindex_get_step(impl);
 }
 
+const uint64_t* RowIndex::bitmap_words() const noexcept {
+  auto b = dynamic_cast<BitmapRowIndexImpl*>(impl);
+  return b? b->bitmap_words() : nullptr;
+}
+
+const int64_t* RowIndex::runs_starts() const noexcept {
+  auto r = dynamic_cast<RunsRowIndexImpl*>(impl);
+  return r? r->runs_starts() : nullptr;
+}
+const int64_t* RowIndex::runs_offsets() const noexcept {
+  auto r = dynamic_cast<RunsRowIndexImpl*>(impl);
+  return r? r->runs_offsets() : nullptr;
+}
+size_t RowIndex::runs_find(size_t i) const noexcept {
+  auto r = dynamic_cast<RunsRowIndexImpl*>(impl);
+  return r? r->find(i) : 0;
+}
+
 
 
 void RowIndex::clear() {
@@ -197,8 +227,8 @@ void RowIndex::clear() {
 
 void RowIndex::resize(size_t nrows) {
   xassert(impl);
-  if (impl->refcount > 1 || (impl->type == RowIndexType::SLICE &&
-                             impl->length < nrows)) {
+  if (impl->refcount > 1 || iscompressed() ||
+      (impl->type == RowIndexType::SLICE && impl->length < nrows)) {
     auto newimpl = impl->resized(nrows);
     xassert(newimpl->refcount == 0);
     impl->release();
@@ -231,6 +261,19 @@ void RowIndex::extract_into(arr32_t& target) const {
       }
       break;
     }
+    case RowIndexType::BITMAP:
+    case RowIndexType::RUNS: {
+      if (szlen <= INT32_MAX && max() <= INT32_MAX) {
+        dt::run_parallel(
+          [&](size_t i0, size_t i1, size_t di) {
+            iterate(i0, i1, di,
+              [&](size_t i, size_t j) {
+                target[i] = static_cast<int32_t>(j);
+              });
+          }, szlen);
+      }
+      break;
+    }
     default:
       break;
   }
@@ -290,7 +333,16 @@ RowIndex RowIndex::negate(size_t nrows) const {
     throw ValueError() << "Invalid nrows=" << nrows << " for a RowIndex with "
                           "largest index " << max();
   }
-  return RowIndex(impl->negate(nrows));
+  RowIndexImpl* res = impl->negate(nrows);
+  if (res->type == RowIndexType::ARR32 || res->type == RowIndexType::ARR64) {
+    res = static_cast<ArrayRowIndexImpl*>(res)->compressed();
+    return RowIndex(res);
+  }
+  // A negated BITMAP or RUNS index may have become dense, sparse, or a
+  // single run of rows: choose the representation for it anew.
+  RowIndex ri(res);
+  RowIndexImpl* better = recompressed(ri);
+  return better? RowIndex(better) : ri;
 }
 
 
@@ -308,6 +360,232 @@ void RowIndex::verify_integrity() const {
 
 
 
+//------------------------------------------------------------------------------
+// Compressed RowIndex construction
+//------------------------------------------------------------------------------
+
+// RowIndices shorter than this are always kept as arrays: compressed forms
+// have slower random access, and for small frames the memory savings are
+// negligible anyways.
+static constexpr size_t MIN_COMPRESSED_LENGTH = 65536;
+
+
+/**
+ * Given a strictly ascending sequence of `n` row indices with the largest
+ * index `jmax`, and which form `nruns` runs of consecutive rows, decide
+ * whether the sequence should be stored as a BITMAP, as RUNS, or as an array
+ * (in which case UNKNOWN is returned). A compressed form is chosen only when
+ * it is at least twice smaller than the array.
+ */
+static RowIndexType choose_compressed_type(size_t n, size_t jmax, size_t nruns)
+{
+  if (n < MIN_COMPRESSED_LENGTH) return RowIndexType::UNKNOWN;
+  size_t array_size = n * ((n <= INT32_MAX && jmax <= INT32_MAX)? 4 : 8);
+  size_t bitmap_size = jmax / 8 + n / 8;
+  size_t runs_size = nruns * 16;
+  if (2 * std::min(bitmap_size, runs_size) > array_size) {
+    return RowIndexType::UNKNOWN;
+  }
+  return (runs_size <= bitmap_size)? RowIndexType::RUNS : RowIndexType::BITMAP;
+}
+
+
+// "Generators" of row indices for `try_compress()` below. Each generator,
+// when invoked with a function `fn`, calls `fn(i, j)` for every `i` from 0
+// to n-1 in order, where `j` is the `i`-th row index.
+
+template <typename T>
+struct array_gen {
+  const T* indices;
+  size_t n;
+  template <typename F> void operator()(F fn) const {
+    for (size_t i = 0; i < n; ++i) {
+      fn(i, static_cast<size_t>(indices[i]));
+    }
+  }
+};
+
+struct mask_gen {
+  const int8_t* mask;
+  size_t nrows;
+  template <typename F> void operator()(F fn) const {
+    size_t i = 0;
+    for (size_t j = 0; j < nrows; ++j) {
+      if (mask[j] == 1) fn(i++, j);
+    }
+  }
+};
+
+struct compose_gen {
+  const RowIndex& ab;
+  const RowIndex& bc;
+  template <typename F> void operator()(F fn) const {
+    ab.iterate(0, ab.size(), 1,
+      [&](size_t i, size_t p) {
+        fn(i, p == RowIndex::NA? RowIndex::NA : bc[p]);
+      });
+  }
+};
+
+
+/**
+ * Build a compressed RowIndex from the `n` row indices produced by `gen`.
+ * The generator is invoked twice: first to verify that the indices are
+ * strictly ascending and to count the runs, and then to fill in the chosen
+ * representation. Returns nullptr if the indices are not ascending, or if an
+ * array representation is preferable.
+ */
+template <typename G>
+static RowIndexImpl* try_compress(size_t n, const G& gen) {
+  if (n < MIN_COMPRESSED_LENGTH) return nullptr;
+  bool ok = true;
+  size_t nruns = 0;
+  size_t prev = 0;
+  gen([&](size_t i, size_t j) {
+    if (j == RowIndex::NA || (i && j <= prev)) ok = false;
+    if (i == 0 || j != prev + 1) nruns++;
+    prev = j;
+  });
+  if (!ok) return nullptr;
+
+  size_t jmax = prev;
+  RowIndexType rt = choose_compressed_type(n, jmax, nruns);
+  if (rt == RowIndexType::BITMAP) {
+    size_t nbits = jmax + 1;
+    dt::array<uint64_t> words((nbits + 63) / 64);
+    uint64_t* wdata = words.data();
+    std::memset(wdata, 0, words.size() * sizeof(uint64_t));
+    gen([&](size_t, size_t j) {
+      wdata[j >> 6] |= uint64_t(1) << (j & 63);
+    });
+    return new BitmapRowIndexImpl(std::move(words), nbits);
+  }
+  if (rt == RowIndexType::RUNS) {
+    arr64_t starts(nruns);
+    arr64_t offsets(nruns + 1);
+    size_t k = 0;
+    gen([&](size_t i, size_t j) {
+      if (i == 0 || j != prev + 1) {
+        starts[k] = static_cast<int64_t>(j);
+        offsets[k] = static_cast<int64_t>(i);
+        k++;
+      }
+      prev = j;
+    });
+    xassert(k == nruns);
+    offsets[nruns] = static_cast<int64_t>(n);
+    return new RunsRowIndexImpl(std::move(starts), std::move(offsets));
+  }
+  return nullptr;
+}
+
+
+struct rowindex_gen {
+  const RowIndex& ri;
+  template <typename F> void operator()(F fn) const {
+    ri.iterate(0, ri.size(), 1, fn);
+  }
+};
+
+
+/**
+ * Choose the most compact representation for an ascending compressed
+ * (BITMAP or RUNS) RowIndex `ri`: a SLICE if the rows form a single run, an
+ * ARR32/ARR64 array if neither compressed form is at least twice smaller, or
+ * otherwise whichever of BITMAP / RUNS is smaller. Returns nullptr if `ri`
+ * already has the best representation.
+ */
+RowIndexImpl* recompressed(const RowIndex& ri) {
+  size_t n = ri.size();
+  if (n == 0) return new SliceRowIndexImpl(0, 0, 1);
+  rowindex_gen gen { ri };
+  size_t nruns = 0;
+  size_t prev = 0;
+  gen([&](size_t i, size_t j) {
+    if (i == 0 || j != prev + 1) nruns++;
+    prev = j;
+  });
+  if (nruns == 1) return new SliceRowIndexImpl(ri.min(), n, 1);
+
+  size_t jmax = ri.max();
+  RowIndexType rt = choose_compressed_type(n, jmax, nruns);
+  if (rt == ri.type()) return nullptr;
+  if (rt != RowIndexType::UNKNOWN) return try_compress(n, gen);
+  if (n <= INT32_MAX && jmax <= INT32_MAX) {
+    arr32_t rows(n);
+    int32_t* out = rows.data();
+    gen([&](size_t i, size_t j) { out[i] = static_cast<int32_t>(j); });
+    return new ArrayRowIndexImpl(std::move(rows), /* sorted = */ true);
+  } else {
+    arr64_t rows(n);
+    int64_t* out = rows.data();
+    gen([&](size_t i, size_t j) { out[i] = static_cast<int64_t>(j); });
+    return new ArrayRowIndexImpl(std::move(rows), /* sorted = */ true);
+  }
+}
+
+
+RowIndexImpl* compressed_rowindex_from_mask(const BoolColumn* col) {
+  xassert(!col->rowindex());
+  size_t n = static_cast<size_t>(col->sum());
+  return try_compress(n, mask_gen { col->elements_r(), col->nrows });
+}
+
+
+RowIndexImpl* ArrayRowIndexImpl::compressed() {
+  if (!ascending || length < MIN_COMPRESSED_LENGTH) return this;
+  xassert(refcount == 0);
+  RowIndexImpl* res =
+      (type == RowIndexType::ARR32)
+        ? try_compress(length, array_gen<int32_t> { indices32(), length })
+        : try_compress(length, array_gen<int64_t> { indices64(), length });
+  if (!res) return this;
+  delete this;
+  return res;
+}
+
+
+RowIndexImpl* uplift_compressed(const RowIndexImpl* ab, const RowIndexImpl* bc)
+{
+  xassert(ab->max < bc->length || ab->max == RowIndex::NA);
+  // Both `ab` and `bc` are owned by some RowIndex objects at this point, so
+  // wrapping them temporarily does not risk deleting them.
+  xassert(ab->refcount && bc->refcount);
+  RowIndex riab(const_cast<RowIndexImpl*>(ab));
+  RowIndex ribc(const_cast<RowIndexImpl*>(bc));
+  size_t n = ab->length;
+  bool sorted = ab->ascending && bc->ascending;
+  if (sorted) {
+    RowIndexImpl* res = try_compress(n, compose_gen { riab, ribc });
+    if (res) return res;
+  }
+  if (n <= INT32_MAX && (bc->max <= INT32_MAX || bc->max == RowIndex::NA)) {
+    arr32_t rows(n);
+    int32_t* out = rows.data();
+    dt::run_parallel(
+      [&](size_t i0, size_t i1, size_t di) {
+        riab.iterate(i0, i1, di,
+          [&](size_t i, size_t p) {
+            out[i] = (p == RowIndex::NA)? -1 : static_cast<int32_t>(ribc[p]);
+          });
+      }, n);
+    return new ArrayRowIndexImpl(std::move(rows), sorted);
+  } else {
+    arr64_t rows(n);
+    int64_t* out = rows.data();
+    dt::run_parallel(
+      [&](size_t i0, size_t i1, size_t di) {
+        riab.iterate(i0, i1, di,
+          [&](size_t i, size_t p) {
+            out[i] = (p == RowIndex::NA)? -1 : static_cast<int64_t>(ribc[p]);
+          });
+      }, n);
+    return new ArrayRowIndexImpl(std::move(rows), sorted);
+  }
+}
+
+
+
 
 //------------------------------------------------------------------------------
 // RowIndexImpl
@@ -33,6 +33,8 @@ enum class RowIndexType : uint8_t {
   ARR32 = 1,
   ARR64 = 2,
   SLICE = 3,
+  BITMAP = 4,
+  RUNS = 5,
 };
 
 using filterfn32 = int (size_t row0, size_t row1, int32_t* ind, size_t* nouts);
@@ -117,6 +119,11 @@ class RowIndex {
 
     /**
      * Create RowIndex from either a boolean or an integer column.
+     *
+     * When the boolean column selects a large fraction of its rows (or the
+     * selected rows form few contiguous runs), the RowIndex will be created
+     * in one of the compressed forms BITMAP or RUNS, whichever takes less
+     * memory. The filter-function constructors above do the same.
      */
     RowIndex(const Column* col);
 
@@ -132,6 +139,7 @@ class RowIndex {
     bool isarr32() const;
     bool isarr64() const;
     bool isarray() const;
+    bool iscompressed() const;  // is this a BITMAP or RUNS rowindex?
     const void* ptr() const;
 
     size_t size() const;
@@ -142,6 +150,10 @@ class RowIndex {
     const int64_t* indices64() const noexcept;
     size_t slice_start() const noexcept;
     size_t slice_step() const noexcept;
+    const uint64_t* bitmap_words() const noexcept;
+    const int64_t* runs_starts() const noexcept;
+    const int64_t* runs_offsets() const noexcept;
+    size_t runs_find(size_t i) const noexcept;
 
     void extract_into(arr32_t&) const;
 
@@ -217,6 +229,8 @@ class RowIndex {
 
   private:
     RowIndex(RowIndexImpl* rii);
+    friend RowIndexImpl* uplift_compressed(const RowIndexImpl*,
+                                           const RowIndexImpl*);
 };
 
 
@@ -266,6 +280,42 @@ void RowIndex::iterate(size_t i0, size_t i1, size_t di, F f) const {
       }
       break;
     }
+    case RowIndexType::BITMAP: {
+      if (i0 >= i1) break;
+      // Walk over the set bits of the bitmap, starting from the position
+      // of the `i0`-th selected row. When `di > 1` we skip `di - 1` set
+      // bits between consecutive elements, using popcount to jump over
+      // entire words at once.
+      const uint64_t* words = bitmap_words();
+      size_t j = (*this)[i0];
+      size_t k = j >> 6;
+      uint64_t w = words[k] & (~uint64_t(0) << (j & 63));
+      for (size_t i = i0; ; ) {
+        while (!w) w = words[++k];
+        f(i, (k << 6) + static_cast<size_t>(__builtin_ctzll(w)));
+        i += di;
+        if (i >= i1) break;
+        size_t d = di;
+        size_t c;
+        while ((c = static_cast<size_t>(__builtin_popcountll(w))) < d) {
+          d -= c;
+          w = words[++k];
+        }
+        for (; d; --d) w &= w - 1;
+      }
+      break;
+    }
+    case RowIndexType::RUNS: {
+      if (i0 >= i1) break;
+      const int64_t* starts = runs_starts();
+      const int64_t* offsets = runs_offsets();
+      size_t k = runs_find(i0);
+      for (size_t i = i0; i < i1; i += di) {
+        while (static_cast<size_t>(offsets[k + 1]) <= i) ++k;
+        f(i, static_cast<size_t>(starts[k] - offsets[k]) + i);
+      }
+      break;
+    }
   }
 }
 
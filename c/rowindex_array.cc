@@ -468,6 +468,9 @@ const int64_t* ArrayRowIndexImpl::indices64() const noexcept {
 
 RowIndexImpl* ArrayRowIndexImpl::uplift_from(const RowIndexImpl* rii) const {
   RowIndexType uptype = rii->type;
+  if (uptype == RowIndexType::BITMAP || uptype == RowIndexType::RUNS) {
+    return uplift_compressed(this, rii);
+  }
   if (uptype == RowIndexType::SLICE) {
     size_t start = slice_rowindex_get_start(rii);
     size_t step  = slice_rowindex_get_step(rii);
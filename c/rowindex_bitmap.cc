@@ -0,0 +1,209 @@
+//------------------------------------------------------------------------------
+// Copyright 2019 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>           // std::min
+#include <cstring>             // std::memset
+#include "rowindex.h"
+#include "rowindex_impl.h"
+#include "utils/assert.h"
+#include "utils/exceptions.h"  // AssertionError, RuntimeError
+
+
+// Return the position of the `r`-th (0-based) set bit in the word `w`.
+static inline size_t select_bit(uint64_t w, size_t r) {
+  for (; r; --r) w &= w - 1;
+  return static_cast<size_t>(__builtin_ctzll(w));
+}
+
+static inline size_t popcount(uint64_t w) {
+  return static_cast<size_t>(__builtin_popcountll(w));
+}
+
+
+
+//------------------------------------------------------------------------------
+// BitmapRowIndexImpl implementation
+//------------------------------------------------------------------------------
+
+BitmapRowIndexImpl::BitmapRowIndexImpl(dt::array<uint64_t>&& w, size_t n)
+  : words(std::move(w)), nbits(n)
+{
+  xassert(words.size() == (nbits + 63) / 64);
+  type = RowIndexType::BITMAP;
+  ascending = true;
+  size_t nwords = words.size();
+  const uint64_t* wdata = words.data();
+  if (nbits & 63) {
+    xassert((wdata[nwords - 1] >> (nbits & 63)) == 0);
+  }
+
+  length = 0;
+  for (size_t k = 0; k < nwords; ++k) {
+    length += popcount(wdata[k]);
+  }
+  samples.resize((length + 63) / 64);
+
+  size_t count = 0;  // number of set bits in words [0; k)
+  size_t s = 0;      // next sample to record
+  for (size_t k = 0; k < nwords; ++k) {
+    size_t pc = popcount(wdata[k]);
+    while (s * 64 < count + pc) {
+      size_t pos = (k << 6) + select_bit(wdata[k], s * 64 - count);
+      samples[s++] = static_cast<int64_t>(pos);
+    }
+    count += pc;
+  }
+  xassert(s == samples.size());
+
+  if (length == 0) {
+    min = max = RowIndex::NA;
+  } else {
+    min = static_cast<size_t>(samples[0]);
+    size_t k = nwords - 1;
+    while (!wdata[k]) --k;
+    max = (k << 6) + 63 - static_cast<size_t>(__builtin_clzll(wdata[k]));
+  }
+}
+
+
+const uint64_t* BitmapRowIndexImpl::bitmap_words() const noexcept {
+  return words.data();
+}
+
+
+size_t BitmapRowIndexImpl::nth(size_t i) const {
+  size_t p = static_cast<size_t>(samples[i >> 6]);
+  size_t r = i & 63;
+  size_t k = p >> 6;
+  uint64_t w = words[k] & (~uint64_t(0) << (p & 63));
+  while (true) {
+    size_t c = popcount(w);
+    if (r < c) break;
+    r -= c;
+    w = words[++k];
+  }
+  return (k << 6) + select_bit(w, r);
+}
+
+
+RowIndexImpl* BitmapRowIndexImpl::uplift_from(const RowIndexImpl* rii) const {
+  return uplift_compressed(this, rii);
+}
+
+
+// The negation of a bitmap is obtained by simply flipping all the bits in
+// the range `[0; nrows)`.
+RowIndexImpl* BitmapRowIndexImpl::negate(size_t nrows) const {
+  xassert(nrows >= nbits);
+  size_t nwords = (nrows + 63) / 64;
+  size_t nwords0 = words.size();
+  dt::array<uint64_t> newwords(nwords);
+  uint64_t* out = newwords.data();
+  const uint64_t* inp = words.data();
+  #pragma omp parallel for schedule(static)
+  for (size_t k = 0; k < nwords; ++k) {
+    out[k] = k < nwords0? ~inp[k] : ~uint64_t(0);
+  }
+  if (nrows & 63) {
+    out[nwords - 1] &= (uint64_t(1) << (nrows & 63)) - 1;
+  }
+  return new BitmapRowIndexImpl(std::move(newwords), nrows);
+}
+
+
+// A bitmap cannot contain NA indices, therefore instead of resizing
+// in-place we always convert into an "array" RowIndex.
+void BitmapRowIndexImpl::resize(size_t) {
+  throw RuntimeError() << "Bitmap RowIndex cannot be resized in-place";
+}
+
+RowIndexImpl* BitmapRowIndexImpl::resized(size_t n) {
+  size_t ncopy = std::min(n, length);
+  bool use32 = (n <= INT32_MAX && nbits <= INT32_MAX);
+  arr32_t ind32(use32? n : 0);
+  arr64_t ind64(use32? 0 : n);
+  size_t i = 0;
+  for (size_t k = 0; i < ncopy; ++k) {
+    uint64_t w = words[k];
+    for (; w && i < ncopy; w &= w - 1, ++i) {
+      size_t j = (k << 6) + static_cast<size_t>(__builtin_ctzll(w));
+      if (use32) ind32[i] = static_cast<int32_t>(j);
+      else       ind64[i] = static_cast<int64_t>(j);
+    }
+  }
+  if (use32) {
+    std::memset(ind32.data() + ncopy, -1, (n - ncopy) * 4);
+    return new ArrayRowIndexImpl(std::move(ind32), n <= length);
+  } else {
+    std::memset(ind64.data() + ncopy, -1, (n - ncopy) * 8);
+    return new ArrayRowIndexImpl(std::move(ind64), n <= length);
+  }
+}
+
+
+size_t BitmapRowIndexImpl::memory_footprint() const {
+  return sizeof(*this) + words.size() * 8 + samples.size() * 8;
+}
+
+
+void BitmapRowIndexImpl::verify_integrity() const {
+  RowIndexImpl::verify_integrity();
+  if (type != RowIndexType::BITMAP) {
+    throw AssertionError() << "Invalid type = " << static_cast<int>(type)
+        << " in BitmapRowIndex";
+  }
+  if (words.size() != (nbits + 63) / 64) {
+    throw AssertionError() << "BitmapRowIndex has " << words.size()
+        << " words, but " << nbits << " bits";
+  }
+  if (!ascending) {
+    throw AssertionError() << "BitmapRowIndex is not marked as ascending";
+  }
+  size_t count = 0;
+  size_t jmin = RowIndex::NA;
+  size_t jmax = RowIndex::NA;
+  for (size_t k = 0; k < words.size(); ++k) {
+    for (uint64_t w = words[k]; w; w &= w - 1) {
+      size_t j = (k << 6) + static_cast<size_t>(__builtin_ctzll(w));
+      if (j >= nbits) {
+        throw AssertionError() << "BitmapRowIndex has bit " << j
+            << " set, which is outside of the range [0; " << nbits << ")";
+      }
+      if (count % 64 == 0 && static_cast<size_t>(samples[count/64]) != j) {
+        throw AssertionError() << "Sample " << count/64 << " in BitmapRowIndex"
+            " is " << samples[count/64] << ", whereas it should be " << j;
+      }
+      if (jmin == RowIndex::NA) jmin = j;
+      jmax = j;
+      count++;
+    }
+  }
+  if (count != length) {
+    throw AssertionError() << "BitmapRowIndex has length " << length
+        << ", but the number of bits set is " << count;
+  }
+  if (jmin != min || jmax != max) {
+    throw AssertionError()
+        << "Mismatching min/max values in the BitmapRowIndex min=" << min
+        << "/max=" << max << " compared to the computed min=" << jmin
+        << "/max=" << jmax;
+  }
+}
@@ -47,7 +47,7 @@ class RowIndexImpl {
      *     object is deleted.
      *
      * type
-     *     The type of the RowIndex: SLICE, ARR32 or ARR64.
+     *     The type of the RowIndex: SLICE, ARR32, ARR64, BITMAP or RUNS.
      *
      * ascending
      *     True if the entries in the rowindex are strictly increasing, or false
@@ -156,6 +156,11 @@ class ArrayRowIndexImpl : public RowIndexImpl {
     size_t memory_footprint() const override;
     void verify_integrity() const override;
 
+    // If the indices are strictly increasing, and a compressed form of this
+    // RowIndex takes much less memory, then return such compressed RowIndex
+    // and delete `this`. Otherwise return `this`.
+    RowIndexImpl* compressed();
+
   private:
     void _resize_data();
     void set_min_max();
@@ -177,4 +182,103 @@ class ArrayRowIndexImpl : public RowIndexImpl {
 
 
 
+//------------------------------------------------------------------------------
+// "Bitmap" RowIndexImpl class
+//------------------------------------------------------------------------------
+
+/**
+ * RowIndex stored as a bit-mask over the rows `[0; nbits)`: row `j` is
+ * selected iff bit `j` is set. The selected rows are always in ascending
+ * order. This form takes 1 bit per source row, compared to 32 or 64 bits per
+ * selected row for ARR32 / ARR64, and thus it is preferable whenever a
+ * sizeable fraction of rows is selected.
+ *
+ * In order to support random access, `samples[s]` records the position of
+ * the `64*s`-th selected row; `nth(i)` then only needs to scan a few words
+ * starting from `samples[i / 64]`.
+ */
+class BitmapRowIndexImpl : public RowIndexImpl {
+  private:
+    dt::array<uint64_t> words;
+    arr64_t samples;
+    size_t nbits;
+
+  public:
+    BitmapRowIndexImpl(dt::array<uint64_t>&& words, size_t nbits);
+
+    const uint64_t* bitmap_words() const noexcept;
+
+    size_t nth(size_t i) const override;
+    RowIndexImpl* uplift_from(const RowIndexImpl*) const override;
+    RowIndexImpl* negate(size_t nrows) const override;
+
+    void resize(size_t n) override;
+    RowIndexImpl* resized(size_t n) override;
+
+    size_t memory_footprint() const override;
+    void verify_integrity() const override;
+};
+
+
+
+//------------------------------------------------------------------------------
+// "Runs" RowIndexImpl class
+//------------------------------------------------------------------------------
+
+/**
+ * RowIndex stored as a list of runs of consecutive rows (i.e. a sequence of
+ * slices with step 1). Run `k` starts at row `starts[k]` and contains
+ * `offsets[k + 1] - offsets[k]` rows; thus `offsets[k]` is the position
+ * within the RowIndex of the first element of the `k`-th run. The runs are
+ * ascending and non-overlapping.
+ */
+class RunsRowIndexImpl : public RowIndexImpl {
+  private:
+    arr64_t starts;
+    arr64_t offsets;  // length `nruns + 1`
+
+  public:
+    RunsRowIndexImpl(arr64_t&& starts, arr64_t&& offsets);
+
+    size_t nruns() const noexcept;
+    const int64_t* runs_starts() const noexcept;
+    const int64_t* runs_offsets() const noexcept;
+    size_t find(size_t i) const noexcept;
+
+    size_t nth(size_t i) const override;
+    RowIndexImpl* uplift_from(const RowIndexImpl*) const override;
+    RowIndexImpl* negate(size_t nrows) const override;
+
+    void resize(size_t n) override;
+    RowIndexImpl* resized(size_t n) override;
+
+    size_t memory_footprint() const override;
+    void verify_integrity() const override;
+};
+
+
+
+/**
+ * Compute `ab * bc` where either of the RowIndices is BITMAP or RUNS. The
+ * result will itself be compressed if it is ascending and the compressed
+ * form is sufficiently smaller than an array.
+ */
+RowIndexImpl* uplift_compressed(const RowIndexImpl* ab, const RowIndexImpl* bc);
+
+/**
+ * Try to create a compressed (BITMAP or RUNS) RowIndex from the boolean
+ * column `col`, which must not have a rowindex. Returns nullptr if the
+ * ARR32 / ARR64 form would be more appropriate.
+ */
+RowIndexImpl* compressed_rowindex_from_mask(const BoolColumn* col);
+
+/**
+ * Choose the most compact representation (SLICE, ARR32/ARR64, BITMAP or
+ * RUNS) for the ascending compressed RowIndex `ri`. Returns nullptr if the
+ * current representation of `ri` is already the best one.
+ */
+RowIndexImpl* recompressed(const RowIndex& ri);
+
+
+
 #endif
@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+// Copyright 2019 H2O.ai
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation
+// the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the
+// Software is furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//------------------------------------------------------------------------------
+#include <algorithm>           // std::upper_bound, std::min
+#include <cstring>             // std::memset
+#include "rowindex.h"
+#include "rowindex_impl.h"
+#include "utils/assert.h"
+#include "utils/exceptions.h"  // AssertionError, RuntimeError
+
+
+
+//------------------------------------------------------------------------------
+// RunsRowIndexImpl implementation
+//------------------------------------------------------------------------------
+
+RunsRowIndexImpl::RunsRowIndexImpl(arr64_t&& s, arr64_t&& o)
+  : starts(std::move(s)), offsets(std::move(o))
+{
+  xassert(offsets.size() == starts.size() + 1);
+  type = RowIndexType::RUNS;
+  ascending = true;
+  size_t n = starts.size();
+  length = static_cast<size_t>(offsets[n]);
+  if (length == 0) {
+    min = max = RowIndex::NA;
+  } else {
+    min = static_cast<size_t>(starts[0]);
+    max = static_cast<size_t>(starts[n - 1] + offsets[n] - offsets[n - 1] - 1);
+  }
+}
+
+
+size_t RunsRowIndexImpl::nruns() const noexcept {
+  return starts.size();
+}
+
+const int64_t* RunsRowIndexImpl::runs_starts() const noexcept {
+  return starts.data();
+}
+
+const int64_t* RunsRowIndexImpl::runs_offsets() const noexcept {
+  return offsets.data();
+}
+
+
+// Return the index of the run that contains the `i`-th element.
+size_t RunsRowIndexImpl::find(size_t i) const noexcept {
+  const int64_t* offs = offsets.data();
+  const int64_t* p = std::upper_bound(offs, offs + starts.size(),
+                                      static_cast<int64_t>(i));
+  return static_cast<size_t>(p - offs) - 1;
+}
+
+
+size_t RunsRowIndexImpl::nth(size_t i) const {
+  size_t k = find(i);
+  return static_cast<size_t>(starts[k] + static_cast<int64_t>(i) - offsets[k]);
+}
+
+
+RowIndexImpl* RunsRowIndexImpl::uplift_from(const RowIndexImpl* rii) const {
+  return uplift_compressed(this, rii);
+}
+
+
+// The negation consists of the gaps between the runs, plus the ranges
+// before the first and after the last run.
+RowIndexImpl* RunsRowIndexImpl::negate(size_t nrows) const {
+  xassert(nrows > max);
+  size_t n = starts.size();
+  arr64_t newstarts(n + 1);
+  arr64_t newoffsets(n + 2);
+  size_t m = 0;
+  int64_t prev_end = 0;
+  int64_t count = 0;
+  for (size_t k = 0; k <= n; ++k) {
+    int64_t next_start = k < n? starts[k] : static_cast<int64_t>(nrows);
+    if (next_start > prev_end) {
+      newstarts[m] = prev_end;
+      newoffsets[m] = count;
+      count += next_start - prev_end;
+      m++;
+    }
+    if (k < n) prev_end = starts[k] + offsets[k + 1] - offsets[k];
+  }
+  newoffsets[m] = count;
+  newstarts.resize(m);
+  newoffsets.resize(m + 1);
+  return new RunsRowIndexImpl(std::move(newstarts), std::move(newoffsets));
+}
+
+
+// Since the runs cannot contain NA indices, instead of resizing in-place we
+// always convert into an "array" RowIndex.
+void RunsRowIndexImpl::resize(size_t) {
+  throw RuntimeError() << "Runs RowIndex cannot be resized in-place";
+}
+
+RowIndexImpl* RunsRowIndexImpl::resized(size_t n) {
+  size_t ncopy = std::min(n, length);
+  bool use32 = (n <= INT32_MAX && (max <= INT32_MAX || max == RowIndex::NA));
+  arr32_t ind32(use32? n : 0);
+  arr64_t ind64(use32? 0 : n);
+  size_t k = 0;
+  for (size_t i = 0; i < ncopy; ++i) {
+    while (static_cast<size_t>(offsets[k + 1]) <= i) ++k;
+    int64_t j = starts[k] + static_cast<int64_t>(i) - offsets[k];
+    if (use32) ind32[i] = static_cast<int32_t>(j);
+    else       ind64[i] = j;
+  }
+  if (use32) {
+    std::memset(ind32.data() + ncopy, -1, (n - ncopy) * 4);
+    return new ArrayRowIndexImpl(std::move(ind32), n <= length);
+  } else {
+    std::memset(ind64.data() + ncopy, -1, (n - ncopy) * 8);
+    return new ArrayRowIndexImpl(std::move(ind64), n <= length);
+  }
+}
+
+
+size_t RunsRowIndexImpl::memory_footprint() const {
+  return sizeof(*this) + (starts.size() + offsets.size()) * 8;
+}
+
+
+void RunsRowIndexImpl::verify_integrity() const {
+  RowIndexImpl::verify_integrity();
+  if (type != RowIndexType::RUNS) {
+    throw AssertionError() << "Invalid type = " << static_cast<int>(type)
+        << " in RunsRowIndex";
+  }
+  if (!ascending) {
+    throw AssertionError() << "RunsRowIndex is not marked as ascending";
+  }
+  size_t n = starts.size();
+  if (offsets.size() != n + 1) {
+    throw AssertionError() << "RunsRowIndex has " << n << " runs, but "
+        << offsets.size() << " offsets";
+  }
+  if (offsets[0] != 0) {
+    throw AssertionError() << "First offset in RunsRowIndex is " << offsets[0];
+  }
+  if (static_cast<size_t>(offsets[n]) != length) {
+    throw AssertionError() << "RunsRowIndex has length " << length
+        << ", but the last offset is " << offsets[n];
+  }
+  for (size_t k = 0; k < n; ++k) {
+    if (offsets[k + 1] <= offsets[k]) {
+      throw AssertionError() << "Run " << k << " in RunsRowIndex is empty";
+    }
+    if (starts[k] < 0) {
+      throw AssertionError() << "Run " << k << " in RunsRowIndex starts at "
+          "a negative row " << starts[k];
+    }
+    if (k && starts[k] <= starts[k-1] + offsets[k] - offsets[k-1]) {
+      throw AssertionError() << "Run " << k << " in RunsRowIndex overlaps "
+          "with or is adjacent to the previous run";
+    }
+  }
+}
@@ -91,6 +91,9 @@ RowIndexImpl* SliceRowIndexImpl::uplift_from(const RowIndexImpl* rii) const {
     size_t step_new = uprii->step * step;
     return new SliceRowIndexImpl(start_new, length, step_new);
   }
+  if (uptype == RowIndexType::BITMAP || uptype == RowIndexType::RUNS) {
+    return uplift_compressed(this, rii);
+  }
 
   // Special case: if `step` is 0, then A just contains the same row
   // repeated `length` times, and hence can be created as a slice even
@@ -36,7 +36,7 @@
 //      https://en.wikipedia.org/wiki/Radix_sort
 //      https://en.wikipedia.org/wiki/Insertion_sort
 //      http://stereopsis.com/radix.html
-//      /microbench/sort
+//      microbench/bench_sort.cc
 //
 // Based on the parallel radix sort algorithm by Matt Dowle in (R)data.table:
 //      https://github.com/Rdatatable/data.table/src/forder.c
@@ -123,18 +123,23 @@
 //
 //------------------------------------------------------------------------------
 #include <algorithm>  // std::min
+#include <atomic>     // std::atomic
 #include <cstdlib>    // std::abs
 #include <cstring>    // std::memset, std::memcpy
+#include <mutex>      // std::mutex, std::lock_guard
 #include <vector>     // std::vector
 #include "expr/sort_node.h"
 #include "expr/workframe.h"
 #include "frame/py_frame.h"
 #include "python/args.h"
+#include "python/gil.h"
 #include "utils/alloc.h"
 #include "utils/array.h"
 #include "utils/assert.h"
 #include "utils/misc.h"
 #include "utils/parallel.h"
+#include "utils/profiler.h"
+#include "utils/thread_pool.h"
 #include "column.h"
 #include "datatable.h"
 #include "datatablemodule.h"
@@ -422,10 +427,12 @@ class SortContext {
     groups = arr32_t(groupby.ngroups(), groupby.offsets_r(), false);
     gg.init(nullptr, 0, groupby.ngroups());
     if (!rowindex) {
-      #pragma omp parallel for schedule(static) num_threads(nth)
-      for (size_t i = 0; i < n; ++i) {
-        o[i] = static_cast<int32_t>(i);
-      }
+      dt::parallel_for_static(n, nth,
+        [&](size_t i0, size_t i1) {
+          for (size_t i = i0; i < i1; ++i) {
+            o[i] = static_cast<int32_t>(i);
+          }
+        });
     }
   }
 
@@ -436,18 +443,23 @@ class SortContext {
 
   void start_sort(const Column* col, bool desc) {
     descending = desc;
-    if (desc) {
-      _prepare_data_for_column<false>(col);
-    } else {
-      _prepare_data_for_column<true>(col);
+    {
+      dt::profile_scope ps("sort.prepare");
+      if (desc) {
+        _prepare_data_for_column<false>(col);
+      } else {
+        _prepare_data_for_column<true>(col);
+      }
     }
     if (n <= config::sort_insert_method_threshold) {
+      dt::profile_scope ps("sort.insert");
       if (use_order) {
         kinsert_sort();
       } else {
         vinsert_sort();
       }
     } else {
+      dt::profile_scope ps("sort.radix");
       if (groups) radix_psort<true>();
       else        radix_psort<false>();
     }
@@ -460,10 +472,13 @@ class SortContext {
     descending = desc;
     xassert(nradixes > 0);
     xassert(o == container_o.ptr);
-    if (desc) {
-      _prepare_data_for_column<false>(col);
-    } else {
-      _prepare_data_for_column<true>(col);
+    {
+      dt::profile_scope ps("sort.prepare");
+      if (desc) {
+        _prepare_data_for_column<false>(col);
+      } else {
+        _prepare_data_for_column<true>(col);
+      }
     }
     if (strtype) strstart--;
     // Make sure that `xx` has enough storage capacity. Previous column may
@@ -476,6 +491,7 @@ class SortContext {
     radix_range* rrmap_ptr = rrmap.data();
     _fill_rrmap_from_groups(rrmap_ptr);
 
+    dt::profile_scope ps("sort.radix");
     if (make_groups) {
       gg.init(groups.data() + 1, 0);
       _radix_recurse<true>(rrmap_ptr);
@@ -578,19 +594,24 @@ class SortContext {
     uint8_t* xo = x.data<uint8_t>();
 
     if (use_order) {
-      #pragma omp parallel for schedule(static) num_threads(nth)
-      for (size_t j = 0; j < n; j++) {
-        xo[j] = ASC? static_cast<uint8_t>(xi[o[j]] + 191) >> 6
-                   : static_cast<uint8_t>(128 - xi[o[j]]) >> 6;
-      }
+      dt::parallel_for_static(n, nth,
+        [&](size_t i0, size_t i1) {
+          for (size_t j = i0; j < i1; ++j) {
+            xo[j] = ASC? static_cast<uint8_t>(xi[o[j]] + 191) >> 6
+                       : static_cast<uint8_t>(128 - xi[o[j]]) >> 6;
+          }
+        });
     } else {
-      #pragma omp parallel for schedule(static) num_threads(nth)
-      for (size_t j = 0; j < n; j++) {
-        // xi[j]+191 should be computed as uint8_t; by default C++ upcasts it
-        // to int, which leads to wrong results after shift by 6.
-        xo[j] = ASC? static_cast<uint8_t>(xi[j] + 191) >> 6
-                   : static_cast<uint8_t>(128 - xi[j]) >> 6;
-      }
+      dt::parallel_for_static(n, nth,
+        [&](size_t i0, size_t i1) {
+          for (size_t j = i0; j < i1; ++j) {
+            // xi[j]+191 should be computed as uint8_t; by default C++
+            // upcasts it to int, which leads to wrong results after shift
+            // by 6.
+            xo[j] = ASC? static_cast<uint8_t>(xi[j] + 191) >> 6
+                       : static_cast<uint8_t>(128 - xi[j]) >> 6;
+          }
+        });
     }
   }
 
@@ -625,21 +646,25 @@ class SortContext {
     TO* xo = x.data<TO>();
 
     if (use_order) {
-      #pragma omp parallel for schedule(static) num_threads(nth)
-      for (size_t j = 0; j < n; ++j) {
-        TI t = xi[o[j]];
-        xo[j] = t == una? 0 :
-                ASC? static_cast<TO>(t - uedge + 1)
-                   : static_cast<TO>(uedge - t + 1);
-      }
+      dt::parallel_for_static(n, nth,
+        [&](size_t i0, size_t i1) {
+          for (size_t j = i0; j < i1; ++j) {
+            TI t = xi[o[j]];
+            xo[j] = t == una? 0 :
+                    ASC? static_cast<TO>(t - uedge + 1)
+                       : static_cast<TO>(uedge - t + 1);
+          }
+        });
     } else {
-      #pragma omp parallel for schedule(static) num_threads(nth)
-      for (size_t j = 0; j < n; j++) {
-        TI t = xi[j];
-        xo[j] = t == una? 0 :
-                ASC? static_cast<TO>(t - uedge + 1)
-                   : static_cast<TO>(uedge - t + 1);
-      }
+      dt::parallel_for_static(n, nth,
+        [&](size_t i0, size_t i1) {
+          for (size_t j = i0; j < i1; ++j) {
+            TI t = xi[j];
+            xo[j] = t == una? 0 :
+                    ASC? static_cast<TO>(t - uedge + 1)
+                       : static_cast<TO>(uedge - t + 1);
+          }
+        });
     }
   }
 
@@ -690,21 +715,25 @@ class SortContext {
     constexpr int SHIFT = sizeof(TO) * 8 - 1;
 
     if (use_order) {
-      #pragma omp parallel for schedule(static) num_threads(nth)
-      for (size_t j = 0; j < n; j++) {
-        TO t = xi[o[j]];
-        xo[j] = ((t & EXP) == EXP && (t & SIG) != 0) ? 0 :
-                ASC? t ^ (SBT | -(t>>SHIFT))
-                   : t ^ (~SBT & ((t>>SHIFT) - 1));
-      }
+      dt::parallel_for_static(n, nth,
+        [&](size_t i0, size_t i1) {
+          for (size_t j = i0; j < i1; ++j) {
+            TO t = xi[o[j]];
+            xo[j] = ((t & EXP) == EXP && (t & SIG) != 0) ? 0 :
+                    ASC? t ^ (SBT | -(t>>SHIFT))
+                       : t ^ (~SBT & ((t>>SHIFT) - 1));
+          }
+        });
     } else {
-      #pragma omp parallel for schedule(static) num_threads(nth)
-      for (size_t j = 0; j < n; j++) {
-        TO t = xi[j];
-        xo[j] = ((t & EXP) == EXP && (t & SIG) != 0) ? 0 :
-                ASC? t ^ (SBT | -(t>>SHIFT))
-                   : t ^ (~SBT & ((t>>SHIFT) - 1));
-      }
+      dt::parallel_for_static(n, nth,
+        [&](size_t i0, size_t i1) {
+          for (size_t j = i0; j < i1; ++j) {
+            TO t = xi[j];
+            xo[j] = ((t & EXP) == EXP && (t & SIG) != 0) ? 0 :
+                    ASC? t ^ (SBT | -(t>>SHIFT))
+                       : t ^ (~SBT & ((t>>SHIFT) - 1));
+          }
+        });
     }
   }
 
@@ -733,25 +762,30 @@ class SortContext {
     uint8_t* xo = x.data<uint8_t>();
 
     T maxlen = 0;
-    #pragma omp parallel for schedule(static) num_threads(nth) \
-            reduction(max:maxlen)
-    for (size_t j = 0; j < n; ++j) {
-      int32_t k = use_order? o[j] : static_cast<int32_t>(j);
-      T offend = offs[k];
-      if (ISNA<T>(offend)) {
-        xo[j] = 0;    // NA string
-      } else {
-        T offstart = offs[k - 1] & ~GETNA<T>();
-        if (offend > offstart) {
-          xo[j] = ASC? strdata[offstart] + 2
-                     : 0xFE - strdata[offstart];
-          T len = offend - offstart;
-          if (len > maxlen) maxlen = len;
-        } else {
-          xo[j] = ASC? 1 : 0xFF;  // empty string
+    std::mutex maxlen_mutex;
+    dt::parallel_for_static(n, nth,
+      [&](size_t i0, size_t i1) {
+        T tmaxlen = 0;
+        for (size_t j = i0; j < i1; ++j) {
+          int32_t k = use_order? o[j] : static_cast<int32_t>(j);
+          T offend = offs[k];
+          if (ISNA<T>(offend)) {
+            xo[j] = 0;    // NA string
+          } else {
+            T offstart = offs[k - 1] & ~GETNA<T>();
+            if (offend > offstart) {
+              xo[j] = ASC? strdata[offstart] + 2
+                         : 0xFE - strdata[offstart];
+              T len = offend - offstart;
+              if (len > tmaxlen) tmaxlen = len;
+            } else {
+              xo[j] = ASC? 1 : 0xFF;  // empty string
+            }
+          }
         }
-      }
-    }
+        std::lock_guard<std::mutex> lock(maxlen_mutex);
+        if (tmaxlen > maxlen) maxlen = tmaxlen;
+      });
     next_elemsize = (maxlen > 1);
   }
 
@@ -826,15 +860,15 @@ class SortContext {
 
   template<typename T> void _histogram_gather() {
     T* tx = x.data<T>();
-    #pragma omp parallel for schedule(dynamic) num_threads(nth)
-    for (size_t i = 0; i < nchunks; ++i) {
-      size_t* cnts = histogram + (nradixes * i);
-      size_t j0 = i * chunklen;
-      size_t j1 = std::min(j0 + chunklen, n);
-      for (size_t j = j0; j < j1; ++j) {
-        cnts[tx[j] >> shift]++;
-      }
-    }
+    dt::parallel_for_dynamic(nchunks, nth,
+      [&](size_t i) {
+        size_t* cnts = histogram + (nradixes * i);
+        size_t j0 = i * chunklen;
+        size_t j1 = std::min(j0 + chunklen, n);
+        for (size_t j = j0; j < j1; ++j) {
+          cnts[tx[j] >> shift]++;
+        }
+      });
   }
 
   void _histogram_cumulate() {
@@ -920,20 +954,20 @@ class SortContext {
       xo = xx.data<TO>();
       mask = static_cast<TI>((1ULL << shift) - 1);
     }
-    #pragma omp parallel for schedule(dynamic) num_threads(nth)
-    for (size_t i = 0; i < nchunks; ++i) {
-      size_t j0 = i * chunklen;
-      size_t j1 = std::min(j0 + chunklen, n);
-      size_t* tcounts = histogram + (nradixes * i);
-      for (size_t j = j0; j < j1; ++j) {
-        size_t k = tcounts[xi[j] >> shift]++;
-        xassert(k < n);
-        next_o[k] = use_order? o[j] : static_cast<int32_t>(j);
-        if (OUT) {
-          xo[k] = static_cast<TO>(xi[j] & mask);
+    dt::parallel_for_dynamic(nchunks, nth,
+      [&](size_t i) {
+        size_t j0 = i * chunklen;
+        size_t j1 = std::min(j0 + chunklen, n);
+        size_t* tcounts = histogram + (nradixes * i);
+        for (size_t j = j0; j < j1; ++j) {
+          size_t k = tcounts[xi[j] >> shift]++;
+          xassert(k < n);
+          next_o[k] = use_order? o[j] : static_cast<int32_t>(j);
+          if (OUT) {
+            xo[k] = static_cast<TO>(xi[j] & mask);
+          }
         }
-      }
-    }
+      });
     xassert(histogram[nchunks * nradixes - 1] == n);
   }
 
@@ -945,31 +979,34 @@ class SortContext {
     const T* soffs = static_cast<const T*>(stroffs);
 
     T maxlen = 0;
-    #pragma omp parallel for schedule(dynamic) num_threads(nth) \
-            reduction(max:maxlen)
-    for (size_t i = 0; i < nchunks; ++i) {
-      size_t j0 = i * chunklen;
-      size_t j1 = std::min(j0 + chunklen, n);
-      size_t* tcounts = histogram + (nradixes * i);
-      for (size_t j = j0; j < j1; ++j) {
-        size_t k = tcounts[xi[j]]++;
-        xassert(k < n);
-        int32_t w = use_order? o[j] : static_cast<int32_t>(j);
-        T offend = soffs[w];
-        T offstart = (soffs[w - 1] & ~GETNA<T>()) + sstart;
-        if (ISNA<T>(offend)) {
-          xo[k] = 0;
-        } else if (offend > offstart) {
-          xo[k] = ASC? strdata[offstart] + 2
-                     : 0xFE - strdata[offstart];
-          T len = offend - offstart;
-          if (len > maxlen) maxlen = len;
-        } else {
-          xo[k] = ASC? 1 : 0xFF;  // string is shorter than sstart
+    std::mutex maxlen_mutex;
+    dt::parallel_for_dynamic(nchunks, nth,
+      [&](size_t i) {
+        size_t j0 = i * chunklen;
+        size_t j1 = std::min(j0 + chunklen, n);
+        size_t* tcounts = histogram + (nradixes * i);
+        T tmaxlen = 0;
+        for (size_t j = j0; j < j1; ++j) {
+          size_t k = tcounts[xi[j]]++;
+          xassert(k < n);
+          int32_t w = use_order? o[j] : static_cast<int32_t>(j);
+          T offend = soffs[w];
+          T offstart = (soffs[w - 1] & ~GETNA<T>()) + sstart;
+          if (ISNA<T>(offend)) {
+            xo[k] = 0;
+          } else if (offend > offstart) {
+            xo[k] = ASC? strdata[offstart] + 2
+                       : 0xFE - strdata[offstart];
+            T len = offend - offstart;
+            if (len > tmaxlen) tmaxlen = len;
+          } else {
+            xo[k] = ASC? 1 : 0xFF;  // string is shorter than sstart
+          }
+          next_o[k] = w;
         }
-        next_o[k] = w;
-      }
-    }
+        std::lock_guard<std::mutex> lock(maxlen_mutex);
+        if (tmaxlen > maxlen) maxlen = tmaxlen;
+      });
     next_elemsize = (maxlen > 0);
     xassert(histogram[nchunks * nradixes - 1] == n);
   }
@@ -1145,50 +1182,49 @@ class SortContext {
       TRACK(tmp, sizeof(tmp), "sort.tmp");
       // }
     }
-    #pragma omp parallel num_threads(nthreads)
-    {
-      int tnum = omp_get_thread_num();
-      int32_t* oo = tmp + tnum * static_cast<int32_t>(size0);
-      GroupGatherer tgg;
-
-      #pragma omp for schedule(dynamic)
-      for (size_t i = 0; i < _nradixes; ++i) {
-        size_t zn  = rrmap[i].size;
-        size_t off = rrmap[i].offset;
-        if (zn > rrlarge) {
-          rrmap[i].size = zn & ~GROUPED;
-        } else if (zn > 1) {
-          int32_t  tn = static_cast<int32_t>(zn);
-          rmem     tx { _x, off * elemsize, zn * elemsize };
-          int32_t* to = _o + off;
-          if (make_groups) {
-            tgg.init(ggdata0 + off, static_cast<int32_t>(off) + ggoff0);
-          }
-          if (strtype == 0) {
-            switch (elemsize) {
-              case 1: insert_sort_keys<>(tx.data<uint8_t>(), to, oo, tn, tgg); break;
-              case 2: insert_sort_keys<>(tx.data<uint16_t>(), to, oo, tn, tgg); break;
-              case 4: insert_sort_keys<>(tx.data<uint32_t>(), to, oo, tn, tgg); break;
-              case 8: insert_sort_keys<>(tx.data<uint64_t>(), to, oo, tn, tgg); break;
+    std::atomic<size_t> next_radix(0);
+    dt::parallel_region(nthreads,
+      [&](size_t tnum) {
+        int32_t* oo = tmp + tnum * size0;
+        GroupGatherer tgg;
+
+        for (size_t i = next_radix++; i < _nradixes; i = next_radix++) {
+          size_t zn  = rrmap[i].size;
+          size_t off = rrmap[i].offset;
+          if (zn > rrlarge) {
+            rrmap[i].size = zn & ~GROUPED;
+          } else if (zn > 1) {
+            int32_t  tn = static_cast<int32_t>(zn);
+            rmem     tx { _x, off * elemsize, zn * elemsize };
+            int32_t* to = _o + off;
+            if (make_groups) {
+              tgg.init(ggdata0 + off, static_cast<int32_t>(off) + ggoff0);
             }
-          } else if (strtype == 1) {
-            const uint32_t* soffs = static_cast<const uint32_t*>(stroffs);
-            uint32_t ss = static_cast<uint32_t>(_strstart + 1);
-            insert_sort_keys_str(strdata, soffs, ss, to, oo, tn, tgg, descending);
-          } else {
-            const uint64_t* soffs = static_cast<const uint64_t*>(stroffs);
-            uint64_t ss = static_cast<uint64_t>(_strstart + 1);
-            insert_sort_keys_str(strdata, soffs, ss, to, oo, tn, tgg, descending);
-          }
-          if (make_groups) {
-            rrmap[i].size = static_cast<size_t>(tgg.size());
+            if (strtype == 0) {
+              switch (elemsize) {
+                case 1: insert_sort_keys<>(tx.data<uint8_t>(), to, oo, tn, tgg); break;
+                case 2: insert_sort_keys<>(tx.data<uint16_t>(), to, oo, tn, tgg); break;
+                case 4: insert_sort_keys<>(tx.data<uint32_t>(), to, oo, tn, tgg); break;
+                case 8: insert_sort_keys<>(tx.data<uint64_t>(), to, oo, tn, tgg); break;
+              }
+            } else if (strtype == 1) {
+              const uint32_t* soffs = static_cast<const uint32_t*>(stroffs);
+              uint32_t ss = static_cast<uint32_t>(_strstart + 1);
+              insert_sort_keys_str(strdata, soffs, ss, to, oo, tn, tgg, descending);
+            } else {
+              const uint64_t* soffs = static_cast<const uint64_t*>(stroffs);
+              uint64_t ss = static_cast<uint64_t>(_strstart + 1);
+              insert_sort_keys_str(strdata, soffs, ss, to, oo, tn, tgg, descending);
+            }
+            if (make_groups) {
+              rrmap[i].size = static_cast<size_t>(tgg.size());
+            }
+          } else if (zn == 1 && make_groups) {
+            ggdata0[off] = static_cast<int32_t>(off) + ggoff0 + 1;
+            rrmap[i].size = 1;
           }
-        } else if (zn == 1 && make_groups) {
-          ggdata0[off] = static_cast<int32_t>(off) + ggoff0 + 1;
-          rrmap[i].size = 1;
         }
-      }
-    }
+      });
 
     // Consolidate groups into a single contiguous chunk
     if (make_groups) {
@@ -1268,6 +1304,29 @@ class SortContext {
 using RiGb = std::pair<RowIndex, Groupby>;
 
 
+/**
+ * Once the GIL is released, other python threads may modify the frame that
+ * is being sorted, or access the stats of its columns (which are created
+ * lazily and without synchronization). Therefore the sort works with a
+ * private shallow copy of each column, and the stats that it needs (min/max
+ * of integer columns) are computed before the GIL is released, so that the
+ * copy inherits them from the original column.
+ */
+static colptr prepare_for_sort(const Column* col) {
+  switch (col->stype()) {
+    case SType::INT8:
+    case SType::INT16:
+    case SType::INT32:
+    case SType::INT64:
+      col->min_int64();
+      col->max_int64();
+      break;
+    default: break;
+  }
+  return colptr(col->shallowcopy());
+}
+
+
 RiGb DataTable::group(const std::vector<sort_spec>& spec, bool as_view) const
 {
   RiGb result;
@@ -1300,10 +1359,18 @@ RiGb DataTable::group(const std::vector<sort_spec>& spec, bool as_view) const
       columns[s.col_index]->materialize();
     }
   }
+  std::vector<colptr> sortcols;
+  sortcols.reserve(n);
+  for (auto& s : spec) {
+    sortcols.push_back(prepare_for_sort(columns[s.col_index]));
+  }
 
+  py::gil_release nogil;
+  dt::profile_scope ps("sort");
+  dt::profile_count("sort.rows", nrows);
   bool do_groups = n > 1 || !spec[0].sort_only;
-  SortContext sc(nrows, col0->rowindex(), do_groups);
-  sc.start_sort(col0, spec[0].descending);
+  SortContext sc(nrows, sortcols[0]->rowindex(), do_groups);
+  sc.start_sort(sortcols[0].get(), spec[0].descending);
   for (size_t j = 1; j < n; ++j) {
     if (spec[j].sort_only && !spec[j - 1].sort_only) {
       result.second = sc.copy_groups();
@@ -1311,8 +1378,7 @@ RiGb DataTable::group(const std::vector<sort_spec>& spec, bool as_view) const
     if (j == n - 1 && spec[j].sort_only) {
       do_groups = false;
     }
-    sc.continue_sort(columns[spec[j].col_index],
-                     spec[j].descending, do_groups);
+    sc.continue_sort(sortcols[j].get(), spec[j].descending, do_groups);
   }
   result.first = sc.get_result_rowindex();
   if (!spec[0].sort_only && !result.second) {
@@ -1342,8 +1408,12 @@ RowIndex Column::sort(Groupby* out_grps) const {
   if (nrows <= 1) {
     return sort_tiny(this, out_grps);
   }
-  SortContext sc(nrows, rowindex(), (out_grps != nullptr));
-  sc.start_sort(this, false);
+  colptr col = prepare_for_sort(this);
+  py::gil_release nogil;
+  dt::profile_scope ps("sort");
+  dt::profile_count("sort.rows", nrows);
+  SortContext sc(nrows, col->rowindex(), (out_grps != nullptr));
+  sc.start_sort(col.get(), false);
   if (out_grps) {
     auto res = sc.get_result_groups();
     *out_grps = std::move(res.second);
@@ -1357,8 +1427,12 @@ RowIndex Column::sort(Groupby* out_grps) const {
 RowIndex Column::sort_grouped(const RowIndex& rowindex,
                               const Groupby& grps) const
 {
+  colptr col = prepare_for_sort(this);
+  py::gil_release nogil;
+  dt::profile_scope ps("sort");
+  dt::profile_count("sort.rows", nrows);
   SortContext sc(nrows, rowindex, grps, /* make_groups = */ false);
-  sc.continue_sort(this, /* desc = */ false, /* make_groups = */ false);
+  sc.continue_sort(col.get(), /* desc = */ false, /* make_groups = */ false);
   return sc.get_result_rowindex();
 }
 
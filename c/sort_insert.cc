@@ -26,7 +26,7 @@
 //
 // See also:
 //   - https://en.wikipedia.org/wiki/Insertion_sort
-//   - datatable/microbench/insertsort
+//   - microbench/bench_sort.cc, benchmarks "sort/insert/n=*"
 //------------------------------------------------------------------------------
 #include "sort.h"
 #include <cstdlib>  // std::abs
@@ -5,7 +5,7 @@
 //
 // © H2O.ai 2018
 //------------------------------------------------------------------------------
-#include <cmath>        // std::isinf, std::sqrt
+#include <cmath>        // std::isinf, std::isnan, std::sqrt
 #include <limits>       // std::numeric_limits
 #include <type_traits>  // std::is_floating_point
 #include "utils/misc.h"
@@ -100,8 +100,38 @@ size_t Stats::memory_footprint() const {
 }
 
 
-void Stats::merge_stats(const Stats*) {
-  // TODO: implement
+Stats* Stats::copy() const {
+  Stats* res = make();
+  res->copy_from(this);
+  return res;
+}
+
+void Stats::copy_from(const Stats* other) {
+  _computed = other->_computed;
+  _countna = other->_countna;
+  _nunique = other->_nunique;
+  _nmodal = other->_nmodal;
+}
+
+
+/**
+ * The NA count is additive; whereas the number of unique values and the
+ * mode cannot be derived from their values on the parts, unless the appended
+ * rows are all NAs.
+ */
+void Stats::merge_stats(const Stats* other, size_t, size_t other_nrows) {
+  if (other == nullptr) {
+    if (is_computed(Stat::NaCount)) _countna += other_nrows;
+    return;
+  }
+  if (is_computed(Stat::NaCount) && other->is_computed(Stat::NaCount)) {
+    _countna += other->_countna;
+  } else {
+    set_computed(Stat::NaCount, false);
+  }
+  set_computed(Stat::NUnique, false);
+  set_computed(Stat::NModal, false);
+  set_computed(Stat::Mode, false);
 }
 
 
@@ -124,6 +154,7 @@ void Stats::verify_stat(Stat s, T value, F getter) const {
   if (!is_computed(s)) return;
   T test_value = getter();
   if (value == test_value) return;
+  if (std::isnan(value) && std::isnan(test_value)) return;
   if (std::is_floating_point<T>::value && (value != 0) &&
       std::abs(1.0 - static_cast<double>(test_value/value)) < 1e-12) return;
   throw AssertionError()
@@ -139,19 +170,16 @@ void Stats::verify_stat(Stat s, T value, F getter) const {
 
 /**
  * Standard deviation and mean computations are done using Welford's method.
- * Ditto for skewness and kurtosis computations.
- * (Source: https://www.johndcook.com/blog/standard_deviation)
+ * Ditto for skewness and kurtosis computations. Each thread accumulates the
+ * moments for its own subset of rows, and then they are merged together
+ * (see `MomentsAccumulator`).
  */
 template <typename T, typename A>
 void NumericalStats_<T, A>::compute_numerical_stats(const Column* col) {
   size_t nrows = col->nrows;
   const RowIndex& rowindex = col->rowindex();
   const T* data = static_cast<const T*>(col->data());
-  size_t count_notna = 0;
-  double mean = 0;
-  double m2 = 0;
-  double m3 = 0;
-  double m4 = 0;
+  MomentsAccumulator moments;
   A sum = 0;
   T min = infinity<T>();
   T max = -infinity<T>();
@@ -160,15 +188,7 @@ void NumericalStats_<T, A>::compute_numerical_stats(const Column* col) {
   {
     size_t ith = static_cast<size_t>(omp_get_thread_num());
     size_t nth = static_cast<size_t>(omp_get_num_threads());
-    size_t t_count_notna = 0;
-    size_t n1 = 0;
-    size_t n2 = 0; // added for readability
-    double t_mean = 0;
-    double t_m2 = 0;
-    double t_m3 = 0;
-    double t_m4 = 0;
-    double t_m2_helper = 0;
-
+    MomentsAccumulator t_moments;
     A t_sum = 0;
     T t_min = infinity<T>();
     T t_max = -infinity<T>();
@@ -178,86 +198,154 @@ void NumericalStats_<T, A>::compute_numerical_stats(const Column* col) {
         if (j == RowIndex::NA) return;
         T x = data[j];
         if (ISNA<T>(x)) return;
-        n1 = t_count_notna;
-        ++t_count_notna;
-        n2 = t_count_notna; // readability
         t_sum += static_cast<A>(x);
         if (x < t_min) t_min = x;  // Note: these ifs are not exclusive!
         if (x > t_max) t_max = x;
-        double delta = static_cast<double>(x) - t_mean;
-        double delta_n = static_cast<double>(delta) / t_count_notna;
-        double delta_n2 = delta_n * delta_n;
-        double term1 = delta * delta_n * static_cast<double>(n1);
-        t_mean += delta / t_count_notna;
-        double delta2 = static_cast<double>(x) - t_mean;
-        t_m4 += term1 * delta_n2 * (n2 * n2 - 3 * n2 + 3);
-        t_m4 += 6 * delta_n2 * t_m2_helper - 4 * delta_n * t_m3;
-        t_m3 += (term1 * delta_n * (n2 - 2) - 3 * delta_n * t_m2_helper);
-        t_m2 += delta * delta2;
-        t_m2_helper += term1;
+        t_moments.add(static_cast<double>(x));
       });
 
     #pragma omp critical
     {
-      if (t_count_notna) {
-        size_t nold = count_notna;
-        count_notna += t_count_notna;
+      if (t_moments.n) {
         sum += t_sum;
         if (t_min < min) min = t_min;
         if (t_max > max) max = t_max;
-        double delta = mean - t_mean;
-        double delta2 = delta * delta;
-        double delta3 = delta2 * delta;
-        double delta4 = delta2 * delta2;
-        double a_m2 = m2;
-        double a_m3 = m3;
-        double b_m2 = t_m2;
-        double b_m3 = t_m3;
-        // readibility for counts
-        size_t a_n = nold;
-        size_t b_n = t_count_notna;
-        size_t c_n = count_notna;
-
-        // Running SD
-        m2 += t_m2 + delta2 * (1.0 * a_n / count_notna * t_count_notna);
-
-        // Running Skewness
-        m3 += t_m3 + delta3 * a_n * b_n * (a_n - b_n)/(c_n * c_n);
-        m3 += 3.0 * delta * (a_n * b_m2 - b_n * a_m2)/c_n;
-
-        // Running Kurtosis
-        m4 += t_m4 + delta4 * a_n * b_n * (a_n * a_n - a_n * b_n + b_n * b_n)/(pow(c_n,3));
-        m4 += 6 * delta2 * (a_n * a_n * b_m2 + b_n * b_n * a_m2) / (c_n*c_n);
-        m4 += 4 * delta * (a_n * b_m3 - b_n * a_m3) / c_n;
-
-        // Running mean
-        mean = static_cast<double>(sum) / count_notna;
+        moments.merge(t_moments);
       }
     }
   }
 
-  _countna = nrows - count_notna;
-  if (count_notna == 0) {
+  _countna = nrows - moments.n;
+  if (moments.n == 0) {
     _min = _max = GETNA<T>();
-    _mean = _sd = _skew = _kurt = GETNA<double>();
     _sum = 0;
   } else {
     _min = min;
     _max = max;
     _sum = sum;
-    _mean = mean;
-    _sd = count_notna > 1 ? std::sqrt(m2 / (count_notna - 1)) : 0;
-    _skew = count_notna > 1 ? std::sqrt(count_notna) * m3/std::pow(m2,1.5) : 0;
-    _kurt = count_notna > 1 ? (static_cast<double>(m4)*count_notna)/(m2*m2) : 0;
   }
+  set_moments(moments);
   set_computed(Stat::Min);
   set_computed(Stat::Max);
   set_computed(Stat::Sum);
+  set_computed(Stat::NaCount);
+}
+
+
+/**
+ * Store the mean, sd, skew and kurtosis from the `moments` accumulator. The
+ * mean is derived from `_sum`, so that it doesn't depend on the order in
+ * which the moments were accumulated.
+ */
+template <typename T, typename A>
+void NumericalStats_<T, A>::set_moments(const MomentsAccumulator& moments) {
+  size_t count_notna = moments.n;
+  if (count_notna == 0) {
+    _mean = _sd = _skew = _kurt = GETNA<double>();
+  } else {
+    _mean = static_cast<double>(_sum) / count_notna;
+    _sd = count_notna > 1 ? std::sqrt(moments.var()) : 0;
+    _skew = count_notna > 1 ? moments.skew() : 0;
+    _kurt = count_notna > 1 ? moments.kurt() : 0;
+  }
   set_computed(Stat::Mean);
   set_computed(Stat::StDev);
   set_computed(Stat::Skew);
   set_computed(Stat::Kurt);
-  set_computed(Stat::NaCount);
+}
+
+
+/**
+ * Inverse of `set_moments()`: restore the moments accumulator from the stored
+ * stats of a column with `nrows` rows. When all values are the same (M2 = 0),
+ * the skew and kurtosis are NaN, but M3 and M4 are known to be 0.
+ */
+template <typename T, typename A>
+MomentsAccumulator NumericalStats_<T, A>::moments(size_t nrows) const {
+  MomentsAccumulator res;
+  res.n = nrows - _countna;
+  if (res.n == 0) return res;
+  double n = static_cast<double>(res.n);
+  res.mean = _mean;
+  res.m2 = res.n > 1 ? _sd * _sd * (n - 1) : 0;
+  if (res.m2 > 0) {
+    res.m3 = _skew * std::pow(res.m2, 1.5) / std::sqrt(n);
+    res.m4 = _kurt * res.m2 * res.m2 / n;
+  }
+  return res;
+}
+
+
+/**
+ * Min, max and sum of the combined column are computed directly from their
+ * values on the parts; the mean, sd, skew and kurtosis are obtained by
+ * merging the central moments of the parts (see `MomentsAccumulator`).
+ */
+template <typename T, typename A>
+void NumericalStats_<T, A>::merge_stats(
+    const Stats* other, size_t nrows, size_t other_nrows)
+{
+  if (other == nullptr) {
+    // Appending NAs changes only the NA count
+    Stats::merge_stats(other, nrows, other_nrows);
+    return;
+  }
+  auto o = static_cast<const NumericalStats_<T, A>*>(other);
+
+  if (is_computed(Stat::Min) && o->is_computed(Stat::Min)) {
+    if (ISNA<T>(_min) || (!ISNA<T>(o->_min) && o->_min < _min)) {
+      _min = o->_min;
+    }
+  } else {
+    set_computed(Stat::Min, false);
+  }
+  if (is_computed(Stat::Max) && o->is_computed(Stat::Max)) {
+    if (ISNA<T>(_max) || (!ISNA<T>(o->_max) && o->_max > _max)) {
+      _max = o->_max;
+    }
+  } else {
+    set_computed(Stat::Max, false);
+  }
+
+  // The moments can only be restored if all of the stats they're derived
+  // from are known (normally they are computed together).
+  auto has_moments = [](const NumericalStats_<T, A>* st) {
+    return st->is_computed(Stat::NaCount) && st->is_computed(Stat::Sum) &&
+           st->is_computed(Stat::Mean) && st->is_computed(Stat::StDev) &&
+           st->is_computed(Stat::Skew) && st->is_computed(Stat::Kurt);
+  };
+  if (has_moments(this) && has_moments(o)) {
+    MomentsAccumulator acc = moments(nrows);
+    acc.merge(o->moments(other_nrows));
+    _sum += o->_sum;
+    set_moments(acc);
+  } else {
+    if (is_computed(Stat::Sum) && o->is_computed(Stat::Sum)) {
+      _sum += o->_sum;
+    } else {
+      set_computed(Stat::Sum, false);
+    }
+    set_computed(Stat::Mean, false);
+    set_computed(Stat::StDev, false);
+    set_computed(Stat::Skew, false);
+    set_computed(Stat::Kurt, false);
+  }
+  Stats::merge_stats(other, nrows, other_nrows);
+}
+
+
+template <typename T, typename A>
+void NumericalStats_<T, A>::copy_from(const Stats* other) {
+  Stats::copy_from(other);
+  auto o = static_cast<const NumericalStats_<T, A>*>(other);
+  _mean = o->_mean;
+  _sd = o->_sd;
+  _skew = o->_skew;
+  _kurt = o->_kurt;
+  _sum = o->_sum;
+  _min = o->_min;
+  _max = o->_max;
+  _mode = o->_mode;
 }
 
 
@@ -398,6 +486,26 @@ template class NumericalStats_<double, double>;
 template <typename T>
 void RealStats<T>::compute_numerical_stats(const Column *col) {
   NumericalStats_<T, double>::compute_numerical_stats(col);
+  adjust_for_infinities();
+}
+
+
+// The moments of a part that contains infinities are NaN, but then the
+// merged min or max is infinite too, and the same adjustment applies.
+template <typename T>
+void RealStats<T>::merge_stats(
+    const Stats* other, size_t nrows, size_t other_nrows)
+{
+  NumericalStats_<T, double>::merge_stats(other, nrows, other_nrows);
+  if (this->is_computed(Stat::Min) && this->is_computed(Stat::Max) &&
+      this->is_computed(Stat::Mean)) {
+    adjust_for_infinities();
+  }
+}
+
+
+template <typename T>
+void RealStats<T>::adjust_for_infinities() {
   if (std::isinf(this->_min) || std::isinf(this->_max)) {
     this->_sd = GETNA<double>();
     this->_skew = GETNA<double>();
@@ -475,6 +583,39 @@ void BooleanStats::compute_numerical_stats(const Column *col) {
       count1 += tcount1;
     }
   }
+  set_from_counts(count0, count1, nrows);
+}
+
+
+/**
+ * All stats of a boolean column are determined by the number of 0s and 1s in
+ * it, and therefore they can all be merged: `count1` is the sum, and `count0`
+ * is the number of non-NA values minus the sum.
+ */
+void BooleanStats::merge_stats(
+    const Stats* other, size_t nrows, size_t other_nrows)
+{
+  auto o = static_cast<const BooleanStats*>(other);
+  auto has_counts = [](const BooleanStats* st) {
+    return st->is_computed(Stat::NaCount) && st->is_computed(Stat::Sum);
+  };
+  if (has_counts(this) && (o == nullptr || has_counts(o))) {
+    size_t count1 = static_cast<size_t>(_sum);
+    size_t count0 = nrows - _countna - count1;
+    if (o) {
+      size_t o_count1 = static_cast<size_t>(o->_sum);
+      count1 += o_count1;
+      count0 += other_nrows - o->_countna - o_count1;
+    }
+    set_from_counts(count0, count1, nrows + other_nrows);
+  } else {
+    NumericalStats<int8_t>::merge_stats(other, nrows, other_nrows);
+  }
+}
+
+
+void BooleanStats::set_from_counts(size_t count0, size_t count1, size_t nrows)
+{
   size_t t_count = count0 + count1;
   double dcount0 = static_cast<double>(count0);
   double dcount1 = static_cast<double>(count1);
@@ -593,6 +734,15 @@ void StringStats<T>::compute_sorted_stats(const Column* col) {
 }
 
 
+// The mode is not copied, since it points into the string data of the source
+// column, whereas the copy may later replace its string buffer.
+template <typename T>
+void StringStats<T>::copy_from(const Stats* other) {
+  Stats::copy_from(other);
+  set_computed(Stat::Mode, false);
+}
+
+
 template <typename T>
 CString StringStats<T>::mode(const Column* col) {
   if (!is_computed(Stat::Mode)) compute_sorted_stats(col);
@@ -8,6 +8,7 @@
 #ifndef dt_STATS_h
 #define dt_STATS_h
 #include <bitset>
+#include <cmath>      // std::sqrt, std::pow
 #include <vector>
 #include "types.h"
 
@@ -68,6 +69,11 @@ constexpr uint8_t NSTATS = 14;
  *       from the provided column.
  *   <S>_get() - retrieve the value of computed statistic (but the user should
  *       check its availability first).
+ *
+ * Stats of a column can also be composed from the stats of its parts (see
+ * `merge_stats()`), which allows the result of an rbind to avoid rescanning
+ * the data. Only the stats that are known for every part are carried over;
+ * the rest will be recomputed from the data upon request, as usual.
  */
 class Stats {
   protected:
@@ -89,13 +95,24 @@ class Stats {
     bool is_computed(Stat s) const;
     void reset();
     void set_countna(size_t n);
-    virtual void merge_stats(const Stats*);
+    Stats* copy() const;
+
+    /**
+     * Update these stats, which describe a column with `nrows` rows, so that
+     * they describe the same column with the rows of another column appended
+     * (the stats of that column are `other`, and it has `other_nrows` rows).
+     * If `other` is nullptr, then the appended rows are all NAs. `other` must
+     * be of the same class as `this`.
+     */
+    virtual void merge_stats(const Stats* other, size_t nrows,
+                             size_t other_nrows);
 
     virtual size_t memory_footprint() const = 0;
     virtual void verify_integrity(const Column*) const;
 
   protected:
     virtual Stats* make() const = 0;
+    virtual void copy_from(const Stats*);
     template <typename T, typename F> void verify_stat(Stat, T, F) const;
     virtual void verify_more(Stats*, const Column*) const;
 
@@ -107,6 +124,84 @@ class Stats {
 
 
 
+//------------------------------------------------------------------------------
+// Moments accumulator
+//------------------------------------------------------------------------------
+
+/**
+ * Running computation of the mean and the central moments M2, M3, M4 of a
+ * sequence of values, using Welford's method. Two accumulators can be merged
+ * together, so that the data may be split into chunks (one per thread, or one
+ * per group) and then combined.
+ * (Source: https://www.johndcook.com/blog/skewness_kurtosis)
+ *
+ * This class is shared between `NumericalStats` and the `var()` / `skew()` /
+ * `kurt()` reducers, so that both produce the same results.
+ */
+struct MomentsAccumulator {
+  size_t n;
+  double mean;
+  double m2;
+  double m3;
+  double m4;
+
+  MomentsAccumulator() : n(0), mean(0), m2(0), m3(0), m4(0) {}
+
+  void add(double x) {
+    double n1 = static_cast<double>(n);
+    n++;
+    double nn = static_cast<double>(n);
+    double delta = x - mean;
+    double delta_n = delta / nn;
+    double delta_n2 = delta_n * delta_n;
+    double term1 = delta * delta_n * n1;
+    mean += delta_n;
+    m4 += term1 * delta_n2 * (nn * nn - 3 * nn + 3) +
+          6 * delta_n2 * m2 - 4 * delta_n * m3;
+    m3 += term1 * delta_n * (nn - 2) - 3 * delta_n * m2;
+    m2 += term1;
+  }
+
+  void merge(const MomentsAccumulator& o) {
+    if (o.n == 0) return;
+    if (n == 0) { *this = o; return; }
+    double a_n = static_cast<double>(n);
+    double b_n = static_cast<double>(o.n);
+    double c_n = a_n + b_n;
+    double delta = o.mean - mean;
+    double delta2 = delta * delta;
+    double delta3 = delta2 * delta;
+    double delta4 = delta2 * delta2;
+    double r_m2 = m2 + o.m2 + delta2 * a_n * b_n / c_n;
+    double r_m3 = m3 + o.m3 + delta3 * a_n * b_n * (a_n - b_n) / (c_n * c_n)
+                  + 3.0 * delta * (a_n * o.m2 - b_n * m2) / c_n;
+    double r_m4 = m4 + o.m4
+                  + delta4 * a_n * b_n * (a_n * a_n - a_n * b_n + b_n * b_n)
+                    / (c_n * c_n * c_n)
+                  + 6.0 * delta2 * (a_n * a_n * o.m2 + b_n * b_n * m2)
+                    / (c_n * c_n)
+                  + 4.0 * delta * (a_n * o.m3 - b_n * m3) / c_n;
+    mean += delta * b_n / c_n;
+    m2 = r_m2;
+    m3 = r_m3;
+    m4 = r_m4;
+    n += o.n;
+  }
+
+  // Sample variance; requires `n > 1`
+  double var() const { return m2 / static_cast<double>(n - 1); }
+
+  // Sample skewness g1 and kurtosis (not excess); require `n > 1`
+  double skew() const {
+    return std::sqrt(static_cast<double>(n)) * m3 / std::pow(m2, 1.5);
+  }
+  double kurt() const {
+    return static_cast<double>(n) * m4 / (m2 * m2);
+  }
+};
+
+
+
 //------------------------------------------------------------------------------
 // NumericalStats class
 //------------------------------------------------------------------------------
@@ -148,11 +243,15 @@ class NumericalStats_ : public Stats {
 
     void set_min(T value);
     void set_max(T value);
+    void merge_stats(const Stats*, size_t, size_t) override;
 
     // void verify_integrity(const Column*) const override;
 
   protected:
+    void copy_from(const Stats*) override;
     void verify_more(Stats*, const Column*) const override;
+    MomentsAccumulator moments(size_t nrows) const;
+    void set_moments(const MomentsAccumulator&);
 
     // Helper method that computes min, max, sum, mean, sd, and countna
     virtual void compute_numerical_stats(const Column*);
@@ -190,9 +289,13 @@ extern template class NumericalStats_<double, double>;
  */
 template <typename T>
 class RealStats : public NumericalStats<T> {
+  public:
+    void merge_stats(const Stats*, size_t, size_t) override;
+
   protected:
     virtual RealStats<T>* make() const override;
     void compute_numerical_stats(const Column*) override;
+    void adjust_for_infinities();
 };
 
 extern template class RealStats<float>;
@@ -230,10 +333,14 @@ extern template class IntegerStats<int64_t>;
  * if we know that the set of possible element values is {0, 1, NA}.
  */
 class BooleanStats : public NumericalStats<int8_t> {
+  public:
+    void merge_stats(const Stats*, size_t, size_t) override;
+
   protected:
     virtual BooleanStats* make() const override;
     void compute_numerical_stats(const Column *col) override;
     void compute_sorted_stats(const Column*) override;
+    void set_from_counts(size_t count0, size_t count1, size_t nrows);
 };
 
 
@@ -258,6 +365,7 @@ class StringStats : public Stats {
 
   protected:
     StringStats<T>* make() const override;
+    void copy_from(const Stats*) override;
     void compute_countna(const Column*) override;
     void compute_sorted_stats(const Column*) override;
 };
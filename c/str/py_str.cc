@@ -22,14 +22,15 @@ namespace py {
 
 
 static PKArgs args_split_into_nhot(
-    1, 0, 1, false, false,
-    {"col", "sep"}, "split_into_nhot", nullptr
+    1, 0, 2, false, false,
+    {"col", "sep", "sparse"}, "split_into_nhot", nullptr
 );
 
 
 static oobj split_into_nhot(const PKArgs& args) {
   DataTable* dt = args[0].to_datatable();
   std::string sep = args[1]? args[1].to_string() : ",";
+  bool sparse = args[2].to<bool>(false);
 
   Column* col0 = dt->ncols == 1? dt->columns[0] : nullptr;
   if (!col0) {
@@ -48,6 +49,14 @@ static oobj split_into_nhot(const PKArgs& args) {
       "single character; got '" << sep << "'";
   }
 
+  if (sparse) {
+    // Returns a tuple of 3 single-column frames: (offsets, ids, tokens)
+    dt::nhot_sparse res = dt::split_into_nhot_sparse(col0, sep[0]);
+    return otuple(
+        oobj::from_new_reference(Frame::from_datatable(res.offsets.release())),
+        oobj::from_new_reference(Frame::from_datatable(res.ids.release())),
+        oobj::from_new_reference(Frame::from_datatable(res.tokens.release())));
+  }
   DataTable* res = dt::split_into_nhot(col0, sep[0]);
   return Frame::from_datatable(res);
 }
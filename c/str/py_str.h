@@ -19,7 +19,29 @@
 
 
 namespace dt {
+
+  /**
+   * Split each string of the column `col` into tokens separated by `sep`,
+   * and return a DataTable with one boolean column per distinct token,
+   * indicating which rows contain that token.
+   */
   DataTable* split_into_nhot(Column* col, char sep);
+
+  /**
+   * Sparse (CSR) form of the n-hot encoding: the ids of the tokens found in
+   * row `i` are `ids[offsets[i]], ..., ids[offsets[i+1] - 1]`, listed in
+   * ascending order and without duplicates; and the token with id `k` is
+   * `tokens[k]`. Each of the three tables has a single column: `offsets` is
+   * INT32 or INT64 with `nrows + 1` elements, `ids` is INT32, and `tokens`
+   * is a string column.
+   */
+  struct nhot_sparse {
+    dtptr offsets;
+    dtptr ids;
+    dtptr tokens;
+  };
+
+  nhot_sparse split_into_nhot_sparse(Column* col, char sep);
 }
 
 
@@ -14,21 +14,34 @@
 // limitations under the License.
 //------------------------------------------------------------------------------
 #include "str/py_str.h"
-#include <unordered_map>
+#include <algorithm>   // std::sort, std::unique, std::equal, std::min
+#include <cstring>     // std::memset
 #include <vector>
-#include "datatable.h"
-#include "options.h"
+#include "models/murmurhash.h"
+#include "python/gil.h"
 #include "utils/exceptions.h"
-#include "utils/parallel.h"
-#include "utils/shared_mutex.h"
+#include "utils/profiler.h"
+#include "utils/thread_pool.h"
+#include "column.h"
+#include "datatable.h"
+#include "wstringcol.h"
 
 namespace dt {
 
+/**
+ * Token within a string: a substring of the column's string data.
+ */
+struct token {
+  const char* ptr;
+  size_t len;
+};
+
+
 /**
  * Split string into tokens
  */
 static void tokenize_string(
-    std::vector<std::string>& tokens,
+    std::vector<token>& tokens,
     const char* strstart,
     const char* strend,
     char sep
@@ -48,7 +61,7 @@ static void tokenize_string(
           ch += 1 + (*ch == '\\');
         }
         if (ch < strend) {
-          tokens.emplace_back(ch0 + 1, ch);
+          tokens.push_back({ch0 + 1, static_cast<size_t>(ch - ch0 - 1)});
           ch++;  // move over the closing quote
           continue;
         }
@@ -65,7 +78,7 @@ static void tokenize_string(
         if (!(c == ' ' || c == '\t' || c == '\n')) break;
         ch1--;
       }
-      tokens.emplace_back(ch0, ch1);
+      tokens.push_back({ch0, static_cast<size_t>(ch1 - ch0)});
       ch++;  // move over the sep
     }
   }
@@ -73,100 +86,322 @@ static void tokenize_string(
 
 
 
-DataTable* split_into_nhot(Column* col, char sep) {
+//------------------------------------------------------------------------------
+// Token dictionary
+//------------------------------------------------------------------------------
+
+/**
+ * Open addressing hash table of distinct tokens, with linear probing. Tokens
+ * get ids 0, 1, 2, ... in the order in which they were inserted.
+ */
+struct token_dict {
+  std::vector<token> tokens;
+  std::vector<uint64_t> hashes;
+  std::vector<int32_t> slots;   // ids of the tokens, or -1
+  size_t mask;
+
+  token_dict() : slots(16, -1), mask(15) {}
+  size_t size() const { return tokens.size(); }
+
+  static uint64_t hash(const token& t) {
+    return hash_murmur2(t.ptr, t.len, 0);
+  }
+
+  /**
+   * Find token `t` with hash `h` in the dictionary and return its id. If
+   * the token is not there yet, add it with the next available id.
+   */
+  int32_t insert(const token& t, uint64_t h) {
+    size_t pos = h & mask;
+    while (slots[pos] >= 0) {
+      const token& u = tokens[static_cast<size_t>(slots[pos])];
+      if (hashes[static_cast<size_t>(slots[pos])] == h && u.len == t.len &&
+          std::equal(t.ptr, t.ptr + t.len, u.ptr)) {
+        return slots[pos];
+      }
+      pos = (pos + 1) & mask;
+    }
+    auto id = static_cast<int32_t>(size());
+    slots[pos] = id;
+    tokens.push_back(t);
+    hashes.push_back(h);
+    // Keep the load factor below 0.5
+    if (2 * size() > mask) {
+      mask = 2 * mask + 1;
+      slots.assign(mask + 1, -1);
+      for (size_t k = 0; k < size(); ++k) {
+        pos = hashes[k] & mask;
+        while (slots[pos] >= 0) pos = (pos + 1) & mask;
+        slots[pos] = static_cast<int32_t>(k);
+      }
+    }
+    return id;
+  }
+};
+
+
+
+//------------------------------------------------------------------------------
+// Tokenized column
+//------------------------------------------------------------------------------
+
+/**
+ * Result of tokenizing all rows of a string column, which can then be
+ * converted into either dense or sparse n-hot encoding.
+ *
+ * Tokenization proceeds in two phases. First, the rows are split into
+ * `nchunks` contiguous chunks, and each chunk is tokenized in parallel into
+ * its own dictionary: every row is stored as a list of distinct local token
+ * ids. Then the local dictionaries are merged (in the order of chunks) into
+ * a global dictionary, producing for each chunk a map from local to global
+ * token ids. Thus the global ids are assigned in the order of first
+ * appearance of each token in the column, regardless of the number of
+ * threads. The output is filled in the second parallel pass over the same
+ * chunks.
+ *
+ * There is no synchronization between threads while tokenizing, and each
+ * output element is written exactly once.
+ */
+class tokenized_column {
+  private:
+    struct chunk {
+      token_dict dict;
+      std::vector<int32_t> ids;   // local ids of the tokens, row after row
+      std::vector<int32_t> map;   // local id -> global id
+    };
+
+    size_t nrows;
+    size_t nchunks;
+    std::vector<chunk> chunks;
+    std::vector<uint32_t> counts;  // number of tokens in each row
+    token_dict global;
+
+  public:
+    tokenized_column(Column* col, char sep);
+    void to_dense(colvec& outcols, strvec& outnames);
+    colvec to_sparse();
+
+  private:
+    template <typename U>
+    void tokenize(const StringColumn<U>* col, char sep, size_t c);
+    void merge();
+    size_t row0(size_t c) const { return nrows * c / nchunks; }
+};
+
+
+tokenized_column::tokenized_column(Column* col, char sep)
+  : nrows(col->nrows)
+{
   bool is32 = (col->stype() == SType::STR32);
   xassert(is32 || (col->stype() == SType::STR64));
-  const uint32_t* offsets32 = nullptr;
-  const uint64_t* offsets64 = nullptr;
-  const char* strdata;
-  if (is32) {
-    auto scol = static_cast<StringColumn<uint32_t>*>(col);
-    offsets32 = scol->offsets();
-    strdata = scol->strdata();
-  } else {
-    auto scol = static_cast<StringColumn<uint64_t>*>(col);
-    offsets64 = scol->offsets();
-    strdata = scol->strdata();
+  nchunks = std::max(size_t(1), std::min(num_threads_in_pool(), nrows));
+  chunks.resize(nchunks);
+  counts.resize(nrows);
+
+  dt::parallel_for_dynamic(nchunks, nchunks,
+    [&](size_t c) {
+      if (is32) tokenize(static_cast<StringColumn<uint32_t>*>(col), sep, c);
+      else      tokenize(static_cast<StringColumn<uint64_t>*>(col), sep, c);
+    });
+  merge();
+}
+
+
+template <typename U>
+void tokenized_column::tokenize(const StringColumn<U>* col, char sep,
+                                size_t c)
+{
+  const U* offsets = col->offsets();
+  const char* strdata = col->strdata();
+  const RowIndex& ri = col->rowindex();
+  chunk& ch = chunks[c];
+  std::vector<token> tokens;
+  size_t i1 = row0(c + 1);
+  for (size_t irow = row0(c); irow < i1; ++irow) {
+    counts[irow] = 0;
+    size_t jrow = ri[irow];
+    if (jrow == RowIndex::NA || ISNA<U>(offsets[jrow])) continue;
+    const char* strstart = strdata + (offsets[jrow - 1] & ~GETNA<U>());
+    const char* strend = strdata + offsets[jrow];
+    if (strstart == strend) continue;
+    char chfirst = *strstart;
+    char chlast = strend[-1];
+    if ((chfirst == '(' && chlast == ')') ||
+        (chfirst == '[' && chlast == ']') ||
+        (chfirst == '{' && chlast == '}')) {
+      strstart++;
+      strend--;
+    }
+
+    tokenize_string(tokens, strstart, strend, sep);
+
+    // Store the distinct local ids of the row's tokens
+    size_t k0 = ch.ids.size();
+    for (const token& t : tokens) {
+      ch.ids.push_back(ch.dict.insert(t, token_dict::hash(t)));
+    }
+    auto beg = ch.ids.begin() + static_cast<long>(k0);
+    std::sort(beg, ch.ids.end());
+    ch.ids.erase(std::unique(beg, ch.ids.end()), ch.ids.end());
+    counts[irow] = static_cast<uint32_t>(ch.ids.size() - k0);
   }
+}
 
-  size_t nrows = col->nrows;
-  std::unordered_map<std::string, size_t> colsmap;
-  std::vector<Column*> outcols;
+
+void tokenized_column::merge() {
+  for (chunk& ch : chunks) {
+    const token_dict& d = ch.dict;
+    ch.map.resize(d.size());
+    for (size_t k = 0; k < d.size(); ++k) {
+      ch.map[k] = global.insert(d.tokens[k], d.hashes[k]);
+    }
+  }
+}
+
+
+/**
+ * Create one boolean column per token, named after that token.
+ */
+void tokenized_column::to_dense(colvec& outcols, strvec& outnames) {
+  size_t ntokens = global.size();
   std::vector<int8_t*> outdata;
-  std::vector<std::string> outnames;
-  dt::shared_mutex shmutex;
-  const RowIndex& ri = col->rowindex();
+  outcols.reserve(ntokens);
+  outdata.reserve(ntokens);
+  outnames.reserve(ntokens);
+  for (const token& t : global.tokens) {
+    BoolColumn* newcol = new BoolColumn(nrows);
+    outcols.push_back(newcol);
+    outdata.push_back(newcol->elements_w());
+    outnames.emplace_back(t.ptr, t.len);
+  }
 
-  OmpExceptionManager oem;
-  size_t nth0 = std::min(static_cast<size_t>(config::nthreads), nrows);
-  (void)nth0;  // Prevent warning about unused variable
-  #pragma omp parallel num_threads(nth0)
-  {
-    try {
-      size_t ith = static_cast<size_t>(omp_get_thread_num());
-      size_t nth = static_cast<size_t>(omp_get_num_threads());
-      std::vector<std::string> chunks;
-
-      for (size_t irow = ith; irow < nrows; irow += nth) {
-        const char* strstart, *strend;
-        size_t jrow = ri[irow];
-        if (jrow == RowIndex::NA) continue;
-        if (is32) {
-          if (ISNA(offsets32[jrow])) continue;
-          strstart = strdata + (offsets32[jrow - 1] & ~GETNA<uint32_t>());
-          strend = strdata + offsets32[jrow];
-        } else {
-          if (ISNA(offsets64[jrow])) continue;
-          strstart = strdata + (offsets64[jrow - 1] & ~GETNA<uint64_t>());
-          strend = strdata + offsets64[jrow];
-        }
-        if (strstart == strend) continue;
-        char chfirst = *strstart;
-        char chlast = strend[-1];
-        if ((chfirst == '(' && chlast == ')') ||
-            (chfirst == '[' && chlast == ']') ||
-            (chfirst == '{' && chlast == '}')) {
-          strstart++;
-          strend--;
+  // Each chunk clears and fills its own range of rows in all output columns
+  dt::parallel_for_dynamic(nchunks, nchunks,
+    [&](size_t c) {
+      size_t i0 = row0(c);
+      size_t i1 = row0(c + 1);
+      for (int8_t* data : outdata) {
+        std::memset(data + i0, 0, i1 - i0);
+      }
+      const int32_t* ids = chunks[c].ids.data();
+      const int32_t* map = chunks[c].map.data();
+      for (size_t i = i0; i < i1; ++i) {
+        for (uint32_t q = counts[i]; q; --q) {
+          outdata[static_cast<size_t>(map[*ids++])][i] = 1;
         }
+      }
+    });
+}
+
+
+template <typename T>
+static void fill_offsets(T* out, const uint32_t* counts, size_t i0,
+                         size_t i1, size_t base)
+{
+  if (i0 == 0) out[0] = 0;
+  size_t s = base;
+  for (size_t i = i0; i < i1; ++i) {
+    s += counts[i];
+    out[i + 1] = static_cast<T>(s);
+  }
+}
+
+
+/**
+ * Create columns `offsets`, `ids` and `tokens` of the sparse encoding.
+ */
+colvec tokenized_column::to_sparse() {
+  std::vector<size_t> base(nchunks + 1, 0);
+  for (size_t c = 0; c < nchunks; ++c) {
+    base[c + 1] = base[c] + chunks[c].ids.size();
+  }
+  size_t nnz = base[nchunks];
+  bool off32 = (nnz <= static_cast<size_t>(INT32_MAX));
 
-        tokenize_string(chunks, strstart, strend, sep);
-
-        dt::shared_lock<dt::shared_mutex> lock(shmutex);
-        for (const std::string& s : chunks) {
-          if (colsmap.count(s)) {
-            size_t j = colsmap[s];
-            outdata[j][irow] = 1;
-          } else {
-            lock.exclusive_start();
-            if (colsmap.count(s) == 0) {
-              colsmap[s] = outcols.size();
-              BoolColumn* newcol = new BoolColumn(col->nrows);
-              int8_t* data = newcol->elements_w();
-              std::memset(data, 0, nrows);
-              data[irow] = 1;
-              outcols.push_back(newcol);
-              outdata.push_back(data);
-              outnames.push_back(s);
-            } else {
-              // In case the name was already added from another thread while we
-              // were waiting for the exclusive lock
-              size_t j = colsmap[s];
-              outdata[j][irow] = 1;
-            }
-            lock.exclusive_end();
-          }
+  Column* offcol = Column::new_data_column(off32? SType::INT32 : SType::INT64,
+                                           nrows + 1);
+  Column* idscol = Column::new_data_column(SType::INT32, nnz);
+  void* offdata = offcol->data_w();
+  int32_t* outids = static_cast<int32_t*>(idscol->data_w());
+
+  dt::parallel_for_dynamic(nchunks, nchunks,
+    [&](size_t c) {
+      size_t i0 = row0(c);
+      size_t i1 = row0(c + 1);
+      if (off32) {
+        fill_offsets(static_cast<int32_t*>(offdata), counts.data(),
+                     i0, i1, base[c]);
+      } else {
+        fill_offsets(static_cast<int64_t*>(offdata), counts.data(),
+                     i0, i1, base[c]);
+      }
+      // Translate the ids into global ones, sorted within each row
+      const int32_t* ids = chunks[c].ids.data();
+      const int32_t* map = chunks[c].map.data();
+      int32_t* out = outids + base[c];
+      for (size_t i = i0; i < i1; ++i) {
+        int32_t* rowstart = out;
+        for (uint32_t q = counts[i]; q; --q) {
+          *out++ = map[*ids++];
         }
+        std::sort(rowstart, out);
       }
-    } catch (...) {
-      oem.capture_exception();  // LCOV_EXCL_LINE
-    }                           // LCOV_EXCL_LINE
-  }  // end of #pragma omp parallel
+    });
 
-  oem.rethrow_exception_if_any();
+  size_t ntokens = global.size();
+  dt::writable_string_col tokcol(ntokens);
+  dt::writable_string_col::buffer_impl<uint32_t> sb(tokcol);
+  sb.commit_and_start_new_chunk(0);
+  for (const token& t : global.tokens) {
+    sb.write(t.ptr, t.len);
+  }
+  sb.order();
+  sb.commit_and_start_new_chunk(ntokens);
 
+  return {offcol, idscol, std::move(tokcol).to_column()};
+}
+
+
+
+//------------------------------------------------------------------------------
+// Main functions
+//------------------------------------------------------------------------------
+
+// The GIL is released while the data is processed, but the DataTables are
+// created with the GIL held, since setting their names requires python.
+// The data is processed on a shallow copy of the column, so that it cannot
+// be modified by other python threads in the meantime; the copy is destroyed
+// after the GIL is re-acquired.
+
+DataTable* split_into_nhot(Column* col0, char sep) {
+  dt::profile_scope ps("split_into_nhot");
+  colptr col(col0->shallowcopy());
+  colvec outcols;
+  strvec outnames;
+  {
+    py::gil_release nogil;
+    tokenized_column tc(col.get(), sep);
+    tc.to_dense(outcols, outnames);
+  }
   return new DataTable(std::move(outcols), std::move(outnames));
 }
 
 
+nhot_sparse split_into_nhot_sparse(Column* col0, char sep) {
+  dt::profile_scope ps("split_into_nhot");
+  colptr col(col0->shallowcopy());
+  colvec cols;
+  {
+    py::gil_release nogil;
+    tokenized_column tc(col.get(), sep);
+    cols = tc.to_sparse();
+  }
+  nhot_sparse res;
+  res.offsets = dtptr(new DataTable({cols[0]}, {"offsets"}));
+  res.ids = dtptr(new DataTable({cols[1]}, {"ids"}));
+  res.tokens = dtptr(new DataTable({cols[2]}, {"tokens"}));
+  return res;
+}
+
+
 } // namespace dt
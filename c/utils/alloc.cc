@@ -6,22 +6,61 @@
 // © H2O.ai 2018
 //------------------------------------------------------------------------------
 #include <cerrno>              // errno
+#include <cstdio>              // printf
 #include <cstdlib>             // std::realloc, std::free
+#include <cstring>             // std::strerror
 #include <unordered_map>
+#ifndef _WIN32
+#include <sys/mman.h>          // mmap, munmap, madvise
+#include <unistd.h>            // sysconf
+#endif
 #include "utils/alloc.h"
 #include "utils/exceptions.h"  // MemoryError
+#include "utils/thread_pool.h"
 #include "datatablemodule.h"
 #include "mmm.h"               // MemoryMapManager
+#include "options.h"           // config::memory_hugepages, ...
+#include "utils/misc.h"        // malloc_size
 
 namespace dt
 {
 
 
+//------------------------------------------------------------------------------
+// Memory accounting
+//------------------------------------------------------------------------------
+
+memory_counters_t memory_counters;
+
+size_t memory_current() {
+  return memory_counters.heap_bytes.load(std::memory_order_relaxed) +
+         memory_counters.mapped_bytes.load(std::memory_order_relaxed);
+}
+
+size_t memory_reset_peak() {
+  return memory_counters.peak.exchange(memory_current());
+}
+
+static void update_peak() {
+  size_t total = memory_current();
+  size_t p = memory_counters.peak.load(std::memory_order_relaxed);
+  while (total > p &&
+         !memory_counters.peak.compare_exchange_weak(
+              p, total, std::memory_order_relaxed));
+}
+
+
+
+//------------------------------------------------------------------------------
+// Heap allocations
+//------------------------------------------------------------------------------
+
 void* _realloc(void* ptr, size_t n) {
   if (n == 0) {
     dt::free(ptr);
     return nullptr;
   }
+  size_t oldsize = ptr? malloc_size(ptr) : 0;
   int attempts = 3;
   while (true) {
     // The documentation for `void* realloc(void* ptr, size_t new_size);` says
@@ -37,6 +76,18 @@ void* _realloc(void* ptr, size_t n) {
     if (newptr) {
       if (ptr) UNTRACK(ptr);
       TRACK(newptr, n, "malloc");
+      size_t newsize = malloc_size(newptr);
+      if (!ptr) {
+        memory_counters.heap_buffers.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (newsize >= oldsize) {
+        memory_counters.heap_bytes.fetch_add(newsize - oldsize,
+                                             std::memory_order_relaxed);
+        update_peak();
+      } else {
+        memory_counters.heap_bytes.fetch_sub(oldsize - newsize,
+                                             std::memory_order_relaxed);
+      }
       return newptr;
     }
     if (errno == 12 && attempts--) {
@@ -55,9 +106,140 @@ void* _realloc(void* ptr, size_t n) {
 
 void free(void* ptr) {
   if (!ptr) return;
+  memory_counters.heap_bytes.fetch_sub(malloc_size(ptr),
+                                       std::memory_order_relaxed);
+  memory_counters.heap_buffers.fetch_sub(1, std::memory_order_relaxed);
   std::free(ptr);
   UNTRACK(ptr);
 }
 
 
+
+//------------------------------------------------------------------------------
+// Large buffers
+//------------------------------------------------------------------------------
+
+alloc_stats_t alloc_stats;
+
+#ifndef _WIN32
+
+static void* mmap_anonymous(size_t n) {
+  int attempts = 3;
+  while (true) {
+    void* p = mmap(/* address = */ nullptr,
+                   /* length = */ n,
+                   /* protection = */ PROT_WRITE|PROT_READ,
+                   /* flags = */ MAP_PRIVATE|MAP_ANONYMOUS,
+                   /* fd = */ -1,
+                   /* offset = */ 0);
+    if (p != MAP_FAILED) return p;
+    if (errno == 12 && attempts--) {
+      MemoryMapManager::get()->freeup_memory();
+      errno = 0;
+    } else {
+      throw MemoryError() << "Unable to allocate memory of size " << n << Errno;
+    }
+  }
+}
+
+
+// Size of a mapping of `n` bytes, i.e. `n` rounded up to the system page
+// size. Both the allocation and the deallocation of a large buffer must use
+// the same rounded length.
+static size_t mapped_size(size_t n) {
+  static const size_t pagesize = static_cast<size_t>(sysconf(_SC_PAGE_SIZE));
+  return (n + pagesize - 1) / pagesize * pagesize;
+}
+
+
+// Over-allocate by one huge page, and then trim the unaligned head and the
+// tail of the mapping: transparent huge pages can only be used for the
+// regions that are aligned at `HUGEPAGE_SIZE`. The length `n` is rounded
+// to the page size first, so that the tail starts at a page boundary (as
+// required by `munmap`).
+static void* mmap_hugepage_aligned(size_t n) {
+  n = mapped_size(n);
+  char* p = static_cast<char*>(mmap_anonymous(n + HUGEPAGE_SIZE));
+  size_t head = (HUGEPAGE_SIZE - reinterpret_cast<size_t>(p) % HUGEPAGE_SIZE)
+                % HUGEPAGE_SIZE;
+  size_t tail = HUGEPAGE_SIZE - head;
+  if (head && munmap(p, head) != 0) {
+    munmap(p, n + HUGEPAGE_SIZE);
+    throw MemoryError() << "Unable to trim memory mapping of size "
+        << n + HUGEPAGE_SIZE << Errno;
+  }
+  if (tail && munmap(p + head + n, tail) != 0) {
+    munmap(p + head, n + tail);
+    throw MemoryError() << "Unable to trim memory mapping of size "
+        << n + tail << Errno;
+  }
+  return p + head;
+}
+
+
+static void first_touch(void* ptr, size_t n, size_t pagesize) {
+  char* p = static_cast<char*>(ptr);
+  size_t npages = (n + pagesize - 1) / pagesize;
+  dt::parallel_for_static(npages, num_threads_in_pool(),
+    [&](size_t i0, size_t i1) {
+      for (size_t i = i0; i < i1; ++i) {
+        p[i * pagesize] = 0;
+      }
+    });
+  alloc_stats.first_touch_bytes += n;
+}
+
+#endif
+
+
+void* large_alloc(size_t n) {
+  #ifdef _WIN32
+    return dt::malloc<void>(n);
+  #else
+    void* ptr = nullptr;
+    size_t pagesize = 4096;
+    if (n >= HUGEPAGE_SIZE && config::memory_hugepages) {
+      ptr = mmap_hugepage_aligned(n);
+      #ifdef MADV_HUGEPAGE
+        if (madvise(ptr, n, MADV_HUGEPAGE) == 0) {
+          pagesize = HUGEPAGE_SIZE;
+          alloc_stats.hugepage_allocs++;
+          alloc_stats.hugepage_bytes += n;
+        }
+      #endif
+    } else {
+      ptr = mmap_anonymous(n);
+    }
+    alloc_stats.large_allocs++;
+    alloc_stats.large_bytes += n;
+    memory_counters.mapped_bytes.fetch_add(n, std::memory_order_relaxed);
+    memory_counters.mapped_buffers.fetch_add(1, std::memory_order_relaxed);
+    update_peak();
+    if (config::memory_first_touch && config::nthreads > 1 &&
+        !in_parallel_region()) {
+      first_touch(ptr, n, pagesize);
+    }
+    return ptr;
+  #endif
+}
+
+
+void large_free(void* ptr, size_t n) {
+  if (!ptr) return;
+  #ifdef _WIN32
+    (void) n;
+    dt::free(ptr);
+  #else
+    if (munmap(ptr, mapped_size(n)) != 0) {
+      // Called from destructors, so cannot throw an exception here
+      printf("Error unmapping memory buffer of size %zu: [errno %d] %s. "
+             "Resources may have not been freed properly.",
+             n, errno, std::strerror(errno));
+    }
+    memory_counters.mapped_bytes.fetch_sub(n, std::memory_order_relaxed);
+    memory_counters.mapped_buffers.fetch_sub(1, std::memory_order_relaxed);
+  #endif
+}
+
+
 }; // namespace dt
@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------------
 #ifndef dt_UTILS_ALLLOC_h
 #define dt_UTILS_ALLLOC_h
+#include <atomic>
 #include <cstdlib>
 
 namespace dt
@@ -14,6 +15,59 @@ namespace dt
 void free(void*);
 void* _realloc(void*, size_t);
 
+/**
+ * Allocation of large buffers directly via `mmap`, bypassing the malloc heap.
+ * Buffers of at least `HUGEPAGE_SIZE` bytes are aligned to the huge page
+ * boundary and advised for transparent huge pages (unless disabled via
+ * `dt.options.memory.hugepages`). If `dt.options.memory.first_touch` is
+ * on, the pages of the buffer are touched in parallel using static
+ * scheduling, so that on NUMA machines each page is placed on the node of
+ * the thread that will likely process it.
+ *
+ * Memory allocated with `large_alloc()` must be freed with `large_free()`,
+ * passing the same size `n`. There is no "large realloc": `dt::realloc()`
+ * works with the malloc heap only, and never switches to this path even if
+ * the buffer grows past `HUGEPAGE_SIZE`. Buffers that may grow large should
+ * be held in a MemoryRange, whose `resize()` moves the data into a new
+ * `large_alloc()` buffer once the size crosses the threshold.
+ */
+void* large_alloc(size_t n);
+void large_free(void* ptr, size_t n);
+constexpr size_t HUGEPAGE_SIZE = 2 << 20;
+
+struct alloc_stats_t {
+  std::atomic<size_t> large_allocs;
+  std::atomic<size_t> large_bytes;
+  std::atomic<size_t> hugepage_allocs;
+  std::atomic<size_t> hugepage_bytes;
+  std::atomic<size_t> first_touch_bytes;
+};
+extern alloc_stats_t alloc_stats;
+
+
+/**
+ * Memory currently held by the allocator: `heap` counts the blocks obtained
+ * via `dt::malloc()` / `dt::realloc()` (as measured by `malloc_size()`), and
+ * `mapped` the anonymous mappings created by `large_alloc()`. This includes
+ * the temporary buffers (for example in sorting or grouping) that are not
+ * held in a MemoryRange, and thus are not seen by the MemoryBudget.
+ *
+ * `memory_current()` is the sum of the two, and `peak` is the highest value
+ * that this sum has reached since the start of the program, or since the
+ * last call to `memory_reset_peak()` (which returns the previous peak).
+ */
+struct memory_counters_t {
+  std::atomic<size_t> heap_bytes;
+  std::atomic<size_t> heap_buffers;
+  std::atomic<size_t> mapped_bytes;
+  std::atomic<size_t> mapped_buffers;
+  std::atomic<size_t> peak;
+};
+extern memory_counters_t memory_counters;
+
+size_t memory_current();
+size_t memory_reset_peak();
+
 
 
 template <typename T> inline T* malloc(size_t n) {
@@ -16,6 +16,7 @@
 #include "utils/parallel.h"
 #include "options.h"
 #include "utils/exceptions.h"
+#include "utils/thread_pool.h"
 
 namespace dt {
 
@@ -24,7 +25,12 @@ namespace dt {
 // Order-less iteration
 //------------------------------------------------------------------------------
 
-void run_parallel(rangefn run, size_t nrows)
+void run_parallel(rangefn run, size_t nrows) {
+  run_parallel(run, nrows, num_threads_in_pool());
+}
+
+
+void run_parallel(rangefn run, size_t nrows, size_t nthreads)
 {
   // `min_nrows_per_thread`: avoid processing less than this many rows in each
   // thread, reduce the number of threads if necessary.
@@ -42,27 +48,24 @@ void run_parallel(rangefn run, size_t nrows)
   else {
     // If the number of rows is too small, then we want to reduce the number of
     // processing threads.
-    int nth0 = std::min(config::nthreads,
-                        static_cast<int>(nrows / min_nrows_per_thread));
-    xassert(nth0 > 0);
+    size_t nth = std::min(nthreads, nrows / min_nrows_per_thread);
+    xassert(nth > 0);
     OmpExceptionManager oem;
-    #pragma omp parallel num_threads(nth0)
-    {
-      size_t ith = static_cast<size_t>(omp_get_thread_num());
-      size_t nth = static_cast<size_t>(omp_get_num_threads());
-      size_t batchsize = min_nrows_per_batch * nth;
-      try {
-        size_t i = ith;
-        do {
-          size_t iend = std::min(i + batchsize, nrows);
-          run(i, iend, nth);
-          i = iend;
-          // if (ith == 0) progress.report(iend);
-        } while (i < nrows && !oem.stop_requested());
-      } catch (...) {
-        oem.capture_exception();
-      }
-    }
+    parallel_region(nth,
+      [&](size_t ith) {
+        size_t batchsize = min_nrows_per_batch * nth;
+        try {
+          size_t i = ith;
+          do {
+            size_t iend = std::min(i + batchsize, nrows);
+            run(i, iend, nth);
+            i = iend;
+            // if (ith == 0) progress.report(iend);
+          } while (i < nrows && !oem.stop_requested());
+        } catch (...) {
+          oem.capture_exception();
+        }
+      });
     oem.rethrow_exception_if_any();
   }
 }
@@ -103,52 +106,52 @@ void ordered_job::execute()
     // progress.report(nrows);
   }
   else {
-    size_t nth0 = std::min(static_cast<size_t>(config::nthreads),
+    size_t nth0 = std::min(num_threads_in_pool(),
                            nrows / min_nrows_per_thread);
     if (noomp) nth0 = 1;
-    (void)nth0;  // Prevent warning about unused variable
 
+    size_t nchunks = 1 + (nrows - 1)/1000;
+    size_t chunksize = 1 + (nrows - 1)/nchunks;
+    ordered_loop loop(nchunks);
     OmpExceptionManager oem;
-    #pragma omp parallel num_threads(nth0)
-    {
-      // int ith = omp_get_thread_num();
-      size_t nchunks = 1 + (nrows - 1)/1000;
-      size_t chunksize = 1 + (nrows - 1)/nchunks;
-      ojcptr ctx;
-
-      try {
-        ctx = start_thread_context();
-      } catch (...) {
-        oem.capture_exception();
-      }
-
-      #pragma omp for ordered schedule(dynamic)
-      for (size_t j = 0; j < nchunks; ++j) {
-        if (oem.stop_requested()) continue;
-        size_t i0 = j * chunksize;
-        size_t i1 = std::min(i0 + chunksize, nrows);
+    parallel_region(nth0,
+      [&](size_t) {
+        ojcptr ctx;
         try {
-          run(ctx, i0, i1);
-          // if (ith == 0) progress.report(i1);
+          ctx = start_thread_context();
         } catch (...) {
           oem.capture_exception();
         }
-        #pragma omp ordered
-        {
-          try {
-            order(ctx);
-          } catch (...) {
-            oem.capture_exception();
+
+        size_t j;
+        while (loop.next(&j)) {
+          if (!oem.stop_requested()) {
+            size_t i0 = j * chunksize;
+            size_t i1 = std::min(i0 + chunksize, nrows);
+            try {
+              run(ctx, i0, i1);
+              // if (ith == 0) progress.report(i1);
+            } catch (...) {
+              oem.capture_exception();
+            }
+          }
+          loop.wait_turn(j);
+          if (!oem.stop_requested()) {
+            try {
+              order(ctx);
+            } catch (...) {
+              oem.capture_exception();
+            }
           }
+          loop.end_turn(j);
+        }
+
+        try {
+          finish_thread_context(ctx);
+        } catch (...) {
+          oem.capture_exception();
         }
-      }
-
-      try {
-        finish_thread_context(ctx);
-      } catch (...) {
-        oem.capture_exception();
-      }
-    }
+      });
     oem.rethrow_exception_if_any();
   }
 }
@@ -26,6 +26,7 @@
   #define omp_get_num_threads() 1
   #define omp_set_num_threads(n)
   #define omp_get_thread_num() 0
+  #define omp_in_parallel() 0
 #else
   #ifdef __clang__
     #pragma clang diagnostic push
@@ -59,6 +60,17 @@ using rangefn = dt::function<void(size_t, size_t, size_t)>;
  */
 void run_parallel(rangefn run, size_t nrows);
 
+/**
+ * Same as above, but with at most `nthreads` tasks. Each task starts at the
+ * row equal to its index, and all the ranges it receives begin at rows
+ * congruent to that index modulo `step`. Thus `start % step` identifies the
+ * task, and is always less than `nthreads`; this can be used to index
+ * per-task buffers allocated in advance (the size of the thread pool may
+ * change while the function runs, so `this_thread_index()` cannot be used
+ * for this purpose).
+ */
+void run_parallel(rangefn run, size_t nrows, size_t nthreads);
+
 
 
 
@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+#include "utils/profiler.h"
+#include <chrono>       // std::chrono
+#include <mutex>        // std::mutex, std::lock_guard
+
+namespace dt {
+
+// Each thread keeps at most this many events; the rest are dropped (but
+// still counted in "profile.dropped_events").
+static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+
+struct thread_buffer {
+  // Protects the buffer against concurrent `profile_collect()`
+  std::mutex mutex;
+  std::vector<profile_event> events;
+  std::vector<profile_counter> counters;
+  size_t thread;
+  // Whether the buffer is attached to a running thread (protected by the
+  // registry mutex)
+  bool in_use;
+  size_t : 56;
+
+  explicit thread_buffer(size_t i) : thread(i), in_use(true) {}
+};
+
+
+// The buffers are owned by the registry (not by their threads), so that the
+// data survives the threads that recorded it. When a thread exits, its
+// buffer is released and then reused by the next thread that starts
+// recording, so the registry grows only up to the largest number of threads
+// that were recording simultaneously. The registry (and its mutex) is
+// intentionally never destroyed, since worker threads may still be running
+// at exit.
+static std::mutex* registry_mutex = new std::mutex();
+static std::vector<thread_buffer*>* registry = nullptr;
+
+// Detaches the buffer from its thread when the thread exits
+struct buffer_holder {
+  thread_buffer* buf = nullptr;
+  ~buffer_holder() {
+    if (!buf) return;
+    std::lock_guard<std::mutex> lock(*registry_mutex);
+    buf->in_use = false;
+  }
+};
+static thread_local buffer_holder tl_holder;
+
+static const auto epoch = std::chrono::steady_clock::now();
+
+
+static thread_buffer* get_thread_buffer() {
+  if (!tl_holder.buf) {
+    std::lock_guard<std::mutex> lock(*registry_mutex);
+    if (!registry) registry = new std::vector<thread_buffer*>();
+    for (thread_buffer* buf : *registry) {
+      if (!buf->in_use) {
+        buf->in_use = true;
+        tl_holder.buf = buf;
+        return buf;
+      }
+    }
+    tl_holder.buf = new thread_buffer(registry->size());
+    registry->push_back(tl_holder.buf);
+  }
+  return tl_holder.buf;
+}
+
+
+static void add_count(thread_buffer* buf, const char* name, size_t n) {
+  for (auto& cnt : buf->counters) {
+    if (cnt.first == name) {
+      cnt.second += n;
+      return;
+    }
+  }
+  buf->counters.push_back(profile_counter(name, n));
+}
+
+
+
+//------------------------------------------------------------------------------
+// Recording
+//------------------------------------------------------------------------------
+
+int64_t profile_now() {
+  auto delta = std::chrono::steady_clock::now() - epoch;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(delta).count();
+}
+
+
+void profile_record(const char* name, int64_t t0) {
+  int64_t t1 = profile_now();
+  thread_buffer* buf = get_thread_buffer();
+  std::lock_guard<std::mutex> lock(buf->mutex);
+  if (buf->events.size() < MAX_EVENTS_PER_THREAD) {
+    buf->events.push_back(profile_event {name, buf->thread, t0, t1 - t0});
+  } else {
+    add_count(buf, "profile.dropped_events", 1);
+  }
+}
+
+
+void profile_add_count(const char* name, size_t n) {
+  thread_buffer* buf = get_thread_buffer();
+  std::lock_guard<std::mutex> lock(buf->mutex);
+  add_count(buf, name, n);
+}
+
+
+
+//------------------------------------------------------------------------------
+// Retrieving
+//------------------------------------------------------------------------------
+
+void profile_collect(std::vector<profile_event>& events,
+                     std::vector<profile_counter>& counters)
+{
+  std::lock_guard<std::mutex> lock(*registry_mutex);
+  if (!registry) return;
+  for (thread_buffer* buf : *registry) {
+    std::lock_guard<std::mutex> buflock(buf->mutex);
+    events.insert(events.end(), buf->events.begin(), buf->events.end());
+    counters.insert(counters.end(), buf->counters.begin(),
+                    buf->counters.end());
+  }
+}
+
+
+void profile_clear() {
+  std::lock_guard<std::mutex> lock(*registry_mutex);
+  if (!registry) return;
+  for (thread_buffer* buf : *registry) {
+    std::lock_guard<std::mutex> buflock(buf->mutex);
+    buf->events.clear();
+    buf->events.shrink_to_fit();
+    buf->counters.clear();
+  }
+}
+
+
+}  // namespace dt
@@ -0,0 +1,336 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//------------------------------------------------------------------------------
+#include "utils/thread_pool.h"
+#include <algorithm>            // std::min
+#include <condition_variable>   // std::condition_variable
+#include <exception>            // std::exception_ptr
+#include <mutex>                // std::mutex, std::unique_lock
+#include <thread>               // std::thread, std::this_thread
+#include <vector>               // std::vector
+#include <pthread.h>            // pthread_atfork
+#include "utils/parallel.h"     // omp_in_parallel
+#include "options.h"
+
+namespace dt {
+
+// Nesting level of the parallel regions whose tasks the current thread is
+// executing. This is also the priority of the regions that this thread
+// starts.
+static thread_local int tl_depth = 0;
+
+// Index of the current thread, see `this_thread_index()`
+static thread_local size_t tl_thread_index = 0;
+
+
+
+//------------------------------------------------------------------------------
+// region
+//------------------------------------------------------------------------------
+
+struct region {
+  dt::function<void(size_t)> fn;
+  size_t ntasks;
+  std::atomic<size_t> next_task;
+  // The following fields are protected by the pool's mutex
+  size_t nremaining;
+  std::exception_ptr exception;
+  int priority;
+  size_t : 32;
+
+  region(size_t n, dt::function<void(size_t)> f, int prio)
+    : fn(f), ntasks(n), next_task(0), nremaining(n),
+      exception(nullptr), priority(prio) {}
+
+  // Execute task `i`, returning the exception it has thrown (if any).
+  std::exception_ptr run_task(size_t i) {
+    std::exception_ptr res = nullptr;
+    int depth = tl_depth;
+    tl_depth = priority + 1;
+    try {
+      fn(i);
+    } catch (...) {
+      res = std::current_exception();
+    }
+    tl_depth = depth;
+    return res;
+  }
+};
+
+
+
+//------------------------------------------------------------------------------
+// thread_pool
+//------------------------------------------------------------------------------
+
+class thread_pool {
+  private:
+    std::mutex mutex;
+    // Held for the entire duration of `resize()`, including the joining of
+    // the stopped workers: otherwise a concurrent `resize()` could start a
+    // new worker with the same index as a worker that is still stopping,
+    // and the latter would never exit.
+    std::mutex resize_mutex;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    // Regions that have tasks not yet claimed by any thread
+    std::vector<region*> queue;
+    std::vector<std::thread> workers;
+    // Number of workers that should be running (workers with larger index
+    // will exit as soon as they become idle). Protected by `mutex`.
+    size_t nworkers;
+
+    static std::atomic<thread_pool*> instance;
+
+  public:
+    thread_pool();
+    static thread_pool* get();
+    void resize(size_t nthreads);
+    void execute(region& r);
+
+  private:
+    void worker_loop(size_t index);
+    void finish_task(region& r, std::exception_ptr e);
+    void dequeue(region* r);
+    static void after_fork_in_child();
+};
+
+std::atomic<thread_pool*> thread_pool::instance(nullptr);
+
+
+thread_pool::thread_pool() : nworkers(0) {}
+
+
+// Parallel regions may be started concurrently by several threads (that
+// have released the GIL), so the pool is created lock-free: if another
+// thread has installed its pool first, ours is discarded.
+thread_pool* thread_pool::get() {
+  thread_pool* pool = instance.load();
+  if (!pool) {
+    static std::atomic_flag atfork_registered = ATOMIC_FLAG_INIT;
+    if (!atfork_registered.test_and_set()) {
+      pthread_atfork(nullptr, nullptr, after_fork_in_child);
+    }
+    thread_pool* newpool = new thread_pool();
+    if (instance.compare_exchange_strong(pool, newpool)) {
+      pool = newpool;
+    } else {
+      delete newpool;
+    }
+  }
+  return pool;
+}
+
+
+// The worker threads do not survive `fork()`, so the child process must
+// start with a fresh pool. The old pool object is abandoned: its mutexes
+// may have been locked at the moment of the fork.
+void thread_pool::after_fork_in_child() {
+  instance = nullptr;
+}
+
+
+/**
+ * Adjust the number of worker threads so that, together with the thread
+ * starting a region, there are `nthreads` threads.
+ */
+void thread_pool::resize(size_t nthreads) {
+  size_t n = nthreads? nthreads - 1 : 0;
+  std::unique_lock<std::mutex> resize_lock(resize_mutex);
+  std::vector<std::thread> stopped;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (n == workers.size()) return;
+    nworkers = n;
+    while (workers.size() > n) {
+      stopped.push_back(std::move(workers.back()));
+      workers.pop_back();
+    }
+    try {
+      while (workers.size() < n) {
+        size_t index = workers.size();
+        workers.push_back(std::thread(&thread_pool::worker_loop, this, index));
+      }
+    } catch (const std::system_error&) {
+      // Unable to create more threads: make do with what we have
+      nworkers = workers.size();
+    }
+  }
+  work_cv.notify_all();
+  for (auto& th : stopped) th.join();
+}
+
+
+void thread_pool::worker_loop(size_t index) {
+  tl_thread_index = index + 1;
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    work_cv.wait(lock,
+        [&]{ return index >= nworkers || !queue.empty(); });
+    if (index >= nworkers) return;
+
+    // Pick the region with the highest priority
+    region* r = queue[0];
+    for (region* q : queue) {
+      if (q->priority > r->priority) r = q;
+    }
+    size_t i = r->next_task++;
+    if (i + 1 >= r->ntasks) dequeue(r);
+    if (i >= r->ntasks) continue;
+
+    lock.unlock();
+    std::exception_ptr e = r->run_task(i);
+    finish_task(*r, e);
+    lock.lock();
+  }
+}
+
+
+void thread_pool::finish_task(region& r, std::exception_ptr e) {
+  std::unique_lock<std::mutex> lock(mutex);
+  if (e && !r.exception) r.exception = e;
+  if (--r.nremaining == 0) done_cv.notify_all();
+}
+
+
+// Must be called while holding the mutex
+void thread_pool::dequeue(region* r) {
+  auto it = std::find(queue.begin(), queue.end(), r);
+  if (it != queue.end()) queue.erase(it);
+}
+
+
+void thread_pool::execute(region& r) {
+  // Task 0 is reserved for the calling thread
+  r.next_task = 1;
+  if (r.ntasks > 1) {
+    bool queued = false;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      if (nworkers) {
+        queue.push_back(&r);
+        queued = true;
+      }
+    }
+    if (queued) work_cv.notify_all();
+  }
+  size_t i = 0;
+  do {
+    std::exception_ptr e = r.run_task(i);
+    finish_task(r, e);
+    i = r.next_task++;
+  } while (i < r.ntasks);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  dequeue(&r);
+  done_cv.wait(lock, [&]{ return r.nremaining == 0; });
+  if (r.exception) std::rethrow_exception(r.exception);
+}
+
+
+
+//------------------------------------------------------------------------------
+// Public API
+//------------------------------------------------------------------------------
+
+void parallel_region(size_t ntasks, dt::function<void(size_t)> fn) {
+  if (ntasks == 0) return;
+  thread_pool* pool = thread_pool::get();
+  if (tl_depth == 0) {
+    pool->resize(num_threads_in_pool());
+  }
+  region r(ntasks, fn, tl_depth);
+  pool->execute(r);
+}
+
+
+void parallel_for_static(size_t n, size_t nthreads,
+                         dt::function<void(size_t, size_t)> fn)
+{
+  size_t nth = std::min(n, nthreads);
+  if (nth <= 1) {
+    if (n) fn(0, n);
+    return;
+  }
+  parallel_region(nth,
+    [&](size_t ith) {
+      size_t i0 = n * ith / nth;
+      size_t i1 = n * (ith + 1) / nth;
+      fn(i0, i1);
+    });
+}
+
+
+void parallel_for_dynamic(size_t n, size_t nthreads,
+                          dt::function<void(size_t)> fn)
+{
+  size_t nth = std::min(n, nthreads);
+  if (nth <= 1) {
+    for (size_t i = 0; i < n; ++i) fn(i);
+    return;
+  }
+  std::atomic<size_t> next_iter(0);
+  parallel_region(nth,
+    [&](size_t) {
+      for (size_t i = next_iter++; i < n; i = next_iter++) {
+        fn(i);
+      }
+    });
+}
+
+
+size_t num_threads_in_pool() {
+  return static_cast<size_t>(std::max(config::nthreads, 1));
+}
+
+
+size_t this_thread_index() {
+  return tl_thread_index;
+}
+
+
+bool in_parallel_region() {
+  return tl_depth > 0 || omp_in_parallel();
+}
+
+
+
+//------------------------------------------------------------------------------
+// ordered_loop
+//------------------------------------------------------------------------------
+
+ordered_loop::ordered_loop(size_t n_)
+  : n(n_), next_iter(0), next_ordered(0) {}
+
+bool ordered_loop::next(size_t* i) {
+  *i = next_iter++;
+  return *i < n;
+}
+
+void ordered_loop::wait_turn(size_t i) const {
+  // The preceding iteration has already been claimed by a running task,
+  // so this wait is short.
+  while (next_ordered.load(std::memory_order_acquire) != i) {
+    std::this_thread::yield();
+  }
+}
+
+void ordered_loop::end_turn(size_t i) {
+  next_ordered.store(i + 1, std::memory_order_release);
+}
+
+
+
+}  // namespace dt
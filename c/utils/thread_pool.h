@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+// Copyright 2018 H2O.ai
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//------------------------------------------------------------------------------
+#ifndef dt_UTILS_THREAD_POOL_h
+#define dt_UTILS_THREAD_POOL_h
+#include <atomic>         // std::atomic
+#include <cstddef>        // size_t
+#include "utils/function.h"
+
+namespace dt {
+
+
+//------------------------------------------------------------------------------
+// Thread pool
+//------------------------------------------------------------------------------
+//
+// All parallel work in datatable is executed by a single persistent pool of
+// worker threads, whose size is controlled by `dt.options.nthreads`. The
+// threads are created lazily, on first use, and then wait for work.
+//
+// The unit of work is a "parallel region": `ntasks` tasks which execute the
+// same function `fn(i)`, for `i` in `[0; ntasks)`. The thread that starts a
+// region always executes task 0 itself (so that task 0 may safely call into
+// python), and then helps executing the remaining tasks of its region, while
+// the idle workers of the pool pick up the rest. Thus, a region never waits
+// for a thread to become available, and the tasks must not assume that they
+// run concurrently (for example, they must not wait for each other via a
+// barrier).
+//
+// Regions may be nested: a task may start its own region, which is then
+// executed by the same pool without creating any extra threads. A nested
+// region has a higher priority than its parent, so that idle workers first
+// help finishing the inner work that some other task is waiting for. Regions
+// may also be started concurrently from different (python) threads.
+//
+// If any task throws an exception, the remaining tasks are still executed,
+// and then the first exception is rethrown in the thread that started the
+// region.
+//
+
+/**
+ * Execute `fn(i)` for each `i` in `[0; ntasks)`, in parallel.
+ */
+void parallel_region(size_t ntasks, dt::function<void(size_t)> fn);
+
+
+/**
+ * Split the range `[0; n)` into (at most) `nthreads` contiguous chunks of
+ * approximately equal size, and execute `fn(i0, i1)` for each chunk, in
+ * parallel. This is the analog of `#pragma omp for schedule(static)`.
+ */
+void parallel_for_static(size_t n, size_t nthreads,
+                         dt::function<void(size_t, size_t)> fn);
+
+
+/**
+ * Execute `fn(i)` for each `i` in `[0; n)`, where the iterations are handed
+ * out dynamically to `nthreads` tasks. This is the analog of
+ * `#pragma omp for schedule(dynamic)`.
+ */
+void parallel_for_dynamic(size_t n, size_t nthreads,
+                          dt::function<void(size_t)> fn);
+
+
+/**
+ * Number of threads in the pool (including the thread that starts a
+ * region), i.e. the maximum useful number of tasks in a parallel region.
+ */
+size_t num_threads_in_pool();
+
+
+/**
+ * Index of the current thread within the pool: 0 for any thread that is not
+ * the pool's worker (such as the python's main thread, which starts parallel
+ * regions), and `1 .. N-1` for the worker threads. Only a thread with index 0
+ * may call into python.
+ */
+size_t this_thread_index();
+
+
+/**
+ * Return true if the current thread is executing a task of a parallel region
+ * (or is within an OpenMP parallel region).
+ */
+bool in_parallel_region();
+
+
+/**
+ * Helper for a loop over `[0; n)` whose iterations are claimed dynamically by
+ * the tasks of a parallel region, and where a part of each iteration must be
+ * executed in the order of iterations. This is the analog of
+ * `#pragma omp for ordered schedule(dynamic)`. Each task should run:
+ *
+ *     size_t i;
+ *     while (loop.next(&i)) {
+ *       ... parallel part ...
+ *       loop.wait_turn(i);
+ *       ... ordered part ...
+ *       loop.end_turn(i);
+ *     }
+ *
+ * Each claimed iteration must eventually call `wait_turn()` + `end_turn()`,
+ * even if its parallel part has failed.
+ */
+class ordered_loop {
+  private:
+    const size_t n;
+    std::atomic<size_t> next_iter;
+    std::atomic<size_t> next_ordered;
+
+  public:
+    explicit ordered_loop(size_t n_);
+    bool next(size_t* i);
+    void wait_turn(size_t i) const;
+    void end_turn(size_t i);
+};
+
+
+
+}  // namespace dt
+#endif
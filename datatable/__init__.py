@@ -23,7 +23,9 @@
 from .__version__ import version as __version__
 from .frame import Frame
 from .expr import (mean, min, max, sd, isna, sum, count, first, abs, exp,
-                   log, log10, f, g, median)
+                   log, log10, f, g, median, last, nunique, prod, var, skew,
+                   kurt, any, all, cumsum, cumcount, shift, rank, rolling_mean,
+                   rolling_sum)
 from .fread import fread, GenericReader, FreadWarning, _DefaultLogger
 from .lib._datatable import (
     unique, union, intersect, setdiff, symdiff,
@@ -36,6 +38,7 @@ from .types import stype, ltype
 from .utils.typechecks import TTypeError as TypeError
 from .utils.typechecks import TValueError as ValueError
 from .utils.typechecks import DatatableWarning
+import datatable.profiler
 import datatable.widget
 try:
     from .__git__ import __git_revision__
@@ -51,7 +54,9 @@ __all__ = (
     "mean",
     "median",
     "min",
-    "open", "sd", "sum", "count", "first",
+    "open", "sd", "sum", "count", "first", "last", "nunique", "prod",
+    "var", "skew", "kurt", "any", "all",
+    "cumsum", "cumcount", "shift", "rank", "rolling_mean", "rolling_sum",
     "isna", "fread", "GenericReader", "stype", "ltype", "f", "g",
     "join", "by", "abs", "exp", "log", "log10",
     "TypeError", "ValueError", "DatatableWarning", "FreadWarning",
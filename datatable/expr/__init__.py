@@ -29,27 +29,43 @@ from .column_expr import ColSelectorExpr, NewColumnExpr
 from .dtproxy import f, g
 from .exp_expr import exp, log, log10
 from .literal_expr import LiteralExpr
-from .reduce_expr import (ReduceExpr, sum, count, first, mean, median, min,
-    max, sd)
+from .reduce_expr import (ReduceExpr, sum, count, first, last, mean, median,
+    min, max, sd, nunique, any, all, prod, var, skew, kurt)
 from .relop_expr import RelationalOpExpr
 from .string_expr import StringExpr
 from .unary_expr import UnaryOpExpr, isna
+from .window_expr import (WindowExpr, cumsum, cumcount, shift, rank,
+    rolling_mean, rolling_sum)
 
 __all__ = (
     "abs",
+    "all",
+    "any",
     "count",
+    "cumcount",
+    "cumsum",
     "exp",
     "f",
     "first",
     "isna",
+    "kurt",
+    "last",
     "log",
     "log10",
     "max",
     "mean",
     "median",
     "min",
+    "nunique",
+    "prod",
+    "rank",
+    "rolling_mean",
+    "rolling_sum",
     "sd",
+    "shift",
+    "skew",
     "sum",
+    "var",
     "BinaryOpExpr",
     "CastExpr",
     "ColSelectorExpr",
@@ -59,4 +75,5 @@ __all__ = (
     "ReduceExpr",
     "RelationalOpExpr",
     "UnaryOpExpr",
+    "WindowExpr",
 )
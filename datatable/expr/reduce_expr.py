@@ -27,6 +27,8 @@ from datatable.lib import core
 _builtin_sum = sum
 _builtin_min = min
 _builtin_max = max
+_builtin_any = any
+_builtin_all = all
 
 # See "c/expr/base_expr.h"
 BASEEXPR_OPCODE_UNARY_REDUCE = 6
@@ -55,6 +57,16 @@ def first(iterable):
             return x
 
 
+def last(iterable):
+    if isinstance(iterable, BaseExpr):
+        return ReduceExpr("last", iterable)
+    else:
+        res = None
+        for x in iterable:
+            res = x
+        return res
+
+
 def mean(expr):
     return ReduceExpr("mean", expr)
 
@@ -67,6 +79,42 @@ def median(expr):
     return ReduceExpr("median", expr)
 
 
+def nunique(expr):
+    return ReduceExpr("nunique", expr)
+
+
+def prod(expr):
+    return ReduceExpr("prod", expr)
+
+
+def var(expr):
+    return ReduceExpr("var", expr)
+
+
+def skew(expr):
+    return ReduceExpr("skew", expr)
+
+
+def kurt(expr):
+    return ReduceExpr("kurt", expr)
+
+
+# noinspection PyShadowingBuiltins
+def any(iterable):
+    if isinstance(iterable, BaseExpr):
+        return ReduceExpr("any", iterable)
+    else:
+        return _builtin_any(iterable)
+
+
+# noinspection PyShadowingBuiltins
+def all(iterable):
+    if isinstance(iterable, BaseExpr):
+        return ReduceExpr("all", iterable)
+    else:
+        return _builtin_all(iterable)
+
+
 # noinspection PyShadowingBuiltins
 def sum(iterable, start=0):
     if isinstance(iterable, BaseExpr):
@@ -98,6 +146,8 @@ def max(*args, **kwds):
 sum.__doc__ = _builtin_sum.__doc__
 min.__doc__ = _builtin_min.__doc__
 max.__doc__ = _builtin_max.__doc__
+any.__doc__ = _builtin_any.__doc__
+all.__doc__ = _builtin_all.__doc__
 
 
 
@@ -140,4 +190,12 @@ reduce_opcodes = {
     "sum": 6,
     "count": 7,
     "median": 8,
+    "nunique": 9,
+    "last": 10,
+    "any": 11,
+    "all": 12,
+    "prod": 13,
+    "var": 14,
+    "skew": 15,
+    "kurt": 16,
 }
@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+#-------------------------------------------------------------------------------
+# Copyright 2019 H2O.ai
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+from .base_expr import BaseExpr
+from datatable.lib import core
+
+# See "c/expr/base_expr.h"
+BASEEXPR_OPCODE_WINDOW = 9
+
+
+
+#-------------------------------------------------------------------------------
+# Exported functions
+#-------------------------------------------------------------------------------
+
+def cumsum(expr):
+    """Running sum of `expr` within each group."""
+    return WindowExpr("cumsum", expr)
+
+
+def cumcount():
+    """0-based index of each row within its group."""
+    return WindowExpr("cumcount", None)
+
+
+def shift(expr, n=1):
+    """
+    Value of `expr` from `n` rows before (or `-n` rows after, if `n` is
+    negative) within the same group; NA if such row does not exist.
+    """
+    return WindowExpr("shift", expr, n)
+
+
+def rank(expr):
+    """1-based rank of each value within its group (ties get the same rank)."""
+    return WindowExpr("rank", expr)
+
+
+def rolling_mean(expr, window):
+    """Mean of `expr` over the trailing `window` rows within each group."""
+    return WindowExpr("rolling_mean", expr, window)
+
+
+def rolling_sum(expr, window):
+    """Sum of `expr` over the trailing `window` rows within each group."""
+    return WindowExpr("rolling_sum", expr, window)
+
+
+
+
+class WindowExpr(BaseExpr):
+    __slots__ = ["_op", "_expr", "_params"]
+
+    def __init__(self, op, expr, *args):
+        super().__init__()
+        self._op = op
+        self._expr = expr
+        self._params = args
+
+    def __str__(self):
+        if self._expr is None:
+            return "%s()" % self._op
+        return "%s(%s%s)" % (self._op, self._expr,
+                             "".join(", %r" % p for p in self._params))
+
+    def _core(self):
+        return core.base_expr(BASEEXPR_OPCODE_WINDOW,
+                              window_opcodes[self._op],
+                              None if self._expr is None else self._expr._core(),
+                              self._params)
+
+
+# Synchronize with c/expr/base_expr.h
+window_opcodes = {
+    "cumsum": 1,
+    "cumcount": 2,
+    "shift": 3,
+    "rank": 4,
+    "rolling_mean": 5,
+    "rolling_sum": 6,
+}
@@ -44,6 +44,27 @@ class Frame(core.Frame):
     This is a primary data structure for datatable module.
     """
 
+    #---------------------------------------------------------------------------
+    # Iteration
+    #---------------------------------------------------------------------------
+
+    def iter_tuples(self, batch_size=65536):
+        """
+        Iterate over the rows of the Frame, as tuples.
+
+        This is equivalent to ``iter(self.to_tuples())``, except that the rows
+        are converted into python objects in batches of `batch_size` rows
+        each, and so the complete list of tuples is never materialized.
+        """
+        if not isinstance(batch_size, int) or batch_size <= 0:
+            raise ValueError("Parameter `batch_size` should be a positive "
+                             "integer, instead got %r" % (batch_size, ))
+        nrows = self.nrows
+        for i0 in range(0, nrows, batch_size):
+            i1 = min(i0 + batch_size, nrows)
+            yield from self[i0:i1, :].to_tuples()
+
+
     #---------------------------------------------------------------------------
     # Deprecated
     #---------------------------------------------------------------------------
@@ -25,8 +25,11 @@ from .lib._datatable import (
     frame_column_data_r,
     frame_column_rowindex,
     frame_integrity_check,
+    get_alloc_stats,
     has_omp_support,
     in_debug_mode,
+    memory_stats,
+    reset_memory_peak,
     RowIndex
 )
 
@@ -34,7 +37,10 @@ __all__ = [
     "frame_column_data_r",
     "frame_column_rowindex",
     "frame_integrity_check",
+    "get_alloc_stats",
     "has_omp_support",
     "in_debug_mode",
+    "memory_stats",
+    "reset_memory_peak",
     "RowIndex",
 ]
@@ -20,6 +20,15 @@
 # FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 # IN THE SOFTWARE.
 #-------------------------------------------------------------------------------
-from datatable.lib._datatable import aggregate, Ftrl, kfold
+from datatable.lib._datatable import (
+    aggregate,
+    Ftrl,
+    kfold,
+    kfold_grouped,
+    kfold_random,
+    kfold_stratified,
+    sample_rows,
+)
 
-__all__ = ("aggregate", "Ftrl", "kfold")
+__all__ = ("aggregate", "Ftrl", "kfold", "kfold_grouped", "kfold_random",
+           "kfold_stratified", "sample_rows")
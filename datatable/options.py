@@ -248,3 +248,48 @@ options.register_option(
         "fewer threads than the maximum.\n\n"
         "Note that requesting **too many** threads may exhaust your system\n"
         "resources and cause the Python process to crash.\n")
+
+
+options.register_option(
+    "memory.limit", int, default=0,
+    doc="The maximum amount of memory (in bytes) that datatable may use for\n"
+        "storing the data of its columns.\n\n"
+        "When the limit is exceeded, datatable will write the contents of\n"
+        "the least recently used large buffers into temporary files on\n"
+        "disk (see option `memory.spill_dir`), and then memory-map those\n"
+        "files. If spilling does not free enough memory, a `MemoryError`\n"
+        "will be raised.\n\n"
+        "The default value of 0 means no limit.\n")
+
+options.register_option(
+    "memory.spill_dir", str, default="",
+    doc="The directory where temporary files for the spilled buffers are\n"
+        "created (see option `memory.limit`). If empty, the environment\n"
+        "variable `TMPDIR` is used, or `/tmp` if that variable is not set.\n"
+        "The files are deleted immediately after creation, and therefore\n"
+        "are not visible in the file system.\n")
+
+options.register_option(
+    "memory.hugepages", bool, default=True,
+    doc="If True, large column buffers (2MB or more) will be aligned at the\n"
+        "huge page boundary and advised to the kernel to be backed by\n"
+        "transparent huge pages. This reduces TLB misses when working\n"
+        "with big columns, for example when sorting.\n")
+
+options.register_option(
+    "memory.first_touch", bool, default=False,
+    doc="If True, the pages of each newly allocated large column buffer\n"
+        "will be touched in parallel by all threads (using static\n"
+        "scheduling), before the buffer is filled with data. On NUMA\n"
+        "machines this places the memory closer to the threads that\n"
+        "will process it later, at the cost of a small overhead during\n"
+        "the allocation.\n")
+
+options.register_option(
+    "profile", bool, default=False,
+    doc="If True, datatable will record the time spent in the various\n"
+        "stages of its native operations (sorting, joins, groupby, fread,\n"
+        "writing csv/jay files, etc), together with some counters such\n"
+        "as the number of rows processed. The collected data can be\n"
+        "examined with `datatable.profiler.report()`, or saved as a\n"
+        "Chrome trace file via `datatable.profiler.save_trace()`.\n")
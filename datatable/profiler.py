@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+# © H2O.ai 2018; -*- encoding: utf-8 -*-
+#   This Source Code Form is subject to the terms of the Mozilla Public
+#   License, v. 2.0. If a copy of the MPL was not distributed with this
+#   file, You can obtain one at http://mozilla.org/MPL/2.0/.
+#-------------------------------------------------------------------------------
+"""
+Access to the data collected by datatable's native profiler.
+
+Profiling is turned on with `dt.options.profile = True`. After that, the
+time spent in the various stages of sorting, joins, groupby, fread, writing
+csv / jay files, etc, is recorded, together with some counters (such as the
+number of rows processed). Example::
+
+    dt.options.profile = True
+    DT = dt.fread("data.csv")
+    DT.sort("A")
+    print(dt.profiler.report())
+    dt.profiler.save_trace("trace.json")  # open in chrome://tracing
+"""
+import json
+import datatable as dt
+from datatable.lib import core
+
+__all__ = ("clear", "counters", "report", "save_trace")
+
+
+
+def report():
+    """
+    Return a Frame with the summary of all timed operations recorded so far:
+    for each operation it contains the number of calls, the total time spent
+    (in seconds), and the maximum duration of a single call.
+    """
+    events, _ = core.get_profile_data()
+    stats = {}
+    for name, _, _, duration in events:
+        st = stats.get(name)
+        if st is None:
+            stats[name] = [1, duration, duration]
+        else:
+            st[0] += 1
+            st[1] += duration
+            if duration > st[2]:
+                st[2] = duration
+    names = sorted(stats)
+    return dt.Frame([names,
+                     [stats[k][0] for k in names],
+                     [stats[k][1] * 1e-6 for k in names],
+                     [stats[k][2] * 1e-6 for k in names]],
+                    names=["operation", "count", "total_time", "max_time"],
+                    stypes=[dt.stype.str32, dt.stype.int64,
+                            dt.stype.float64, dt.stype.float64])
+
+
+def counters():
+    """
+    Return a dictionary with the total values of all counters recorded so
+    far, for example `{"sort.rows": 1000000, ...}`.
+    """
+    return core.get_profile_data()[1]
+
+
+def save_trace(filename):
+    """
+    Save all recorded events into `filename` in the Chrome Trace Event
+    format. This file can be viewed in `chrome://tracing` or in Perfetto.
+    """
+    events, cnts = core.get_profile_data()
+    trace = [{"name": name, "ph": "X", "pid": 0, "tid": tid,
+              "ts": start, "dur": duration}
+             for name, tid, start, duration in events]
+    with open(filename, "w", encoding="utf-8") as out:
+        json.dump({"traceEvents": trace, "otherData": cnts}, out)
+
+
+def clear():
+    """
+    Discard all data collected by the profiler so far.
+    """
+    core.clear_profile_data()
@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+#include <memory>      // std::unique_ptr
+#include "expr/base_expr.h"
+#include "expr/py_expr.h"
+#include "expr/workframe.h"
+#include "python/int.h"
+#include "benchmark.h"
+#include "rowindex.h"
+#include "utils/array.h"
+
+namespace bench {
+
+
+
+//------------------------------------------------------------------------------
+// Join
+//------------------------------------------------------------------------------
+
+// Join a frame of `n` rows with a keyed frame of `n/10` rows. About 20% of
+// the rows in the left frame have no match.
+static void bench_join_stype(Runner& runner, SType stype) {
+  std::string name = std::string("join/") + info(stype).name();
+  if (!runner.enabled(name)) return;
+  size_t n = runner.nrows();
+  size_t nkeys = n / 10 + 1;
+  Random rng(runner.seed());
+
+  // Unique keys in random order, and a payload column
+  std::vector<size_t> perm(nkeys);
+  for (size_t i = 0; i < nkeys; ++i) perm[i] = i;
+  for (size_t i = nkeys - 1; i > 0; --i) {
+    std::swap(perm[i], perm[rng.uniform(i + 1)]);
+  }
+  Column* jkey;
+  Column* xkey;
+  if (stype == SType::STR32) {
+    std::vector<std::string> jvalues(nkeys), xvalues(n);
+    for (size_t i = 0; i < nkeys; ++i) {
+      jvalues[i] = "key" + std::to_string(perm[i]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      xvalues[i] = "key" + std::to_string(rng.uniform(nkeys * 5 / 4));
+    }
+    jkey = string_column(jvalues);
+    xkey = string_column(xvalues);
+  } else {
+    jkey = Column::new_data_column(stype, nkeys);
+    auto jdata = static_cast<int32_t*>(jkey->data_w());
+    for (size_t i = 0; i < nkeys; ++i) {
+      jdata[i] = static_cast<int32_t>(perm[i]);
+    }
+    xkey = random_int_column(stype, n, rng, nkeys * 5 / 4);
+  }
+  std::unique_ptr<DataTable> jdt(make_frame({
+      jkey, random_real_column(SType::FLOAT64, nkeys, rng)}));
+  std::unique_ptr<DataTable> xdt(make_frame({xkey}));
+  std::vector<size_t> keys = {0};
+  jdt->set_key(keys);
+
+  runner.measure(name, n, [&]{ natural_join(xdt.get(), jdt.get()); });
+}
+
+
+void bench_join(Runner& runner) {
+  bench_join_stype(runner, SType::INT32);
+  bench_join_stype(runner, SType::STR32);
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Reducers
+//------------------------------------------------------------------------------
+
+// Ungrouped reductions `DT[:, op(f.C0)]`, evaluated directly via the
+// `expr_reduce` node.
+void bench_reduce(Runner& runner) {
+  static SType stypes[] = {SType::INT32, SType::INT64, SType::FLOAT64};
+  static expr::ReduceOp ops[] = {
+    expr::ReduceOp::SUM, expr::ReduceOp::MEAN, expr::ReduceOp::MIN,
+    expr::ReduceOp::MAX, expr::ReduceOp::STDEV, expr::ReduceOp::COUNT,
+    expr::ReduceOp::MEDIAN
+  };
+  size_t n = runner.nrows();
+  for (SType stype : stypes) {
+    std::unique_ptr<DataTable> dt;
+    for (expr::ReduceOp op : ops) {
+      size_t iop = static_cast<size_t>(op);
+      std::string name = std::string("reduce/") + expr::reducer_names[iop] +
+                         "/" + info(stype).name();
+      if (!runner.enabled(name)) continue;
+      if (!dt) {
+        Random rng(runner.seed());
+        dt.reset(make_frame({random_column(stype, n, rng)}));
+      }
+      dt::workframe wf(dt.get());
+      expr::expr_reduce reduce(
+          dt::pexpr(new dt::expr_column(0, py::oint(0))), iop);
+      reduce.resolve(wf);
+      runner.measure(name, n, [&]{ reduce.evaluate_eager(wf); });
+    }
+  }
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Binary operators
+//------------------------------------------------------------------------------
+
+struct binop_case {
+  size_t opcode;
+  const char* opname;
+  SType lhs;
+  SType rhs;
+};
+
+void bench_binaryop(Runner& runner) {
+  // See enum OpCode in "expr/binaryop.cc"
+  static binop_case cases[] = {
+    {1,  "+",  SType::INT32,   SType::INT32},
+    {1,  "+",  SType::INT64,   SType::INT64},
+    {1,  "+",  SType::FLOAT64, SType::FLOAT64},
+    {1,  "+",  SType::INT32,   SType::FLOAT64},
+    {3,  "*",  SType::FLOAT64, SType::FLOAT64},
+    {4,  "/",  SType::INT32,   SType::INT32},
+    {4,  "/",  SType::FLOAT64, SType::FLOAT64},
+    {5,  "//", SType::INT64,   SType::INT64},
+    {12, "==", SType::INT32,   SType::INT32},
+    {12, "==", SType::STR32,   SType::STR32},
+    {15, "<",  SType::FLOAT64, SType::FLOAT64},
+  };
+  size_t n = runner.nrows();
+  for (const binop_case& bc : cases) {
+    std::string name = std::string("binaryop/") + info(bc.lhs).name() +
+                       bc.opname + info(bc.rhs).name();
+    if (!runner.enabled(name)) continue;
+    Random rng(runner.seed());
+    std::unique_ptr<Column> lhs(random_column(bc.lhs, n, rng));
+    std::unique_ptr<Column> rhs(random_column(bc.rhs, n, rng));
+    runner.measure(name, n, [&]{
+      delete expr::binaryop(bc.opcode, lhs.get(), rhs.get());
+    });
+  }
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// RowIndex
+//------------------------------------------------------------------------------
+
+static RowIndex random_array_rowindex(size_t n, size_t nmax, Random& rng) {
+  arr32_t arr(n);
+  for (size_t i = 0; i < n; ++i) {
+    arr[i] = static_cast<int32_t>(rng.uniform(nmax));
+  }
+  return RowIndex(std::move(arr), /* sorted = */ false);
+}
+
+
+// Composition `ab * bc` of two rowindices of various kinds, where `ab` has
+// `n` elements.
+void bench_rowindex(Runner& runner) {
+  size_t n = runner.nrows();
+  Random rng(runner.seed());
+  RowIndex arr_n = random_array_rowindex(n, n, rng);
+  RowIndex arr_2n = random_array_rowindex(n, 2 * n, rng);
+  RowIndex slice_n(size_t(0), n, size_t(1));
+  // every other row of a frame with 2n rows
+  RowIndex slice_2n(size_t(1), n, size_t(2));
+
+  runner.measure("rowindex/array*array", n,
+                 [&]{ RowIndex res = arr_n * arr_2n; });
+  runner.measure("rowindex/array*slice", n,
+                 [&]{ RowIndex res = arr_n * slice_2n; });
+  runner.measure("rowindex/slice*array", n,
+                 [&]{ RowIndex res = slice_n * arr_n; });
+  runner.measure("rowindex/slice*slice", n,
+                 [&]{ RowIndex res = slice_n * slice_2n; });
+}
+
+
+
+}  // namespace bench
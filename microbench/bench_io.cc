@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+#include <cstdio>      // std::snprintf
+#include <memory>      // std::unique_ptr
+#include "csv/reader_parsers.h"
+#include "csv/writer.h"
+#include "read/fread/fread_tokenizer.h"
+#include "read/field64.h"
+#include "benchmark.h"
+#include "options.h"
+#include "utils/array.h"
+#include "writebuf.h"
+
+namespace bench {
+
+
+
+//------------------------------------------------------------------------------
+// fread parsers
+//------------------------------------------------------------------------------
+
+struct parser_case {
+  PT ptype;
+  SType stype;   // type of the values from which the input text is generated
+  size_t : 48;
+};
+
+
+// Render `n` random values of the given stype as a single line of text,
+// with the values separated by commas.
+static std::string make_csv_line(SType stype, size_t n, Random& rng) {
+  std::unique_ptr<Column> col(random_column(stype, n, rng));
+  std::string out;
+  char buf[32];
+  for (size_t i = 0; i < n; ++i) {
+    if (i) out += ',';
+    switch (stype) {
+      case SType::BOOL:
+        out += static_cast<const int8_t*>(col->data())[i]? "true" : "false";
+        break;
+      case SType::INT32:
+        out += std::to_string(static_cast<const int32_t*>(col->data())[i]);
+        break;
+      case SType::INT64:
+        out += std::to_string(static_cast<const int64_t*>(col->data())[i]);
+        break;
+      case SType::FLOAT64:
+        std::snprintf(buf, sizeof(buf), "%.15g",
+                      static_cast<const double*>(col->data())[i]);
+        out += buf;
+        break;
+      case SType::STR32: {
+        auto scol = static_cast<const StringColumn<uint32_t>*>(col.get());
+        auto offsets = static_cast<const uint32_t*>(scol->data());
+        auto chars = scol->strdata();
+        out.append(chars + offsets[i], offsets[i + 1] - offsets[i]);
+        break;
+      }
+      default: break;
+    }
+  }
+  out += '\n';
+  return out;
+}
+
+
+void bench_fread(Runner& runner) {
+  static parser_case cases[] = {
+    {PT::BoolL,        SType::BOOL},
+    {PT::Int32,        SType::INT32},
+    {PT::Int64,        SType::INT64},
+    {PT::Float64Plain, SType::FLOAT64},
+    {PT::Float64Ext,   SType::FLOAT64},
+    {PT::Str32,        SType::STR32},
+  };
+  static const char* const nastrings[] = {"NA", nullptr};
+  ParserLibrary plib;
+  const ParserInfo* parsers = ParserLibrary::get_parser_infos();
+  size_t n = runner.nrows();
+  for (const parser_case& pc : cases) {
+    const ParserInfo& pi = parsers[pc.ptype];
+    std::string name = "fread/" + pi.name;
+    if (!runner.enabled(name)) continue;
+    Random rng(runner.seed());
+    std::string text = make_csv_line(pc.stype, n, rng);
+    dt::array<dt::read::field64> out(n);
+
+    dt::read::FreadTokenizer ctx;
+    ctx.anchor = text.data();
+    ctx.eof = text.data() + text.size();
+    ctx.NAstrings = nastrings;
+    ctx.whiteChar = 0;
+    ctx.dec = '.';
+    ctx.sep = ',';
+    ctx.quote = '"';
+    ctx.quoteRule = 0;
+    ctx.strip_whitespace = true;
+    ctx.blank_is_na = false;
+    ctx.cr_is_newline = false;
+    runner.measure(name, n, [&]{
+      ctx.ch = text.data();
+      ctx.target = out.data();
+      for (size_t i = 0; i < n; ++i) {
+        pi.fn(ctx);
+        ctx.ch++;  // skip the separator
+        ctx.target++;
+      }
+    });
+  }
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// CSV writer
+//------------------------------------------------------------------------------
+
+// Write a single-column frame into a memory buffer, for each stype
+void bench_writecsv(Runner& runner) {
+  static SType stypes[] = {SType::BOOL, SType::INT8, SType::INT32,
+                           SType::INT64, SType::FLOAT32, SType::FLOAT64,
+                           SType::STR32};
+  size_t n = runner.nrows();
+  for (SType stype : stypes) {
+    std::string name = std::string("writecsv/") + info(stype).name();
+    if (!runner.enabled(name)) continue;
+    Random rng(runner.seed());
+    std::unique_ptr<DataTable> dt(make_frame({random_column(stype, n, rng)}));
+    runner.measure(name, n, [&]{
+      CsvWriter writer(dt.get(), "");
+      writer.set_nthreads(static_cast<size_t>(config::nthreads));
+      writer.set_strategy(WritableBuffer::Strategy::Auto);
+      writer.write();
+      delete writer.get_output_buffer();
+    });
+  }
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Jay
+//------------------------------------------------------------------------------
+
+void bench_jay(Runner& runner) {
+  if (!runner.enabled("jay/save") && !runner.enabled("jay/open")) return;
+  size_t n = runner.nrows();
+  Random rng(runner.seed());
+  std::unique_ptr<DataTable> dt(make_frame({
+      random_column(SType::BOOL, n, rng),
+      random_column(SType::INT32, n, rng),
+      random_column(SType::INT64, n, rng),
+      random_column(SType::FLOAT64, n, rng),
+      random_column(SType::STR32, n, rng)}));
+
+  runner.measure("jay/save", n, [&]{ dt->save_jay(); });
+
+  MemoryRange saved = dt->save_jay();
+  runner.measure("jay/open", n, [&]{ delete open_jay_from_mbuf(saved); });
+}
+
+
+
+}  // namespace bench
@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+#include <memory>      // std::unique_ptr
+#include "benchmark.h"
+#include "options.h"
+#include "rowindex.h"
+#include "sort.h"
+#include "utils/array.h"
+
+namespace bench {
+
+
+// Radix sort of a single column, for each stype
+static void bench_sort_stypes(Runner& runner) {
+  static SType stypes[] = {SType::BOOL, SType::INT8, SType::INT16,
+                           SType::INT32, SType::INT64, SType::FLOAT32,
+                           SType::FLOAT64, SType::STR32};
+  size_t n = runner.nrows();
+  for (SType stype : stypes) {
+    std::string name = std::string("sort/") + info(stype).name();
+    if (!runner.enabled(name)) continue;
+    Random rng(runner.seed());
+    std::unique_ptr<Column> col(random_column(stype, n, rng));
+    runner.measure(name, n, [&]{ col->sort(nullptr); });
+  }
+}
+
+
+// Sorting small arrays with the insertion sort: this is what the radix sort
+// falls back to for the subarrays smaller than the
+// `sort_insert_method_threshold`.
+static void bench_insert_sort(Runner& runner) {
+  static int sizes[] = {4, 8, 16, 32, 64, 128, 256};
+  size_t n = runner.nrows();
+  for (int k : sizes) {
+    std::string name = "sort/insert/n=" + std::to_string(k);
+    if (!runner.enabled(name)) continue;
+    size_t narrays = n / static_cast<size_t>(k);
+    Random rng(runner.seed());
+    dt::array<uint32_t> x(narrays * static_cast<size_t>(k));
+    dt::array<int32_t> o(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+      x[i] = static_cast<uint32_t>(rng.next());
+    }
+    runner.measure(name, x.size(), [&]{
+      GroupGatherer gg;
+      for (size_t j = 0; j < narrays; ++j) {
+        size_t offset = j * static_cast<size_t>(k);
+        insert_sort_values(x.data() + offset, o.data() + offset, k, gg);
+      }
+    });
+  }
+}
+
+
+// Full sort of an INT32 column for different values of the insertion-sort
+// threshold (`dt.options.sort.insert_method_threshold`)
+static void bench_sort_thresholds(Runner& runner) {
+  static size_t thresholds[] = {4, 16, 64, 256, 1024};
+  size_t n = runner.nrows();
+  size_t saved = config::sort_insert_method_threshold;
+  for (size_t t : thresholds) {
+    std::string name = "sort/threshold=" + std::to_string(t);
+    if (!runner.enabled(name)) continue;
+    Random rng(runner.seed());
+    std::unique_ptr<Column> col(random_int_column(SType::INT32, n, rng));
+    config::sort_insert_method_threshold = t;
+    runner.measure(name, n, [&]{ col->sort(nullptr); });
+  }
+  config::sort_insert_method_threshold = saved;
+}
+
+
+void bench_sort(Runner& runner) {
+  bench_sort_stypes(runner);
+  bench_insert_sort(runner);
+  bench_sort_thresholds(runner);
+}
+
+
+
+}  // namespace bench
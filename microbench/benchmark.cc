@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+#include "benchmark.h"
+#include <algorithm>   // std::sort
+#include <chrono>      // std::chrono
+#include <cstdio>      // std::fprintf
+#include <cstring>     // std::memcpy
+#include "memrange.h"
+#include "options.h"
+#include "utils/exceptions.h"
+
+namespace bench {
+
+
+
+//------------------------------------------------------------------------------
+// Random
+//------------------------------------------------------------------------------
+
+Random::Random(uint64_t seed) : state(seed) {}
+
+uint64_t Random::next() {
+  uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+uint64_t Random::uniform(uint64_t n) {
+  return n? next() % n : 0;
+}
+
+double Random::uniform01() {
+  return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+
+//------------------------------------------------------------------------------
+// Data generators
+//------------------------------------------------------------------------------
+
+template <typename T>
+static void fill_ints(void* data, size_t n, Random& rng, uint64_t range) {
+  T* out = static_cast<T*>(data);
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<T>(range? rng.uniform(range) : rng.next());
+  }
+}
+
+Column* random_int_column(SType stype, size_t n, Random& rng,
+                          uint64_t range)
+{
+  Column* col = Column::new_data_column(stype, n);
+  void* data = col->data_w();
+  switch (stype) {
+    case SType::BOOL:  fill_ints<int8_t>(data, n, rng, 2); break;
+    case SType::INT8:  fill_ints<int8_t>(data, n, rng, range); break;
+    case SType::INT16: fill_ints<int16_t>(data, n, rng, range); break;
+    case SType::INT32: fill_ints<int32_t>(data, n, rng, range); break;
+    case SType::INT64: fill_ints<int64_t>(data, n, rng, range); break;
+    default:
+      throw ValueError() << "Cannot generate random integers of type "
+                         << stype;
+  }
+  return col;
+}
+
+
+template <typename T>
+static void fill_reals(void* data, size_t n, Random& rng) {
+  T* out = static_cast<T*>(data);
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = static_cast<T>(rng.uniform01() * 2e6 - 1e6);
+  }
+}
+
+Column* random_real_column(SType stype, size_t n, Random& rng) {
+  Column* col = Column::new_data_column(stype, n);
+  switch (stype) {
+    case SType::FLOAT32: fill_reals<float>(col->data_w(), n, rng); break;
+    case SType::FLOAT64: fill_reals<double>(col->data_w(), n, rng); break;
+    default:
+      throw ValueError() << "Cannot generate random reals of type " << stype;
+  }
+  return col;
+}
+
+
+Column* string_column(const std::vector<std::string>& values) {
+  size_t n = values.size();
+  size_t total = 0;
+  for (const auto& value : values) total += value.size();
+  MemoryRange offbuf = MemoryRange::mem(sizeof(uint32_t) * (n + 1));
+  MemoryRange strbuf = MemoryRange::mem(total);
+  uint32_t* offsets = static_cast<uint32_t*>(offbuf.xptr());
+  char* chars = static_cast<char*>(strbuf.xptr());
+  offsets[0] = 0;
+  uint32_t off = 0;
+  for (size_t i = 0; i < n; ++i) {
+    std::memcpy(chars + off, values[i].data(), values[i].size());
+    off += static_cast<uint32_t>(values[i].size());
+    offsets[i + 1] = off;
+  }
+  return new_string_column(n, std::move(offbuf), std::move(strbuf));
+}
+
+
+Column* random_string_column(size_t n, Random& rng, size_t nunique,
+                             size_t maxlen)
+{
+  std::vector<std::string> words(std::max<size_t>(nunique, 1));
+  for (auto& word : words) {
+    size_t len = 1 + rng.uniform(maxlen);
+    for (size_t j = 0; j < len; ++j) {
+      word += static_cast<char>('a' + rng.uniform(26));
+    }
+  }
+  std::vector<std::string> values(n);
+  for (size_t i = 0; i < n; ++i) {
+    values[i] = words[rng.uniform(words.size())];
+  }
+  return string_column(values);
+}
+
+
+Column* random_column(SType stype, size_t n, Random& rng) {
+  switch (stype) {
+    case SType::FLOAT32:
+    case SType::FLOAT64: return random_real_column(stype, n, rng);
+    case SType::STR32:   return random_string_column(n, rng, n / 10 + 1);
+    default:             return random_int_column(stype, n, rng);
+  }
+}
+
+
+DataTable* make_frame(colvec&& cols) {
+  strvec names;
+  for (size_t i = 0; i < cols.size(); ++i) {
+    names.push_back("C" + std::to_string(i));
+  }
+  return new DataTable(std::move(cols), names);
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Result
+//------------------------------------------------------------------------------
+
+double Result::min() const {
+  return *std::min_element(times.begin(), times.end());
+}
+
+double Result::median() const {
+  std::vector<double> sorted(times);
+  std::sort(sorted.begin(), sorted.end());
+  size_t k = sorted.size() / 2;
+  return sorted.size() % 2? sorted[k] : (sorted[k - 1] + sorted[k]) / 2;
+}
+
+double Result::mean() const {
+  double sum = 0;
+  for (double t : times) sum += t;
+  return sum / static_cast<double>(times.size());
+}
+
+
+
+
+//------------------------------------------------------------------------------
+// Runner
+//------------------------------------------------------------------------------
+
+Runner::Runner(const std::string& filter_, size_t nrows, size_t repeat,
+               uint64_t seed, bool verbose_)
+  : filter(filter_), nrows_(nrows), repeat_(std::max<size_t>(repeat, 1)),
+    seed_(seed), verbose(verbose_) {}
+
+
+bool Runner::enabled(const std::string& name) const {
+  return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+
+void Runner::measure(const std::string& name, size_t n,
+                     dt::function<void()> run, dt::function<void()> prepare)
+{
+  if (!enabled(name)) return;
+  using clock = std::chrono::steady_clock;
+  Result res;
+  res.name = name;
+  res.n = n;
+  for (size_t i = 0; i <= repeat_; ++i) {
+    if (prepare) prepare();
+    auto t0 = clock::now();
+    run();
+    auto t1 = clock::now();
+    // Iteration 0 is the warm-up run
+    if (i) res.times.push_back(std::chrono::duration<double>(t1 - t0).count());
+  }
+  if (verbose) {
+    std::fprintf(stderr, "%-40s  min %10.3f ms   median %10.3f ms\n",
+                 name.c_str(), res.min() * 1000, res.median() * 1000);
+  }
+  results.push_back(std::move(res));
+}
+
+
+void Runner::write_json(std::ostream& out) const {
+  out << "{\n"
+      << "  \"nrows\": " << nrows_ << ",\n"
+      << "  \"repeat\": " << repeat_ << ",\n"
+      << "  \"seed\": " << seed_ << ",\n"
+      << "  \"nthreads\": " << config::nthreads << ",\n"
+      << "  \"benchmarks\": [";
+  bool first = true;
+  for (const Result& res : results) {
+    double tmin = res.min();
+    out << (first? "\n" : ",\n")
+        << "    {\"name\": \"" << res.name << "\""
+        << ", \"n\": " << res.n
+        << ", \"runs\": " << res.times.size()
+        << ", \"min\": " << tmin
+        << ", \"median\": " << res.median()
+        << ", \"mean\": " << res.mean()
+        << ", \"ns_per_item\": "
+        << (res.n? tmin * 1e9 / static_cast<double>(res.n) : 0.0)
+        << "}";
+    first = false;
+  }
+  out << "\n  ]\n}\n";
+}
+
+
+
+}  // namespace bench
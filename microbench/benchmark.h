@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+//
+// Micro-benchmarks for the core C++ kernels of datatable.
+//
+// The benchmarks are compiled together with all sources in `c/` into a
+// standalone executable (see `make bench`), which embeds the python
+// interpreter only to the extent necessary for initializing the `_datatable`
+// module. Thus, the kernels are timed without any python overhead, which
+// makes it possible to see small regressions that would be lost in the noise
+// of the python-level benchmarks.
+//
+// Each benchmark is a named kernel invocation, for example "sort/int32" or
+// "binaryop/float64+float64". The results are written in JSON format, so
+// that they can be compared between builds.
+//
+//------------------------------------------------------------------------------
+#ifndef dt_MICROBENCH_BENCHMARK_h
+#define dt_MICROBENCH_BENCHMARK_h
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "utils/function.h"
+#include "column.h"
+#include "datatable.h"
+#include "types.h"
+
+namespace bench {
+
+
+//------------------------------------------------------------------------------
+// Random
+//------------------------------------------------------------------------------
+
+/**
+ * Pseudo-random number generator (splitmix64). We do not use the standard
+ * `<random>` distributions, because their output is implementation-defined,
+ * whereas the benchmark data must be the same on every platform for a given
+ * seed.
+ */
+class Random {
+  private:
+    uint64_t state;
+
+  public:
+    explicit Random(uint64_t seed);
+    uint64_t next();
+
+    // Random integer in the range `[0; n)`
+    uint64_t uniform(uint64_t n);
+
+    // Random double in the range `[0; 1)`
+    double uniform01();
+};
+
+
+
+//------------------------------------------------------------------------------
+// Data generators
+//------------------------------------------------------------------------------
+
+/**
+ * Create a column of the given integer `stype` (BOOL, INT8, .., INT64) with
+ * `n` random values. If `range` is non-zero, the values are drawn from
+ * `[0; range)`, otherwise from the full range of the stype.
+ */
+Column* random_int_column(SType stype, size_t n, Random& rng,
+                          uint64_t range = 0);
+
+/**
+ * Create a FLOAT32 or FLOAT64 column with `n` random values uniformly
+ * distributed in `[-1e6; 1e6)`.
+ */
+Column* random_real_column(SType stype, size_t n, Random& rng);
+
+/**
+ * Create a STR32 column with the given values.
+ */
+Column* string_column(const std::vector<std::string>& values);
+
+/**
+ * Create a STR32 column with `n` values chosen from a pool of `nunique`
+ * random lowercase words of length up to `maxlen`.
+ */
+Column* random_string_column(size_t n, Random& rng, size_t nunique,
+                             size_t maxlen = 16);
+
+/**
+ * Create a column of any stype with `n` random values, using the generators
+ * above with their default settings.
+ */
+Column* random_column(SType stype, size_t n, Random& rng);
+
+/**
+ * Wrap the columns into a DataTable with names "C0", "C1", ...
+ */
+DataTable* make_frame(colvec&& cols);
+
+
+
+//------------------------------------------------------------------------------
+// Runner
+//------------------------------------------------------------------------------
+
+struct Result {
+  std::string name;
+  size_t n;           // problem size: number of elements processed per run
+  std::vector<double> times;  // duration of each run, in seconds
+
+  double min() const;
+  double median() const;
+  double mean() const;
+};
+
+
+class Runner {
+  private:
+    std::vector<Result> results;
+    std::string filter;
+    size_t nrows_;
+    size_t repeat_;
+    uint64_t seed_;
+    bool verbose;
+    size_t : 56;
+
+  public:
+    Runner(const std::string& filter, size_t nrows, size_t repeat,
+           uint64_t seed, bool verbose);
+
+    size_t nrows() const { return nrows_; }
+    uint64_t seed() const { return seed_; }
+
+    /**
+     * Return true if the benchmark `name` was selected by the `--filter`
+     * option. This should be checked before generating the data for a
+     * benchmark, in order to avoid unnecessary work.
+     */
+    bool enabled(const std::string& name) const;
+
+    /**
+     * Time the function `run()`, which processes `n` elements. The function
+     * is executed once for warm-up, and then `repeat` times for measurement.
+     * If `prepare()` is given, it is called (untimed) before every execution
+     * of `run()`, for example in order to restore the input data modified
+     * in-place by the previous run.
+     */
+    void measure(const std::string& name, size_t n,
+                 dt::function<void()> run,
+                 dt::function<void()> prepare = nullptr);
+
+    void write_json(std::ostream& out) const;
+};
+
+
+
+//------------------------------------------------------------------------------
+// Benchmark suites
+//------------------------------------------------------------------------------
+
+void bench_sort(Runner&);       // bench_sort.cc
+void bench_join(Runner&);       // bench_frame.cc
+void bench_reduce(Runner&);     // bench_frame.cc
+void bench_binaryop(Runner&);   // bench_frame.cc
+void bench_rowindex(Runner&);   // bench_frame.cc
+void bench_fread(Runner&);      // bench_io.cc
+void bench_writecsv(Runner&);   // bench_io.cc
+void bench_jay(Runner&);        // bench_io.cc
+
+
+
+}  // namespace bench
+#endif
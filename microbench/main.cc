@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+//
+// © H2O.ai 2018
+//------------------------------------------------------------------------------
+//
+// Usage:
+//
+//     microbench [--filter=STR] [--nrows=N] [--repeat=N] [--seed=N]
+//                [--nthreads=N] [--output=FILE] [--quiet]
+//
+//   --filter    run only the benchmarks whose name contains STR
+//   --nrows     size of the generated data (default 1000000)
+//   --repeat    number of timed runs of each benchmark (default 5)
+//   --seed      seed for the data generators (default 1)
+//   --nthreads  number of threads to use (default: all cores)
+//   --output    write the JSON results into FILE instead of stdout
+//   --quiet     do not print the progress to stderr
+//
+//------------------------------------------------------------------------------
+#include <cstdio>      // std::fprintf
+#include <cstdlib>     // std::strtoull
+#include <cstring>     // std::strncmp
+#include <fstream>     // std::ofstream
+#include <iostream>    // std::cout
+#include <Python.h>
+#include "benchmark.h"
+#include "datatablemodule.h"
+#include "options.h"
+
+
+static const char* arg_value(const char* arg, const char* name) {
+  size_t len = std::strlen(name);
+  if (std::strncmp(arg, name, len) == 0 && arg[len] == '=') {
+    return arg + len + 1;
+  }
+  return nullptr;
+}
+
+
+int main(int argc, char** argv) {
+  std::string filter;
+  std::string output;
+  size_t nrows = 1000000;
+  size_t repeat = 5;
+  uint64_t seed = 1;
+  int nthreads = 0;
+  bool verbose = true;
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    const char* v;
+    if ((v = arg_value(arg, "--filter")))   filter = v; else
+    if ((v = arg_value(arg, "--output")))   output = v; else
+    if ((v = arg_value(arg, "--nrows")))    nrows = std::strtoull(v, nullptr, 10); else
+    if ((v = arg_value(arg, "--repeat")))   repeat = std::strtoull(v, nullptr, 10); else
+    if ((v = arg_value(arg, "--seed")))     seed = std::strtoull(v, nullptr, 10); else
+    if ((v = arg_value(arg, "--nthreads"))) nthreads = std::atoi(v); else
+    if (std::strcmp(arg, "--quiet") == 0)   verbose = false;
+    else {
+      std::fprintf(stderr, "Unknown argument %s\n", arg);
+      return 2;
+    }
+  }
+
+  Py_Initialize();
+  PyObject* module = PyInit__datatable();
+  if (!module) {
+    PyErr_Print();
+    return 1;
+  }
+  config::set_nthreads(nthreads);
+
+  bench::Runner runner(filter, nrows, repeat, seed, verbose);
+  try {
+    bench::bench_sort(runner);
+    bench::bench_join(runner);
+    bench::bench_reduce(runner);
+    bench::bench_binaryop(runner);
+    bench::bench_rowindex(runner);
+    bench::bench_fread(runner);
+    bench::bench_writecsv(runner);
+    bench::bench_jay(runner);
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "Error: %s\n", e.what());
+    return 1;
+  }
+
+  if (output.empty()) {
+    runner.write_json(std::cout);
+  } else {
+    std::ofstream out(output);
+    runner.write_json(out);
+  }
+  return 0;
+}
@@ -883,6 +883,35 @@ def test_fread_logger():
     assert "\n\n" not in lg.msg
 
 
+def test_fread_logger_in_threads():
+    # The data is parsed without the GIL, which must be re-acquired to
+    # report messages to the logger
+    import threading
+    class MyLogger:
+        def __init__(self):
+            self.count = 0
+
+        def debug(self, msg):
+            self.count += 1
+
+    text = "A,B\n" + "".join("%d,%d.5\n" % (i, i) for i in range(100000))
+    loggers = [MyLogger() for _ in range(3)]
+    results = [None] * 3
+
+    def work(i):
+        results[i] = dt.fread(text=text, logger=loggers[i])
+
+    threads = [threading.Thread(target=work, args=(i,)) for i in range(3)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    for i in range(3):
+        assert loggers[i].count > 10
+        assert results[i].shape == (100000, 2)
+        assert results[i][-1, :].to_list() == [[99999], [99999.5]]
+
+
 
 #-------------------------------------------------------------------------------
 # `nthreads`
@@ -407,6 +407,38 @@ def test_aggregate_2d_categorical_sampling():
     assert_equals(d_in, d_in_copy)
 
 
+def test_aggregate_2d_categorical_random():
+    import random
+    random.seed(5)
+    nrows = 10000
+    a_in = [[random.choice(["", "a", "ab", "b", "ba", "\u00e9", None])
+             for _ in range(nrows)],
+            [random.choice([str(i) for i in range(50)] + [None])
+             for _ in range(nrows)]]
+    d_in = dt.Frame(a_in)
+    d_in_view = d_in[::2, :]
+    for frame in (d_in, d_in_view):
+        [d_exemplars, d_members] = aggregate(frame, min_rows=0, nx_bins=10,
+                                             ny_bins=100)
+        frame_integrity_check(d_members)
+        frame_integrity_check(d_exemplars)
+        a, b = frame.to_list()
+        ea, eb, counts = d_exemplars.to_list()
+        members = d_members.to_list()[0]
+        assert sum(counts) == frame.nrows
+        for i, e in enumerate(members):
+            if a[i] is not None and b[i] is not None:
+                assert (ea[e], eb[e]) == (a[i], b[i])
+        # Exemplars without NAs are distinct and sorted, and go after the
+        # NA bins
+        pairs = [(x.encode(), y.encode()) for x, y in zip(ea, eb)
+                 if x is not None and y is not None]
+        assert pairs == sorted(set(pairs))
+        nna = d_exemplars.nrows - len(pairs)
+        assert nna <= 3
+        assert all(ea[k] is None or eb[k] is None for k in range(nna))
+
+
 def test_aggregate_2d_mixed_sorted():
     nx_bins = 7
     d_in = dt.Frame([[None, None, 0, 0, 1, 2, 3, 4, 5, 6],
@@ -548,6 +580,30 @@ def aggregate_nd(nd):
     assert_equals(d_in, d_in_copy)
 
 
+def test_aggregate_nd_nthreads():
+    import random
+    random.seed(11)
+    nrows = 5000
+    nd = 5
+    d_in = dt.Frame([[random.random() if random.random() > 0.05 else None
+                      for _ in range(nrows)] for _ in range(nd)])
+    nthreads = dt.options.nthreads
+    try:
+        dt.options.nthreads = 1
+        [d_exemplars1, d_members1] = aggregate(d_in, min_rows=0,
+                                               nd_max_bins=100, seed=7)
+    finally:
+        dt.options.nthreads = nthreads
+    [d_exemplars, d_members] = aggregate(d_in, min_rows=0,
+                                         nd_max_bins=100, seed=7)
+    frame_integrity_check(d_members)
+    frame_integrity_check(d_exemplars)
+    assert d_exemplars.nrows <= 100
+    assert d_exemplars[:, -1].sum1() == nrows
+    assert_equals(d_members, d_members1)
+    assert_equals(d_exemplars, d_exemplars1)
+
+
 #-------------------------------------------------------------------------------
 # Aggregate views
 #-------------------------------------------------------------------------------
@@ -110,6 +110,13 @@ def test_ftrl_construct_wrong_double_precision_type():
             "instead got <class 'int'>" == str(e.value))
 
 
+def test_ftrl_construct_wrong_deterministic_type():
+    with pytest.raises(TypeError) as e:
+        noop(Ftrl(deterministic = 1))
+    assert ("Argument `deterministic` in Ftrl() constructor should be a boolean, "
+            "instead got <class 'int'>" == str(e.value))
+
+
 def test_ftrl_construct_wrong_combination():
     with pytest.raises(TypeError) as e:
         noop(Ftrl(params=tparams, alpha = tparams.alpha))
@@ -565,6 +572,43 @@ def test_ftrl_fit_predict_view():
     assert_equals(predictions, predictions_range)
 
 
+@pytest.mark.parametrize('nbins', [1000, 1024])
+def test_ftrl_fit_predict_view_multiple_blocks(nbins):
+    # Rows are hashed in blocks, check that blocks of different columns
+    # are hashed consistently for views and materialized frames, and when
+    # some of the targets are NA.
+    n = 1000
+    ft = Ftrl(nbins = nbins, nepochs = 2)
+    ft.interactions = [["A", "C"]]
+    df_train = dt.Frame(A = [random.randint(0, 100) for _ in range(n)],
+                        B = [random.random() for _ in range(n)],
+                        C = [random.choice(["x", "y", None]) for _ in range(n)])
+    df_target = dt.Frame([random.choice([True, False, None])
+                          for _ in range(n)])
+    rows = range(n - 1, 0, -3)
+    nthreads = dt.options.nthreads
+    try:
+        # Single thread makes the training deterministic
+        dt.options.nthreads = 1
+        ft.fit(df_train[rows, :], df_target[rows, :])
+        predictions = ft.predict(df_train[rows, :])
+        model = ft.model
+
+        ft.reset()
+        ft.interactions = [["A", "C"]]
+        df_train_range = df_train[rows, :]
+        df_target_range = df_target[rows, :]
+        df_train_range.materialize()
+        df_target_range.materialize()
+        ft.fit(df_train_range, df_target_range)
+        predictions_range = ft.predict(df_train_range)
+    finally:
+        dt.options.nthreads = nthreads
+
+    assert_equals(model, ft.model)
+    assert_equals(predictions, predictions_range)
+
+
 @pytest.mark.parametrize('parameter, value',
                          [("nbins", 100),
                          ("interactions", [["C0", "C0"]])])
@@ -583,6 +627,61 @@ def test_ftrl_disable_setters_after_fit(parameter, value):
     setattr(ft, parameter, value)
 
 
+def test_ftrl_fit_deterministic():
+    # Deterministic mode should produce the same model and feature
+    # importances on every run, regardless of the number of threads.
+    n = 5000
+    df_train = dt.Frame(A = [random.randint(0, 1000) for _ in range(n)],
+                        B = [random.choice(["a", "b", "c"]) for _ in range(n)])
+    df_target = dt.Frame([random.random() for _ in range(n)])
+    nthreads = dt.options.nthreads
+    results = []
+    try:
+        for nth in [nthreads, nthreads, 1, 3]:
+            dt.options.nthreads = nth
+            ft = Ftrl(nbins = 100, nepochs = 2, deterministic = True)
+            ft.fit(df_train, df_target)
+            results.append((ft.model, ft.feature_importances))
+    finally:
+        dt.options.nthreads = nthreads
+    for model, fi in results[1:]:
+        assert_equals(model, results[0][0])
+        assert_equals(fi, results[0][1])
+
+
+def test_ftrl_fit_deterministic_multinomial():
+    # More labels than are buffered at once in the deterministic mode
+    n = 3000
+    labels = [chr(ord("a") + i) for i in range(11)]
+    df_train = dt.Frame(A = [random.randint(0, 1000) for _ in range(n)],
+                        B = [random.randint(0, 30) for _ in range(n)])
+    df_target = dt.Frame([random.choice(labels) for _ in range(n)])
+    nthreads = dt.options.nthreads
+    results = []
+    try:
+        for nth in [nthreads, 1, 3]:
+            dt.options.nthreads = nth
+            ft = Ftrl(nbins = 1000, nepochs = 2, deterministic = True)
+            ft.fit(df_train, df_target)
+            results.append((ft.model, ft.feature_importances))
+    finally:
+        dt.options.nthreads = nthreads
+    for model, fi in results[1:]:
+        assert_equals(model, results[0][0])
+        assert_equals(fi, results[0][1])
+
+
+def test_ftrl_deterministic_setter():
+    ft = Ftrl()
+    assert not ft.deterministic
+    ft.deterministic = True
+    assert ft.deterministic
+    ft_unpickled = pickle.loads(pickle.dumps(ft))
+    assert ft_unpickled.deterministic
+    with pytest.raises(TypeError):
+        ft.deterministic = 0
+
+
 #-------------------------------------------------------------------------------
 # Test multinomial regression
 #-------------------------------------------------------------------------------
@@ -812,6 +911,89 @@ def test_ftrl_early_stopping_multinomial():
     assert collections.Counter(p.names) == collections.Counter(labels)
 
 
+#-------------------------------------------------------------------------------
+# Test training on a stream of batches
+#-------------------------------------------------------------------------------
+
+def test_ftrl_partial_fit_vs_fit():
+    nbatches = 5
+    n = 1000
+    batches = []
+    for _ in range(nbatches):
+        df_X = dt.Frame(A = [random.randint(0, 100) for _ in range(n)],
+                        B = [random.choice(["a", "b", "c"]) for _ in range(n)])
+        df_y = dt.Frame([random.random() for _ in range(n)])
+        batches.append((df_X, df_y))
+    ft1 = Ftrl(nbins = 100, nepochs = 2, deterministic = True)
+    ft2 = Ftrl(nbins = 100, nepochs = 2, deterministic = True)
+    for df_X, df_y in batches:
+        ft1.fit(df_X, df_y)
+    res = ft2.partial_fit(batch for batch in batches)
+    assert res == nbatches
+    assert_equals(ft1.model, ft2.model)
+    assert_equals(ft1.feature_importances, ft2.feature_importances)
+
+
+def test_ftrl_partial_fit_early_stopping():
+    nbins = 10
+    ft = Ftrl(alpha = 0.5, nbins = nbins, nepochs = 10)
+    df_X = dt.Frame(range(nbins))
+    df_y = dt.Frame(range(nbins))
+    nbatches = ft.partial_fit(((df_X, df_y) for _ in range(10000)),
+                              df_X, df_y)
+    p = ft.predict(df_X)
+    delta = [abs(i - j) for i, j in zip(p.to_list()[0], range(nbins))]
+    assert 1 < nbatches < 10000
+    assert max(delta) < epsilon
+
+
+def test_ftrl_partial_fit_wrong_batches():
+    ft = Ftrl(nbins = 10)
+    df_X = dt.Frame(range(10))
+    df_y = dt.Frame(range(10))
+    with pytest.raises(TypeError) as e:
+        ft.partial_fit([(df_X, df_y), df_X])
+    assert ("Each batch should be a tuple `(X, y)` of frames, instead "
+            "batch 1 is <class 'datatable.Frame'>" == str(e.value))
+    with pytest.raises(ValueError) as e:
+        ft.partial_fit([(df_X, df_y[:5, :])])
+    assert ("Target column must have the same number of rows as the "
+            "training frame" == str(e.value))
+
+    def failing_batches():
+        yield (df_X, df_y)
+        raise RuntimeError("cannot read the next batch")
+
+    with pytest.raises(RuntimeError) as e:
+        ft.partial_fit(failing_batches())
+    assert "cannot read the next batch" == str(e.value)
+
+
+def test_ftrl_partial_fit_model_in_use():
+    # The next batch is read while the model is being trained on the
+    # current one: the model cannot be used in the meantime
+    ft = Ftrl(nbins = 10)
+    df_X = dt.Frame(range(10))
+    df_y = dt.Frame(range(10))
+
+    def batches(action):
+        yield (df_X, df_y)
+        action()
+        yield (df_X, df_y)
+
+    actions = [lambda: ft.predict(df_X), lambda: ft.reset(),
+               lambda: setattr(ft, "alpha", 0.1), lambda: ft.model,
+               lambda: ft.fit(df_X, df_y)]
+    for action in actions:
+        with pytest.raises(RuntimeError) as e:
+            ft.partial_fit(batches(action))
+        assert ("This model is being trained by `partial_fit()` and cannot "
+                "be used until the training is done" == str(e.value))
+    # Once `partial_fit()` has returned, the model can be used again
+    ft.alpha = 0.1
+    assert ft.predict(df_X).shape == (10, 1)
+
+
 #-------------------------------------------------------------------------------
 # Test regression for numerical targets
 #-------------------------------------------------------------------------------
@@ -849,6 +1031,22 @@ def test_ftrl_feature_importances():
     assert fi[2, 1] < fi[1, 1]
 
 
+def test_ftrl_feature_importances_deterministic():
+    nrows = 10**4
+    feature_names = ['unique', 'boolean', 'mod100']
+    ft = Ftrl(deterministic = True)
+    assert ft.deterministic
+    df_train = dt.Frame([range(nrows),
+                         [i % 2 for i in range(nrows)],
+                         [i % 100 for i in range(nrows)]
+                        ], names = feature_names)
+    df_target = dt.Frame([False, True] * (nrows // 2))
+    ft.fit(df_train, df_target)
+    fi = ft.feature_importances
+    assert fi[0, 1] < fi[2, 1]
+    assert fi[2, 1] < fi[1, 1]
+
+
 def test_ftrl_fi_shallowcopy():
     import copy
     ft = Ftrl(tparams)
@@ -862,6 +1060,70 @@ def test_ftrl_fi_shallowcopy():
     assert_equals(fi1, fi2)
 
 
+#-------------------------------------------------------------------------------
+# Test models finalized for inference
+#-------------------------------------------------------------------------------
+
+def test_ftrl_finalize_untrained():
+    ft = Ftrl()
+    assert not ft.finalized
+    with pytest.raises(ValueError) as e:
+        ft.finalize()
+    assert ("To finalize the model, it should be trained first" ==
+            str(e.value))
+
+
+@pytest.mark.parametrize('double_precision', [False, True])
+def test_ftrl_finalize_predict(double_precision):
+    n = 1000
+    df_train = dt.Frame(A = [random.randint(0, 100) for _ in range(n)],
+                        B = [random.choice(["a", "b", "c"]) for _ in range(n)])
+    targets = [dt.Frame([random.random() > 0.5 for _ in range(n)]),
+               dt.Frame([random.random() for _ in range(n)]),
+               dt.Frame([random.choice(["x", "y", "z"]) for _ in range(n)])]
+    for df_target in targets:
+        ft = Ftrl(nbins = 1000, lambda1 = 0.01,
+                  double_precision = double_precision)
+        ft.fit(df_train, df_target)
+        p = ft.predict(df_train)
+        ft.finalize()
+        assert ft.finalized
+        assert ft.model is None
+        p_finalized = ft.predict(df_train)
+        frame_integrity_check(p_finalized)
+        assert_equals(p, p_finalized)
+
+
+def test_ftrl_finalize_no_training():
+    ft = Ftrl(nbins = 10)
+    df_train = dt.Frame(range(ft.nbins))
+    df_target = dt.Frame([True] * ft.nbins)
+    ft.fit(df_train, df_target)
+    ft.finalize()
+    with pytest.raises(ValueError) as e:
+        ft.fit(df_train, df_target)
+    assert ("This model was finalized for inference and cannot be trained "
+            "any further" == str(e.value))
+    ft.reset()
+    assert not ft.finalized
+    ft.fit(df_train, df_target)
+    assert ft.model.shape == (ft.nbins, 2)
+
+
+def test_ftrl_pickling_finalized():
+    ft = Ftrl(nbins = 100)
+    df_train = dt.Frame(range(20), names = ["f1"])
+    df_target = dt.Frame([True, False] * 10)
+    ft.fit(df_train, df_target)
+    p = ft.predict(df_train)
+    ft.finalize()
+    ft_unpickled = pickle.loads(pickle.dumps(ft))
+    assert ft_unpickled.finalized
+    assert ft_unpickled.model is None
+    assert ft.labels == ft_unpickled.labels
+    assert_equals(p, ft_unpickled.predict(df_train))
+
+
 #-------------------------------------------------------------------------------
 # Test feature interactions
 #-------------------------------------------------------------------------------
@@ -115,3 +115,168 @@ def test_kfold_k_any(seed):
         assert split[0].nrows + len(split[1]) == n
         assert split[0].ncols == 1
         assert split[0].to_list()[0] == list(range(0, hl)) + list(range(hu, n))
+
+
+
+#-------------------------------------------------------------------------------
+# kfold_random, kfold_stratified, kfold_grouped
+#-------------------------------------------------------------------------------
+
+def rows_of(selector):
+    if isinstance(selector, range):
+        return list(selector)
+    assert isinstance(selector, dt.Frame)
+    assert selector.ncols == 1
+    return selector.to_list()[0]
+
+
+def check_splits(splits, n, k):
+    assert isinstance(splits, list)
+    assert len(splits) == k
+    all_test = []
+    for train, test in splits:
+        train_rows = rows_of(train)
+        test_rows = rows_of(test)
+        assert train_rows == sorted(train_rows)
+        assert test_rows == sorted(test_rows)
+        assert sorted(train_rows + test_rows) == list(range(n))
+        all_test += test_rows
+    assert sorted(all_test) == list(range(n))
+    return [rows_of(test) for _, test in splits]
+
+
+def test_kfold_random_api():
+    from datatable.models import kfold_random
+    assert_type_error(lambda: kfold_random(nrows=5),
+        "Required parameter `nsplits` is missing")
+    assert_value_error(lambda: kfold_random(nrows=5, nsplits=1),
+        "The number of splits cannot be less than two")
+    assert_value_error(lambda: kfold_random(nrows=3, nsplits=4),
+        "The number of splits cannot exceed the number of rows")
+    assert_value_error(lambda: kfold_random(nrows=3, nsplits=2, seed=-1),
+        "Argument `seed` in kfold_random() cannot be negative")
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32)])
+def test_kfold_random(seed):
+    from datatable.models import kfold_random
+    random.seed(seed)
+    k = 2 + int(random.expovariate(0.2))
+    n = k + int(random.expovariate(0.0001))
+    splits = kfold_random(nrows=n, nsplits=k, seed=seed)
+    tests = check_splits(splits, n, k)
+    sizes = [len(t) for t in tests]
+    assert max(sizes) - min(sizes) <= 1
+    splits2 = kfold_random(nrows=n, nsplits=k, seed=seed)
+    assert check_splits(splits2, n, k) == tests
+
+
+def test_kfold_random_shuffles():
+    from datatable.models import kfold_random
+    splits = kfold_random(nrows=1000, nsplits=5, seed=1)
+    tests = check_splits(splits, 1000, 5)
+    assert tests[0] != list(range(200))
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32)])
+def test_kfold_stratified(seed):
+    from datatable.models import kfold_stratified
+    random.seed(seed)
+    k = 2 + int(random.expovariate(0.3))
+    n = 10 * k + int(random.expovariate(0.001))
+    labels = [random.choice(["a", "b", "c", None]) for _ in range(n)]
+    y = dt.Frame(labels)
+    splits = kfold_stratified(y=y, nsplits=k, seed=seed)
+    tests = check_splits(splits, n, k)
+    sizes = [len(t) for t in tests]
+    assert max(sizes) - min(sizes) <= 1
+    for label in ["a", "b", "c", None]:
+        counts = [sum(labels[i] == label for i in t) for t in tests]
+        assert max(counts) - min(counts) <= 1
+
+
+def test_kfold_stratified_api():
+    from datatable.models import kfold_stratified
+    assert_value_error(
+        lambda: kfold_stratified(y=dt.Frame(A=[1, 2], B=[3, 4]), nsplits=2),
+        "Argument `y` in kfold_stratified() must be a single-column Frame")
+    assert_value_error(
+        lambda: kfold_stratified(y=dt.Frame([1, 2]), nsplits=3),
+        "The number of splits cannot exceed the number of rows")
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32)])
+def test_kfold_grouped(seed):
+    from datatable.models import kfold_grouped
+    random.seed(seed)
+    k = 2 + int(random.expovariate(0.3))
+    ngroups = k + int(random.expovariate(0.05))
+    n = ngroups + int(random.expovariate(0.001))
+    groups = list(range(ngroups)) + [random.randint(0, ngroups - 1)
+                                     for _ in range(n - ngroups)]
+    random.shuffle(groups)
+    splits = kfold_grouped(groups=dt.Frame(groups), nsplits=k)
+    tests = check_splits(splits, n, k)
+    fold_of_group = {}
+    for f, t in enumerate(tests):
+        for i in t:
+            assert fold_of_group.setdefault(groups[i], f) == f
+    splits2 = kfold_grouped(groups=dt.Frame(groups), nsplits=k)
+    assert check_splits(splits2, n, k) == tests
+
+
+def test_kfold_grouped_too_many_splits():
+    from datatable.models import kfold_grouped
+    assert_value_error(
+        lambda: kfold_grouped(groups=dt.Frame([1, 1, 2, 2, 2]), nsplits=3),
+        "The number of splits cannot exceed the number of groups")
+
+
+def test_kfold_grouped_contiguous():
+    from datatable.models import kfold_grouped
+    splits = kfold_grouped(groups=dt.Frame([5, 5, 5, 5, 7, 7]), nsplits=2)
+    assert splits == [(range(4, 6), range(0, 4)),
+                      (range(0, 4), range(4, 6))]
+
+
+
+#-------------------------------------------------------------------------------
+# sample_rows
+#-------------------------------------------------------------------------------
+
+def test_sample_rows_api():
+    from datatable.models import sample_rows
+    assert_value_error(lambda: sample_rows(nrows=3, size=4),
+        "Sample size cannot exceed the number of rows when sampling "
+        "without replacement")
+    assert_value_error(lambda: sample_rows(nrows=0, size=1, replace=True),
+        "Cannot sample from a frame with 0 rows")
+    assert sample_rows(nrows=10, size=10) == range(0, 10)
+    assert sample_rows(nrows=10, size=0) == range(0, 0)
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32)])
+@pytest.mark.parametrize("frac", [0.1, 0.5, 0.9])
+def test_sample_rows_without_replacement(seed, frac):
+    from datatable.models import sample_rows
+    random.seed(seed)
+    n = 10 + int(random.expovariate(0.0001))
+    size = int(n * frac)
+    rows = rows_of(sample_rows(nrows=n, size=size, seed=seed))
+    assert len(rows) == size
+    assert rows == sorted(set(rows))
+    assert all(0 <= r < n for r in rows)
+    assert rows == rows_of(sample_rows(nrows=n, size=size, seed=seed))
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32)])
+def test_sample_rows_with_replacement(seed):
+    from datatable.models import sample_rows
+    n = 1000
+    sel = sample_rows(nrows=n, size=5000, replace=True, seed=seed)
+    rows = rows_of(sel)
+    assert len(rows) == 5000
+    assert all(0 <= r < n for r in rows)
+    assert len(set(rows)) < 5000
+    DT = dt.Frame(A=range(n))
+    assert DT[sel, :].to_list()[0] == rows
@@ -864,6 +864,120 @@ def test_chained_array3(dt0):
 
 
 
+#-------------------------------------------------------------------------------
+# Compressed (bitmap / runs) rowindices
+#-------------------------------------------------------------------------------
+
+def rowindex_type(DT):
+    return frame_column_rowindex(DT, 0).type
+
+
+def test_filter_dense_bitmap():
+    random.seed(17)
+    n = 200000
+    src = [random.randint(0, 9) for _ in range(n)]
+    DT = dt.Frame(A=src, B=range(n))
+    RES = DT[f.A < 6, :]
+    frame_integrity_check(RES)
+    assert rowindex_type(RES) == "bitmap"
+    exp = [i for i in range(n) if src[i] < 6]
+    assert RES[:, "B"].to_list()[0] == exp
+    assert RES[[0, 7, -1], "B"].to_list()[0] == [exp[0], exp[7], exp[-1]]
+
+
+def test_filter_sparse_stays_array():
+    n = 200000
+    DT = dt.Frame(A=range(n))
+    RES = DT[f.A % 100 == 3, :]
+    frame_integrity_check(RES)
+    assert rowindex_type(RES) == "arr32"
+    assert RES.to_list()[0] == list(range(3, n, 100))
+
+
+def test_filter_runs():
+    n = 300000
+    DT = dt.Frame(A=range(n))
+    RES = DT[f.A % 1000 < 900, :]
+    frame_integrity_check(RES)
+    assert rowindex_type(RES) == "runs"
+    assert RES.to_list()[0] == [i for i in range(n) if i % 1000 < 900]
+
+
+def test_compressed_rowindex_compose():
+    random.seed(3)
+    n = 300000
+    src = [random.randint(0, 9) for _ in range(n)]
+    DT = dt.Frame(A=src, B=range(n))
+    D1 = DT[f.A < 8, :]
+    D2 = DT[f.B % 1000 < 900, :]
+    exp1 = [i for i in range(n) if src[i] < 8]
+    exp2 = [i for i in range(n) if i % 1000 < 900]
+    for RES, exp in [(D1[f.B % 2 == 0, :], [i for i in exp1 if i % 2 == 0]),
+                     (D1[::3, :], exp1[::3]),
+                     (D1[::-1, :], exp1[::-1]),
+                     (D1[[5, 0, 3], :], [exp1[5], exp1[0], exp1[3]]),
+                     (D2[f.A < 8, :], [i for i in exp2 if src[i] < 8]),
+                     (D2[1000:-1000, :], exp2[1000:-1000])]:
+        frame_integrity_check(RES)
+        assert RES[:, "B"].to_list()[0] == exp
+
+
+def test_compressed_rowindex_negate():
+    random.seed(5)
+    n = 200000
+    src = [random.randint(0, 9) for _ in range(n)]
+    DT = dt.Frame(A=src, B=range(n))
+    del DT[f.A >= 7, :]
+    frame_integrity_check(DT)
+    assert rowindex_type(DT) == "bitmap"
+    assert DT[:, "B"].to_list()[0] == [i for i in range(n) if src[i] < 7]
+    DT = dt.Frame(A=range(n))
+    del DT[f.A % 100 < 90, :]
+    frame_integrity_check(DT)
+    assert rowindex_type(DT) == "runs"
+    assert DT.to_list()[0] == [i for i in range(n) if i % 100 >= 90]
+
+
+def test_compressed_rowindex_negate_density():
+    n = 200000
+    # Negation of a dense compressed index is sparse, and becomes an array
+    DT = dt.Frame(A=range(n))
+    del DT[f.A % 100 != 0, :]
+    frame_integrity_check(DT)
+    assert rowindex_type(DT) == "arr32"
+    assert DT.to_list()[0] == list(range(0, n, 100))
+    # Negation of two runs at the edges is a single run, i.e. a slice
+    DT = dt.Frame(A=range(n))
+    del DT[(f.A < 1000) | (f.A >= 100000), :]
+    frame_integrity_check(DT)
+    assert rowindex_type(DT) == "slice"
+    assert DT.to_list()[0] == list(range(1000, 100000))
+
+
+def test_compressed_rowindex_ops():
+    random.seed(11)
+    n = 200000
+    src = [random.randint(0, 9) for _ in range(n)]
+    DT = dt.Frame(A=src, B=range(n), C=[str(i) for i in range(n)])
+    RES = DT[f.A < 5, :]
+    exp = [i for i in range(n) if src[i] < 5]
+    assert RES[:, dt.sum(f.B)][0, 0] == sum(exp)
+    assert RES[:, dt.count(), by("A")].to_list() == \
+        [[0, 1, 2, 3, 4], [sum(src[i] == k for i in exp) for k in range(5)]]
+    SRT = RES.sort("B")
+    frame_integrity_check(SRT)
+    assert SRT[:, "B"].to_list()[0] == exp
+    RES.nrows = len(exp) + 2
+    frame_integrity_check(RES)
+    assert RES[-3:, :].to_list() == [[src[exp[-1]], None, None],
+                                     [exp[-1], None, None],
+                                     [str(exp[-1]), None, None]]
+    RES.materialize()
+    frame_integrity_check(RES)
+    assert RES[:-2, "C"].to_list()[0] == [str(i) for i in exp]
+
+
+
 #-------------------------------------------------------------------------------
 # Others
 #-------------------------------------------------------------------------------
@@ -331,6 +331,51 @@ def test_replace_multiple(nn, st):
     assert df.to_list()[0] == res
 
 
+@pytest.mark.parametrize("seed", [random.getrandbits(32)])
+@pytest.mark.parametrize("nn", [9, 100, 3000])
+@pytest.mark.parametrize("spread", [1, 1000000])
+def test_replace_many_int(seed, nn, spread):
+    # Recoding: each value maps into the next one, which must not be
+    # replaced again. With `spread` > 1 the targets are too sparse for a
+    # direct lookup table, and a hash table is used.
+    random.seed(seed)
+    n = 10000 + int(random.expovariate(0.0001))
+    src = [random.randint(0, nn + 10) * spread for _ in range(n)] + [None]
+    replacements = {i * spread: (i + 1) * spread for i in range(nn)}
+    replacements[None] = -1
+    df = dt.Frame(src, stype=dt.int64)
+    df.replace(replacements)
+    frame_integrity_check(df)
+    assert df.to_list()[0] == [replacements.get(x, x) for x in src]
+
+
+@pytest.mark.parametrize("nn", [9, 100])
+def test_replace_many_real(nn):
+    src = [i / 4 for i in range(-50, 500)] + [-0.0, None, inf]
+    replacements = {i / 2: -i / 2 - 1 for i in range(nn)}
+    df = dt.Frame(src, stype=dt.float64)
+    df.replace(replacements)
+    frame_integrity_check(df)
+    res = [replacements.get(x, x) for x in src[:-2]] + [None, inf]
+    assert df.to_list()[0] == res
+    # -0.0 is equal to 0.0, and so must be replaced as well
+    assert res[-3] == -1.0
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32)])
+def test_replace_many_str(seed):
+    random.seed(seed)
+    words = ["w%d" % i for i in range(500)]
+    src = [random.choice(words) for _ in range(5000)] + [None, ""]
+    replacements = {w: w.upper() for w in words[::3]}
+    replacements["w1"] = "w2"  # must not be replaced again into "W2"
+    replacements[None] = "NA"
+    df = dt.Frame(src)
+    df.replace(replacements)
+    frame_integrity_check(df)
+    assert df.to_list()[0] == [replacements.get(x, x) for x in src]
+
+
 def test_replace_in_copy():
     df1 = dt.Frame([[1, 2, 3], [5.5, 6.6, 7.7], ["A", "B", "C"]])
     df2 = df1.copy()
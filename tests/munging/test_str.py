@@ -141,6 +141,52 @@ def test_split_into_nhot_view():
     assert f2[:, ["cat", "dog"]].to_list() == [[1], [1]]
 
 
+def test_split_into_nhot_order():
+    # Columns are in the order of first appearance of each token
+    f0 = dt.Frame(["b, a", None, "c, a, b", "", "d"])
+    f1 = dt.split_into_nhot(f0)
+    assert f1.names == ("b", "a", "c", "d")
+    assert f1.to_list() == [[1, 0, 1, 0, 0], [1, 0, 1, 0, 0],
+                            [0, 0, 1, 0, 0], [0, 0, 0, 0, 1]]
+
+
+def test_split_into_nhot_sparse():
+    f0 = dt.Frame(["cat, dog, cat", None, "", "mouse, dog", "[dog]"])
+    offsets, ids, tokens = dt.split_into_nhot(f0, sparse=True)
+    frame_integrity_check(offsets)
+    frame_integrity_check(ids)
+    frame_integrity_check(tokens)
+    assert offsets.stypes == (stype.int32,)
+    assert ids.stypes == (stype.int32,)
+    assert tokens.to_list() == [["cat", "dog", "mouse"]]
+    assert offsets.to_list() == [[0, 2, 2, 2, 4, 5]]
+    assert ids.to_list() == [[0, 1, 1, 2, 1]]
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32)])
+def test_split_into_nhot_sparse_vs_dense(seed):
+    random.seed(seed)
+    n = int(random.expovariate(0.0001) + 10)
+    words = ["w%d" % i for i in range(int(random.expovariate(0.01)) + 1)]
+    data = [None if random.random() < 0.1 else
+            ",".join(random.choice(words)
+                     for _ in range(int(random.expovariate(0.3))))
+            for _ in range(n)]
+    f0 = dt.Frame(data)
+    dense = dt.split_into_nhot(f0[::-1, :])
+    offsets, ids, tokens = dt.split_into_nhot(f0[::-1, :], sparse=True)
+    tokens = tokens.to_list()[0]
+    offsets = offsets.to_list()[0]
+    ids = ids.to_list()[0]
+    assert tuple(tokens) == dense.names
+    assert len(offsets) == n + 1
+    columns = dense.to_list()
+    for i in range(n):
+        row_ids = ids[offsets[i]:offsets[i + 1]]
+        assert row_ids == sorted(set(row_ids))
+        assert row_ids == [k for k in range(len(tokens)) if columns[k][i]]
+
+
 
 #-------------------------------------------------------------------------------
 # len()
@@ -618,6 +618,13 @@ def test_to_list2():
     assert a0 == [1.0, None, None, 3.3]
 
 
+def test_to_list_signed_zeros():
+    from math import copysign
+    d0 = dt.Frame([0.0, -0.0, -0.0, 0.0])
+    a0 = d0.to_list()[0]
+    assert [copysign(1, x) for x in a0] == [1, -1, -1, 1]
+
+
 def test_to_tuples():
     d0 = dt.Frame([[2, 17, -5, 148],
                    [3.6, 9.99, -14.15, 2.5e100],
@@ -629,6 +636,48 @@ def test_to_tuples():
                               (148, 2.5e100, "polonium", None)]
 
 
+def test_to_tuples_view():
+    d0 = dt.Frame(A=range(10), B=[None, "x", "yy", "ä"] * 2 + ["z", None],
+                  C=[1.5, None] * 5, D=[True, False, None, True, True] * 2)
+    d1 = d0[::-3, :]
+    assert d1.to_tuples() == [(9, None, None, True),
+                              (6, "yy", 1.5, False),
+                              (3, "ä", None, True),
+                              (0, None, 1.5, True)]
+    assert d1.to_list() == [list(col) for col in zip(*d1.to_tuples())]
+
+
+def test_to_tuples_large():
+    n = 10000
+    d0 = dt.Frame(A=list(range(7)) * n,
+                  B=["abc", "de", None, "ü", "f", "abc", "de"] * n,
+                  C=[2.5] * (7 * n - 1) + [None])
+    tt = d0.to_tuples()
+    assert len(tt) == 70000
+    assert tt[:5] == [(0, "abc", 2.5), (1, "de", 2.5), (2, None, 2.5),
+                      (3, "ü", 2.5), (4, "f", 2.5)]
+    assert tt[-1] == (6, "de", None)
+    assert tt == list(zip(*d0.to_list()))
+    # repeated string values are converted into the same python objects
+    assert tt[0][1] is tt[5][1] is tt[69993][1]
+
+
+def test_iter_tuples():
+    d0 = dt.Frame(A=range(100), B=[str(i % 7) for i in range(100)])
+    it = d0.iter_tuples(batch_size=17)
+    assert not isinstance(it, list)
+    assert list(it) == d0.to_tuples()
+    assert list(d0.iter_tuples()) == d0.to_tuples()
+    assert list(d0[:0, :].iter_tuples()) == []
+
+
+def test_iter_tuples_bad():
+    d0 = dt.Frame(A=range(10))
+    with pytest.raises(ValueError) as e:
+        list(d0.iter_tuples(batch_size=0))
+    assert "Parameter `batch_size` should be a positive integer" in str(e.value)
+
+
 def test_to_dict():
     d0 = dt.Frame(A=["purple", "yellow", "indigo", "crimson"],
                   B=[0, None, 123779, -299],
@@ -697,6 +746,43 @@ def test_topandas_view_mixed():
     assert all(math.isnan(x) for x in pp["V"].tolist()[1:])
 
 
+def test_topandas_strings(pandas):
+    src = ["abc", None, "\u00e9t\u00e9", "", "abc", "x" * 100, "abc"]
+    d0 = dt.Frame(A=src)
+    d1 = d0[::-1, :]
+    p0 = d0.to_pandas()
+    p1 = d1.to_pandas()
+    assert p0["A"].tolist() == src
+    assert p1["A"].tolist() == src[::-1]
+    # repeated short strings are converted into the same object
+    assert p0["A"][0] is p0["A"][4]
+
+
+def test_topandas_zero_copy(pandas):
+    d0 = dt.Frame(A=range(100), B=[1.5, None] * 50, C=[1, None] * 50)
+    p0 = d0.to_pandas()
+    assert p0["A"].dtype.name == "int8"
+    assert p0["B"].dtype.name == "float64"
+    assert p0["C"].dtype.name == "float64"
+    assert p0["A"].tolist() == list(range(100))
+    assert p0["C"].count() == 50
+    del d0
+    assert p0["A"].sum() == 4950
+
+
+def test_topandas_zero_copy_readonly(pandas):
+    d0 = dt.Frame(A=[1, 2, 3], B=[1, None, 3])
+    p0 = d0.to_pandas()
+    # Column A is shared with the frame, and cannot be modified in-place;
+    # column B was converted (because of the NA), and is writable
+    assert not p0["A"].values.flags.writeable
+    assert p0["B"].values.flags.writeable
+    p1 = p0.copy()
+    p1.iloc[0, 0] = 100
+    assert p1["A"].tolist() == [100, 2, 3]
+    assert d0.to_list()[0] == [1, 2, 3]
+
+
 @pytest.mark.usefixtures("pandas", "numpy")
 def test_topandas_bool_nas():
     d0 = dt.Frame(A=[True, False, None, True])
@@ -883,6 +969,16 @@ def test_tonumpy_with_NAs_view():
     assert a.tolist() == [[2.3], [None], [4.4], [9.8], [None]]
 
 
+def test_tonumpy_strings(numpy):
+    src = ["abc", None, "\u00e9t\u00e9", "", "abc", "\U0001F600", None]
+    d0 = dt.Frame(A=src * 100)
+    a = d0.to_numpy()
+    assert a.dtype == numpy.dtype("object")
+    assert a[:, 0].tolist() == src * 100
+    b = d0[::-3, :].to_numpy()
+    assert b[:, 0].tolist() == (src * 100)[::-3]
+
+
 
 #-------------------------------------------------------------------------------
 # [0, 0] (conversion to scalar python variable)
@@ -199,6 +199,44 @@ def test_create_from_tuple():
     assert d2.ltypes == (ltype.int, )
 
 
+@pytest.mark.parametrize("src, st", [
+    ([None, None], stype.bool8),
+    ([True, None, 0, 1], stype.bool8),
+    ([1, -127, None, 127], stype.int8),
+    ([-128, 0], stype.int16),
+    ([1, 32767, -32768], stype.int32),
+    ([2**31, None], stype.int64),
+    ([5, 2**63], stype.float64),
+    ([1, None, 2.5, float("inf")], stype.float64),
+    (["a", None, "", "ÿŵü", "tiger"], stype.str32),
+    ([True, 5], stype.obj64),
+    (["a", 1.5, None], stype.obj64)])
+def test_create_from_list_autotype(src, st):
+    d0 = dt.Frame(src)
+    frame_integrity_check(d0)
+    assert d0.stypes == (st, )
+    if st == stype.bool8:
+        src = [None if x is None else bool(x) for x in src]
+    if st == stype.float64:
+        src = [None if x is None else float(x) for x in src]
+    assert d0.to_list() == [src]
+
+
+def test_create_from_list_autotype_large():
+    n = 200000
+    src = [i % 1000 for i in range(n)]
+    src[-1] = 100000
+    d0 = dt.Frame(src)
+    frame_integrity_check(d0)
+    assert d0.stypes == (stype.int32, )
+    assert d0.to_list() == [src]
+    src = [str(i) if i % 3 else None for i in range(n)]
+    d1 = dt.Frame(src)
+    frame_integrity_check(d1)
+    assert d1.stypes == (stype.str32, )
+    assert d1.to_list() == [src]
+
+
 def test_create_from_range():
     d0 = dt.Frame(range(8))
     frame_integrity_check(d0)
@@ -939,6 +977,116 @@ def test_create_from_datetime_array(numpy):
 
 
 
+#-------------------------------------------------------------------------------
+# Create from Arrow
+#-------------------------------------------------------------------------------
+
+class ArrowSource:
+    """Minimal object implementing the Arrow PyCapsule protocol."""
+    def __init__(self, frame):
+        self.frame = frame
+
+    def __arrow_c_array__(self, requested_schema=None):
+        return self.frame.__arrow_c_array__(requested_schema)
+
+
+def test_arrow_capsules():
+    DT = dt.Frame(A=[1, 2, 3])
+    res = DT.__arrow_c_array__()
+    assert isinstance(res, tuple) and len(res) == 2
+    assert "arrow_schema" in repr(res[0])
+    assert "arrow_array" in repr(res[1])
+
+
+def test_arrow_roundtrip():
+    DT = dt.Frame([[True, False, None], [1, None, -3], [7, 1000, None],
+                   [10**6, None, 0], [None, 2**40, -1], [1.5, None, 2.25],
+                   [0.5, -1e300, None], ["a", None, "ccc"], [None, "", "d"]],
+                  names=list("ABCDEFGHI"),
+                  stypes=[stype.bool8, stype.int8, stype.int16, stype.int32,
+                          stype.int64, stype.float32, stype.float64,
+                          stype.str32, stype.str64])
+    RES = dt.Frame(ArrowSource(DT))
+    frame_integrity_check(RES)
+    assert RES.names == DT.names
+    assert RES.stypes == DT.stypes
+    assert RES.to_list() == DT.to_list()
+
+
+def test_arrow_roundtrip_view():
+    DT = dt.Frame(A=range(10), B=[str(i) if i % 3 else None
+                                  for i in range(10)])
+    view = DT[::2, :]
+    RES = dt.Frame(ArrowSource(view))
+    frame_integrity_check(RES)
+    assert RES.to_list() == view.to_list()
+
+
+def test_arrow_keeps_data_alive():
+    DT = dt.Frame(A=list(range(1000)), B=["x%d" % i for i in range(1000)])
+    src = ArrowSource(DT)
+    RES = dt.Frame(src)
+    del DT
+    del src
+    frame_integrity_check(RES)
+    assert RES[999, :].to_list() == [[999], ["x999"]]
+    # Imported buffers are read-only, so modifying the frame creates a copy
+    RES[0, "A"] = -1
+    assert RES[:2, "A"].to_list() == [[-1, 1]]
+
+
+def test_arrow_with_names():
+    DT = dt.Frame(A=[1, 2], B=[3, 4])
+    RES = dt.Frame(ArrowSource(DT), names=["x", "y"])
+    assert RES.names == ("x", "y")
+    with pytest.raises(TypeError):
+        dt.Frame(ArrowSource(DT), stypes=[int, int])
+
+
+def test_arrow_export_obj_column():
+    DT = dt.Frame(A=[1, [], None], stype=stype.obj64)
+    with pytest.raises(TypeError) as e:
+        DT.__arrow_c_array__()
+    assert "cannot be exported to Arrow" in str(e.value)
+
+
+def test_arrow_pyarrow(pyarrow):
+    DT = dt.Frame(A=[1, None, 3], B=["a", "bb", None], C=[0.5, 1.5, None])
+    batch = pyarrow.record_batch(DT)
+    assert batch.num_rows == 3
+    assert batch.column(0).to_pylist() == [1, None, 3]
+    assert batch.column(1).to_pylist() == ["a", "bb", None]
+    RES = dt.Frame(batch)
+    frame_integrity_check(RES)
+    assert RES.to_list() == DT.to_list()
+
+
+@pytest.mark.parametrize("large", [False, True])
+def test_arrow_pyarrow_null_slot_with_data(pyarrow, large):
+    # Arrow allows null elements to occupy a non-empty slot in the string
+    # data: here the null in the middle spans the bytes "XYZ", which must
+    # not end up in the imported column
+    import array
+    offsets = array.array("q" if large else "i", [0, 2, 5, 7])
+    arr = pyarrow.Array.from_buffers(
+        pyarrow.large_string() if large else pyarrow.string(), 3,
+        [pyarrow.py_buffer(bytes([0b101])),
+         pyarrow.py_buffer(offsets.tobytes()),
+         pyarrow.py_buffer(b"abXYZcd")])
+    assert arr.to_pylist() == ["ab", None, "cd"]
+    RES = dt.Frame(pyarrow.record_batch([arr], names=["A"]))
+    frame_integrity_check(RES)
+    assert RES.stypes == (stype.str64 if large else stype.str32,)
+    assert RES.to_list() == [["ab", None, "cd"]]
+    RES = dt.Frame(pyarrow.record_batch([arr.slice(1)], names=["A"]))
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[None, "cd"]]
+    RES = dt.Frame(pyarrow.record_batch([arr.slice(0, 2)], names=["A"]))
+    frame_integrity_check(RES)
+    assert RES.to_list() == [["ab", None]]
+
+
+
 #-------------------------------------------------------------------------------
 # Issues
 #-------------------------------------------------------------------------------
@@ -14,7 +14,8 @@ def test_options_all():
     # Update this test every time a new option is added
     assert repr(dt.options).startswith("<datatable.options.DtConfig:")
     assert set(dir(dt.options)) == {
-        "nthreads", "core_logger", "sort", "display", "frame", "fread"}
+        "nthreads", "core_logger", "sort", "display", "frame", "fread",
+        "memory", "profile"}
     assert set(dir(dt.options.sort)) == {
         "insert_method_threshold", "thread_multiplier", "max_chunk_length",
         "max_radix_bits", "over_radix_bits", "nthreads"}
@@ -23,6 +24,8 @@ def test_options_all():
     assert set(dir(dt.options.frame)) == {
         "names_auto_index", "names_auto_prefix"}
     assert set(dir(dt.options.fread)) == {"anonymize"}
+    assert set(dir(dt.options.memory)) == {
+        "limit", "spill_dir", "hugepages", "first_touch"}
 
 
 @pytest.mark.skip()
@@ -119,6 +122,68 @@ def test_nthreads():
     del dt.options.nthreads
     assert dt.options.nthreads == initial
 
+
+def test_nthreads_concurrent():
+    # Several python threads using the same thread pool simultaneously
+    import threading
+    initial = dt.options.nthreads
+    try:
+        dt.options.nthreads = 4
+        n = 100000
+        DT = dt.Frame(A=[(i * 7919) % n for i in range(n)],
+                      B=[str(i % 1000) for i in range(n)])
+        csv = DT.to_csv()
+        errors = []
+
+        def work():
+            try:
+                for _ in range(3):
+                    d = dt.fread(csv)
+                    assert d.shape == (n, 2)
+                    assert d.sort("A")[:, "A"].to_list() == [list(range(n))]
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=work) for _ in range(3)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert not errors
+    finally:
+        dt.options.nthreads = initial
+
+
+def test_nthreads_resize_concurrent():
+    # The thread pool is resized while other python threads are running
+    # parallel regions in it
+    import threading
+    initial = dt.options.nthreads
+    try:
+        n = 200000
+        DT = dt.Frame(A=[(i * 7919) % n for i in range(n)])
+        errors = []
+
+        def work():
+            try:
+                for _ in range(5):
+                    res = DT.sort("A")
+                    assert res[:, "A"].to_list() == [list(range(n))]
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=work) for _ in range(3)]
+        for t in threads:
+            t.start()
+        for i in range(100):
+            dt.options.nthreads = 1 + i % 4
+        for t in threads:
+            t.join()
+        assert not errors
+    finally:
+        dt.options.nthreads = initial
+
+
 def test_core_logger():
     class MyLogger:
         def __init__(self):
@@ -167,3 +232,151 @@ def test_frame_names_auto_prefix():
     assert f2.names == ("C0", "C1", "C2", "C3")
     with pytest.raises(TypeError):
         dt.options.frame.names_auto_prefix = 0
+
+
+def test_memory_limit_spill():
+    assert dt.options.memory.limit == 0
+    n = 500000
+    try:
+        dt.options.memory.limit = 16 * 1024 * 1024
+        frames = []
+        copies = []
+        for i in range(10):
+            frames.append(dt.Frame(A=range(i, i + n), stype=dt.int64))
+            # Only read-only buffers can be spilled: the copy shares the
+            # frame's buffer, so that it can no longer be written in-place
+            copies.append(frames[-1].copy())
+        for i, f in enumerate(frames):
+            frame_integrity_check(f)
+            assert f[0, 0] == i
+            assert f[-1, 0] == i + n - 1
+            assert f.sum1() == n * i + n * (n - 1) // 2
+        # writing into a spilled buffer creates a copy of it
+        frames[0][0, 0] = -1
+        assert frames[0][0, 0] == -1
+        assert copies[0][0, 0] == 0
+    finally:
+        del dt.options.memory.limit
+    assert dt.options.memory.limit == 0
+
+
+def test_memory_limit_writable_not_spilled():
+    # Buffers owned by a single frame may be written into at any time, and
+    # therefore they are never spilled
+    n = 500000
+    frames = []
+    try:
+        dt.options.memory.limit = 16 * 1024 * 1024
+        with pytest.raises(MemoryError):
+            for i in range(10):
+                frames.append(dt.Frame(A=range(i, i + n), stype=dt.int64))
+    finally:
+        del dt.options.memory.limit
+    for f in frames:
+        frame_integrity_check(f)
+
+
+def test_memory_limit_exceeded():
+    try:
+        dt.options.memory.limit = 1024 * 1024
+        with pytest.raises(MemoryError) as e:
+            dt.Frame(A=range(1000000), stype=dt.int64)
+        assert ("memory limit of 1048576 bytes set in "
+                "`dt.options.memory.limit` has been exceeded" in str(e.value))
+    finally:
+        del dt.options.memory.limit
+    f = dt.Frame(A=range(1000000), stype=dt.int64)
+    assert f.shape == (1000000, 1)
+
+
+def test_memory_limit_bad():
+    with pytest.raises(ValueError):
+        dt.options.memory.limit = -1
+    assert dt.options.memory.limit == 0
+
+
+def test_memory_hugepages():
+    from datatable.internal import get_alloc_stats
+    n = 1000000
+    assert dt.options.memory.hugepages
+    assert not dt.options.memory.first_touch
+    stats0 = get_alloc_stats()
+    f0 = dt.Frame(A=range(n), stype=dt.int64)
+    stats1 = get_alloc_stats()
+    assert stats1["large_allocs"] > stats0["large_allocs"]
+    assert stats1["large_bytes"] - stats0["large_bytes"] >= 8 * n
+    try:
+        dt.options.memory.hugepages = False
+        dt.options.memory.first_touch = True
+        f1 = dt.Frame(A=range(n), stype=dt.int64)
+        stats2 = get_alloc_stats()
+        assert stats2["hugepage_allocs"] == stats1["hugepage_allocs"]
+    finally:
+        del dt.options.memory.hugepages
+        del dt.options.memory.first_touch
+    frame_integrity_check(f0)
+    frame_integrity_check(f1)
+    assert f0.sum1() == f1.sum1() == n * (n - 1) // 2
+
+
+def test_option_profile(tempfile):
+    import json
+    assert not dt.options.profile
+    dt.profiler.clear()
+    try:
+        dt.options.profile = True
+        assert dt.options.profile
+        DT = dt.Frame(A=[5, 3, 1, 4, 2] * 100, B=list(range(500)))
+        DT.sort("A")
+        DT[:, dt.sum(dt.f.B), dt.by("A")]
+        dt.fread(DT.to_csv())
+    finally:
+        del dt.options.profile
+    assert not dt.options.profile
+
+    rep = dt.profiler.report()
+    frame_integrity_check(rep)
+    assert rep.names == ("operation", "count", "total_time", "max_time")
+    ops = rep[:, "operation"].to_list()[0]
+    for op in ["sort", "sort.prepare", "evaluate", "evaluate.by",
+               "reduce", "to_csv", "fread", "fread.parse"]:
+        assert op in ops
+    cnt = dt.profiler.counters()
+    assert cnt["sort.rows"] >= 1000
+    assert cnt["fread.rows"] == 500
+
+    dt.profiler.save_trace(tempfile)
+    with open(tempfile) as inp:
+        trace = json.load(inp)
+    assert len(trace["traceEvents"]) == rep[:, dt.sum(dt.f.count)][0, 0]
+    assert all(e["ph"] == "X" for e in trace["traceEvents"])
+
+    # Nothing is recorded when profiling is off
+    dt.profiler.clear()
+    DT.sort("B")
+    assert dt.profiler.report().nrows == 0
+    assert dt.profiler.counters() == {}
+
+
+def test_option_profile_short_lived_threads(tempfile):
+    # Buffers of the threads that have exited are reused, so the number of
+    # buffers does not grow with the number of threads ever started
+    import json
+    import threading
+    dt.profiler.clear()
+    try:
+        dt.options.profile = True
+        DT = dt.Frame(A=list(range(1000)))
+        for _ in range(30):
+            t = threading.Thread(target=lambda: DT.sort("A"))
+            t.start()
+            t.join()
+    finally:
+        del dt.options.profile
+    dt.profiler.save_trace(tempfile)
+    with open(tempfile) as inp:
+        trace = json.load(inp)
+    tids = set(e["tid"] for e in trace["traceEvents"])
+    assert len(trace["traceEvents"]) >= 30
+    assert len(tids) <= dt.options.nthreads + 5
+    dt.profiler.clear()
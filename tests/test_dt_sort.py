@@ -914,3 +914,63 @@ def test_h2oai7014(tempfile):
     counts = counts[:, :, sort("count")]
     counts.materialize()
     assert counts.to_list() == [['t'], [1047]]
+
+
+def test_sort_concurrent_threads():
+    # Sort releases the GIL, so that several sorts (and other operations)
+    # may run concurrently from different python threads
+    import threading
+    n = 200000
+    DT = dt.Frame(A=[(i * 7907) % 1000 for i in range(n)],
+                  B=["%05d" % ((i * 13) % 99991) for i in range(n)],
+                  C=[(i * 0.37) % 1 for i in range(n)])
+    expected = {c: sorted(DT[:, c].to_list()[0]) for c in "ABC"}
+    errors = []
+
+    def work(col):
+        try:
+            for _ in range(2):
+                res = DT.sort(col)
+                assert res[:, col].to_list()[0] == expected[col]
+                DT2 = dt.fread(DT.to_csv())
+                assert DT2.shape == DT.shape
+        except Exception as e:
+            errors.append(e)
+
+    # Several threads sort the same column: the stats of the column (which
+    # the sort needs for integer columns) have not been computed yet, so
+    # the threads must not race to create them
+    threads = [threading.Thread(target=work, args=(c,)) for c in "AABBCC"]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert not errors
+
+
+def test_sort_concurrent_shared_column():
+    import threading
+    n = 300000
+    for stype in (dt.int8, dt.int32, dt.int64, dt.str32):
+        src = [(i * 7907) % 100 for i in range(n)]
+        if stype == dt.str32:
+            src = [str(x) for x in src]
+        DT = dt.Frame(A=src, stype=stype)
+        expected = sorted(src)
+        errors = []
+
+        def work():
+            try:
+                for _ in range(3):
+                    res = DT.sort("A")
+                    assert res.to_list()[0] == expected
+            except Exception as e:
+                errors.append(e)
+
+        threads = [threading.Thread(target=work) for _ in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert not errors
+        frame_integrity_check(DT)
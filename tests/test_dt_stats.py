@@ -339,6 +339,109 @@ def test_mode(src):
 
 
 
+#-------------------------------------------------------------------------------
+# Stats composed from parts
+#-------------------------------------------------------------------------------
+
+def check_stats_after_rbind(parts):
+    frames = [dt.Frame(p) for p in parts]
+    for f in frames:
+        # compute all stats of each part in advance
+        f.min(); f.max(); f.sum(); f.mean(); f.sd(); f.countna()
+        f.nunique(); f.mode()
+    res = frames[0]
+    res.rbind(*frames[1:])
+    frame_integrity_check(res)
+    data = sum(parts, [])
+    exp = dt.Frame(data)
+    assert res.countna1() == exp.countna1()
+    assert res.nunique1() == exp.nunique1()
+    assert res.min1() == exp.min1()
+    assert res.max1() == exp.max1()
+    assert list_equals([res.sum1(), res.mean1(), res.sd1()],
+                       [exp.sum1(), exp.mean1(), exp.sd1()])
+
+
+@pytest.mark.parametrize("parts", [
+    [[True, False, None], [None, None], [True, True]],
+    [[None, None], [False]],
+    [[5, -3, 6, 3, 0], [None, -1, 0, 26, -3], [7, 7, 7]],
+    [[None, None], [1, 2, 3, 4]],
+    [[1.5, 2.5, None, 1e10], [0.1, -0.7], [None]],
+    [[1.5, inf, 3.0], [2.0, -1.0]],
+    [[1.0, 2.0], [-inf, 0.5], [inf]],
+])
+def test_stats_after_rbind(parts):
+    check_stats_after_rbind(parts)
+
+
+@pytest.mark.parametrize("seed", [random.getrandbits(32)])
+def test_stats_after_rbind_random(seed):
+    random.seed(seed)
+    parts = [[random.gauss(10, 3) if random.random() > 0.1 else None
+              for _ in range(random.randint(1, 50))]
+             for _ in range(random.randint(2, 6))]
+    check_stats_after_rbind(parts)
+
+
+def test_stats_after_rbind_void_and_cast():
+    f0 = dt.Frame(A=[3, 1, 4])
+    assert f0.max1() == 4
+    f0.rbind(dt.Frame(B=[None] * 5), force=True)
+    frame_integrity_check(f0)
+    assert f0.shape == (8, 2)
+    assert f0.countna().to_list() == [[5], [8]]
+    assert f0.max().to_list() == [[4], [None]]
+    f0.rbind(dt.Frame(A=[2.5], B=["x"]))
+    frame_integrity_check(f0)
+    assert f0.stypes == (stype.float64, stype.str32)
+    assert f0.mean().to_list()[0] == [2.625]
+
+
+def test_stats_after_rbind_strings():
+    f0 = dt.Frame(["a", "b", None, "b"])
+    f1 = dt.Frame(["c", None, None])
+    assert f0.mode1() == "b" and f1.mode1() == "c"
+    f0.rbind(f1)
+    frame_integrity_check(f0)
+    assert f0.countna1() == 3
+    assert f0.nunique1() == 3
+    assert f0.mode1() == "b"
+
+
+def test_stats_of_copy():
+    f0 = dt.Frame([5, 2, None, 8])
+    assert f0.sum1() == 15
+    f1 = f0.copy()
+    frame_integrity_check(f1)
+    assert f1.sum1() == 15
+    f1[0, 0] = 100
+    frame_integrity_check(f1)
+    assert f1.sum1() == 110
+    assert f0.sum1() == 15
+
+
+def test_stats_of_copy_after_assign():
+    f0 = dt.Frame(A=[5, 2, None, 8])
+    assert [f0.min1(), f0.max1(), f0.mean1()] == [2, 8, 5]
+    f1 = f0.copy()
+    f1[[0, 3], "A"] = dt.Frame([-10, 100])
+    frame_integrity_check(f1)
+    assert [f1.min1(), f1.max1(), f1.mean1()] == [-10, 100, 92 / 3]
+    assert [f0.min1(), f0.max1(), f0.mean1()] == [2, 8, 5]
+
+
+def test_stats_of_copy_after_replace():
+    f0 = dt.Frame([True, False, True, None])
+    assert [f0.min1(), f0.max1(), f0.mean1()] == [False, True, 2 / 3]
+    f1 = f0.copy()
+    f1.replace(True, False)
+    frame_integrity_check(f1)
+    assert [f1.min1(), f1.max1(), f1.mean1()] == [False, False, 0]
+    assert [f0.min1(), f0.max1(), f0.mean1()] == [False, True, 2 / 3]
+
+
+
 #-------------------------------------------------------------------------------
 # Special cases
 #-------------------------------------------------------------------------------
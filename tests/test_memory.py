@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#-------------------------------------------------------------------------------
+# Copyright 2018 H2O.ai
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+#-------------------------------------------------------------------------------
+# Tests for the memory accounting in `datatable.internal.memory_stats()`
+#-------------------------------------------------------------------------------
+import datatable as dt
+from datatable.internal import memory_stats, reset_memory_peak
+
+
+def test_memory_stats():
+    n = 1000000
+    stats0 = memory_stats()
+    assert set(stats0.keys()) == {
+        "current", "peak", "heap", "heap_buffers", "limited", "spilled",
+        "mmap", "external", "view", "mmap_buffers", "external_buffers",
+        "view_buffers", "cow_copies", "cow_bytes"}
+    assert stats0["peak"] >= stats0["current"]
+    assert stats0["heap"] <= stats0["current"]
+    f0 = dt.Frame(A=range(n), stype=dt.int64)
+    stats1 = memory_stats()
+    assert stats1["current"] - stats0["current"] >= 8 * n
+    del f0
+    stats2 = memory_stats()
+    assert stats2["current"] < stats1["current"]
+    assert stats2["peak"] >= stats1["current"]
+    old_peak = reset_memory_peak()
+    assert old_peak == stats2["peak"]
+    assert memory_stats()["peak"] < stats1["current"]
+
+
+def test_memory_stats_temporaries():
+    # Temporary buffers used while sorting are not held by the frame, but
+    # still count towards the peak
+    n = 1000000
+    f0 = dt.Frame(A=range(n, 0, -1), stype=dt.int64)
+    reset_memory_peak()
+    stats0 = memory_stats()
+    f1 = f0.sort("A")
+    stats1 = memory_stats()
+    assert stats1["heap_buffers"] >= stats0["heap_buffers"]
+    assert stats1["peak"] > stats0["current"]
+    assert stats1["peak"] >= stats1["current"]
+    assert f1[0, "A"] == 1
+    del f0, f1
+
+
+def test_memory_stats_cow():
+    f0 = dt.Frame(A=range(1000), stype=dt.int32)
+    f1 = f0.copy()
+    stats0 = memory_stats()
+    f1[0, "A"] = -1
+    stats1 = memory_stats()
+    assert stats1["cow_copies"] == stats0["cow_copies"] + 1
+    assert stats1["cow_bytes"] == stats0["cow_bytes"] + 4000
+    assert f0[0, "A"] == 0
+    assert f1[0, "A"] == -1
+
+
+def test_memory_stats_external(numpy):
+    arr = numpy.arange(100000, dtype="int64")
+    stats0 = memory_stats()
+    f0 = dt.Frame(arr)
+    stats1 = memory_stats()
+    assert stats1["external"] == stats0["external"] + 800000
+    assert stats1["external_buffers"] == stats0["external_buffers"] + 1
+    # External buffers are not included into the current total
+    assert stats1["current"] - stats0["current"] < 800000
+    del f0
+    assert memory_stats()["external"] == stats0["external"]
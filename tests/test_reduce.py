@@ -24,7 +24,9 @@
 import datatable as dt
 import math
 import pytest
-from datatable import f, by, ltype, first, count, median
+from datatable import (f, by, ltype, first, count, median, last, nunique,
+                       prod, var, skew, kurt)
+from datatable.expr import any as dtany, all as dtall
 from datatable.internal import frame_integrity_check
 from tests import noop
 
@@ -351,3 +353,131 @@ def test_median_wrong_stype():
         noop(DT[:, median(f.B)])
     assert ("Unable to apply reduce function `median()` to a column of "
             "type `str64`" in str(e.value))
+
+
+
+
+#-------------------------------------------------------------------------------
+# Last
+#-------------------------------------------------------------------------------
+
+def test_last_array():
+    assert last([1, 5, 2]) == 2
+    assert last([]) is None
+
+
+def test_last_dt_groupby():
+    DT = dt.Frame(A=[1, 1, 2, 2, 2, 3], B=["a", "b", None, "c", "d", "e"])
+    RES = DT[:, last(f.B), by(f.A)]
+    frame_integrity_check(RES)
+    assert RES.stypes == (dt.int8, dt.str32)
+    assert RES.to_list() == [[1, 2, 3], ["b", "d", "e"]]
+
+
+def test_last_empty_frame():
+    DT = dt.Frame(A=[], stype=dt.float64)
+    RES = DT[:, last(f.A)]
+    assert RES.shape == (0, 1)
+
+
+
+
+#-------------------------------------------------------------------------------
+# Nunique
+#-------------------------------------------------------------------------------
+
+@pytest.mark.parametrize("st", ltype.int.stypes + ltype.real.stypes)
+def test_nunique_numeric(st):
+    DT = dt.Frame(A=[3, 1, None, 3, 7, 1, None, 0], stype=st)
+    RES = DT[:, nunique(f.A)]
+    frame_integrity_check(RES)
+    assert RES.stypes == (dt.int64,)
+    assert RES.to_list() == [[4]]
+
+
+@pytest.mark.parametrize("st", [dt.str32, dt.str64])
+def test_nunique_str_grouped(st):
+    DT = dt.Frame(A=[1, 2, 1, 1, 2, 3, 1],
+                  B=["x", "yy", "y", "x", None, None, ""],
+                  stypes={"A": dt.int32, "B": st})
+    RES = DT[:, nunique(f.B), by(f.A)]
+    frame_integrity_check(RES)
+    assert RES.stypes == (dt.int32, dt.int64)
+    assert RES.to_list() == [[1, 2, 3], [3, 1, 0]]
+
+
+def test_nunique_empty_frame():
+    DT = dt.Frame(A=[], stype=dt.str32)
+    assert DT[:, nunique(f.A)].to_list() == [[0]]
+
+
+
+
+#-------------------------------------------------------------------------------
+# Any / All
+#-------------------------------------------------------------------------------
+
+def test_any_all_grouped():
+    DT = dt.Frame(G=[1, 1, 2, 2, 3, 3, 4],
+                  X=[True, False, False, False, True, None, None])
+    RES = DT[:, [dtany(f.X), dtall(f.X)], by(f.G)]
+    frame_integrity_check(RES)
+    assert RES.stypes == (dt.int8, dt.bool8, dt.bool8)
+    assert RES.to_list() == [[1, 2, 3, 4],
+                             [True, False, True, False],
+                             [False, False, True, True]]
+
+
+def test_any_all_python():
+    assert dtany([0, 0, 1]) is True
+    assert dtall([1, 0]) is False
+
+
+def test_any_wrong_stype():
+    DT = dt.Frame(A=[1, 2], stype=dt.int32)
+    with pytest.raises(TypeError) as e:
+        noop(DT[:, dtany(f.A)])
+    assert ("Unable to apply reduce function `any()` to a column of "
+            "type `int32`" in str(e.value))
+
+
+
+
+#-------------------------------------------------------------------------------
+# Prod / Var / Skew / Kurt
+#-------------------------------------------------------------------------------
+
+def test_prod_grouped():
+    DT = dt.Frame(G=[1, 1, 1, 2, 2, 3], X=[2, 3, None, -1, 5, None])
+    RES = DT[:, prod(f.X), by(f.G)]
+    frame_integrity_check(RES)
+    assert RES.stypes == (dt.int8, dt.int64)
+    assert RES.to_list() == [[1, 2, 3], [6, -5, 1]]
+
+
+def test_var():
+    DT = dt.Frame(A=[1, 2, 3, 4, None], B=[1.5, None, None, None, None])
+    RES = DT[:, [var(f.A), var(f.B)]]
+    assert RES.stypes == (dt.float64, dt.float64)
+    assert RES.to_list() == [[5 / 3], [None]]
+
+
+def test_skew_kurt():
+    src = [1, 2, 3, 10, 4, None]
+    DT = dt.Frame(A=src)
+    RES = DT[:, [skew(f.A), kurt(f.A)]]
+    xs = [x for x in src if x is not None]
+    n = len(xs)
+    mean = sum(xs) / n
+    m2 = sum((x - mean)**2 for x in xs)
+    m3 = sum((x - mean)**3 for x in xs)
+    m4 = sum((x - mean)**4 for x in xs)
+    assert RES[0, 0] == pytest.approx(math.sqrt(n) * m3 / m2**1.5)
+    assert RES[0, 1] == pytest.approx(n * m4 / m2**2)
+
+
+def test_skew_grouped_constant():
+    DT = dt.Frame(G=[1, 1, 2, 2, 2], X=[5, 5, 1, 2, 4])
+    RES = DT[:, skew(f.X), by(f.G)]
+    assert RES[0, 1] is None
+    assert RES[1, 1] == pytest.approx(0.3818017741606059)
@@ -0,0 +1,179 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#-------------------------------------------------------------------------------
+# Copyright 2019 H2O.ai
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+import pytest
+import datatable as dt
+from datatable import (f, by, cumsum, cumcount, shift, rank, rolling_mean,
+                       rolling_sum)
+from datatable.internal import frame_integrity_check
+from tests import noop
+
+
+#-------------------------------------------------------------------------------
+# cumsum / cumcount
+#-------------------------------------------------------------------------------
+
+def test_cumsum_ungrouped():
+    DT = dt.Frame(X=[1, 2, None, 4, 5])
+    RES = DT[:, cumsum(f.X)]
+    frame_integrity_check(RES)
+    assert RES.stypes == (dt.int64,)
+    assert RES.to_list() == [[1, 3, None, 7, 12]]
+
+
+def test_cumsum_grouped():
+    DT = dt.Frame(G=[2, 1, 2, 1, 2, 1], X=[1.5, 2, 3, None, 5, 6])
+    RES = DT[:, [f.X, cumsum(f.X)], by(f.G)]
+    frame_integrity_check(RES)
+    assert RES.stypes == (dt.int8, dt.float64, dt.float64)
+    assert RES.to_list() == [[1, 1, 1, 2, 2, 2],
+                             [2, None, 6, 1.5, 3, 5],
+                             [2, None, 8, 1.5, 4.5, 9.5]]
+
+
+def test_window_grouped_row_order():
+    # Window results come out in grouped order, aligned with the other
+    # columns of the same `by()` query, not in the original row order.
+    DT = dt.Frame(g=[2, 1, 2, 1, 2], v=[10, 20, 30, 40, 50])
+    RES = DT[:, [f.g, f.v, cumsum(f.v)], by(f.g)]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[1, 1, 2, 2, 2],
+                             [1, 1, 2, 2, 2],
+                             [20, 40, 10, 30, 50],
+                             [20, 60, 10, 40, 90]]
+
+
+def test_cumcount_grouped():
+    DT = dt.Frame(G=[3, 1, 3, 3, 1])
+    RES = DT[:, cumcount(), by(f.G)]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[1, 1, 3, 3, 3], [0, 1, 0, 1, 2]]
+
+
+def test_cumsum_wrong_stype():
+    DT = dt.Frame(S=["a", "b"])
+    with pytest.raises(TypeError) as e:
+        noop(DT[:, cumsum(f.S)])
+    assert ("Unable to apply window function `cumsum()` to a column of type "
+            "`str32`" in str(e.value))
+
+
+
+
+#-------------------------------------------------------------------------------
+# shift
+#-------------------------------------------------------------------------------
+
+def test_shift_grouped():
+    DT = dt.Frame(G=[2, 1, 2, 1, 2, 1], X=[1, 2, 3, None, 5, 6])
+    RES = DT[:, [shift(f.X), shift(f.X, n=-1), shift(f.X, 5)], by(f.G)]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[1, 1, 1, 2, 2, 2],
+                             [None, 2, None, None, 1, 3],
+                             [None, 6, None, 3, 5, None],
+                             [None] * 6]
+
+
+def test_shift_strings():
+    DT = dt.Frame(G=[1, 1, 2, 2, 2], S=["a", "b", "c", None, "e"])
+    RES = DT[:, shift(f.S), by(f.G)]
+    frame_integrity_check(RES)
+    assert RES.stypes == (dt.int8, dt.str32)
+    assert RES.to_list() == [[1, 1, 2, 2, 2], [None, "a", None, "c", None]]
+
+
+def test_shift_with_filter():
+    DT = dt.Frame(X=range(10))
+    RES = DT[::3, shift(f.X)]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[None, 0, 3, 6]]
+
+
+def test_shift_huge_amount():
+    DT = dt.Frame(X=[1, 2, 3])
+    RES = DT[:, [shift(f.X, 2**63 - 1), shift(f.X, -2**63 + 1)]]
+    frame_integrity_check(RES)
+    assert RES.to_list() == [[None] * 3, [None] * 3]
+    with pytest.raises(ValueError) as e:
+        noop(DT[:, shift(f.X, -2**63)])
+    assert "Shift amount in `shift()` is out of range" in str(e.value)
+
+
+
+
+#-------------------------------------------------------------------------------
+# rank
+#-------------------------------------------------------------------------------
+
+def test_rank_ties():
+    DT = dt.Frame(X=[3.5, 1, None, 3.5, -2, 1])
+    RES = DT[:, rank(f.X)]
+    frame_integrity_check(RES)
+    assert RES.stypes == (dt.int64,)
+    assert RES.to_list() == [[4, 2, None, 4, 1, 2]]
+
+
+def test_rank_grouped():
+    DT = dt.Frame(G=[1, 2, 1, 2, 1], X=[7, 7, 3, 9, 7])
+    RES = DT[:, rank(f.X), by(f.G)]
+    assert RES.to_list() == [[1, 1, 1, 2, 2], [2, 1, 2, 1, 2]]
+
+
+
+
+#-------------------------------------------------------------------------------
+# rolling_mean / rolling_sum
+#-------------------------------------------------------------------------------
+
+def test_rolling_grouped():
+    DT = dt.Frame(G=[2, 1, 2, 1, 2, 1], X=[1, 2, 3, None, 5, 6])
+    RES = DT[:, [rolling_sum(f.X, 2), rolling_mean(f.X, 2)], by(f.G)]
+    frame_integrity_check(RES)
+    assert RES.stypes == (dt.int8, dt.int64, dt.float64)
+    assert RES.to_list() == [[1, 1, 1, 2, 2, 2],
+                             [2, 2, 6, 1, 4, 8],
+                             [2.0, 2.0, 6.0, 1.0, 2.0, 4.0]]
+
+
+def test_rolling_all_na_window():
+    DT = dt.Frame(X=[None, None, 1.0])
+    RES = DT[:, [rolling_sum(f.X, 1), rolling_mean(f.X, 1)]]
+    assert RES.to_list() == [[0, 0, 1.0], [None, None, 1.0]]
+
+
+def test_rolling_infinities():
+    inf = float("inf")
+    DT = dt.Frame(X=[1.0, inf, 2.0, 3.0, -inf, inf, 4.0, 5.0, 6.0])
+    RES = DT[:, [rolling_sum(f.X, 2), rolling_mean(f.X, 2)]]
+    frame_integrity_check(RES)
+    # Once an infinity leaves the window, the results are finite again
+    assert RES.to_list() == [
+        [1.0, inf, inf, 5.0, -inf, None, inf, 9.0, 11.0],
+        [1.0, inf, inf, 2.5, -inf, None, inf, 4.5, 5.5]]
+
+
+def test_rolling_bad_window():
+    DT = dt.Frame(X=[1, 2, 3])
+    with pytest.raises(ValueError) as e:
+        noop(DT[:, rolling_mean(f.X, 0)])
+    assert ("Window size in `rolling_mean()` should be positive, instead "
+            "got 0" in str(e.value))